@@ -500,10 +500,12 @@ public:
     return 0;
   }
 
-  /// Create increment contents of target by 1 for Instrumentation
+  /// Create increment contents of target by 1 for Instrumentation.
+  /// If \p Atomic is false, targets may use a plain (non-locked) increment
+  /// where that is cheaper; concurrent updates can then lose counts.
   virtual InstructionListType
   createInstrIncMemory(const MCSymbol *Target, MCContext *Ctx, bool IsLeaf,
-                       unsigned CodePointerSize) const {
+                       unsigned CodePointerSize, bool Atomic = true) const {
     llvm_unreachable("not implemented");
     return InstructionListType();
   }
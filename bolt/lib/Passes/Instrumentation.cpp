@@ -57,6 +57,15 @@ cl::opt<uint32_t> InstrumentationSleepTime(
              "program and the profile is not being dumped at the end."),
     cl::init(0), cl::Optional, cl::cat(BoltInstrCategory));
 
+cl::opt<bool> InstrumentationNoAtomicCounters(
+    "instrumentation-no-atomic-counters",
+    cl::desc("increment profile counters without atomic read-modify-write. "
+             "Racing threads may lose increments, but the cache-line "
+             "serialization of locked counters is avoided, keeping "
+             "instrumented runs closer to production behavior "
+             "(default: false)"),
+    cl::init(false), cl::Optional, cl::cat(BoltInstrCategory));
+
 cl::opt<bool> InstrumentationNoCountersClear(
     "instrumentation-no-counters-clear",
     cl::desc("Don't clear counters across dumps "
@@ -196,7 +205,8 @@ Instrumentation::createInstrumentationSnippet(BinaryContext &BC, bool IsLeaf) {
   MCSymbol *Label = BC.Ctx->createNamedTempSymbol("InstrEntry");
   Summary->Counters.emplace_back(Label);
   return BC.MIB->createInstrIncMemory(Label, BC.Ctx.get(), IsLeaf,
-                                      BC.AsmInfo->getCodePointerSize());
+                                      BC.AsmInfo->getCodePointerSize(),
+                                      !opts::InstrumentationNoAtomicCounters);
 }
 
 // Helper instruction sequence insertion function
@@ -351,8 +351,8 @@ bool DataAggregator::checkPerfDataMagic(StringRef FileName) {
 void DataAggregator::parsePreAggregated() {
   std::string Error;
 
-  ErrorOr<std::unique_ptr<MemoryBuffer>> MB =
-      MemoryBuffer::getFileOrSTDIN(Filename);
+  ErrorOr<std::unique_ptr<MemoryBuffer>> MB = MemoryBuffer::getFileOrSTDIN(
+      Filename, /*IsText=*/false, /*RequiresNullTerminator=*/false);
   if (std::error_code EC = MB.getError()) {
     errs() << "PERF2BOLT-ERROR: cannot open " << Filename << ": "
            << EC.message() << "\n";
@@ -360,6 +360,7 @@ void DataAggregator::parsePreAggregated() {
   }
 
   FileBuf = std::move(*MB);
+  FileBuf->adviseSequentialIfMmap();
   ParsingBuf = FileBuf->getBuffer();
   Col = 0;
   Line = 1;
@@ -480,8 +481,13 @@ int DataAggregator::prepareToParse(StringRef Name, PerfProcessInfo &Process,
     return PI.ReturnCode;
   }
 
-  ErrorOr<std::unique_ptr<MemoryBuffer>> MB =
-      MemoryBuffer::getFileOrSTDIN(Process.StdoutPath.data());
+  // The parser works off ParsingBuf with explicit bounds, so skip the null
+  // terminator requirement: perf script output for long collections runs to
+  // tens of GB, and this guarantees it is mmapped rather than copied into
+  // memory.
+  ErrorOr<std::unique_ptr<MemoryBuffer>> MB = MemoryBuffer::getFileOrSTDIN(
+      Process.StdoutPath.data(), /*IsText=*/false,
+      /*RequiresNullTerminator=*/false);
   if (std::error_code EC = MB.getError()) {
     errs() << "Cannot open " << Process.StdoutPath.data() << ": "
            << EC.message() << "\n";
@@ -490,6 +496,7 @@ int DataAggregator::prepareToParse(StringRef Name, PerfProcessInfo &Process,
   }
 
   FileBuf = std::move(*MB);
+  FileBuf->adviseSequentialIfMmap();
   ParsingBuf = FileBuf->getBuffer();
   Col = 0;
   Line = 1;
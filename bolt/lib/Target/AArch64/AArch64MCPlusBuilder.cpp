@@ -1558,7 +1558,9 @@ public:
 
   InstructionListType
   createInstrIncMemory(const MCSymbol *Target, MCContext *Ctx, bool IsLeaf,
-                       unsigned CodePointerSize) const override {
+                       unsigned CodePointerSize, bool Atomic) const override {
+    // Atomic is ignored: the LSE add below has no cheaper non-atomic
+    // replacement that fits in the two registers this sequence preserves.
     unsigned int I = 0;
     InstructionListType Instrs(IsLeaf ? 12 : 10);
 
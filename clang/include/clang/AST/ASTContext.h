@@ -612,6 +612,13 @@ private:
   /// AST objects will be released when the ASTContext itself is destroyed.
   mutable llvm::BumpPtrAllocator BumpAlloc;
 
+  /// The allocator used to create Decl nodes.
+  ///
+  /// Decls get their own pool so that Stmt trees and type nodes, which are
+  /// what tree traversals actually walk, stay contiguous in \c BumpAlloc
+  /// instead of being interleaved with declarations.
+  mutable llvm::BumpPtrAllocator DeclAlloc;
+
   /// Allocator for partial diagnostics.
   PartialDiagnostic::DiagStorageAllocator DiagAllocator;
 
@@ -715,6 +722,12 @@ public:
   }
   void Deallocate(void *Ptr) const {}
 
+  /// Allocate memory for a Decl node. Only Decl::operator new should use
+  /// this; everything else belongs in the main arena.
+  void *AllocateDecl(size_t Size, unsigned Align = 8) const {
+    return DeclAlloc.Allocate(Size, Align);
+  }
+
   /// Allocates a \c DeclListNode or returns one from the \c ListNodeFreeList
   /// pool.
   DeclListNode *AllocateDeclListNode(clang::NamedDecl *ND) {
@@ -736,7 +749,7 @@ public:
   /// Return the total amount of physical memory allocated for representing
   /// AST nodes and type information.
   size_t getASTAllocatedMemory() const {
-    return BumpAlloc.getTotalMemory();
+    return BumpAlloc.getTotalMemory() + DeclAlloc.getTotalMemory();
   }
 
   /// Return the total memory used for various side tables.
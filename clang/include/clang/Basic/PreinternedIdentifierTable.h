@@ -0,0 +1,72 @@
+//===--- PreinternedIdentifierTable.h - Shared identifier set ---*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// A read-only, mmap-friendly table of pre-interned identifier spellings that
+// many compiler invocations can share. The file holds an open-addressed hash
+// table over a string blob; a probe answers "is this name in the shared set,
+// and at which stable index" without any per-process setup, and the returned
+// spellings live in the mapped pages, so one copy of the bytes serves every
+// process that maps the file.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_BASIC_PREINTERNEDIDENTIFIERTABLE_H
+#define LLVM_CLANG_BASIC_PREINTERNEDIDENTIFIERTABLE_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include <memory>
+#include <optional>
+
+namespace clang {
+
+/// A shared, immutable set of identifier spellings with stable indices.
+///
+/// Lookups hash the query once and probe the mapped table; indices are dense
+/// in [0, size()) and stable for the lifetime of the file, so clients can use
+/// them to key per-invocation side tables. The table is a pure string set:
+/// per-TU identifier state (macro bits, token kinds, revertibility) stays in
+/// IdentifierTable, which remains the source of truth for semantics.
+class PreinternedIdentifierTable {
+public:
+  /// Attempt to interpret \p File as a preinterned table; returns null if the
+  /// buffer is malformed.
+  static std::unique_ptr<PreinternedIdentifierTable>
+  open(std::unique_ptr<const llvm::MemoryBuffer> File);
+
+  /// Serialize a table over \p Names to \p OS. Duplicates are allowed and
+  /// uniqued; indices are assigned in sorted order so table contents are
+  /// reproducible across builders.
+  static void build(ArrayRef<StringRef> Names, raw_ostream &OS);
+
+  /// Return the stable index of \p Name, or std::nullopt if it is not in the
+  /// shared set.
+  std::optional<uint32_t> lookup(StringRef Name) const;
+
+  /// Whether \p Name is in the shared set.
+  bool contains(StringRef Name) const { return lookup(Name).has_value(); }
+
+  /// Return the spelling with the given stable index. The result points into
+  /// the mapped file and outlives this object only as long as the mapping.
+  StringRef getSpelling(uint32_t Index) const;
+
+  /// The number of spellings in the shared set.
+  size_t size() const;
+
+private:
+  explicit PreinternedIdentifierTable(
+      std::unique_ptr<const llvm::MemoryBuffer> File)
+      : FileBuffer(std::move(File)) {}
+
+  std::unique_ptr<const llvm::MemoryBuffer> FileBuffer;
+};
+
+} // namespace clang
+
+#endif // LLVM_CLANG_BASIC_PREINTERNEDIDENTIFIERTABLE_H
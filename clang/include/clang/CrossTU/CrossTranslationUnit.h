@@ -99,6 +99,43 @@ parseCrossTUIndex(StringRef IndexPath);
 
 std::string createCrossTUIndexString(const llvm::StringMap<std::string> &Index);
 
+/// Memory-mapped binary form of the CTU index.
+///
+/// Parsing the textual index is linear in its size and is paid by every
+/// analysis process sharing one CTU directory before it can resolve a single
+/// USR. The cache stores the (USR, identifier) pairs sorted by USR together
+/// with the size and modification time of the textual index it was built
+/// from, so later processes can map it and binary-search instead.
+class CrossTUIndexCache {
+public:
+  /// Interpret \p File as a cache built from a textual index with the given
+  /// size and modification time.
+  ///
+  /// \return The cache, or nullptr if the buffer is malformed or was built
+  /// from a different version of the textual index.
+  static std::unique_ptr<CrossTUIndexCache>
+  open(std::unique_ptr<const llvm::MemoryBuffer> File, uint64_t TextSize,
+       uint64_t TextModTime);
+
+  /// Serialize \p Index to \p OS, recording the stamp of the textual index it
+  /// was parsed from.
+  static void write(const llvm::StringMap<std::string> &Index,
+                    uint64_t TextSize, uint64_t TextModTime,
+                    llvm::raw_ostream &OS);
+
+  /// Find the identifier recorded for \p LookupName.
+  std::optional<StringRef> lookup(StringRef LookupName) const;
+
+  /// The number of (USR, identifier) pairs in the cache.
+  size_t size() const;
+
+private:
+  explicit CrossTUIndexCache(std::unique_ptr<const llvm::MemoryBuffer> File)
+      : FileBuffer(std::move(File)) {}
+
+  std::unique_ptr<const llvm::MemoryBuffer> FileBuffer;
+};
+
 using InvocationListTy = llvm::StringMap<llvm::SmallVector<std::string, 32>>;
 /// Parse the YAML formatted invocation list file content \p FileContent.
 /// The format is expected to be a mapping from absolute source file
@@ -324,6 +361,10 @@ private:
     llvm::Error ensureCTUIndexLoaded(StringRef CrossTUDir, StringRef IndexName);
     llvm::Expected<ASTUnit *> getASTUnitForFile(StringRef FileName,
                                                 bool DisplayCTUProgress);
+    /// Find the identifier the loaded index maps \p FunctionName to, looking
+    /// in the binary index cache when one is mapped and in \c NameFileMap
+    /// otherwise. Returns the empty string for unknown names.
+    std::string getFileForName(StringRef FunctionName) const;
 
     template <typename... T> using BaseMapTy = llvm::StringMap<T...>;
     using OwningMapTy = BaseMapTy<std::unique_ptr<clang::ASTUnit>>;
@@ -335,6 +376,10 @@ private:
     using IndexMapTy = BaseMapTy<std::string>;
     IndexMapTy NameFileMap;
 
+    /// When the ctu-index-cache option is set, the index is served from this
+    /// memory-mapped cache instead of \c NameFileMap.
+    std::unique_ptr<CrossTUIndexCache> IndexCache;
+
     /// Loads the AST based on the identifier found in the index.
     ASTLoader Loader;
 
@@ -343,6 +388,9 @@ private:
     /// information whether the AST to load is actually loaded or returned from
     /// cache. This information is needed to maintain the counter.
     ASTLoadGuard LoadGuard;
+
+    /// Whether to look for and maintain a binary cache next to the index.
+    bool UseIndexCache;
   };
 
   ASTUnitStorage ASTStorage;
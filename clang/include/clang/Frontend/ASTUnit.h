@@ -80,6 +80,12 @@ class TargetInfo;
 class SyntaxOnlyAction;
 
 /// \brief Enumerates the available scopes for skipping function bodies.
+///
+/// These scopes only affect textual parsing. Bodies deserialized from a PCH
+/// or module file never need to be skipped: the AST writer records a
+/// bitstream offset for every function definition and the reader attaches it
+/// via FunctionDecl::setLazyBody, so a body is only materialized when a
+/// client actually calls getBody().
 enum class SkipFunctionBodiesScope { None, Preamble, PreambleAndMainFile };
 
 /// \brief Enumerates the available kinds for capturing diagnostics.
@@ -0,0 +1,94 @@
+//===--- DirectoryIndex.h - Persistent include directory index --*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file defines the DirectoryIndex interface.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_LEX_DIRECTORYINDEX_H
+#define LLVM_CLANG_LEX_DIRECTORYINDEX_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include <memory>
+#include <system_error>
+
+namespace llvm {
+namespace vfs {
+class FileSystem;
+} // namespace vfs
+} // namespace llvm
+
+namespace clang {
+
+class FileManager;
+
+/// One observed state of a directory. An index carries the stamp of the
+/// directory it was built from and is only usable while the directory still
+/// has that stamp.
+struct DirectoryStamp {
+  uint64_t MTimeNanos;
+  uint64_t Inode;
+};
+
+/// A small mmap-friendly file listing the immediate entries of one include
+/// directory, so header search can reject most \#include candidates in a
+/// search path without touching the filesystem. It is similar in spirit to a
+/// \a HeaderMap, but is built automatically from the directory contents and
+/// validated against the directory's mtime and inode rather than authored as
+/// a build product, so it can be shared between machines that see the same
+/// filesystem.
+class DirectoryIndex {
+public:
+  /// Attempt to interpret \p File as a directory index. Returns null if the
+  /// buffer is malformed; the stamp is not checked.
+  static std::unique_ptr<DirectoryIndex>
+  open(std::unique_ptr<const llvm::MemoryBuffer> File);
+
+  /// Load the index at \p IndexPath covering the directory \p DirPath.
+  /// Returns null unless the file is well-formed and its stamp matches the
+  /// directory's current state.
+  static std::unique_ptr<DirectoryIndex>
+  load(StringRef IndexPath, StringRef DirPath, FileManager &FM);
+
+  /// Enumerate the immediate entries of \p DirPath through \p FS and
+  /// serialize an index of them to \p OS.
+  static std::error_code write(StringRef DirPath, llvm::vfs::FileSystem &FS,
+                               raw_ostream &OS);
+
+  /// Serialize an index with the given entry names and stamp. Exposed for
+  /// index-producing tools and tests; \a write is the normal entry point.
+  static void writeEntries(ArrayRef<StringRef> Names,
+                           const DirectoryStamp &Stamp, raw_ostream &OS);
+
+  /// Whether looking up \p Filename under the indexed directory can possibly
+  /// succeed. Only the first path component is consulted, and the comparison
+  /// folds case, so a true result can be a false positive (the caller falls
+  /// through to the filesystem); a false result is definitive for a fresh
+  /// index.
+  bool mightContain(StringRef Filename) const;
+
+  /// The number of entries in the index.
+  size_t getNumEntries() const;
+
+  /// The stamp the index was built with.
+  DirectoryStamp getStamp() const;
+
+private:
+  explicit DirectoryIndex(std::unique_ptr<const llvm::MemoryBuffer> File)
+      : FileBuffer(std::move(File)) {}
+
+  StringRef getString(unsigned Index) const;
+
+  std::unique_ptr<const llvm::MemoryBuffer> FileBuffer;
+};
+
+} // end namespace clang
+
+#endif
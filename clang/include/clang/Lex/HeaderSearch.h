@@ -42,6 +42,7 @@ namespace clang {
 
 class DiagnosticsEngine;
 class DirectoryEntry;
+class DirectoryIndex;
 class ExternalPreprocessorSource;
 class FileEntry;
 class FileManager;
@@ -324,6 +325,11 @@ class HeaderSearch {
   /// This is a mapping from FileEntry -> HeaderMap, uniquing headermaps.
   std::vector<std::pair<FileEntryRef, std::unique_ptr<HeaderMap>>> HeaderMaps;
 
+  /// Directory indexes for normal search directories, loaded or built on
+  /// first use. A null value records that the directory cannot be indexed.
+  llvm::DenseMap<const DirectoryEntry *, std::unique_ptr<DirectoryIndex>>
+      DirectoryIndexes;
+
   /// The mapping between modules and headers.
   mutable ModuleMap ModMap;
 
@@ -583,6 +589,11 @@ public:
   /// Get filenames for all registered header maps.
   void getHeaderMapFileNames(SmallVectorImpl<std::string> &Names) const;
 
+  /// Return the directory index covering \p Dir, loading or building it on
+  /// first use, or null when indexes are disabled or \p Dir cannot be
+  /// indexed.
+  const DirectoryIndex *getDirectoryIndex(DirectoryEntryRef Dir);
+
   /// Retrieve the name of the cached module file that should be used
   /// to load the given module.
   ///
@@ -111,6 +111,11 @@ public:
   /// etc.).
   std::string ResourceDir;
 
+  /// The directory used to store automatically built directory indexes that
+  /// let header search reject candidate directories without stat'ing them.
+  /// Indexes are disabled when this is empty.
+  std::string DirectoryIndexStorePath;
+
   /// The directory used for the module cache.
   std::string ModuleCachePath;
 
@@ -38,6 +38,7 @@ class DiagnosticBuilder;
 class Preprocessor;
 class SourceManager;
 class LangOptions;
+struct RawCachedToken;
 
 /// ConflictMarkerKind - Kinds of conflict marker which the lexer might be
 /// recovering from.
@@ -157,6 +158,14 @@ class Lexer : public PreprocessorLexer {
   /// next token to use from the current dependency directive.
   unsigned NextDepDirectiveTokenIndex = 0;
 
+  /// Non-empty while this Lexer is replaying a cached raw token stream for a
+  /// directive-free file instead of lexing characters. Once exhausted, normal
+  /// lexing resumes at \p BufferPtr for end-of-file handling.
+  ArrayRef<RawCachedToken> ReplayTokens;
+
+  /// Next token to replay from \p ReplayTokens.
+  unsigned NextReplayTokenIndex = 0;
+
   void InitLexer(const char *BufStart, const char *BufPtr, const char *BufEnd);
 
 public:
@@ -220,6 +229,19 @@ private:
   const char *convertDependencyDirectiveToken(
       const dependency_directives_scan::Token &DDTok, Token &Result);
 
+  /// Replay the next token of a cached raw token stream (see
+  /// \p setReplayTokens). Identifiers and literals are routed through the
+  /// same Preprocessor machinery as freshly lexed tokens.
+  bool LexReplayToken(Token &Result);
+
+  /// Provide a cached raw token stream for the buffer this Lexer lexes;
+  /// subsequent Lex() calls replay it instead of scanning characters. The
+  /// stream must have been produced from identical buffer contents under the
+  /// same lexing-relevant language options (see RawTokenCache).
+  void setReplayTokens(ArrayRef<RawCachedToken> Tokens) {
+    ReplayTokens = Tokens;
+  }
+
 public:
   /// isPragmaLexer - Returns true if this Lexer is being used to lex a pragma.
   bool isPragmaLexer() const { return Is_PragmaLexer; }
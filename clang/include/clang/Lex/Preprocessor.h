@@ -77,6 +77,7 @@ class PragmaNamespace;
 class PreprocessingRecord;
 class PreprocessorLexer;
 class PreprocessorOptions;
+class RawTokenCache;
 class ScratchBuffer;
 class TargetInfo;
 
@@ -1091,6 +1092,12 @@ private:
   /// The file ID for the PCH through header.
   FileID PCHThroughHeaderFileID;
 
+  /// If non-null, a shared content-hash-keyed cache of raw token streams
+  /// that EnterSourceFile consults so directive-free files already seen (by
+  /// this process or a previous one) are replayed instead of re-lexed. Not
+  /// owned; typically shared across Preprocessor instances.
+  RawTokenCache *TokenCache = nullptr;
+
   /// Whether tokens are being skipped until a #pragma hdrstop is seen.
   bool SkippingUntilPragmaHdrStop = false;
 
@@ -1284,6 +1291,11 @@ public:
   /// Returns the FileID for the preprocessor predefines.
   FileID getPredefinesFileID() const { return PredefinesFileID; }
 
+  /// Attach a shared raw token cache (see RawTokenCache); not owned. Pass
+  /// null to detach.
+  void setRawTokenCache(RawTokenCache *Cache) { TokenCache = Cache; }
+  RawTokenCache *getRawTokenCache() const { return TokenCache; }
+
   /// \{
   /// Accessors for preprocessor callbacks.
   ///
@@ -0,0 +1,112 @@
+//===- clang/Lex/RawTokenCache.h - Content-keyed raw token cache -*- C++-*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// A shared cache of raw token streams keyed by file content hash, so that a
+/// header whose contents were already tokenized (by this process, or by a
+/// previous one via the on-disk format) can be replayed by the Lexer instead
+/// of re-lexed character by character. Only directive-free files are cached:
+/// their raw token stream is a pure function of the bytes and the lexing-
+/// relevant language options, and replaying it through the normal
+/// Preprocessor identifier/macro machinery preserves all semantics.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_LEX_RAWTOKENCACHE_H
+#define LLVM_CLANG_LEX_RAWTOKENCACHE_H
+
+#include "clang/Basic/TokenKinds.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/MemoryBufferRef.h"
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace llvm {
+class MemoryBuffer;
+class raw_ostream;
+} // namespace llvm
+
+namespace clang {
+
+class LangOptions;
+
+/// One raw token in a cached stream. The layout is fixed-width little-endian
+/// so that an array of these can be written to disk and later used directly
+/// out of an mmap'd buffer without a deserialization pass.
+struct RawCachedToken {
+  /// Offset of the token start in the source buffer.
+  llvm::support::ulittle32_t Offset;
+  /// Length of the token in bytes.
+  llvm::support::ulittle32_t Length;
+  /// The tok::TokenKind produced by raw lexing. Identifiers are stored as
+  /// tok::raw_identifier; keyword and macro resolution happens at replay.
+  llvm::support::ulittle16_t Kind;
+  /// Token::TokenFlags relevant to replay (StartOfLine, LeadingSpace,
+  /// HasUDSuffix, HasUCN).
+  llvm::support::ulittle16_t Flags;
+};
+
+static_assert(sizeof(RawCachedToken) == 12, "on-disk layout must be packed");
+
+/// Process-wide cache mapping (content hash, lexing signature) to the raw
+/// token stream of the file. Thread-safe; intended to be shared across
+/// Preprocessor instances. Streams loaded from disk are referenced in place
+/// from the mapped buffer.
+class RawTokenCache {
+public:
+  RawTokenCache() = default;
+  RawTokenCache(const RawTokenCache &) = delete;
+  RawTokenCache &operator=(const RawTokenCache &) = delete;
+
+  /// Return the raw token stream for \p Buffer, tokenizing and caching it on
+  /// a miss. Returns std::nullopt if the file is not cacheable (it contains a
+  /// preprocessor directive, a token needing cleaning, an unknown token, or a
+  /// VCS conflict marker); the rejection is remembered so repeated inclusions
+  /// do not rescan the file.
+  std::optional<llvm::ArrayRef<RawCachedToken>>
+  getOrTokenize(llvm::MemoryBufferRef Buffer, const LangOptions &LangOpts);
+
+  /// Hash of the language options that influence raw tokenization (dialect,
+  /// digraphs, literal syntax, comment style, ...). Part of the cache key:
+  /// the same bytes can tokenize differently under different options.
+  static uint64_t computeLexSignature(const LangOptions &LangOpts);
+
+  /// Write every cached stream (excluding remembered rejections) in the
+  /// on-disk format.
+  void serialize(llvm::raw_ostream &OS) const;
+
+  /// Add the streams from a serialized cache file. The buffer is retained and
+  /// token arrays point directly into it, so an mmap'd buffer is used without
+  /// copying. Entries already present in the cache are kept.
+  llvm::Error addSerialized(std::unique_ptr<llvm::MemoryBuffer> Buffer);
+
+private:
+  struct Entry {
+    /// False for a remembered rejection.
+    bool Cacheable = false;
+    /// Owned storage for streams tokenized in-process; null for streams
+    /// backed by a mapped file.
+    std::unique_ptr<RawCachedToken[]> Storage;
+    llvm::ArrayRef<RawCachedToken> Tokens;
+  };
+
+  using KeyTy = std::pair<uint64_t, uint64_t>;
+
+  mutable std::mutex Lock;
+  llvm::DenseMap<KeyTy, Entry> Entries;
+  std::vector<std::unique_ptr<llvm::MemoryBuffer>> MappedBuffers;
+};
+
+} // namespace clang
+
+#endif // LLVM_CLANG_LEX_RAWTOKENCACHE_H
@@ -0,0 +1,53 @@
+//===- TopLevelDeclPartition.h - Cheap top-level decl pre-scan --*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// A raw-token pre-scan that splits a source buffer into top-level declaration
+// ranges and marks the ranges that do not reference any name introduced by a
+// sibling range. The scan is purely lexical: it never builds an AST and costs
+// one pass over the raw token stream. It is intended as a scheduling hint for
+// clients that want to know how much of a (typically machine-generated) header
+// consists of mutually independent declarations; it is not a semantic
+// dependency analysis.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_LEX_TOPLEVELDECLPARTITION_H
+#define LLVM_CLANG_LEX_TOPLEVELDECLPARTITION_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+
+namespace clang {
+
+class LangOptions;
+
+/// A contiguous byte range of the input covering one top-level declaration
+/// (or one braced group such as a namespace, which the scan does not split).
+struct TopLevelDeclRange {
+  /// Byte offset of the first token in the range.
+  unsigned Offset;
+  /// Number of bytes from \c Offset to the end of the last token.
+  unsigned Length;
+  /// True if no identifier used in this range is introduced by a different
+  /// range of the same scan. Names are detected syntactically, so unusual
+  /// declarators can be missed; treat this as advisory, not as a guarantee.
+  bool Independent;
+};
+
+/// Partition \p Input into top-level declaration ranges.
+///
+/// Returns false without populating \p Ranges when the input cannot be
+/// partitioned lexically: it contains preprocessor directives (which can
+/// splice arbitrary text across range boundaries) or unbalanced delimiters.
+bool scanTopLevelDeclPartition(StringRef Input, const LangOptions &LangOpts,
+                               SmallVectorImpl<TopLevelDeclRange> &Ranges);
+
+} // namespace clang
+
+#endif // LLVM_CLANG_LEX_TOPLEVELDECLPARTITION_H
@@ -329,9 +329,11 @@ private:
         : Status(std::move(Status)), Contents(std::move(Contents)) {}
   };
 
-  /// Reads file at the given path. Enforces consistency between the file size
-  /// in status and size of read contents.
-  llvm::ErrorOr<TentativeEntry> readFile(StringRef Filename);
+  /// Reads file at the given path, reusing \p Stat obtained by the caller
+  /// instead of re-stat'ing the opened file. Enforces consistency between the
+  /// file size in status and size of read contents.
+  llvm::ErrorOr<TentativeEntry> readFile(StringRef Filename,
+                                         llvm::vfs::Status Stat);
 
   /// Returns entry associated with the unique ID of the given tentative entry
   /// if there is some in the shared cache. Otherwise, constructs new one,
@@ -1001,6 +1001,7 @@ void ASTContext::PrintStats() const {
   }
 
   BumpAlloc.PrintStats();
+  DeclAlloc.PrintStats();
 }
 
 void ASTContext::mergeDefinitionIntoModule(NamedDecl *ND, Module *M,
@@ -76,7 +76,7 @@ void *Decl::operator new(std::size_t Size, const ASTContext &Context,
   // resulting pointer will still be 8-byte aligned.
   static_assert(sizeof(unsigned) * 2 >= alignof(Decl),
                 "Decl won't be misaligned");
-  void *Start = Context.Allocate(Size + Extra + 8);
+  void *Start = Context.AllocateDecl(Size + Extra + 8);
   void *Result = (char*)Start + 8;
 
   unsigned *PrefixPtr = (unsigned *)Result - 2;
@@ -102,13 +102,13 @@ void *Decl::operator new(std::size_t Size, const ASTContext &Ctx,
     size_t ExtraAlign =
         llvm::offsetToAlignment(sizeof(Module *), llvm::Align(alignof(Decl)));
     auto *Buffer = reinterpret_cast<char *>(
-        ::operator new(ExtraAlign + sizeof(Module *) + Size + Extra, Ctx));
+        Ctx.AllocateDecl(ExtraAlign + sizeof(Module *) + Size + Extra));
     Buffer += ExtraAlign;
     auto *ParentModule =
         Parent ? cast<Decl>(Parent)->getOwningModule() : nullptr;
     return new (Buffer) Module*(ParentModule) + 1;
   }
-  return ::operator new(Size + Extra, Ctx);
+  return Ctx.AllocateDecl(Size + Extra);
 }
 
 Module *Decl::getOwningModuleSlow() const {
@@ -1047,6 +1047,10 @@ private:
     const bool EnableCheckProfiling = Options.CheckProfiling.has_value();
     TimeBucketRegion Timer;
     auto &Matchers = this->Matchers->DeclOrStmt;
+    // Whether the node is replaced by another one under traversal depends
+    // only on the effective traversal kind, so compute the answer once per
+    // kind instead of once per matcher.
+    std::optional<bool> SurvivesTraversal[2];
     for (unsigned short I : Filter) {
       auto &MP = Matchers[I];
       if (EnableCheckProfiling)
@@ -1055,8 +1059,15 @@ private:
 
       {
         TraversalKindScope RAII(getASTContext(), MP.first.getTraversalKind());
-        if (getASTContext().getParentMapContext().traverseIgnored(DynNode) !=
-            DynNode)
+        auto &ParentMapCtx = getASTContext().getParentMapContext();
+        unsigned TKIdx =
+            ParentMapCtx.getTraversalKind() == TK_IgnoreUnlessSpelledInSource
+                ? 1
+                : 0;
+        if (!SurvivesTraversal[TKIdx])
+          SurvivesTraversal[TKIdx] =
+              ParentMapCtx.traverseIgnored(DynNode) == DynNode;
+        if (!*SurvivesTraversal[TKIdx])
           continue;
       }
 
@@ -0,0 +1,155 @@
+//===--- PreinternedIdentifierTable.cpp - Shared identifier set -----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the PreinternedIdentifierTable interface.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Basic/PreinternedIdentifierTable.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+
+using namespace clang;
+using namespace llvm;
+using namespace llvm::support;
+
+static const char Magic[4] = {'C', 'P', 'I', 'T'};
+static constexpr uint32_t FormatVersion = 1;
+
+namespace {
+/// The fixed header, followed by NumStrings little-endian 32-bit offsets into
+/// the string blob (one per stable index), followed by NumBuckets little-
+/// endian 32-bit open-addressing buckets holding index + 1 (0 means empty),
+/// followed by the blob of null-terminated spellings.
+struct PITHeader {
+  char Magic[4];
+  ulittle32_t Version;
+  ulittle32_t NumStrings;
+  ulittle32_t NumBuckets;
+  ulittle32_t StringDataSize;
+};
+} // namespace
+
+/// Buckets are kept under ~70% full so linear probing stays short.
+static uint32_t numBucketsFor(size_t NumStrings) {
+  return NumStrings ? NextPowerOf2(NumStrings + NumStrings / 2) : 1;
+}
+
+std::unique_ptr<PreinternedIdentifierTable>
+PreinternedIdentifierTable::open(
+    std::unique_ptr<const llvm::MemoryBuffer> File) {
+  StringRef Data = File->getBuffer();
+  if (Data.size() < sizeof(PITHeader))
+    return nullptr;
+  const auto *Hdr = reinterpret_cast<const PITHeader *>(Data.data());
+  if (memcmp(Hdr->Magic, Magic, sizeof(Magic)) != 0 ||
+      Hdr->Version != FormatVersion)
+    return nullptr;
+  if (!isPowerOf2_32(Hdr->NumBuckets) ||
+      Hdr->NumBuckets < numBucketsFor(Hdr->NumStrings))
+    return nullptr;
+
+  uint64_t BlobStart = sizeof(PITHeader) +
+                       uint64_t(Hdr->NumStrings) * sizeof(ulittle32_t) +
+                       uint64_t(Hdr->NumBuckets) * sizeof(ulittle32_t);
+  if (Data.size() != BlobStart + Hdr->StringDataSize)
+    return nullptr;
+  if (Hdr->StringDataSize != 0 && Data.back() != '\0')
+    return nullptr;
+
+  const auto *Offsets =
+      reinterpret_cast<const ulittle32_t *>(Data.data() + sizeof(PITHeader));
+  for (uint32_t I = 0, E = Hdr->NumStrings; I != E; ++I)
+    if (Offsets[I] >= Hdr->StringDataSize)
+      return nullptr;
+  const ulittle32_t *Buckets = Offsets + Hdr->NumStrings;
+  for (uint32_t I = 0, E = Hdr->NumBuckets; I != E; ++I)
+    if (Buckets[I] > Hdr->NumStrings)
+      return nullptr;
+
+  return std::unique_ptr<PreinternedIdentifierTable>(
+      new PreinternedIdentifierTable(std::move(File)));
+}
+
+void PreinternedIdentifierTable::build(ArrayRef<StringRef> Names,
+                                       raw_ostream &OS) {
+  std::vector<StringRef> Sorted(Names.begin(), Names.end());
+  llvm::sort(Sorted);
+  Sorted.erase(std::unique(Sorted.begin(), Sorted.end()), Sorted.end());
+
+  std::vector<ulittle32_t> Offsets;
+  Offsets.reserve(Sorted.size());
+  uint32_t StringDataSize = 0;
+  for (StringRef Name : Sorted) {
+    Offsets.push_back(ulittle32_t(StringDataSize));
+    StringDataSize += Name.size() + 1;
+  }
+
+  uint32_t NumBuckets = numBucketsFor(Sorted.size());
+  std::vector<ulittle32_t> Buckets(NumBuckets, ulittle32_t(0));
+  for (uint32_t I = 0, E = Sorted.size(); I != E; ++I) {
+    uint32_t Bucket = xxh3_64bits(Sorted[I]) & (NumBuckets - 1);
+    while (Buckets[Bucket] != 0)
+      Bucket = (Bucket + 1) & (NumBuckets - 1);
+    Buckets[Bucket] = I + 1;
+  }
+
+  PITHeader Hdr;
+  memcpy(Hdr.Magic, Magic, sizeof(Magic));
+  Hdr.Version = FormatVersion;
+  Hdr.NumStrings = Sorted.size();
+  Hdr.NumBuckets = NumBuckets;
+  Hdr.StringDataSize = StringDataSize;
+  OS.write(reinterpret_cast<const char *>(&Hdr), sizeof(Hdr));
+  OS.write(reinterpret_cast<const char *>(Offsets.data()),
+           Offsets.size() * sizeof(ulittle32_t));
+  OS.write(reinterpret_cast<const char *>(Buckets.data()),
+           Buckets.size() * sizeof(ulittle32_t));
+  for (StringRef Name : Sorted)
+    OS.write(Name.data(), Name.size()) << '\0';
+}
+
+static const PITHeader &getHeader(const llvm::MemoryBuffer &File) {
+  return *reinterpret_cast<const PITHeader *>(File.getBufferStart());
+}
+
+StringRef PreinternedIdentifierTable::getSpelling(uint32_t Index) const {
+  const PITHeader &Hdr = getHeader(*FileBuffer);
+  assert(Index < Hdr.NumStrings && "spelling index out of range");
+  const auto *Offsets = reinterpret_cast<const ulittle32_t *>(
+      FileBuffer->getBufferStart() + sizeof(PITHeader));
+  const char *Blob = FileBuffer->getBufferStart() + sizeof(PITHeader) +
+                     (uint64_t(Hdr.NumStrings) + Hdr.NumBuckets) *
+                         sizeof(ulittle32_t);
+  return StringRef(Blob + Offsets[Index]);
+}
+
+std::optional<uint32_t>
+PreinternedIdentifierTable::lookup(StringRef Name) const {
+  const PITHeader &Hdr = getHeader(*FileBuffer);
+  if (Hdr.NumStrings == 0)
+    return std::nullopt;
+  const auto *Offsets = reinterpret_cast<const ulittle32_t *>(
+      FileBuffer->getBufferStart() + sizeof(PITHeader));
+  const ulittle32_t *Buckets = Offsets + Hdr.NumStrings;
+
+  uint32_t Bucket = xxh3_64bits(Name) & (Hdr.NumBuckets - 1);
+  while (uint32_t IndexPlusOne = Buckets[Bucket]) {
+    if (getSpelling(IndexPlusOne - 1) == Name)
+      return IndexPlusOne - 1;
+    Bucket = (Bucket + 1) & (Hdr.NumBuckets - 1);
+  }
+  return std::nullopt;
+}
+
+size_t PreinternedIdentifierTable::size() const {
+  return getHeader(*FileBuffer).NumStrings;
+}
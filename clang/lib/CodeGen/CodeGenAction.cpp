@@ -291,6 +291,14 @@ bool BackendConsumer::LinkInModules(llvm::Module *M, bool ShouldLinkFiles) {
   return false; // success
 }
 
+// This is the frontend/backend handoff: IR generation for the whole TU
+// completes before EmitBackendOutput sees any of it. Overlapping the two by
+// streaming finished functions into the backend is not possible with the
+// current architecture: the backend would have to run module-level passes
+// over a Module that IRGen is still appending to, on an LLVMContext that is
+// not thread-safe, and CodeGenModule::Release emits deferred and vtable
+// definitions that reshape earlier functions. Parallelism across function
+// partitions is instead available at link time via ThinLTO.
 void BackendConsumer::HandleTranslationUnit(ASTContext &C) {
   {
     llvm::TimeTraceScope TimeScope("Frontend");
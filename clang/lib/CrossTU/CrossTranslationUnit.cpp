@@ -21,8 +21,11 @@
 #include "clang/Index/USRGeneration.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Option/ArgList.h"
+#include "llvm/Support/Endian.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/YAMLParser.h"
 #include "llvm/Support/raw_ostream.h"
@@ -220,6 +223,122 @@ createCrossTUIndexString(const llvm::StringMap<std::string> &Index) {
   return Result.str();
 }
 
+static const char IndexCacheMagic[4] = {'C', 'T', 'I', 'X'};
+static constexpr uint32_t IndexCacheVersion = 1;
+
+namespace {
+/// On-disk layout of the binary index cache: the fixed header, NumEntries
+/// offset pairs sorted by USR, and a blob of null-terminated strings.
+struct IndexCacheHeader {
+  char Magic[4];
+  llvm::support::ulittle32_t Version;
+  llvm::support::ulittle32_t NumEntries;
+  llvm::support::ulittle32_t StringDataSize;
+  llvm::support::ulittle64_t TextSize;
+  llvm::support::ulittle64_t TextModTime;
+};
+
+/// Offsets into the string blob of one "<USR-Length>:<USR>" lookup name and
+/// the identifier it maps to.
+struct IndexCacheEntry {
+  llvm::support::ulittle32_t USROffset;
+  llvm::support::ulittle32_t FileOffset;
+};
+} // namespace
+
+std::unique_ptr<CrossTUIndexCache>
+CrossTUIndexCache::open(std::unique_ptr<const llvm::MemoryBuffer> File,
+                        uint64_t TextSize, uint64_t TextModTime) {
+  StringRef Data = File->getBuffer();
+  if (Data.size() < sizeof(IndexCacheHeader))
+    return nullptr;
+  const auto *Hdr = reinterpret_cast<const IndexCacheHeader *>(Data.data());
+  if (memcmp(Hdr->Magic, IndexCacheMagic, sizeof(IndexCacheMagic)) != 0 ||
+      Hdr->Version != IndexCacheVersion || Hdr->TextSize != TextSize ||
+      Hdr->TextModTime != TextModTime)
+    return nullptr;
+
+  uint64_t BlobStart = sizeof(IndexCacheHeader) +
+                       uint64_t(Hdr->NumEntries) * sizeof(IndexCacheEntry);
+  if (Data.size() != BlobStart + Hdr->StringDataSize)
+    return nullptr;
+  if (Hdr->StringDataSize != 0 && Data.back() != '\0')
+    return nullptr;
+
+  const auto *Entries = reinterpret_cast<const IndexCacheEntry *>(
+      Data.data() + sizeof(IndexCacheHeader));
+  for (uint32_t I = 0, E = Hdr->NumEntries; I != E; ++I)
+    if (Entries[I].USROffset >= Hdr->StringDataSize ||
+        Entries[I].FileOffset >= Hdr->StringDataSize)
+      return nullptr;
+
+  return std::unique_ptr<CrossTUIndexCache>(
+      new CrossTUIndexCache(std::move(File)));
+}
+
+void CrossTUIndexCache::write(const llvm::StringMap<std::string> &Index,
+                              uint64_t TextSize, uint64_t TextModTime,
+                              llvm::raw_ostream &OS) {
+  using llvm::support::ulittle32_t;
+  std::vector<const llvm::StringMapEntry<std::string> *> Sorted;
+  Sorted.reserve(Index.size());
+  for (const auto &E : Index)
+    Sorted.push_back(&E);
+  llvm::sort(Sorted, [](const auto *L, const auto *R) {
+    return L->getKey() < R->getKey();
+  });
+
+  std::vector<IndexCacheEntry> Entries;
+  Entries.reserve(Sorted.size());
+  uint32_t StringDataSize = 0;
+  for (const auto *E : Sorted) {
+    IndexCacheEntry Entry;
+    Entry.USROffset = StringDataSize;
+    Entry.FileOffset = StringDataSize + E->getKey().size() + 1;
+    Entries.push_back(Entry);
+    StringDataSize += E->getKey().size() + 1 + E->getValue().size() + 1;
+  }
+
+  IndexCacheHeader Hdr;
+  memcpy(Hdr.Magic, IndexCacheMagic, sizeof(IndexCacheMagic));
+  Hdr.Version = IndexCacheVersion;
+  Hdr.NumEntries = Sorted.size();
+  Hdr.StringDataSize = StringDataSize;
+  Hdr.TextSize = TextSize;
+  Hdr.TextModTime = TextModTime;
+  OS.write(reinterpret_cast<const char *>(&Hdr), sizeof(Hdr));
+  OS.write(reinterpret_cast<const char *>(Entries.data()),
+           Entries.size() * sizeof(IndexCacheEntry));
+  for (const auto *E : Sorted) {
+    OS.write(E->getKey().data(), E->getKey().size()) << '\0';
+    OS.write(E->getValue().data(), E->getValue().size()) << '\0';
+  }
+}
+
+std::optional<StringRef> CrossTUIndexCache::lookup(StringRef LookupName) const {
+  const auto &Hdr =
+      *reinterpret_cast<const IndexCacheHeader *>(FileBuffer->getBufferStart());
+  const auto *Entries = reinterpret_cast<const IndexCacheEntry *>(
+      FileBuffer->getBufferStart() + sizeof(IndexCacheHeader));
+  const char *Blob = FileBuffer->getBufferStart() + sizeof(IndexCacheHeader) +
+                     uint64_t(Hdr.NumEntries) * sizeof(IndexCacheEntry);
+
+  const IndexCacheEntry *It = std::partition_point(
+      Entries, Entries + Hdr.NumEntries, [&](const IndexCacheEntry &E) {
+        return StringRef(Blob + E.USROffset) < LookupName;
+      });
+  if (It == Entries + Hdr.NumEntries ||
+      StringRef(Blob + It->USROffset) != LookupName)
+    return std::nullopt;
+  return StringRef(Blob + It->FileOffset);
+}
+
+size_t CrossTUIndexCache::size() const {
+  return reinterpret_cast<const IndexCacheHeader *>(
+             FileBuffer->getBufferStart())
+      ->NumEntries;
+}
+
 bool shouldImport(const VarDecl *VD, const ASTContext &ACtx) {
   CanQualType CT = ACtx.getCanonicalType(VD->getType());
   return CT.isConstQualified() && VD->getType().isTrivialType(ACtx);
@@ -396,7 +515,8 @@ CrossTranslationUnitContext::ASTUnitStorage::ASTUnitStorage(
              CI.getAnalyzerOpts().CTUInvocationList),
       LoadGuard(CI.getASTContext().getLangOpts().CPlusPlus
                     ? CI.getAnalyzerOpts().CTUImportCppThreshold
-                    : CI.getAnalyzerOpts().CTUImportThreshold) {}
+                    : CI.getAnalyzerOpts().CTUImportThreshold),
+      UseIndexCache(CI.getAnalyzerOpts().ShouldUseCTUIndexCache) {}
 
 llvm::Expected<ASTUnit *>
 CrossTranslationUnitContext::ASTUnitStorage::getASTUnitForFile(
@@ -453,7 +573,8 @@ CrossTranslationUnitContext::ASTUnitStorage::getASTUnitForFunction(
       return std::move(IndexLoadError);
 
     // Check if there is an entry in the index for the function.
-    if (!NameFileMap.count(FunctionName)) {
+    std::string ASTFileName = getFileForName(FunctionName);
+    if (ASTFileName.empty()) {
       ++NumNotInOtherTU;
       return llvm::make_error<IndexError>(index_error_code::missing_definition);
     }
@@ -461,7 +582,7 @@ CrossTranslationUnitContext::ASTUnitStorage::getASTUnitForFunction(
     // Search in the index for the filename where the definition of FunctionName
     // resides.
     if (llvm::Expected<ASTUnit *> FoundForFile =
-            getASTUnitForFile(NameFileMap[FunctionName], DisplayCTUProgress)) {
+            getASTUnitForFile(ASTFileName, DisplayCTUProgress)) {
 
       // Update the cache.
       NameASTUnitMap[FunctionName] = *FoundForFile;
@@ -481,13 +602,23 @@ CrossTranslationUnitContext::ASTUnitStorage::getFileForFunction(
     StringRef FunctionName, StringRef CrossTUDir, StringRef IndexName) {
   if (llvm::Error IndexLoadError = ensureCTUIndexLoaded(CrossTUDir, IndexName))
     return std::move(IndexLoadError);
-  return NameFileMap[FunctionName];
+  return getFileForName(FunctionName);
+}
+
+std::string CrossTranslationUnitContext::ASTUnitStorage::getFileForName(
+    StringRef FunctionName) const {
+  if (IndexCache) {
+    if (std::optional<StringRef> Identifier = IndexCache->lookup(FunctionName))
+      return Identifier->str();
+    return std::string();
+  }
+  return NameFileMap.lookup(FunctionName);
 }
 
 llvm::Error CrossTranslationUnitContext::ASTUnitStorage::ensureCTUIndexLoaded(
     StringRef CrossTUDir, StringRef IndexName) {
-  // Dont initialize if the map is filled.
-  if (!NameFileMap.empty())
+  // Dont initialize if the map or the binary cache is filled.
+  if (!NameFileMap.empty() || IndexCache)
     return llvm::Error::success();
 
   // Get the absolute path to the index file.
@@ -497,9 +628,51 @@ llvm::Error CrossTranslationUnitContext::ASTUnitStorage::ensureCTUIndexLoaded(
   else
     llvm::sys::path::append(IndexFile, IndexName);
 
+  // With the ctu-index-cache option, a binary cache stamped with the size and
+  // modification time of the textual index lives next to it. Mapping the
+  // cache replaces re-parsing the text in every analysis process.
+  SmallString<256> CacheFile = IndexFile;
+  CacheFile += ".cache";
+  llvm::sys::fs::file_status TextStatus;
+  bool HaveTextStatus =
+      UseIndexCache && !llvm::sys::fs::status(IndexFile, TextStatus);
+  uint64_t TextSize = TextStatus.getSize();
+  uint64_t TextModTime =
+      TextStatus.getLastModificationTime().time_since_epoch().count();
+
+  if (HaveTextStatus)
+    if (auto Buffer = llvm::MemoryBuffer::getFile(CacheFile))
+      if (auto Cache = CrossTUIndexCache::open(std::move(*Buffer), TextSize,
+                                               TextModTime)) {
+        IndexCache = std::move(Cache);
+        return llvm::Error::success();
+      }
+
   if (auto IndexMapping = parseCrossTUIndex(IndexFile)) {
     // Initialize member map.
     NameFileMap = *IndexMapping;
+    if (HaveTextStatus) {
+      // Populate the cache for later processes. This is best-effort: losing
+      // the race or failing to write only costs them a re-parse.
+      std::string Bytes;
+      llvm::raw_string_ostream OS(Bytes);
+      CrossTUIndexCache::write(NameFileMap, TextSize, TextModTime, OS);
+      if (auto Temp = llvm::sys::fs::TempFile::create(CacheFile + "-%%%%%%")) {
+        bool WriteFailed;
+        {
+          llvm::raw_fd_ostream TempOS(Temp->FD, /*shouldClose=*/false);
+          TempOS << Bytes;
+          TempOS.flush();
+          WriteFailed = TempOS.has_error();
+          if (WriteFailed)
+            TempOS.clear_error();
+        }
+        if (llvm::Error E =
+                WriteFailed ? Temp->discard() : Temp->keep(CacheFile))
+          llvm::consumeError(std::move(E));
+      } else
+        llvm::consumeError(Temp.takeError());
+    }
     return llvm::Error::success();
   } else {
     // Error while parsing CrossTU index file.
@@ -3046,6 +3046,10 @@ static void GenerateHeaderSearchArgs(const HeaderSearchOptions &Opts,
   if (!Opts.ModuleCachePath.empty())
     GenerateArg(Consumer, OPT_fmodules_cache_path, Opts.ModuleCachePath);
 
+  if (!Opts.DirectoryIndexStorePath.empty())
+    GenerateArg(Consumer, OPT_fdirectory_index_store_path,
+                Opts.DirectoryIndexStorePath);
+
   for (const auto &File : Opts.PrebuiltModuleFiles)
     GenerateArg(Consumer, OPT_fmodule_file, File.first + "=" + File.second);
 
@@ -3178,6 +3182,9 @@ static bool ParseHeaderSearchArgs(HeaderSearchOptions &Opts, ArgList &Args,
   llvm::sys::path::remove_dots(P);
   Opts.ModuleCachePath = std::string(P.str());
 
+  Opts.DirectoryIndexStorePath =
+      std::string(Args.getLastArgValue(OPT_fdirectory_index_store_path));
+
   // Only the -fmodule-file=<name>=<file> form.
   for (const auto *A : Args.filtered(OPT_fmodule_file)) {
     StringRef Val = A->getValue();
@@ -0,0 +1,199 @@
+//===--- DirectoryIndex.cpp - Persistent include directory index ----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the DirectoryIndex interface.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Lex/DirectoryIndex.h"
+#include "clang/Basic/FileManager.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Support/Endian.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/VirtualFileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace clang;
+using namespace llvm;
+using namespace llvm::support;
+
+static const char Magic[4] = {'C', 'D', 'I', 'X'};
+static constexpr uint32_t FormatVersion = 1;
+
+namespace {
+/// The fixed header, followed by NumEntries little-endian 32-bit offsets into
+/// the string table (sorted by the strings they reference), followed by the
+/// string table of null-terminated, case-folded entry names.
+struct DirIdxHeader {
+  char Magic[4];
+  ulittle32_t Version;
+  ulittle64_t DirMTime;
+  ulittle64_t DirInode;
+  ulittle32_t NumEntries;
+  ulittle32_t StringTableSize;
+};
+} // namespace
+
+/// The index only answers membership queries, so names are stored folded to
+/// lowercase; a case-insensitive filesystem then at worst produces false
+/// positives, which the caller resolves against the real filesystem.
+static void foldName(StringRef Name, SmallVectorImpl<char> &Out) {
+  Out.clear();
+  for (char C : Name)
+    Out.push_back(toLower(C));
+}
+
+std::unique_ptr<DirectoryIndex>
+DirectoryIndex::open(std::unique_ptr<const llvm::MemoryBuffer> File) {
+  StringRef Data = File->getBuffer();
+  if (Data.size() < sizeof(DirIdxHeader))
+    return nullptr;
+  const auto *Hdr = reinterpret_cast<const DirIdxHeader *>(Data.data());
+  if (memcmp(Hdr->Magic, Magic, sizeof(Magic)) != 0 ||
+      Hdr->Version != FormatVersion)
+    return nullptr;
+
+  uint64_t TableEnd =
+      sizeof(DirIdxHeader) + uint64_t(Hdr->NumEntries) * sizeof(ulittle32_t);
+  if (Data.size() != TableEnd + Hdr->StringTableSize)
+    return nullptr;
+  // Every offset must reference a properly terminated string.
+  if (Hdr->StringTableSize != 0 && Data.back() != '\0')
+    return nullptr;
+  const auto *Offsets =
+      reinterpret_cast<const ulittle32_t *>(Data.data() + sizeof(DirIdxHeader));
+  for (uint32_t I = 0, E = Hdr->NumEntries; I != E; ++I)
+    if (Offsets[I] >= Hdr->StringTableSize)
+      return nullptr;
+
+  return std::unique_ptr<DirectoryIndex>(new DirectoryIndex(std::move(File)));
+}
+
+std::unique_ptr<DirectoryIndex>
+DirectoryIndex::load(StringRef IndexPath, StringRef DirPath, FileManager &FM) {
+  auto Buffer = FM.getBufferForFile(IndexPath);
+  if (!Buffer)
+    return nullptr;
+  std::unique_ptr<DirectoryIndex> Index = open(std::move(*Buffer));
+  if (!Index)
+    return nullptr;
+
+  llvm::ErrorOr<llvm::vfs::Status> Status =
+      FM.getVirtualFileSystem().status(DirPath);
+  if (!Status)
+    return nullptr;
+  DirectoryStamp Stamp = Index->getStamp();
+  if (Stamp.MTimeNanos != uint64_t(Status->getLastModificationTime()
+                                       .time_since_epoch()
+                                       .count()) ||
+      Stamp.Inode != Status->getUniqueID().getFile())
+    return nullptr;
+  return Index;
+}
+
+std::error_code DirectoryIndex::write(StringRef DirPath,
+                                      llvm::vfs::FileSystem &FS,
+                                      raw_ostream &OS) {
+  std::error_code EC;
+  std::vector<std::string> Names;
+  for (llvm::vfs::directory_iterator I = FS.dir_begin(DirPath, EC), E;
+       !EC && I != E; I.increment(EC))
+    Names.push_back(std::string(llvm::sys::path::filename(I->path())));
+  if (EC)
+    return EC;
+
+  // Stamp after enumerating: if the directory changes in between, the stamp
+  // is newer than the listing and the index self-invalidates on next load.
+  llvm::ErrorOr<llvm::vfs::Status> Status = FS.status(DirPath);
+  if (!Status)
+    return Status.getError();
+  DirectoryStamp Stamp{
+      uint64_t(Status->getLastModificationTime().time_since_epoch().count()),
+      Status->getUniqueID().getFile()};
+
+  SmallVector<StringRef, 64> NameRefs(Names.begin(), Names.end());
+  writeEntries(NameRefs, Stamp, OS);
+  return std::error_code();
+}
+
+void DirectoryIndex::writeEntries(ArrayRef<StringRef> Names,
+                                  const DirectoryStamp &Stamp,
+                                  raw_ostream &OS) {
+  std::vector<SmallString<32>> Folded(Names.size());
+  for (size_t I = 0, E = Names.size(); I != E; ++I)
+    foldName(Names[I], Folded[I]);
+  llvm::sort(Folded);
+  Folded.erase(std::unique(Folded.begin(), Folded.end()), Folded.end());
+
+  std::vector<ulittle32_t> Offsets;
+  Offsets.reserve(Folded.size());
+  uint32_t StringTableSize = 0;
+  for (const SmallString<32> &Name : Folded) {
+    Offsets.push_back(ulittle32_t(StringTableSize));
+    StringTableSize += Name.size() + 1;
+  }
+
+  DirIdxHeader Hdr;
+  memcpy(Hdr.Magic, Magic, sizeof(Magic));
+  Hdr.Version = FormatVersion;
+  Hdr.DirMTime = Stamp.MTimeNanos;
+  Hdr.DirInode = Stamp.Inode;
+  Hdr.NumEntries = Folded.size();
+  Hdr.StringTableSize = StringTableSize;
+  OS.write(reinterpret_cast<const char *>(&Hdr), sizeof(Hdr));
+  OS.write(reinterpret_cast<const char *>(Offsets.data()),
+           Offsets.size() * sizeof(ulittle32_t));
+  for (const SmallString<32> &Name : Folded)
+    OS.write(Name.data(), Name.size()) << '\0';
+}
+
+static const DirIdxHeader &getHeader(const llvm::MemoryBuffer &File) {
+  return *reinterpret_cast<const DirIdxHeader *>(File.getBufferStart());
+}
+
+StringRef DirectoryIndex::getString(unsigned Index) const {
+  const DirIdxHeader &Hdr = getHeader(*FileBuffer);
+  const auto *Offsets = reinterpret_cast<const ulittle32_t *>(
+      FileBuffer->getBufferStart() + sizeof(DirIdxHeader));
+  const char *StringTable = FileBuffer->getBufferStart() +
+                            sizeof(DirIdxHeader) +
+                            Hdr.NumEntries * sizeof(ulittle32_t);
+  return StringRef(StringTable + Offsets[Index]);
+}
+
+bool DirectoryIndex::mightContain(StringRef Filename) const {
+  // Only the first component can be checked against the immediate entries;
+  // "sub/foo.h" is present iff "sub" is.
+  StringRef First = Filename.substr(0, Filename.find_first_of("/\\"));
+  SmallString<32> Folded;
+  foldName(First, Folded);
+
+  size_t Lo = 0, Hi = getNumEntries();
+  while (Lo != Hi) {
+    size_t Mid = Lo + (Hi - Lo) / 2;
+    int Cmp = getString(Mid).compare(Folded);
+    if (Cmp == 0)
+      return true;
+    if (Cmp < 0)
+      Lo = Mid + 1;
+    else
+      Hi = Mid;
+  }
+  return false;
+}
+
+size_t DirectoryIndex::getNumEntries() const {
+  return getHeader(*FileBuffer).NumEntries;
+}
+
+DirectoryStamp DirectoryIndex::getStamp() const {
+  const DirIdxHeader &Hdr = getHeader(*FileBuffer);
+  return {Hdr.DirMTime, Hdr.DirInode};
+}
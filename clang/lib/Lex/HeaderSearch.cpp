@@ -16,6 +16,7 @@
 #include "clang/Basic/IdentifierTable.h"
 #include "clang/Basic/Module.h"
 #include "clang/Basic/SourceManager.h"
+#include "clang/Lex/DirectoryIndex.h"
 #include "clang/Lex/DirectoryLookup.h"
 #include "clang/Lex/ExternalPreprocessorSource.h"
 #include "clang/Lex/HeaderMap.h"
@@ -28,6 +29,7 @@
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/Support/Allocator.h"
@@ -37,6 +39,7 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/VirtualFileSystem.h"
+#include "llvm/Support/xxhash.h"
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
@@ -169,6 +172,50 @@ void HeaderSearch::getHeaderMapFileNames(
     Names.push_back(std::string(HM.first.getName()));
 }
 
+const DirectoryIndex *HeaderSearch::getDirectoryIndex(DirectoryEntryRef Dir) {
+  if (HSOpts->DirectoryIndexStorePath.empty())
+    return nullptr;
+
+  auto It = DirectoryIndexes.find(&Dir.getDirEntry());
+  if (It != DirectoryIndexes.end())
+    return It->second.get();
+
+  // One index file per directory, named after the hash of its path so one
+  // store can serve unrelated include lists.
+  SmallString<128> IndexPath(HSOpts->DirectoryIndexStorePath);
+  llvm::sys::path::append(IndexPath,
+                          llvm::utohexstr(llvm::xxh3_64bits(Dir.getName())) +
+                              ".cdix");
+
+  std::unique_ptr<DirectoryIndex> Index =
+      DirectoryIndex::load(IndexPath, Dir.getName(), FileMgr);
+  if (!Index) {
+    // No usable index on disk; build one from the directory and persist it
+    // best-effort. Concurrent builders race benignly: the rename is atomic
+    // and every builder writes equivalent contents.
+    std::string Bytes;
+    llvm::raw_string_ostream OS(Bytes);
+    if (!DirectoryIndex::write(Dir.getName(), FileMgr.getVirtualFileSystem(),
+                               OS)) {
+      SmallString<128> TempModel = IndexPath;
+      TempModel += "-%%%%%%";
+      if (auto Temp = llvm::sys::fs::TempFile::create(TempModel)) {
+        llvm::raw_fd_ostream TempOS(Temp->FD, /*shouldClose=*/false);
+        TempOS << Bytes;
+        TempOS.flush();
+        if (llvm::Error E = TempOS.has_error() ? Temp->discard()
+                                               : Temp->keep(IndexPath))
+          llvm::consumeError(std::move(E));
+      } else
+        llvm::consumeError(Temp.takeError());
+      Index = DirectoryIndex::open(
+          llvm::MemoryBuffer::getMemBufferCopy(Bytes, IndexPath));
+    }
+  }
+  return DirectoryIndexes.try_emplace(&Dir.getDirEntry(), std::move(Index))
+      .first->second.get();
+}
+
 std::string HeaderSearch::getCachedModuleFileName(Module *Module) {
   OptionalFileEntryRef ModuleMap =
       getModuleMap().getModuleMapFileForUniquing(Module);
@@ -457,6 +504,12 @@ OptionalFileEntryRef DirectoryLookup::LookupFile(
 
   SmallString<1024> TmpDir;
   if (isNormalDir()) {
+    // When enabled, a fresh directory index can prove the entry absent
+    // without any filesystem traffic.
+    if (const DirectoryIndex *Index = HS.getDirectoryIndex(*getDirRef()))
+      if (!Index->mightContain(Filename))
+        return std::nullopt;
+
     // Concatenate the requested file onto the directory.
     TmpDir = getDirRef()->getName();
     llvm::sys::path::append(TmpDir, Filename);
@@ -25,6 +25,7 @@
 #include "clang/Lex/MultipleIncludeOpt.h"
 #include "clang/Lex/Preprocessor.h"
 #include "clang/Lex/PreprocessorOptions.h"
+#include "clang/Lex/RawTokenCache.h"
 #include "clang/Lex/Token.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringExtras.h"
@@ -3622,6 +3623,9 @@ void Lexer::PropagateLineStartLeadingSpaceInfo(Token &Result) {
 bool Lexer::Lex(Token &Result) {
   assert(!isDependencyDirectivesLexer());
 
+  if (NextReplayTokenIndex < ReplayTokens.size())
+    return LexReplayToken(Result);
+
   // Start a new token.
   Result.startToken();
 
@@ -4443,6 +4447,38 @@ LexNextToken:
   goto LexStart;
 }
 
+bool Lexer::LexReplayToken(Token &Result) {
+  assert(NextReplayTokenIndex < ReplayTokens.size());
+  const RawCachedToken &CTok = ReplayTokens[NextReplayTokenIndex++];
+  if (NextReplayTokenIndex == ReplayTokens.size()) {
+    // Last cached token; normal lexing resumes at BufferPtr afterwards so
+    // that LexEndOfFile runs with full end-of-file handling.
+    ReplayTokens = ArrayRef<RawCachedToken>();
+    NextReplayTokenIndex = 0;
+  }
+
+  const char *TokPtr = BufferStart + CTok.Offset;
+  Result.startToken();
+  Result.setLocation(FileLoc.getLocWithOffset(CTok.Offset));
+  Result.setKind((tok::TokenKind)(unsigned short)CTok.Kind);
+  Result.setFlag((Token::TokenFlags)(unsigned short)CTok.Flags);
+  Result.setLength(CTok.Length);
+  BufferPtr = TokPtr + CTok.Length;
+  MIOpt.ReadToken();
+
+  if (Result.is(tok::raw_identifier)) {
+    Result.setRawIdentifierData(TokPtr);
+    // Resolve keywords and macros exactly as LexIdentifierContinue does.
+    const IdentifierInfo *II = PP->LookUpIdentifierInfo(Result);
+    if (II->isHandleIdentifierCase())
+      return PP->HandleIdentifier(Result);
+    return true;
+  }
+  if (Result.isLiteral())
+    Result.setLiteralData(TokPtr);
+  return true;
+}
+
 const char *Lexer::convertDependencyDirectiveToken(
     const dependency_directives_scan::Token &DDTok, Token &Result) {
   const char *TokPtr = BufferStart + DDTok.Offset;
@@ -18,6 +18,7 @@
 #include "clang/Lex/MacroInfo.h"
 #include "clang/Lex/Preprocessor.h"
 #include "clang/Lex/PreprocessorOptions.h"
+#include "clang/Lex/RawTokenCache.h"
 #include "llvm/ADT/StringSwitch.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBufferRef.h"
@@ -104,6 +105,19 @@ bool Preprocessor::EnterSourceFile(FileID FID, ConstSearchDirIterator CurDir,
     }
   }
 
+  // If a shared raw token cache is attached and this file's contents were
+  // already tokenized, replay the cached stream instead of re-lexing.
+  // Directive-containing files are never cached, so the replay path does not
+  // interact with conditional compilation or macro definition state. Comment
+  // retention and code completion need tokens the cache does not keep.
+  if (TokenCache && !TheLexer->isDependencyDirectivesLexer() &&
+      FID != PredefinesFileID && !isCodeCompletionEnabled() &&
+      !getCommentRetentionState()) {
+    if (std::optional<ArrayRef<RawCachedToken>> Tokens =
+            TokenCache->getOrTokenize(*InputFile, getLangOpts()))
+      TheLexer->setReplayTokens(*Tokens);
+  }
+
   EnterSourceFileWithLexer(TheLexer, CurDir);
   return false;
 }
@@ -0,0 +1,239 @@
+//===- RawTokenCache.cpp - Content-keyed raw token cache ------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Lex/RawTokenCache.h"
+#include "clang/Basic/LangOptions.h"
+#include "clang/Lex/Lexer.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+
+using namespace clang;
+using namespace llvm;
+using namespace llvm::support;
+
+/// Token flags that survive caching. Everything else is either never produced
+/// by raw lexing or must be recomputed at replay.
+static constexpr unsigned short ReplayableFlags =
+    Token::StartOfLine | Token::LeadingSpace | Token::HasUDSuffix |
+    Token::HasUCN;
+
+static const char Magic[4] = {'C', 'R', 'T', 'C'};
+static constexpr uint32_t FormatVersion = 1;
+
+namespace {
+struct FileHeader {
+  char Magic[4];
+  ulittle32_t Version;
+  ulittle32_t NumEntries;
+  ulittle32_t Reserved;
+};
+
+struct EntryHeader {
+  ulittle64_t ContentHash;
+  ulittle64_t LexSignature;
+  ulittle32_t NumTokens;
+  ulittle32_t Reserved;
+};
+} // namespace
+
+uint64_t RawTokenCache::computeLexSignature(const LangOptions &LangOpts) {
+  // Only options that change which bytes form which raw token matter here;
+  // keyword-vs-identifier decisions are made at replay through the
+  // IdentifierTable of the consuming Preprocessor.
+  uint64_t Sig = 0;
+  unsigned Bit = 0;
+  auto Add = [&](bool B) { Sig |= uint64_t(B) << Bit++; };
+  Add(LangOpts.Trigraphs);
+  Add(LangOpts.LineComment);
+  Add(LangOpts.CPlusPlus);
+  Add(LangOpts.CPlusPlus11);
+  Add(LangOpts.CPlusPlus14);
+  Add(LangOpts.CPlusPlus17);
+  Add(LangOpts.CPlusPlus20);
+  Add(LangOpts.CPlusPlus23);
+  Add(LangOpts.CPlusPlus26);
+  Add(LangOpts.C99);
+  Add(LangOpts.C11);
+  Add(LangOpts.C17);
+  Add(LangOpts.C23);
+  Add(LangOpts.Digraphs);
+  Add(LangOpts.GNUMode);
+  Add(LangOpts.AsmPreprocessor);
+  Add(LangOpts.MicrosoftExt);
+  Add(LangOpts.MSVCCompat);
+  Add(LangOpts.DollarIdents);
+  Add(LangOpts.ObjC);
+  Add(LangOpts.CXXOperatorNames);
+  Add(LangOpts.HexFloats);
+  Add(LangOpts.Char8);
+  // Keep a couple of bits clear at the top so the key can never collide with
+  // the DenseMap empty/tombstone sentinels.
+  assert(Bit < 62 && "signature bits exhausted");
+  return Sig;
+}
+
+/// VCS conflict markers are recovered from by the normal lexer with a
+/// diagnostic; replaying around them is not worth supporting.
+static bool containsConflictMarker(StringRef Contents) {
+  for (StringRef Marker : {"<<<<<<<", ">>>>>>>", "|||||||"}) {
+    if (Contents.starts_with(Marker))
+      return true;
+    if (Contents.contains(Twine("\n", Marker).str()))
+      return true;
+  }
+  return false;
+}
+
+/// Raw-tokenize \p Buffer, producing an entry that is either a cacheable
+/// token stream or a remembered rejection.
+static void tokenizeBuffer(MemoryBufferRef Buffer, const LangOptions &LangOpts,
+                           bool &Cacheable,
+                           std::unique_ptr<RawCachedToken[]> &Storage,
+                           size_t &NumTokens) {
+  Cacheable = false;
+  StringRef Contents = Buffer.getBuffer();
+  if (Contents.size() > UINT32_MAX || containsConflictMarker(Contents))
+    return;
+
+  // Lex with an invalid base location; token locations then encode plain
+  // buffer offsets.
+  Lexer RawLex(SourceLocation(), LangOpts, Contents.begin(), Contents.begin(),
+               Contents.end());
+
+  SmallVector<RawCachedToken, 256> Tokens;
+  Token Tok;
+  while (true) {
+    RawLex.LexFromRawLexer(Tok);
+    if (Tok.is(tok::eof))
+      break;
+    // A directive means the token stream is no longer a pure function of the
+    // bytes; tokens needing cleaning carry out-of-band state; unknown tokens
+    // carry diagnostics the replay path would drop.
+    if ((Tok.is(tok::hash) && Tok.isAtStartOfLine()) || Tok.needsCleaning() ||
+        Tok.is(tok::unknown))
+      return;
+    RawCachedToken C;
+    C.Offset = Tok.getLocation().getRawEncoding();
+    C.Length = Tok.getLength();
+    C.Kind = Tok.getKind();
+    C.Flags = Tok.getFlags() & ReplayableFlags;
+    Tokens.push_back(C);
+  }
+
+  NumTokens = Tokens.size();
+  Storage = std::make_unique<RawCachedToken[]>(NumTokens);
+  std::copy(Tokens.begin(), Tokens.end(), Storage.get());
+  Cacheable = true;
+}
+
+std::optional<ArrayRef<RawCachedToken>>
+RawTokenCache::getOrTokenize(MemoryBufferRef Buffer,
+                             const LangOptions &LangOpts) {
+  KeyTy Key{xxh3_64bits(Buffer.getBuffer()), computeLexSignature(LangOpts)};
+  {
+    std::lock_guard<std::mutex> Guard(Lock);
+    auto It = Entries.find(Key);
+    if (It != Entries.end()) {
+      if (!It->second.Cacheable)
+        return std::nullopt;
+      return It->second.Tokens;
+    }
+  }
+
+  // Tokenize outside the lock; a concurrent duplicate scan is harmless and
+  // the first insertion wins.
+  Entry E;
+  size_t NumTokens = 0;
+  tokenizeBuffer(Buffer, LangOpts, E.Cacheable, E.Storage, NumTokens);
+  if (E.Cacheable)
+    E.Tokens = ArrayRef(E.Storage.get(), NumTokens);
+
+  std::lock_guard<std::mutex> Guard(Lock);
+  auto It = Entries.try_emplace(Key, std::move(E)).first;
+  if (!It->second.Cacheable)
+    return std::nullopt;
+  return It->second.Tokens;
+}
+
+void RawTokenCache::serialize(raw_ostream &OS) const {
+  std::lock_guard<std::mutex> Guard(Lock);
+
+  uint32_t NumEntries = 0;
+  for (const auto &KV : Entries)
+    NumEntries += KV.second.Cacheable;
+
+  FileHeader FH;
+  memcpy(FH.Magic, Magic, sizeof(Magic));
+  FH.Version = FormatVersion;
+  FH.NumEntries = NumEntries;
+  FH.Reserved = 0;
+  OS.write(reinterpret_cast<const char *>(&FH), sizeof(FH));
+
+  // Entry table first, then the token arrays back to back in table order.
+  for (const auto &KV : Entries) {
+    if (!KV.second.Cacheable)
+      continue;
+    EntryHeader EH;
+    EH.ContentHash = KV.first.first;
+    EH.LexSignature = KV.first.second;
+    EH.NumTokens = KV.second.Tokens.size();
+    EH.Reserved = 0;
+    OS.write(reinterpret_cast<const char *>(&EH), sizeof(EH));
+  }
+  for (const auto &KV : Entries) {
+    if (!KV.second.Cacheable)
+      continue;
+    OS.write(reinterpret_cast<const char *>(KV.second.Tokens.data()),
+             KV.second.Tokens.size() * sizeof(RawCachedToken));
+  }
+}
+
+Error RawTokenCache::addSerialized(std::unique_ptr<llvm::MemoryBuffer> Buffer) {
+  StringRef Data = Buffer->getBuffer();
+  if (Data.size() < sizeof(FileHeader))
+    return createStringError(inconvertibleErrorCode(),
+                             "raw token cache file truncated");
+  const auto *FH = reinterpret_cast<const FileHeader *>(Data.data());
+  if (memcmp(FH->Magic, Magic, sizeof(Magic)) != 0)
+    return createStringError(inconvertibleErrorCode(),
+                             "not a raw token cache file");
+  if (FH->Version != FormatVersion)
+    return createStringError(inconvertibleErrorCode(),
+                             "unsupported raw token cache version %u",
+                             (unsigned)FH->Version);
+
+  uint32_t NumEntries = FH->NumEntries;
+  uint64_t TableEnd =
+      sizeof(FileHeader) + uint64_t(NumEntries) * sizeof(EntryHeader);
+  if (Data.size() < TableEnd)
+    return createStringError(inconvertibleErrorCode(),
+                             "raw token cache file truncated");
+  const auto *Table = reinterpret_cast<const EntryHeader *>(
+      Data.data() + sizeof(FileHeader));
+
+  uint64_t TokensOffset = TableEnd;
+  std::lock_guard<std::mutex> Guard(Lock);
+  for (uint32_t I = 0; I != NumEntries; ++I) {
+    uint64_t NumTokens = Table[I].NumTokens;
+    uint64_t End = TokensOffset + NumTokens * sizeof(RawCachedToken);
+    if (Data.size() < End)
+      return createStringError(inconvertibleErrorCode(),
+                               "raw token cache file truncated");
+    Entry E;
+    E.Cacheable = true;
+    E.Tokens = ArrayRef(
+        reinterpret_cast<const RawCachedToken *>(Data.data() + TokensOffset),
+        NumTokens);
+    Entries.try_emplace(KeyTy{Table[I].ContentHash, Table[I].LexSignature},
+                        std::move(E));
+    TokensOffset = End;
+  }
+  MappedBuffers.push_back(std::move(Buffer));
+  return Error::success();
+}
@@ -0,0 +1,177 @@
+//===- TopLevelDeclPartition.cpp - Cheap top-level decl pre-scan ----------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Lex/TopLevelDeclPartition.h"
+#include "clang/Basic/IdentifierTable.h"
+#include "clang/Basic/LangOptions.h"
+#include "clang/Lex/Lexer.h"
+#include "llvm/ADT/StringMap.h"
+
+using namespace clang;
+
+/// Range index recorded when a name is introduced by more than one range.
+static constexpr unsigned MultipleRanges = ~0u;
+
+/// Token kinds that may follow a name in a file-scope declarator. A
+/// non-keyword identifier followed by one of these is treated as introduced
+/// by the current range. This over-approximates (an initializer like "x = 5"
+/// in a function body counts too), which only ever creates extra perceived
+/// dependencies, never missing ones for names it sees.
+static bool isDeclaratorFollower(tok::TokenKind K) {
+  switch (K) {
+  case tok::l_paren:
+  case tok::equal:
+  case tok::semi:
+  case tok::l_brace:
+  case tok::l_square:
+  case tok::comma:
+  case tok::less:
+  case tok::colon:
+  case tok::r_brace:
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool clang::scanTopLevelDeclPartition(StringRef Input,
+                                      const LangOptions &LangOpts,
+                                      SmallVectorImpl<TopLevelDeclRange> &Ranges) {
+  Ranges.clear();
+  if (Input.size() > UINT32_MAX)
+    return false;
+
+  // Lex with an invalid base location; token locations then encode plain
+  // buffer offsets.
+  Lexer RawLex(SourceLocation(), LangOpts, Input.begin(), Input.begin(),
+               Input.end());
+
+  SmallVector<Token, 256> Toks;
+  Token Tok;
+  do {
+    RawLex.LexFromRawLexer(Tok);
+    // A directive can splice arbitrary text across range boundaries, so the
+    // buffer cannot be partitioned lexically.
+    if (Tok.is(tok::hash) && Tok.isAtStartOfLine())
+      return false;
+    Toks.push_back(Tok);
+  } while (Tok.isNot(tok::eof));
+
+  IdentifierTable Keywords(LangOpts);
+  auto IsKeyword = [&](StringRef Name) {
+    return Keywords.get(Name).getTokenID() != tok::identifier;
+  };
+  auto Spelling = [&](const Token &T) {
+    return Input.substr(T.getLocation().getRawEncoding(), T.getLength());
+  };
+
+  // Name -> index of the range introducing it, or MultipleRanges.
+  llvm::StringMap<unsigned> DeclaredIn;
+  // Per range, every non-keyword identifier that occurs in it.
+  SmallVector<SmallVector<StringRef, 8>, 16> UsedNames;
+
+  unsigned BraceDepth = 0, ParenDepth = 0, BracketDepth = 0;
+  unsigned RangeBegin = 0; // Token index of the first token in this range.
+
+  auto EndRange = [&](unsigned Last) {
+    const Token &FirstTok = Toks[RangeBegin];
+    const Token &LastTok = Toks[Last];
+    unsigned Offset = FirstTok.getLocation().getRawEncoding();
+    unsigned EndOffset = LastTok.getLocation().getRawEncoding() +
+                         LastTok.getLength();
+    Ranges.push_back({Offset, EndOffset - Offset, /*Independent=*/true});
+    RangeBegin = Last + 1;
+  };
+
+  for (unsigned I = 0, E = Toks.size() - 1; I != E; ++I) {
+    const Token &T = Toks[I];
+    switch (T.getKind()) {
+    case tok::l_brace:
+      ++BraceDepth;
+      break;
+    case tok::l_paren:
+      ++ParenDepth;
+      break;
+    case tok::l_square:
+      ++BracketDepth;
+      break;
+    case tok::r_brace:
+      if (BraceDepth == 0)
+        return false;
+      --BraceDepth;
+      break;
+    case tok::r_paren:
+      if (ParenDepth == 0)
+        return false;
+      --ParenDepth;
+      break;
+    case tok::r_square:
+      if (BracketDepth == 0)
+        return false;
+      --BracketDepth;
+      break;
+    case tok::raw_identifier: {
+      StringRef Name = Spelling(T);
+      if (IsKeyword(Name))
+        break;
+      unsigned CurRange = Ranges.size();
+      if (UsedNames.size() <= CurRange)
+        UsedNames.resize(CurRange + 1);
+      UsedNames[CurRange].push_back(Name);
+      // Only names near file scope can be referenced by sibling ranges;
+      // depth 1 is included so enum constants and members are seen.
+      if (BraceDepth <= 1 && ParenDepth == 0 && BracketDepth == 0 &&
+          isDeclaratorFollower(Toks[I + 1].getKind())) {
+        auto It = DeclaredIn.try_emplace(Name, CurRange);
+        if (!It.second && It.first->second != CurRange)
+          It.first->second = MultipleRanges;
+      }
+      break;
+    }
+    default:
+      break;
+    }
+
+    if (BraceDepth || ParenDepth || BracketDepth)
+      continue;
+    if (T.is(tok::semi)) {
+      EndRange(I);
+      continue;
+    }
+    // A top-level '}' usually ends a definition, but "struct X {} x, *y;"
+    // style declarators continue the range until the ';'.
+    if (T.is(tok::r_brace)) {
+      const Token &Next = Toks[I + 1];
+      bool Continues = Next.isOneOf(tok::semi, tok::comma) ||
+                       (Next.is(tok::raw_identifier) &&
+                        !IsKeyword(Spelling(Next)));
+      if (!Continues)
+        EndRange(I);
+    }
+  }
+
+  if (BraceDepth || ParenDepth || BracketDepth)
+    return false;
+  // Tokens after the last ';' still form a (malformed but harmless) range.
+  if (RangeBegin + 1 < Toks.size())
+    EndRange(Toks.size() - 2);
+
+  // A range is independent when every name it mentions is either unknown to
+  // the scan or introduced by the range itself.
+  for (unsigned R = 0, N = std::min<size_t>(Ranges.size(), UsedNames.size());
+       R != N; ++R) {
+    for (StringRef Name : UsedNames[R]) {
+      auto It = DeclaredIn.find(Name);
+      if (It == DeclaredIn.end() || It->second == R)
+        continue;
+      Ranges[R].Independent = false;
+      break;
+    }
+  }
+  return true;
+}
@@ -29,6 +29,7 @@
 #include "clang/Sema/SemaInternal.h"
 #include "clang/Sema/Template.h"
 #include "clang/Sema/TemplateInstCallback.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/Support/TimeProfiler.h"
 #include <optional>
 
@@ -6411,6 +6412,13 @@ NamedDecl *Sema::FindInstantiatedDecl(SourceLocation Loc, NamedDecl *D,
 /// instantiations we have seen until this point.
 void Sema::PerformPendingInstantiations(bool LocalOnly) {
   std::deque<PendingImplicitInstantiation> delayedPCHInstantiations;
+  // The queue routinely holds duplicate requests for one specialization:
+  // every reference to an explicit instantiation definition enqueues it
+  // again (with the use site as the point of instantiation, for better
+  // backtraces). Processing a duplicate only re-walks the instantiation
+  // context to discover there is nothing to do, so skip entries this drain
+  // has already handled.
+  llvm::SmallPtrSet<ValueDecl *, 16> Instantiated;
   while (!PendingLocalImplicitInstantiations.empty() ||
          (!LocalOnly && !PendingInstantiations.empty())) {
     PendingImplicitInstantiation Inst;
@@ -6423,6 +6431,9 @@ void Sema::PerformPendingInstantiations(bool LocalOnly) {
       PendingLocalImplicitInstantiations.pop_front();
     }
 
+    if (!Instantiated.insert(Inst.first).second)
+      continue;
+
     // Instantiate function definitions
     if (FunctionDecl *Function = dyn_cast<FunctionDecl>(Inst.first)) {
       bool DefinitionRequired = Function->getTemplateSpecializationKind() ==
@@ -9427,8 +9427,6 @@ void ASTReader::ReadComments() {
       }
     }
   NextCursor:
-    llvm::DenseMap<FileID, std::map<unsigned, RawComment *>>
-        FileToOffsetToComment;
     for (RawComment *C : Comments) {
       SourceLocation CommentLoc = C->getBeginLoc();
       if (CommentLoc.isValid()) {
@@ -9439,6 +9437,10 @@ void ASTReader::ReadComments() {
       }
     }
   }
+
+  // ASTContext only ever asks for comments once, so the saved cursors (and
+  // the bitstream state they pin) are dead weight from here on.
+  CommentsCursors.clear();
 }
 
 void ASTReader::visitInputFileInfos(
@@ -539,7 +539,9 @@ void ASTDeclReader::ReadFunctionDefinition(FunctionDecl *FD) {
     if (CD->getNumCtorInitializers())
       CD->CtorInitializers = ReadGlobalOffset();
   }
-  // Store the offset of the body so we can lazily load it later.
+  // Store the offset of the body so we can lazily load it later. This is the
+  // mechanism that lets clients like code completion deserialize a definition
+  // without ever touching the body bits in the bitstream.
   Reader.PendingBodies[FD] = GetCurrentCursorOffset();
   HasPendingBody = true;
 }
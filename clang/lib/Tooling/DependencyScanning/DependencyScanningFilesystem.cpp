@@ -17,19 +17,19 @@ using namespace tooling;
 using namespace dependencies;
 
 llvm::ErrorOr<DependencyScanningWorkerFilesystem::TentativeEntry>
-DependencyScanningWorkerFilesystem::readFile(StringRef Filename) {
-  // Load the file and its content from the file system.
+DependencyScanningWorkerFilesystem::readFile(StringRef Filename,
+                                             llvm::vfs::Status Stat) {
+  // Load the file content from the file system. The caller has just stat'ed
+  // the path, so reuse that status instead of issuing another stat on the
+  // opened file, and let the size it reports spare the buffer read a stat of
+  // its own. The size check below papers over any raced modification, as
+  // before.
   auto MaybeFile = getUnderlyingFS().openFileForRead(Filename);
   if (!MaybeFile)
     return MaybeFile.getError();
   auto File = std::move(*MaybeFile);
 
-  auto MaybeStat = File->status();
-  if (!MaybeStat)
-    return MaybeStat.getError();
-  auto Stat = std::move(*MaybeStat);
-
-  auto MaybeBuffer = File->getBuffer(Stat.getName());
+  auto MaybeBuffer = File->getBuffer(Stat.getName(), Stat.getSize());
   if (!MaybeBuffer)
     return MaybeBuffer.getError();
   auto Buffer = std::move(*MaybeBuffer);
@@ -241,7 +241,8 @@ DependencyScanningWorkerFilesystem::computeAndStoreResult(
     return insertLocalEntryForFilename(FilenameForLookup, *Entry);
 
   auto TEntry =
-      Stat->isDirectory() ? TentativeEntry(*Stat) : readFile(OriginalFilename);
+      Stat->isDirectory() ? TentativeEntry(*Stat)
+                          : readFile(OriginalFilename, *Stat);
 
   const CachedFileSystemEntry *SharedEntry = [&]() {
     if (TEntry) {
@@ -0,0 +1,94 @@
+//===- unittests/Basic/PreinternedIdentifierTableTest.cpp -----------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Basic/PreinternedIdentifierTable.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+#include "gtest/gtest.h"
+
+using namespace clang;
+
+namespace {
+
+std::unique_ptr<PreinternedIdentifierTable> makeTable(ArrayRef<StringRef> Names) {
+  std::string Bytes;
+  llvm::raw_string_ostream OS(Bytes);
+  PreinternedIdentifierTable::build(Names, OS);
+  return PreinternedIdentifierTable::open(
+      llvm::MemoryBuffer::getMemBufferCopy(Bytes, "table"));
+}
+
+TEST(PreinternedIdentifierTableTest, RoundTrip) {
+  auto Table = makeTable({"begin", "end", "size", "begin"});
+  ASSERT_TRUE(Table);
+  EXPECT_EQ(Table->size(), 3u); // duplicates uniqued
+
+  auto Begin = Table->lookup("begin");
+  ASSERT_TRUE(Begin);
+  EXPECT_EQ(Table->getSpelling(*Begin), "begin");
+  EXPECT_TRUE(Table->contains("end"));
+  EXPECT_TRUE(Table->contains("size"));
+  EXPECT_FALSE(Table->contains("capacity"));
+  EXPECT_FALSE(Table->contains(""));
+}
+
+TEST(PreinternedIdentifierTableTest, IndicesAreDenseAndStable) {
+  auto Table = makeTable({"c", "a", "b"});
+  ASSERT_TRUE(Table);
+  // Indices are assigned in sorted order, independent of insertion order.
+  EXPECT_EQ(Table->lookup("a"), uint32_t(0));
+  EXPECT_EQ(Table->lookup("b"), uint32_t(1));
+  EXPECT_EQ(Table->lookup("c"), uint32_t(2));
+  for (uint32_t I = 0; I != 3; ++I)
+    EXPECT_EQ(Table->lookup(Table->getSpelling(I)), I);
+}
+
+TEST(PreinternedIdentifierTableTest, ManyNamesProbeCorrectly) {
+  std::vector<std::string> Storage;
+  std::vector<StringRef> Names;
+  for (int I = 0; I != 1000; ++I)
+    Storage.push_back("ident_" + std::to_string(I));
+  for (const std::string &S : Storage)
+    Names.push_back(S);
+
+  auto Table = makeTable(Names);
+  ASSERT_TRUE(Table);
+  EXPECT_EQ(Table->size(), 1000u);
+  for (StringRef Name : Names)
+    EXPECT_TRUE(Table->contains(Name)) << Name.str();
+  EXPECT_FALSE(Table->contains("ident_1000"));
+  EXPECT_FALSE(Table->contains("ident_"));
+}
+
+TEST(PreinternedIdentifierTableTest, EmptySet) {
+  auto Table = makeTable({});
+  ASSERT_TRUE(Table);
+  EXPECT_EQ(Table->size(), 0u);
+  EXPECT_FALSE(Table->contains("anything"));
+}
+
+TEST(PreinternedIdentifierTableTest, RejectsMalformedInput) {
+  EXPECT_FALSE(PreinternedIdentifierTable::open(
+      llvm::MemoryBuffer::getMemBuffer("bogus", "table")));
+
+  std::string Bytes;
+  {
+    llvm::raw_string_ostream OS(Bytes);
+    PreinternedIdentifierTable::build({"x", "y"}, OS);
+  }
+  for (size_t Len = 0; Len < Bytes.size(); ++Len)
+    EXPECT_FALSE(
+        PreinternedIdentifierTable::open(llvm::MemoryBuffer::getMemBufferCopy(
+            StringRef(Bytes).take_front(Len), "table")));
+  std::string BadVersion = Bytes;
+  BadVersion[4] = char(0xee);
+  EXPECT_FALSE(PreinternedIdentifierTable::open(
+      llvm::MemoryBuffer::getMemBufferCopy(BadVersion, "table")));
+}
+
+} // anonymous namespace
@@ -178,6 +178,50 @@ TEST(CrossTranslationUnit, IndexFormatCanBeParsed) {
     EXPECT_TRUE(Index.count(E.getKey()));
 }
 
+TEST(CrossTranslationUnit, IndexCacheRoundTrip) {
+  llvm::StringMap<std::string> Index;
+  Index["9:c:@F@f#I#"] = "/b/f1.ast";
+  Index["9:c:@F@g#I#"] = "/d/f2.ast";
+  Index["9:c:@F@h#I#"] = "/f/f3.ast";
+
+  std::string Bytes;
+  llvm::raw_string_ostream OS(Bytes);
+  CrossTUIndexCache::write(Index, /*TextSize=*/123, /*TextModTime=*/456, OS);
+
+  std::unique_ptr<CrossTUIndexCache> Cache = CrossTUIndexCache::open(
+      llvm::MemoryBuffer::getMemBufferCopy(Bytes, "cache"), 123, 456);
+  ASSERT_TRUE(Cache);
+  EXPECT_EQ(Cache->size(), 3u);
+  for (const auto &E : Index) {
+    std::optional<StringRef> Identifier = Cache->lookup(E.getKey());
+    ASSERT_TRUE(Identifier);
+    EXPECT_EQ(*Identifier, E.getValue());
+  }
+  EXPECT_FALSE(Cache->lookup("9:c:@F@i#I#"));
+  EXPECT_FALSE(Cache->lookup(""));
+}
+
+TEST(CrossTranslationUnit, StaleIndexCacheIsRejected) {
+  llvm::StringMap<std::string> Index;
+  Index["9:c:@F@f#I#"] = "/b/f1.ast";
+
+  std::string Bytes;
+  llvm::raw_string_ostream OS(Bytes);
+  CrossTUIndexCache::write(Index, /*TextSize=*/123, /*TextModTime=*/456, OS);
+
+  // A cache built from a differently sized or timed textual index is stale.
+  EXPECT_FALSE(CrossTUIndexCache::open(
+      llvm::MemoryBuffer::getMemBufferCopy(Bytes, "cache"), 124, 456));
+  EXPECT_FALSE(CrossTUIndexCache::open(
+      llvm::MemoryBuffer::getMemBufferCopy(Bytes, "cache"), 123, 457));
+
+  for (size_t Len = 0; Len < Bytes.size(); ++Len)
+    EXPECT_FALSE(CrossTUIndexCache::open(
+        llvm::MemoryBuffer::getMemBufferCopy(StringRef(Bytes).take_front(Len),
+                                             "cache"),
+        123, 456));
+}
+
 TEST(CrossTranslationUnit, EmptyInvocationListIsNotValid) {
   auto Input = "";
 
@@ -0,0 +1,90 @@
+//===- unittests/Lex/DirectoryIndexTest.cpp - DirectoryIndex tests --------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Lex/DirectoryIndex.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+#include "gtest/gtest.h"
+
+using namespace clang;
+
+namespace {
+
+std::unique_ptr<DirectoryIndex> makeIndex(ArrayRef<StringRef> Names,
+                                          DirectoryStamp Stamp = {1, 2}) {
+  std::string Bytes;
+  llvm::raw_string_ostream OS(Bytes);
+  DirectoryIndex::writeEntries(Names, Stamp, OS);
+  return DirectoryIndex::open(
+      llvm::MemoryBuffer::getMemBufferCopy(Bytes, "index"));
+}
+
+TEST(DirectoryIndexTest, RoundTrip) {
+  auto Index = makeIndex({"stdio.h", "sys", "zlib.h"}, {42, 7});
+  ASSERT_TRUE(Index);
+  EXPECT_EQ(Index->getNumEntries(), 3u);
+  EXPECT_EQ(Index->getStamp().MTimeNanos, 42u);
+  EXPECT_EQ(Index->getStamp().Inode, 7u);
+
+  EXPECT_TRUE(Index->mightContain("stdio.h"));
+  EXPECT_TRUE(Index->mightContain("zlib.h"));
+  EXPECT_FALSE(Index->mightContain("string.h"));
+  EXPECT_FALSE(Index->mightContain(""));
+}
+
+TEST(DirectoryIndexTest, FirstComponentOnly) {
+  auto Index = makeIndex({"sys", "net.h"});
+  ASSERT_TRUE(Index);
+  // Only the first component is consulted for nested lookups.
+  EXPECT_TRUE(Index->mightContain("sys/types.h"));
+  EXPECT_TRUE(Index->mightContain("sys\\types.h"));
+  EXPECT_FALSE(Index->mightContain("linux/types.h"));
+}
+
+TEST(DirectoryIndexTest, CaseIsFolded) {
+  auto Index = makeIndex({"CoreFoundation.h"});
+  ASSERT_TRUE(Index);
+  EXPECT_TRUE(Index->mightContain("corefoundation.h"));
+  EXPECT_TRUE(Index->mightContain("COREFOUNDATION.H"));
+}
+
+TEST(DirectoryIndexTest, DuplicatesAreUniqued) {
+  auto Index = makeIndex({"a.h", "A.h", "b.h"});
+  ASSERT_TRUE(Index);
+  EXPECT_EQ(Index->getNumEntries(), 2u);
+}
+
+TEST(DirectoryIndexTest, EmptyDirectory) {
+  auto Index = makeIndex({});
+  ASSERT_TRUE(Index);
+  EXPECT_EQ(Index->getNumEntries(), 0u);
+  EXPECT_FALSE(Index->mightContain("anything.h"));
+}
+
+TEST(DirectoryIndexTest, RejectsMalformedInput) {
+  // Not an index at all.
+  EXPECT_FALSE(DirectoryIndex::open(
+      llvm::MemoryBuffer::getMemBuffer("not an index", "index")));
+
+  std::string Bytes;
+  {
+    llvm::raw_string_ostream OS(Bytes);
+    DirectoryIndex::writeEntries({"a.h", "b.h"}, {1, 2}, OS);
+  }
+  // Truncation anywhere makes the index unusable.
+  for (size_t Len = 0; Len < Bytes.size(); ++Len)
+    EXPECT_FALSE(DirectoryIndex::open(llvm::MemoryBuffer::getMemBufferCopy(
+        StringRef(Bytes).take_front(Len), "index")));
+  // A wrong version is rejected even with intact structure.
+  std::string BadVersion = Bytes;
+  BadVersion[4] = char(0xff);
+  EXPECT_FALSE(DirectoryIndex::open(
+      llvm::MemoryBuffer::getMemBufferCopy(BadVersion, "index")));
+}
+
+} // anonymous namespace
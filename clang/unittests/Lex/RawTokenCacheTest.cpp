@@ -0,0 +1,223 @@
+//===- unittests/Lex/RawTokenCacheTest.cpp --------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Lex/RawTokenCache.h"
+#include "clang/Basic/Diagnostic.h"
+#include "clang/Basic/DiagnosticOptions.h"
+#include "clang/Basic/FileManager.h"
+#include "clang/Basic/LangOptions.h"
+#include "clang/Basic/SourceManager.h"
+#include "clang/Basic/TargetInfo.h"
+#include "clang/Basic/TargetOptions.h"
+#include "clang/Lex/HeaderSearch.h"
+#include "clang/Lex/HeaderSearchOptions.h"
+#include "clang/Lex/ModuleLoader.h"
+#include "clang/Lex/Preprocessor.h"
+#include "clang/Lex/PreprocessorOptions.h"
+#include "llvm/Testing/Support/Error.h"
+#include "gtest/gtest.h"
+#include <optional>
+
+using namespace clang;
+
+namespace {
+
+TEST(RawTokenCacheTest, CacheHitSharesStream) {
+  RawTokenCache Cache;
+  LangOptions LangOpts;
+
+  auto Buf1 = llvm::MemoryBuffer::getMemBuffer("int x = 42;\n");
+  auto Buf2 = llvm::MemoryBuffer::getMemBuffer("int x = 42;\n");
+
+  auto Tokens1 = Cache.getOrTokenize(*Buf1, LangOpts);
+  ASSERT_TRUE(Tokens1);
+  EXPECT_EQ(Tokens1->size(), 5u); // int x = 42 ;
+  EXPECT_EQ(tok::TokenKind(uint16_t((*Tokens1)[0].Kind)), tok::raw_identifier);
+  EXPECT_EQ(tok::TokenKind(uint16_t((*Tokens1)[3].Kind)),
+            tok::numeric_constant);
+
+  // Identical contents from a different buffer hit the same stream.
+  auto Tokens2 = Cache.getOrTokenize(*Buf2, LangOpts);
+  ASSERT_TRUE(Tokens2);
+  EXPECT_EQ(Tokens1->data(), Tokens2->data());
+}
+
+TEST(RawTokenCacheTest, RejectsUncacheableContent) {
+  RawTokenCache Cache;
+  LangOptions LangOpts;
+
+  // Directives make the token stream depend on preprocessor state.
+  auto WithDirective =
+      llvm::MemoryBuffer::getMemBuffer("#define N 1\nint x;\n");
+  EXPECT_FALSE(Cache.getOrTokenize(*WithDirective, LangOpts));
+  // Rejections are remembered.
+  EXPECT_FALSE(Cache.getOrTokenize(*WithDirective, LangOpts));
+
+  // Escaped newlines inside tokens need cleaning.
+  auto NeedsCleaning = llvm::MemoryBuffer::getMemBuffer("in\\\nt x;\n");
+  EXPECT_FALSE(Cache.getOrTokenize(*NeedsCleaning, LangOpts));
+
+  // Conflict markers are recovered from with diagnostics the replay path
+  // would drop.
+  auto Conflict =
+      llvm::MemoryBuffer::getMemBuffer("int x;\n<<<<<<< HEAD\nint y;\n");
+  EXPECT_FALSE(Cache.getOrTokenize(*Conflict, LangOpts));
+}
+
+TEST(RawTokenCacheTest, LexSignatureDistinguishesDialects) {
+  RawTokenCache Cache;
+  LangOptions COpts;
+  LangOptions CXXOpts;
+  CXXOpts.CPlusPlus = 1;
+  CXXOpts.CPlusPlus11 = 1;
+
+  // R"(x)" is one raw string literal in C++11 and several tokens in C.
+  auto Buf = llvm::MemoryBuffer::getMemBuffer("R\"(x)\"\n");
+  auto CTokens = Cache.getOrTokenize(*Buf, COpts);
+  auto CXXTokens = Cache.getOrTokenize(*Buf, CXXOpts);
+  ASSERT_TRUE(CTokens);
+  ASSERT_TRUE(CXXTokens);
+  EXPECT_NE(CTokens->size(), CXXTokens->size());
+  EXPECT_EQ(CXXTokens->size(), 1u);
+}
+
+TEST(RawTokenCacheTest, SerializationRoundTrip) {
+  RawTokenCache Cache;
+  LangOptions LangOpts;
+
+  auto Buf = llvm::MemoryBuffer::getMemBuffer("long f(long a) { return a; }\n");
+  auto Tokens = Cache.getOrTokenize(*Buf, LangOpts);
+  ASSERT_TRUE(Tokens);
+
+  std::string Serialized;
+  {
+    llvm::raw_string_ostream OS(Serialized);
+    Cache.serialize(OS);
+  }
+
+  RawTokenCache Loaded;
+  ASSERT_THAT_ERROR(Loaded.addSerialized(llvm::MemoryBuffer::getMemBufferCopy(
+                        Serialized, "cache")),
+                    llvm::Succeeded());
+
+  auto LoadedTokens = Loaded.getOrTokenize(*Buf, LangOpts);
+  ASSERT_TRUE(LoadedTokens);
+  ASSERT_EQ(Tokens->size(), LoadedTokens->size());
+  for (size_t I = 0, E = Tokens->size(); I != E; ++I) {
+    EXPECT_EQ((*Tokens)[I].Offset, (*LoadedTokens)[I].Offset);
+    EXPECT_EQ((*Tokens)[I].Length, (*LoadedTokens)[I].Length);
+    EXPECT_EQ((*Tokens)[I].Kind, (*LoadedTokens)[I].Kind);
+    EXPECT_EQ((*Tokens)[I].Flags, (*LoadedTokens)[I].Flags);
+  }
+}
+
+/// End-to-end: preprocessing with a warm cache must produce exactly the same
+/// token stream as cold lexing, including macro expansion of identifiers
+/// replayed from the cache.
+class RawTokenCachePPTest : public ::testing::Test {
+protected:
+  RawTokenCachePPTest()
+      : FileMgr(FileMgrOpts), DiagID(new DiagnosticIDs()),
+        Diags(DiagID, new DiagnosticOptions, new IgnoringDiagConsumer()),
+        SourceMgr(Diags, FileMgr), TargetOpts(new TargetOptions) {
+    TargetOpts->Triple = "x86_64-pc-linux-gnu";
+    Target = TargetInfo::CreateTargetInfo(Diags, TargetOpts);
+  }
+
+  struct LexedToken {
+    tok::TokenKind Kind;
+    SourceLocation Loc;
+    unsigned Length;
+    std::string Spelling;
+
+    bool operator==(const LexedToken &RHS) const {
+      return Kind == RHS.Kind && Loc == RHS.Loc && Length == RHS.Length &&
+             Spelling == RHS.Spelling;
+    }
+  };
+
+  std::vector<LexedToken> lexMainFile(RawTokenCache *Cache) {
+    TrivialModuleLoader ModLoader;
+    HeaderSearch HeaderInfo(std::make_shared<HeaderSearchOptions>(), SourceMgr,
+                            Diags, LangOpts, Target.get());
+    Preprocessor PP(std::make_shared<PreprocessorOptions>(), Diags, LangOpts,
+                    SourceMgr, HeaderInfo, ModLoader,
+                    /*IILookup=*/nullptr,
+                    /*OwnsHeaderSearch=*/false);
+    PP.Initialize(*Target);
+    PP.setRawTokenCache(Cache);
+    PP.EnterMainSourceFile();
+
+    std::vector<LexedToken> Result;
+    Token Tok;
+    do {
+      PP.Lex(Tok);
+      Result.push_back({Tok.getKind(), Tok.getLocation(), Tok.getLength(),
+                        PP.getSpelling(Tok)});
+    } while (Tok.isNot(tok::eof));
+    return Result;
+  }
+
+  FileSystemOptions FileMgrOpts;
+  FileManager FileMgr;
+  IntrusiveRefCntPtr<DiagnosticIDs> DiagID;
+  DiagnosticsEngine Diags;
+  SourceManager SourceMgr;
+  LangOptions LangOpts;
+  std::shared_ptr<TargetOptions> TargetOpts;
+  IntrusiveRefCntPtr<TargetInfo> Target;
+};
+
+TEST_F(RawTokenCachePPTest, ReplayMatchesColdLexing) {
+  auto VFS = new llvm::vfs::InMemoryFileSystem();
+  // Directive-free header, included twice so the second inclusion replays.
+  // "N" only macro-expands if replayed identifiers go through the normal
+  // identifier machinery of the including context.
+  VFS->addFile("head.h", 0,
+               llvm::MemoryBuffer::getMemBuffer(
+                   "extern long values[N];\nlong get(unsigned i);\n"));
+  VFS->addFile("main.c", 0,
+               llvm::MemoryBuffer::getMemBuffer("#define N 8\n"
+                                                "#include \"head.h\"\n"
+                                                "#undef N\n"
+                                                "#define N 16\n"
+                                                "#include \"head.h\"\n"));
+  FileMgr.setVirtualFileSystem(VFS);
+
+  OptionalFileEntryRef FE;
+  ASSERT_THAT_ERROR(FileMgr.getFileRef("main.c").moveInto(FE),
+                    llvm::Succeeded());
+  SourceMgr.setMainFileID(
+      SourceMgr.createFileID(*FE, SourceLocation(), SrcMgr::C_User));
+
+  std::vector<LexedToken> Cold = lexMainFile(nullptr);
+
+  // Re-lex with a shared cache. Two fresh runs so FileIDs line up.
+  SourceMgr.setMainFileID(
+      SourceMgr.createFileID(*FE, SourceLocation(), SrcMgr::C_User));
+  RawTokenCache Cache;
+  std::vector<LexedToken> Warm = lexMainFile(&Cache);
+
+  ASSERT_EQ(Cold.size(), Warm.size());
+  for (size_t I = 0, E = Cold.size(); I != E; ++I) {
+    EXPECT_EQ(Cold[I].Kind, Warm[I].Kind) << "token " << I;
+    EXPECT_EQ(Cold[I].Length, Warm[I].Length) << "token " << I;
+    EXPECT_EQ(Cold[I].Spelling, Warm[I].Spelling) << "token " << I;
+  }
+
+  // The macro in the header expanded differently per inclusion.
+  unsigned NumEights = 0, NumSixteens = 0;
+  for (const LexedToken &T : Warm) {
+    NumEights += T.Spelling == "8";
+    NumSixteens += T.Spelling == "16";
+  }
+  EXPECT_EQ(NumEights, 1u);
+  EXPECT_EQ(NumSixteens, 1u);
+}
+
+} // anonymous namespace
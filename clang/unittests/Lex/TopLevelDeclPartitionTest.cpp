@@ -0,0 +1,95 @@
+//===- unittests/Lex/TopLevelDeclPartitionTest.cpp ------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Lex/TopLevelDeclPartition.h"
+#include "clang/Basic/LangOptions.h"
+#include "gtest/gtest.h"
+
+using namespace clang;
+
+namespace {
+
+class TopLevelDeclPartitionTest : public ::testing::Test {
+protected:
+  LangOptions LangOpts;
+  SmallVector<TopLevelDeclRange, 8> Ranges;
+
+  bool scan(StringRef Input) {
+    return scanTopLevelDeclPartition(Input, LangOpts, Ranges);
+  }
+
+  StringRef text(StringRef Input, const TopLevelDeclRange &R) {
+    return Input.substr(R.Offset, R.Length);
+  }
+};
+
+TEST_F(TopLevelDeclPartitionTest, IndependentFunctions) {
+  StringRef Input = "int f(int a) { return a; }\n"
+                    "int g(int b) { return b + 1; }\n"
+                    "int h(void) { return 0; }\n";
+  ASSERT_TRUE(scan(Input));
+  ASSERT_EQ(Ranges.size(), 3u);
+  EXPECT_EQ(text(Input, Ranges[0]), "int f(int a) { return a; }");
+  EXPECT_EQ(text(Input, Ranges[1]), "int g(int b) { return b + 1; }");
+  EXPECT_EQ(text(Input, Ranges[2]), "int h(void) { return 0; }");
+  for (const TopLevelDeclRange &R : Ranges)
+    EXPECT_TRUE(R.Independent);
+}
+
+TEST_F(TopLevelDeclPartitionTest, UseOfSiblingName) {
+  StringRef Input = "typedef unsigned u32;\n"
+                    "u32 counter;\n"
+                    "int unrelated;\n";
+  ASSERT_TRUE(scan(Input));
+  ASSERT_EQ(Ranges.size(), 3u);
+  // The typedef mentions only its own name and keywords.
+  EXPECT_TRUE(Ranges[0].Independent);
+  // "counter" uses u32, which a sibling range introduces.
+  EXPECT_FALSE(Ranges[1].Independent);
+  EXPECT_TRUE(Ranges[2].Independent);
+}
+
+TEST_F(TopLevelDeclPartitionTest, CallerDependsOnCallee) {
+  StringRef Input = "int callee(void) { return 1; }\n"
+                    "int caller(void) { return callee(); }\n";
+  ASSERT_TRUE(scan(Input));
+  ASSERT_EQ(Ranges.size(), 2u);
+  EXPECT_TRUE(Ranges[0].Independent);
+  EXPECT_FALSE(Ranges[1].Independent);
+}
+
+TEST_F(TopLevelDeclPartitionTest, EnumConstantCreatesDependency) {
+  StringRef Input = "enum Color { Red, Green };\n"
+                    "int x = Red;\n";
+  ASSERT_TRUE(scan(Input));
+  ASSERT_EQ(Ranges.size(), 2u);
+  EXPECT_FALSE(Ranges[1].Independent);
+}
+
+TEST_F(TopLevelDeclPartitionTest, TrailingDeclaratorStaysInRange) {
+  StringRef Input = "struct Point { int x, y; } origin;\n"
+                    "void f(void) {}\n";
+  ASSERT_TRUE(scan(Input));
+  ASSERT_EQ(Ranges.size(), 2u);
+  EXPECT_EQ(text(Input, Ranges[0]), "struct Point { int x, y; } origin;");
+  EXPECT_EQ(text(Input, Ranges[1]), "void f(void) {}");
+}
+
+TEST_F(TopLevelDeclPartitionTest, RejectsDirectivesAndUnbalancedInput) {
+  EXPECT_FALSE(scan("#define N 4\nint x;\n"));
+  EXPECT_TRUE(Ranges.empty());
+  EXPECT_FALSE(scan("void f() {\n"));
+  EXPECT_FALSE(scan("int x = a[1]];\n"));
+}
+
+TEST_F(TopLevelDeclPartitionTest, EmptyInput) {
+  ASSERT_TRUE(scan(""));
+  EXPECT_TRUE(Ranges.empty());
+}
+
+} // anonymous namespace
@@ -189,6 +189,26 @@ class Symbolizer final {
   // If stale, need to reload the modules before looking up addresses.
   bool modules_fresh_;
 
+  // Direct-mapped cache of recently symbolized PCs. Sanitizers symbolize the
+  // same frames over and over (deduplicated reports, repeated stacks), and
+  // every miss is a round trip through a symbolizer tool, typically an
+  // external process. Entries own deep copies of the frames; lookups hand
+  // out fresh copies that the caller frees as usual. All access is guarded
+  // by |mu_|.
+  struct CachedSymbolizedStack {
+    uptr addr;
+    SymbolizedStack *frames; // Owned; null if the slot is empty.
+  };
+  static const uptr kSymbolizedStackCacheSize = 1021;
+  CachedSymbolizedStack pc_cache_[kSymbolizedStackCacheSize] = {};
+
+  // Returns an owned copy of the cached frames for |addr|, or null.
+  SymbolizedStack *LookupCachedSymbolizedStack(uptr addr);
+  // Stores a copy of |frames| in the cache slot for |addr|.
+  void CacheSymbolizedStack(uptr addr, SymbolizedStack *frames);
+  // Drops all cached frames, e.g. because the module list changed.
+  void FlushSymbolizedStackCache();
+
   // Platform-specific default demangler, returns nullptr on failure.
   const char *PlatformDemangle(const char *name);
 
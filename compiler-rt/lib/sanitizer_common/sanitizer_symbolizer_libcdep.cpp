@@ -82,8 +82,66 @@ const char *ExtractTokenUpToDelimiter(const char *str, const char *delimiter,
   return prefix_end;
 }
 
+static char *MaybeInternalStrDup(const char *s) {
+  return s ? internal_strdup(s) : nullptr;
+}
+
+// Deep-copies a list of symbolized frames, including the strings owned by
+// each AddressInfo.
+static SymbolizedStack *CopySymbolizedStack(const SymbolizedStack *stack) {
+  SymbolizedStack *head = nullptr;
+  SymbolizedStack *tail = nullptr;
+  for (const SymbolizedStack *s = stack; s; s = s->next) {
+    SymbolizedStack *copy = SymbolizedStack::New(s->info.address);
+    const AddressInfo &src = s->info;
+    AddressInfo &info = copy->info;
+    info.module = MaybeInternalStrDup(src.module);
+    info.module_offset = src.module_offset;
+    info.module_arch = src.module_arch;
+    internal_memcpy(info.uuid, src.uuid, sizeof(info.uuid));
+    info.uuid_size = src.uuid_size;
+    info.function = MaybeInternalStrDup(src.function);
+    info.function_offset = src.function_offset;
+    info.file = MaybeInternalStrDup(src.file);
+    info.line = src.line;
+    info.column = src.column;
+    if (tail)
+      tail->next = copy;
+    else
+      head = copy;
+    tail = copy;
+  }
+  return head;
+}
+
+SymbolizedStack *Symbolizer::LookupCachedSymbolizedStack(uptr addr) {
+  CachedSymbolizedStack &entry = pc_cache_[addr % kSymbolizedStackCacheSize];
+  if (entry.frames && entry.addr == addr)
+    return CopySymbolizedStack(entry.frames);
+  return nullptr;
+}
+
+void Symbolizer::CacheSymbolizedStack(uptr addr, SymbolizedStack *frames) {
+  CachedSymbolizedStack &entry = pc_cache_[addr % kSymbolizedStackCacheSize];
+  if (entry.frames)
+    entry.frames->ClearAll();
+  entry.addr = addr;
+  entry.frames = CopySymbolizedStack(frames);
+}
+
+void Symbolizer::FlushSymbolizedStackCache() {
+  for (uptr i = 0; i < kSymbolizedStackCacheSize; ++i) {
+    if (pc_cache_[i].frames) {
+      pc_cache_[i].frames->ClearAll();
+      pc_cache_[i].frames = nullptr;
+    }
+  }
+}
+
 SymbolizedStack *Symbolizer::SymbolizePC(uptr addr) {
   Lock l(&mu_);
+  if (SymbolizedStack *cached = LookupCachedSymbolizedStack(addr))
+    return cached;
   SymbolizedStack *res = SymbolizedStack::New(addr);
   auto *mod = FindModuleForAddress(addr);
   if (!mod)
@@ -93,9 +151,12 @@ SymbolizedStack *Symbolizer::SymbolizePC(uptr addr) {
   for (auto &tool : tools_) {
     SymbolizerScope sym_scope(this);
     if (tool.SymbolizePC(addr, res)) {
-      return res;
+      break;
     }
   }
+  // Cache negative results from the tool chain too: retrying an address no
+  // tool could symbolize costs a full round trip every time.
+  CacheSymbolizedStack(addr, res);
   return res;
 }
 
@@ -152,6 +213,7 @@ bool Symbolizer::GetModuleNameAndOffsetForPC(uptr pc, const char **module_name,
 
 void Symbolizer::Flush() {
   Lock l(&mu_);
+  FlushSymbolizedStackCache();
   for (auto &tool : tools_) {
     SymbolizerScope sym_scope(this);
     tool.Flush();
@@ -185,6 +247,8 @@ bool Symbolizer::FindModuleNameAndOffsetForAddress(uptr address,
 }
 
 void Symbolizer::RefreshModules() {
+  // Cached frames may refer to modules that moved or got unloaded.
+  FlushSymbolizedStackCache();
   modules_.init();
   fallback_modules_.fallbackInit();
   RAW_CHECK(modules_.size() > 0);
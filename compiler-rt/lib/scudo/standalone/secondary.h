@@ -446,14 +446,69 @@ private:
   }
 
   void releaseOlderThan(u64 Time) EXCLUDES(Mutex) {
-    ScopedLock L(Mutex);
-    if (!EntriesCount || OldestTime == 0 || OldestTime > Time)
+    CachedBlock ReleaseList[CacheConfig::EntriesArraySize];
+    uptr N = 0;
+    {
+      ScopedLock L(Mutex);
+      if (!EntriesCount || OldestTime == 0 || OldestTime > Time)
+        return;
+      OldestTime = 0;
+      for (uptr I = 0; I < CacheConfig::QuarantineSize; I++)
+        releaseIfOlderThan(Quarantine[I], Time);
+      // Take the entries that are due out of the cache and release their
+      // pages after dropping the lock: releaseAndZeroPagesToOS is a syscall
+      // per entry, potentially over many megabytes, and holding the mutex
+      // for the duration blocks every concurrent store() and retrieve().
+      // Removed entries are invisible to concurrent operations, so nothing
+      // can hand them out while their pages are being released.
+      for (uptr I = 0; I < CacheConfig::EntriesArraySize; I++) {
+        CachedBlock &Entry = Entries[I];
+        if (!Entry.isValid() || !Entry.Time)
+          continue;
+        if (Entry.Time > Time) {
+          if (OldestTime == 0 || Entry.Time < OldestTime)
+            OldestTime = Entry.Time;
+          continue;
+        }
+        ReleaseList[N++] = Entry;
+        Entry.invalidate();
+        EntriesCount--;
+      }
+    }
+    if (N == 0)
       return;
-    OldestTime = 0;
-    for (uptr I = 0; I < CacheConfig::QuarantineSize; I++)
-      releaseIfOlderThan(Quarantine[I], Time);
-    for (uptr I = 0; I < CacheConfig::EntriesArraySize; I++)
-      releaseIfOlderThan(Entries[I], Time);
+    for (uptr I = 0; I < N; I++) {
+      ReleaseList[I].MemMap.releaseAndZeroPagesToOS(ReleaseList[I].CommitBase,
+                                                    ReleaseList[I].CommitSize);
+      ReleaseList[I].Time = 0;
+    }
+    // Put the released entries back so they stay retrievable. Concurrent
+    // stores may have taken the free slots in the meantime; whatever no
+    // longer fits is unmapped, which is what store() would have done with
+    // it on a full cache.
+    MemMapT UnmapList[CacheConfig::EntriesArraySize];
+    uptr M = 0;
+    {
+      ScopedLock L(Mutex);
+      const u32 MaxCount = atomic_load_relaxed(&MaxEntriesCount);
+      for (uptr I = 0; I < N; I++) {
+        bool Inserted = false;
+        if (EntriesCount < MaxCount) {
+          for (u32 J = 0; J < MaxCount; J++) {
+            if (Entries[J].isValid())
+              continue;
+            Entries[J] = ReleaseList[I];
+            EntriesCount++;
+            Inserted = true;
+            break;
+          }
+        }
+        if (!Inserted)
+          UnmapList[M++] = ReleaseList[I].MemMap;
+      }
+    }
+    for (uptr I = 0; I < M; I++)
+      UnmapList[I].unmap(UnmapList[I].getBase(), UnmapList[I].getCapacity());
   }
 
   HybridMutex Mutex;
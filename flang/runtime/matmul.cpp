@@ -25,6 +25,7 @@
 #include "flang/Runtime/c-or-cpp.h"
 #include "flang/Runtime/cpp-type.h"
 #include "flang/Runtime/descriptor.h"
+#include <algorithm>
 #include <cstring>
 
 namespace Fortran::runtime {
@@ -69,6 +70,12 @@ private:
 //    DO 2 J = 1, NCOLS
 //     DO 2 I = 1, NROWS
 //   2  RES(I,J) = RES(I,J) + X(I,K)*Y(K,J) ! loop-invariant last term
+// The loops over K and J are additionally tiled so that a
+// (ROWS x jTile) tile of RES and the X panels feeding it stay resident
+// in cache while they are reused across kTile accumulation steps,
+// instead of streaming all of RES through cache once per value of K.
+// Accumulation order per result element is unchanged (tiles cover K in
+// order), so results are identical to the untiled loops.
 template <TypeCategory RCAT, int RKIND, typename XT, typename YT,
     bool X_HAS_STRIDED_COLUMNS, bool Y_HAS_STRIDED_COLUMNS>
 inline void MatrixTimesMatrix(CppTypeFor<RCAT, RKIND> *RESTRICT product,
@@ -77,28 +84,39 @@ inline void MatrixTimesMatrix(CppTypeFor<RCAT, RKIND> *RESTRICT product,
     std::size_t yColumnByteStride = 0) {
   using ResultType = CppTypeFor<RCAT, RKIND>;
   std::memset(product, 0, rows * cols * sizeof *product);
-  const XT *RESTRICT xp0{x};
-  for (SubscriptValue k{0}; k < n; ++k) {
-    ResultType *RESTRICT p{product};
-    for (SubscriptValue j{0}; j < cols; ++j) {
-      const XT *RESTRICT xp{xp0};
-      ResultType yv;
-      if constexpr (!Y_HAS_STRIDED_COLUMNS) {
-        yv = static_cast<ResultType>(y[k + j * n]);
-      } else {
-        yv = static_cast<ResultType>(reinterpret_cast<const YT *>(
-            reinterpret_cast<const char *>(y) + j * yColumnByteStride)[k]);
-      }
-      for (SubscriptValue i{0}; i < rows; ++i) {
-        *p++ += static_cast<ResultType>(*xp++) * yv;
+  // Tile sizes chosen to keep the working set near half of a typical
+  // 256KiB L2 cache for 8-byte element types without getting fancy
+  // about the actual cache hierarchy.
+  constexpr SubscriptValue jTile{128};
+  constexpr SubscriptValue kTile{128};
+  for (SubscriptValue j0{0}; j0 < cols; j0 += jTile) {
+    SubscriptValue jEnd{std::min<SubscriptValue>(j0 + jTile, cols)};
+    for (SubscriptValue k0{0}; k0 < n; k0 += kTile) {
+      SubscriptValue kEnd{std::min<SubscriptValue>(k0 + kTile, n)};
+      for (SubscriptValue k{k0}; k < kEnd; ++k) {
+        const XT *RESTRICT xp0;
+        if constexpr (!X_HAS_STRIDED_COLUMNS) {
+          xp0 = x + k * rows;
+        } else {
+          xp0 = reinterpret_cast<const XT *>(
+              reinterpret_cast<const char *>(x) + k * xColumnByteStride);
+        }
+        ResultType *RESTRICT p{product + j0 * rows};
+        for (SubscriptValue j{j0}; j < jEnd; ++j) {
+          const XT *RESTRICT xp{xp0};
+          ResultType yv;
+          if constexpr (!Y_HAS_STRIDED_COLUMNS) {
+            yv = static_cast<ResultType>(y[k + j * n]);
+          } else {
+            yv = static_cast<ResultType>(reinterpret_cast<const YT *>(
+                reinterpret_cast<const char *>(y) + j * yColumnByteStride)[k]);
+          }
+          for (SubscriptValue i{0}; i < rows; ++i) {
+            *p++ += static_cast<ResultType>(*xp++) * yv;
+          }
+        }
       }
     }
-    if constexpr (!X_HAS_STRIDED_COLUMNS) {
-      xp0 += rows;
-    } else {
-      xp0 = reinterpret_cast<const XT *>(
-          reinterpret_cast<const char *>(xp0) + xColumnByteStride);
-    }
   }
 }
 
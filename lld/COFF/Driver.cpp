@@ -126,11 +126,36 @@ static bool isCrtend(StringRef s) {
 // FIXME: We could open the file in createFutureForFile and avoid needing to
 // return an error here, but for the moment that would cost us a file descriptor
 // (a limited resource on Windows) for the duration that the future is pending.
-using MBErrPair = std::pair<std::unique_ptr<MemoryBuffer>, std::error_code>;
+//
+// The result of asynchronously opening an input file. If the buffer turns out
+// to contain a COFF object, it is also pre-parsed into a Binary on the worker
+// thread: creating the COFFObjectFile only reads the mapped buffer and touches
+// no link state, so it can overlap with the symbol resolution of earlier
+// files, which stays on the main thread in input order so that resolution
+// remains deterministic.
+struct OpenedFile {
+  std::unique_ptr<MemoryBuffer> mb;
+  std::error_code ec;
+  std::unique_ptr<llvm::object::Binary> preparsed;
+};
+
+static std::unique_ptr<llvm::object::Binary>
+maybePreparseBinary(MemoryBufferRef mbref) {
+  if (identify_magic(mbref.getBuffer()) != file_magic::coff_object)
+    return nullptr;
+  Expected<std::unique_ptr<llvm::object::Binary>> bin = createBinary(mbref);
+  if (!bin) {
+    // Drop the error; ObjFile::parse() will re-run createBinary and report it
+    // with the usual diagnostics.
+    consumeError(bin.takeError());
+    return nullptr;
+  }
+  return std::move(*bin);
+}
 
 // Create a std::future that opens and maps a file using the best strategy for
 // the host platform.
-static std::future<MBErrPair> createFutureForFile(std::string path) {
+static std::future<OpenedFile> createFutureForFile(std::string path) {
 #if _WIN64
   // On Windows, file I/O is relatively slow so it is best to do this
   // asynchronously.  But 32-bit has issues with potentially launching tons
@@ -143,8 +168,11 @@ static std::future<MBErrPair> createFutureForFile(std::string path) {
     auto mbOrErr = MemoryBuffer::getFile(path, /*IsText=*/false,
                                          /*RequiresNullTerminator=*/false);
     if (!mbOrErr)
-      return MBErrPair{nullptr, mbOrErr.getError()};
-    return MBErrPair{std::move(*mbOrErr), std::error_code()};
+      return OpenedFile{nullptr, mbOrErr.getError(), nullptr};
+    std::unique_ptr<MemoryBuffer> mb = std::move(*mbOrErr);
+    std::unique_ptr<llvm::object::Binary> bin =
+        maybePreparseBinary(mb->getMemBufferRef());
+    return OpenedFile{std::move(mb), std::error_code(), std::move(bin)};
   });
 }
 
@@ -187,7 +215,8 @@ MemoryBufferRef LinkerDriver::takeBuffer(std::unique_ptr<MemoryBuffer> mb) {
 }
 
 void LinkerDriver::addBuffer(std::unique_ptr<MemoryBuffer> mb,
-                             bool wholeArchive, bool lazy) {
+                             bool wholeArchive, bool lazy,
+                             std::unique_ptr<llvm::object::Binary> bin) {
   StringRef filename = mb->getBufferIdentifier();
 
   MemoryBufferRef mbref = takeBuffer(std::move(mb));
@@ -216,9 +245,13 @@ void LinkerDriver::addBuffer(std::unique_ptr<MemoryBuffer> mb,
     ctx.symtab.addFile(make<BitcodeFile>(ctx, mbref, "", 0, lazy));
     break;
   case file_magic::coff_object:
-  case file_magic::coff_import_library:
-    ctx.symtab.addFile(make<ObjFile>(ctx, mbref, lazy));
+  case file_magic::coff_import_library: {
+    auto *obj = make<ObjFile>(ctx, mbref, lazy);
+    if (bin)
+      obj->adoptPreparsedBinary(std::move(bin));
+    ctx.symtab.addFile(obj);
     break;
+  }
   case file_magic::pdb:
     ctx.symtab.addFile(make<PDBInputFile>(ctx, mbref));
     break;
@@ -243,12 +276,12 @@ void LinkerDriver::addBuffer(std::unique_ptr<MemoryBuffer> mb,
 }
 
 void LinkerDriver::enqueuePath(StringRef path, bool wholeArchive, bool lazy) {
-  auto future = std::make_shared<std::future<MBErrPair>>(
+  auto future = std::make_shared<std::future<OpenedFile>>(
       createFutureForFile(std::string(path)));
   std::string pathStr = std::string(path);
   enqueueTask([=]() {
     llvm::TimeTraceScope timeScope("File: ", path);
-    auto [mb, ec] = future->get();
+    auto [mb, ec, preparsed] = future->get();
     if (ec) {
       // Retry reading the file (synchronously) now that we may have added
       // winsysroot search paths from SymbolTable::addFile().
@@ -281,13 +314,15 @@ void LinkerDriver::enqueuePath(StringRef path, bool wholeArchive, bool lazy) {
       else
         error(msg + "; did you mean '" + nearest + "'");
     } else
-      ctx.driver.addBuffer(std::move(mb), wholeArchive, lazy);
+      ctx.driver.addBuffer(std::move(mb), wholeArchive, lazy,
+                           std::move(preparsed));
   });
 }
 
 void LinkerDriver::addArchiveBuffer(MemoryBufferRef mb, StringRef symName,
                                     StringRef parentName,
-                                    uint64_t offsetInArchive) {
+                                    uint64_t offsetInArchive,
+                                    std::unique_ptr<llvm::object::Binary> bin) {
   file_magic magic = identify_magic(mb.getBuffer());
   if (magic == file_magic::coff_import_library) {
     InputFile *imp = make<ImportFile>(ctx, mb);
@@ -298,7 +333,10 @@ void LinkerDriver::addArchiveBuffer(MemoryBufferRef mb, StringRef symName,
 
   InputFile *obj;
   if (magic == file_magic::coff_object) {
-    obj = make<ObjFile>(ctx, mb);
+    auto *objFile = make<ObjFile>(ctx, mb);
+    if (bin)
+      objFile->adoptPreparsedBinary(std::move(bin));
+    obj = objFile;
   } else if (magic == file_magic::bitcode) {
     obj =
         make<BitcodeFile>(ctx, mb, parentName, offsetInArchive, /*lazy=*/false);
@@ -345,18 +383,18 @@ void LinkerDriver::enqueueArchiveMember(const Archive::Child &c,
             "could not get the filename for the member defining symbol " +
                 toCOFFString(ctx, sym));
   auto future =
-      std::make_shared<std::future<MBErrPair>>(createFutureForFile(childName));
+      std::make_shared<std::future<OpenedFile>>(createFutureForFile(childName));
   enqueueTask([=]() {
-    auto mbOrErr = future->get();
-    if (mbOrErr.second)
-      reportBufferError(errorCodeToError(mbOrErr.second), childName);
+    auto file = future->get();
+    if (file.ec)
+      reportBufferError(errorCodeToError(file.ec), childName);
     llvm::TimeTraceScope timeScope("Archive: ",
-                                   mbOrErr.first->getBufferIdentifier());
+                                   file.mb->getBufferIdentifier());
     // Pass empty string as archive name so that the original filename is
     // used as the buffer identifier.
-    ctx.driver.addArchiveBuffer(takeBuffer(std::move(mbOrErr.first)),
+    ctx.driver.addArchiveBuffer(takeBuffer(std::move(file.mb)),
                                 toCOFFString(ctx, sym), "",
-                                /*OffsetInArchive=*/0);
+                                /*OffsetInArchive=*/0, std::move(file.preparsed));
   });
 }
 
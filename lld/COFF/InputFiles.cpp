@@ -134,10 +134,24 @@ std::vector<MemoryBufferRef> lld::coff::getArchiveMembers(Archive *file) {
   return v;
 }
 
+// Adopt a Binary that was created from our buffer ahead of time on a worker
+// thread, so that parse() and parseLazy() do not have to re-parse it. A Binary
+// of an unexpected type is ignored; parse() then recreates it and reports the
+// mismatch with the usual diagnostics.
+void ObjFile::adoptPreparsedBinary(std::unique_ptr<Binary> bin) {
+  if (isa<COFFObjectFile>(bin.get())) {
+    coffObj.reset(cast<COFFObjectFile>(bin.release()));
+  }
+}
+
 void ObjFile::parseLazy() {
   // Native object file.
-  std::unique_ptr<Binary> coffObjPtr = CHECK(createBinary(mb), this);
-  COFFObjectFile *coffObj = cast<COFFObjectFile>(coffObjPtr.get());
+  std::unique_ptr<Binary> coffObjPtr;
+  COFFObjectFile *coffObj = this->coffObj.get();
+  if (!coffObj) {
+    coffObjPtr = CHECK(createBinary(mb), this);
+    coffObj = cast<COFFObjectFile>(coffObjPtr.get());
+  }
   uint32_t numSymbols = coffObj->getNumberOfSymbols();
   for (uint32_t i = 0; i < numSymbols; ++i) {
     COFFSymbolRef coffSym = check(coffObj->getSymbol(i));
@@ -153,14 +167,16 @@ void ObjFile::parseLazy() {
 }
 
 void ObjFile::parse() {
-  // Parse a memory buffer as a COFF file.
-  std::unique_ptr<Binary> bin = CHECK(createBinary(mb), this);
+  if (!coffObj) {
+    // Parse a memory buffer as a COFF file.
+    std::unique_ptr<Binary> bin = CHECK(createBinary(mb), this);
 
-  if (auto *obj = dyn_cast<COFFObjectFile>(bin.get())) {
-    bin.release();
-    coffObj.reset(obj);
-  } else {
-    fatal(toString(this) + " is not a COFF file");
+    if (auto *obj = dyn_cast<COFFObjectFile>(bin.get())) {
+      bin.release();
+      coffObj.reset(obj);
+    } else {
+      fatal(toString(this) + " is not a COFF file");
+    }
   }
 
   // Read section and symbol tables.
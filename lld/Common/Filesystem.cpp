@@ -17,8 +17,10 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Parallel.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/Process.h"
 #include "llvm/Support/TimeProfiler.h"
 #if LLVM_ON_UNIX
+#include <sys/mman.h>
 #include <unistd.h>
 #endif
 #include <thread>
@@ -110,6 +112,28 @@ void lld::unlinkAsync(StringRef path) {
 #endif
 }
 
+// Hint the OS to start writing the given mapped output pages back to disk
+// without waiting for the writeback to finish. This is a best-effort
+// overlap of disk flushing with the work that still runs between section
+// writing and FileOutputBuffer::commit() (build id hashing, addend
+// checks). It matters most on filesystems where closing the output blocks
+// until every dirty page is flushed, such as NFS. Passing a region that is
+// not a file mapping (e.g. an in-memory output buffer) is harmless; the
+// call simply fails and the pages are written at commit time as before.
+void lld::flushPagesAsync(const void *start, size_t size) {
+#if LLVM_ON_UNIX
+  // msync() requires a page-aligned address.
+  uintptr_t addr = reinterpret_cast<uintptr_t>(start);
+  uintptr_t pageMask = static_cast<uintptr_t>(sys::Process::getPageSizeEstimate()) - 1;
+  uintptr_t alignedAddr = addr & ~pageMask;
+  (void)msync(reinterpret_cast<void *>(alignedAddr), size + (addr - alignedAddr),
+              MS_ASYNC);
+#else
+  (void)start;
+  (void)size;
+#endif
+}
+
 // Simulate file creation to see if Path is writable.
 //
 // Determining whether a file is writable or not is amazingly hard,
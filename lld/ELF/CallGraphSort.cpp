@@ -27,7 +27,10 @@
 #include "InputFiles.h"
 #include "InputSection.h"
 #include "Symbols.h"
+#include "llvm/Support/Endian.h"
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/xxhash.h"
 #include "llvm/Transforms/Utils/CodeLayout.h"
 
 #include <numeric>
@@ -332,12 +335,162 @@ DenseMap<const InputSectionBase *, int> elf::computeCacheDirectedSortOrder() {
   return orderMap;
 }
 
+// A persistent cache of the computed section order, enabled by
+// --call-graph-profile-cache. Production links typically rerun with an
+// identical (or nearly identical) profile and section list, and the ordering
+// algorithms above are pure functions of those inputs, so the order from the
+// previous link can be reused instead of being recomputed. Sections are
+// identified across runs by a hash of their file and section names. An exact
+// profile match reproduces the cached order; a small amount of churn keeps the
+// cached ranks for known sections and appends the rest.
+namespace {
+struct CallGraphCacheHeader {
+  char magic[4];
+  llvm::support::ulittle32_t version;
+  llvm::support::ulittle32_t sortKind;
+  llvm::support::ulittle64_t profileHash;
+  llvm::support::ulittle64_t numSections;
+};
+} // namespace
+
+static constexpr char cacheMagic[4] = {'C', 'G', 'P', 'C'};
+static constexpr uint32_t cacheVersion = 1;
+
+static uint64_t getSectionId(const InputSectionBase *sec) {
+  SmallString<128> buf;
+  if (sec->file)
+    buf += sec->file->getName();
+  buf.push_back('\0');
+  buf += sec->name;
+  return xxh3_64bits(buf);
+}
+
+static uint64_t getProfileHash() {
+  SmallVector<uint64_t, 0> words;
+  words.reserve(config->callGraphProfile.size() * 3);
+  for (std::pair<SectionPair, uint64_t> &c : config->callGraphProfile) {
+    words.push_back(getSectionId(c.first.first));
+    words.push_back(getSectionId(c.first.second));
+    words.push_back(c.second);
+  }
+  return xxh3_64bits(ArrayRef(reinterpret_cast<uint8_t *>(words.data()),
+                              words.size() * sizeof(uint64_t)));
+}
+
+// Return the deduplicated endpoints of profile edges, applying the same
+// same-output-section filter as the ordering algorithms.
+static SmallVector<const InputSectionBase *, 0> getProfiledSections() {
+  SmallVector<const InputSectionBase *, 0> secs;
+  DenseSet<const InputSectionBase *> seen;
+  for (std::pair<SectionPair, uint64_t> &c : config->callGraphProfile) {
+    if (c.first.first->getOutputSection() != c.first.second->getOutputSection())
+      continue;
+    if (seen.insert(c.first.first).second)
+      secs.push_back(c.first.first);
+    if (seen.insert(c.first.second).second)
+      secs.push_back(c.first.second);
+  }
+  return secs;
+}
+
+static std::optional<DenseMap<const InputSectionBase *, int>>
+tryLoadCachedOrder(uint64_t profileHash) {
+  auto mbOrErr = MemoryBuffer::getFile(config->callGraphProfileCache);
+  if (!mbOrErr)
+    return std::nullopt;
+  StringRef data = (*mbOrErr)->getBuffer();
+  if (data.size() < sizeof(CallGraphCacheHeader))
+    return std::nullopt;
+  auto *hdr = reinterpret_cast<const CallGraphCacheHeader *>(data.data());
+  if (memcmp(hdr->magic, cacheMagic, sizeof(cacheMagic)) != 0 ||
+      hdr->version != cacheVersion ||
+      hdr->sortKind != uint32_t(config->callGraphProfileSort) ||
+      data.size() !=
+          sizeof(CallGraphCacheHeader) + hdr->numSections * sizeof(uint64_t))
+    return std::nullopt;
+  auto *ids = reinterpret_cast<const llvm::support::ulittle64_t *>(
+      data.data() + sizeof(CallGraphCacheHeader));
+
+  DenseMap<uint64_t, int> rankForId;
+  rankForId.reserve(hdr->numSections);
+  for (uint64_t i = 0; i != hdr->numSections; ++i)
+    rankForId.try_emplace(ids[i], i + 1);
+
+  SmallVector<const InputSectionBase *, 0> secs = getProfiledSections();
+  DenseMap<const InputSectionBase *, int> orderMap;
+  SmallVector<const InputSectionBase *, 0> unknown;
+  for (const InputSectionBase *sec : secs) {
+    auto it = rankForId.find(getSectionId(sec));
+    if (it == rankForId.end())
+      unknown.push_back(sec);
+    else
+      orderMap[sec] = it->second;
+  }
+
+  // If the profile changed, tolerate a small diff: keep the cached ranks for
+  // known sections and place unknown ones after the cached layout, but
+  // recompute once the diff is large enough that the stale clustering likely
+  // no longer reflects the profile.
+  if (hdr->profileHash != profileHash && unknown.size() * 16 > secs.size())
+    return std::nullopt;
+  int next = hdr->numSections + 1;
+  for (const InputSectionBase *sec : unknown)
+    orderMap[sec] = next++;
+  return orderMap;
+}
+
+static void
+writeCachedOrder(uint64_t profileHash,
+                 const DenseMap<const InputSectionBase *, int> &orderMap) {
+  // Both ordering algorithms assign dense ranks starting at 1; serialize the
+  // section ids in rank order.
+  SmallVector<llvm::support::ulittle64_t, 0> ids(orderMap.size());
+  for (auto &[sec, rank] : orderMap) {
+    if (rank < 1 || size_t(rank) > ids.size())
+      return;
+    ids[rank - 1] = getSectionId(sec);
+  }
+
+  std::error_code ec;
+  raw_fd_ostream os(config->callGraphProfileCache, ec, sys::fs::OF_None);
+  if (ec) {
+    warn("--call-graph-profile-cache: cannot write " +
+         config->callGraphProfileCache + ": " + ec.message());
+    return;
+  }
+  CallGraphCacheHeader hdr = {};
+  memcpy(hdr.magic, cacheMagic, sizeof(cacheMagic));
+  hdr.version = cacheVersion;
+  hdr.sortKind = uint32_t(config->callGraphProfileSort);
+  hdr.profileHash = profileHash;
+  hdr.numSections = ids.size();
+  os.write(reinterpret_cast<const char *>(&hdr), sizeof(hdr));
+  os.write(reinterpret_cast<const char *>(ids.data()),
+           ids.size() * sizeof(uint64_t));
+}
+
 // Sort sections by the profile data provided by --callgraph-profile-file.
 //
 // This first builds a call graph based on the profile data then merges sections
 // according either to the C³ or Cache-Directed-Sort ordering algorithm.
 DenseMap<const InputSectionBase *, int> elf::computeCallGraphProfileOrder() {
-  if (config->callGraphProfileSort == CGProfileSortKind::Cdsort)
-    return computeCacheDirectedSortOrder();
-  return CallGraphSort().run();
+  // The cache cannot serve --print-symbol-order, which is produced while
+  // running the clustering.
+  bool useCache = !config->callGraphProfileCache.empty() &&
+                  config->printSymbolOrder.empty();
+  uint64_t profileHash = 0;
+  if (useCache) {
+    profileHash = getProfileHash();
+    if (std::optional<DenseMap<const InputSectionBase *, int>> orderMap =
+            tryLoadCachedOrder(profileHash))
+      return std::move(*orderMap);
+  }
+
+  DenseMap<const InputSectionBase *, int> orderMap =
+      config->callGraphProfileSort == CGProfileSortKind::Cdsort
+          ? computeCacheDirectedSortOrder()
+          : CallGraphSort().run();
+  if (useCache)
+    writeCachedOrder(profileHash, orderMap);
+  return orderMap;
 }
@@ -11,6 +11,7 @@
 
 #include "lld/Common/ErrorHandler.h"
 #include "llvm/ADT/CachedHashString.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/MapVector.h"
 #include "llvm/ADT/SetVector.h"
@@ -26,10 +27,12 @@
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/GlobPattern.h"
+#include "llvm/Support/MemoryBufferRef.h"
 #include "llvm/Support/PrettyStackTrace.h"
 #include <atomic>
 #include <memory>
 #include <optional>
+#include <tuple>
 #include <vector>
 
 namespace lld::elf {
@@ -140,8 +143,28 @@ private:
   std::vector<InputFile *> files;
   std::optional<InputFile *> armCmseImpLib;
 
+  // State for --incremental. stampHash combines the version, command line and
+  // input file hashes; it is computed once per link and recorded in a sidecar
+  // stamp file next to the output on success.
+  uint64_t stampHash = 0;
+  void computeStampHash(llvm::opt::InputArgList &args);
+  bool isLinkUpToDate() const;
+  void writeLinkStamp() const;
+
+  // Maps the identity (device, inode, size, mtime) of a thin archive member
+  // to its mapped buffer, so that a file referenced from several thin
+  // archives is mapped exactly once.
+  llvm::DenseMap<std::tuple<uint64_t, uint64_t, uint64_t, int64_t>,
+                 MemoryBufferRef>
+      thinBufferPool;
+
 public:
+  MemoryBufferRef readThinArchiveMember(StringRef path);
+
   SmallVector<std::pair<StringRef, unsigned>, 0> archiveFiles;
+  // Hashes of the paths and contents of every file read so far, in read
+  // order. Only populated with --incremental.
+  SmallVector<uint64_t, 0> inputFileHashes;
 };
 
 // This struct contains the global configuration for the linker.
@@ -176,6 +199,7 @@ struct Config {
   llvm::StringRef optRemarksFormat;
   llvm::StringRef optStatsFilename;
   llvm::StringRef progName;
+  llvm::StringRef callGraphProfileCache;
   llvm::StringRef printArchiveStats;
   llvm::StringRef printSymbolOrder;
   llvm::StringRef soName;
@@ -245,6 +269,7 @@ struct Config {
   bool hasDynSymTab;
   bool ignoreDataAddressEquality;
   bool ignoreFunctionAddressEquality;
+  bool incremental;
   bool ltoCSProfileGenerate;
   bool ltoPGOWarnMismatch;
   bool ltoDebugPassManager;
@@ -25,6 +25,25 @@ using namespace llvm::object;
 using namespace lld;
 using namespace lld::elf;
 
+// Return the decompressed contents of sec. Compressed sections are
+// decompressed into buffers owned by this object instead of via
+// contentMaybeDecompress, which would cache the decompressed bytes on the
+// section for the rest of the link. This keeps peak RSS bounded when building
+// .gdb_index or diagnostics over compressed debug info: the decompressed data
+// lives only as long as the (typically per-file, transient) DWARF context,
+// and the sections stay compressed so that the write phase still decompresses
+// them directly into the output buffer.
+template <class ELFT>
+StringRef LLDDwarfObj<ELFT>::sectionData(InputSectionBase *sec) {
+  if (!sec->compressed)
+    return toStringRef(sec->content());
+  auto buf = std::make_unique<uint8_t[]>(sec->size);
+  sec->decompressInto(buf.get());
+  StringRef ret(reinterpret_cast<const char *>(buf.get()), sec->size);
+  uncompressedBufs.push_back(std::move(buf));
+  return ret;
+}
+
 template <class ELFT> LLDDwarfObj<ELFT>::LLDDwarfObj(ObjFile<ELFT> *obj) {
   // Get the ELF sections to retrieve sh_flags. See the SHF_GROUP comment below.
   ArrayRef<typename ELFT::Shdr> objSections = obj->template getELFShdrs<ELFT>();
@@ -44,17 +63,17 @@ template <class ELFT> LLDDwarfObj<ELFT>::LLDDwarfObj(ObjFile<ELFT> *obj) {
                 .Case(".debug_str_offsets", &strOffsetsSection)
                 .Case(".debug_line", &lineSection)
                 .Default(nullptr)) {
-      m->Data = toStringRef(sec->contentMaybeDecompress());
+      m->Data = sectionData(sec);
       m->sec = sec;
       continue;
     }
 
     if (sec->name == ".debug_abbrev")
-      abbrevSection = toStringRef(sec->contentMaybeDecompress());
+      abbrevSection = sectionData(sec);
     else if (sec->name == ".debug_str")
-      strSection = toStringRef(sec->contentMaybeDecompress());
+      strSection = sectionData(sec);
     else if (sec->name == ".debug_line_str")
-      lineStrSection = toStringRef(sec->contentMaybeDecompress());
+      lineStrSection = sectionData(sec);
     else if (sec->name == ".debug_info" &&
              !(objSections[i].sh_flags & ELF::SHF_GROUP)) {
       // In DWARF v5, -fdebug-types-section places type units in .debug_info
@@ -66,7 +85,7 @@ template <class ELFT> LLDDwarfObj<ELFT>::LLDDwarfObj(ObjFile<ELFT> *obj) {
       // need to perform a lightweight parsing. We drop the SHF_GROUP flag when
       // the InputSection was created, so we need to retrieve sh_flags from the
       // associated ELF section header.
-      infoSection.Data = toStringRef(sec->contentMaybeDecompress());
+      infoSection.Data = sectionData(sec);
       infoSection.sec = sec;
     }
   }
@@ -13,6 +13,7 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/DebugInfo/DWARF/DWARFContext.h"
 #include "llvm/Object/ELF.h"
+#include <memory>
 #include <optional>
 
 namespace lld::elf {
@@ -86,6 +87,12 @@ private:
                                               uint64_t pos,
                                               ArrayRef<RelTy> rels) const;
 
+  StringRef sectionData(InputSectionBase *sec);
+
+  // Decompressed contents of compressed input sections, owned by this object
+  // rather than cached on the sections themselves. See sectionData().
+  SmallVector<std::unique_ptr<uint8_t[]>, 0> uncompressedBufs;
+
   LLDDWARFSection gnuPubnamesSection;
   LLDDWARFSection gnuPubtypesSection;
   LLDDWARFSection infoSection;
@@ -56,6 +56,7 @@
 #include "llvm/Remarks/HotnessThresholdParser.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Compression.h"
+#include "llvm/Support/Endian.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/GlobPattern.h"
 #include "llvm/Support/LEB128.h"
@@ -65,6 +66,8 @@
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
+#include <chrono>
 #include <cstdlib>
 #include <tuple>
 #include <utility>
@@ -210,6 +213,45 @@ static std::tuple<ELFKind, uint16_t, uint8_t> parseEmulation(StringRef emul) {
   return std::make_tuple(ret.first, ret.second, osabi);
 }
 
+// Open and map a thin archive member, returning the mapping made when the
+// same underlying file was loaded before. Build graphs commonly reference one
+// object file from many thin archives; keying on the file identity rather
+// than the (possibly differently spelled) path maps each unique file exactly
+// once instead of once per referencing archive.
+MemoryBufferRef LinkerDriver::readThinArchiveMember(StringRef path) {
+  using namespace sys::fs;
+
+  file_status status;
+  std::tuple<uint64_t, uint64_t, uint64_t, int64_t> key;
+  bool haveKey = !sys::fs::status(path, status);
+  if (haveKey) {
+    key = {status.getUniqueID().getDevice(), status.getUniqueID().getFile(),
+           status.getSize(),
+           status.getLastModificationTime().time_since_epoch().count()};
+    auto it = thinBufferPool.find(key);
+    if (it != thinBufferPool.end())
+      return it->second;
+  }
+
+  auto mbOrErr = MemoryBuffer::getFile(path, /*IsText=*/false,
+                                       /*RequiresNullTerminator=*/false);
+  if (auto ec = mbOrErr.getError())
+    fatal(path + ": could not load thin archive member: " + ec.message());
+  MemoryBufferRef mbref = (*mbOrErr)->getMemBufferRef();
+  ctx.memoryBuffers.push_back(std::move(*mbOrErr)); // take MB ownership
+
+  // Members loaded through the archive bypass elf::readFile, so hash them
+  // here to keep the --incremental stamp sensitive to their contents.
+  if (config->incremental) {
+    inputFileHashes.push_back(xxh3_64bits(path));
+    inputFileHashes.push_back(xxh3_64bits(mbref.getBuffer()));
+  }
+
+  if (haveKey)
+    thinBufferPool.try_emplace(key, mbref);
+  return mbref;
+}
+
 // Returns slices of MB by parsing MB as an archive file.
 // Each slice consists of a member file in the archive.
 std::vector<std::pair<MemoryBufferRef, uint64_t>> static getArchiveMembers(
@@ -220,14 +262,26 @@ std::vector<std::pair<MemoryBufferRef, uint64_t>> static getArchiveMembers(
 
   std::vector<std::pair<MemoryBufferRef, uint64_t>> v;
   Error err = Error::success();
-  bool addToTar = file->isThin() && tar;
+  bool isThin = file->isThin();
   for (const Archive::Child &c : file->children(err)) {
-    MemoryBufferRef mbref =
-        CHECK(c.getMemoryBufferRef(),
-              mb.getBufferIdentifier() +
-                  ": could not get the buffer for a child of the archive");
-    if (addToTar)
-      tar->append(relativeToRoot(check(c.getFullName())), mbref.getBuffer());
+    MemoryBufferRef mbref;
+    if (isThin) {
+      // Map the member file ourselves instead of letting Archive do it, so
+      // that a file referenced from several thin archives is mapped only
+      // once.
+      std::string fullName =
+          CHECK(c.getFullName(),
+                mb.getBufferIdentifier() +
+                    ": could not get the name of a child of the archive");
+      mbref = ctx.driver.readThinArchiveMember(fullName);
+      if (tar)
+        tar->append(relativeToRoot(fullName), mbref.getBuffer());
+    } else {
+      mbref =
+          CHECK(c.getMemoryBufferRef(),
+                mb.getBufferIdentifier() +
+                    ": could not get the buffer for a child of the archive");
+    }
     v.push_back(std::make_pair(mbref, c.getChildOffset()));
   }
   if (err)
@@ -1241,6 +1295,8 @@ static void readConfigs(opt::InputArgList &args) {
       config->bsymbolic = BsymbolicKind::All;
   }
   config->callGraphProfileSort = getCGProfileSortKind(args);
+  config->callGraphProfileCache =
+      args.getLastArgValue(OPT_call_graph_profile_cache);
   config->checkSections =
       args.hasFlag(OPT_check_sections, OPT_no_check_sections, true);
   config->chroot = args.getLastArgValue(OPT_chroot);
@@ -1292,6 +1348,8 @@ static void readConfigs(opt::InputArgList &args) {
       args.hasArg(OPT_ignore_data_address_equality);
   config->ignoreFunctionAddressEquality =
       args.hasArg(OPT_ignore_function_address_equality);
+  config->incremental =
+      args.hasFlag(OPT_incremental, OPT_no_incremental, false);
   config->init = args.getLastArgValue(OPT_init, "_init");
   config->ltoAAPipeline = args.getLastArgValue(OPT_lto_aa_pipeline);
   config->ltoCSProfileGenerate = args.hasArg(OPT_lto_cs_profile_generate);
@@ -1662,6 +1720,10 @@ static void readConfigs(opt::InputArgList &args) {
     config->zRelro = false;
 
   std::tie(config->buildId, config->buildIdVector) = getBuildId(args);
+  if (config->incremental && config->buildId == BuildIdKind::Uuid) {
+    warn("--incremental is ignored with --build-id=uuid");
+    config->incremental = false;
+  }
 
   if (getZFlag(args, "pack-relative-relocs", "nopack-relative-relocs", false)) {
     config->relrGlibc = true;
@@ -2677,6 +2739,91 @@ static void postParseObjectFile(ELFFileBase *file) {
   }
 }
 
+namespace {
+// On-disk record of a previous --incremental link, stored in a sidecar file
+// next to the output. The link is skipped when the combined input hash
+// matches and the output file is the unmodified product of the run that
+// wrote the stamp.
+struct LinkStamp {
+  char magic[4];
+  llvm::support::ulittle32_t version;
+  llvm::support::ulittle64_t stampHash;
+  llvm::support::ulittle64_t outputSize;
+  llvm::support::ulittle64_t outputMTime;
+};
+} // namespace
+
+static constexpr char linkStampMagic[4] = {'L', 'S', 'T', 'P'};
+static constexpr uint32_t linkStampVersion = 1;
+
+static std::string getLinkStampPath() {
+  return (config->outputFile + ".lld-incremental").str();
+}
+
+static uint64_t getMTime(const sys::fs::file_status &status) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             status.getLastModificationTime().time_since_epoch())
+      .count();
+}
+
+// Combine everything that determines the output into a single hash: the
+// linker version, the command line, and the path and content hashes of every
+// file read so far. All input files (including ones added by autolinking and
+// the scripts read by readConfigs) have gone through elf::readFile by the
+// time this is called; the few files that are not read until later in the
+// link are hashed here explicitly.
+void LinkerDriver::computeStampHash(opt::InputArgList &args) {
+  SmallVector<uint64_t, 0> words;
+  words.push_back(xxh3_64bits(getLLDVersion()));
+  for (auto *arg : args)
+    words.push_back(xxh3_64bits(arg->getAsString(args)));
+  for (auto opt : {OPT_call_graph_ordering_file, OPT_lto_cs_profile_file,
+                   OPT_lto_sample_profile})
+    if (auto *arg = args.getLastArg(opt))
+      if (auto mb = MemoryBuffer::getFile(arg->getValue()))
+        words.push_back(xxh3_64bits((*mb)->getBuffer()));
+  words.append(inputFileHashes.begin(), inputFileHashes.end());
+  stampHash = xxh3_64bits(ArrayRef<uint8_t>(
+      reinterpret_cast<const uint8_t *>(words.data()), words.size() * 8));
+}
+
+bool LinkerDriver::isLinkUpToDate() const {
+  auto mb = MemoryBuffer::getFile(getLinkStampPath());
+  if (!mb)
+    return false;
+  StringRef data = (*mb)->getBuffer();
+  if (data.size() != sizeof(LinkStamp))
+    return false;
+  LinkStamp stamp;
+  memcpy(&stamp, data.data(), sizeof(stamp));
+  if (memcmp(stamp.magic, linkStampMagic, sizeof(stamp.magic)) != 0 ||
+      stamp.version != linkStampVersion || stamp.stampHash != stampHash)
+    return false;
+  sys::fs::file_status status;
+  if (sys::fs::status(config->outputFile, status))
+    return false;
+  return stamp.outputSize == status.getSize() &&
+         stamp.outputMTime == getMTime(status);
+}
+
+void LinkerDriver::writeLinkStamp() const {
+  sys::fs::file_status status;
+  if (sys::fs::status(config->outputFile, status))
+    return;
+  LinkStamp stamp;
+  memcpy(stamp.magic, linkStampMagic, sizeof(stamp.magic));
+  stamp.version = linkStampVersion;
+  stamp.stampHash = stampHash;
+  stamp.outputSize = status.getSize();
+  stamp.outputMTime = getMTime(status);
+  // The stamp is advisory, so a failure to write it is not an error; the
+  // next run simply performs a full link.
+  std::error_code ec;
+  raw_fd_ostream os(getLinkStampPath(), ec, sys::fs::OF_None);
+  if (!ec)
+    os.write(reinterpret_cast<const char *>(&stamp), sizeof(stamp));
+}
+
 // Do actual linking. Note that when this function is called,
 // all linker scripts have already been parsed.
 void LinkerDriver::link(opt::InputArgList &args) {
@@ -2742,6 +2889,18 @@ void LinkerDriver::link(opt::InputArgList &args) {
       parseArmCMSEImportLib(*armCmseImpLib);
   }
 
+  // With --incremental, skip the rest of the link when nothing that went
+  // into the previous link has changed and its output is still intact. This
+  // is the restricted form of incremental linking: an up-to-date output is
+  // reused wholesale, and any change falls back to a normal full link.
+  if (config->incremental && config->outputFile != "-" && !errorCount()) {
+    computeStampHash(args);
+    if (isLinkUpToDate()) {
+      log("--incremental: " + config->outputFile + " is up to date");
+      return;
+    }
+  }
+
   // Now that we have every file, we can decide if we will need a
   // dynamic symbol table.
   // We need one if we were asked to export dynamic symbols or if we are
@@ -3071,4 +3230,9 @@ void LinkerDriver::link(opt::InputArgList &args) {
 
   // Write the result to the file.
   invokeELFT(writeResult,);
+
+  // Record the inputs of this link so that the next --incremental run can be
+  // skipped if nothing changes.
+  if (config->incremental && config->outputFile != "-" && errorCount() == 0)
+    writeLinkStamp();
 }
@@ -492,45 +492,66 @@ template <class ELFT> void ICF<ELFT>::run() {
   }
 
   // Initially, we use hash values to partition sections.
-  parallelForEach(sections, [&](InputSection *s) {
-    // Set MSB to 1 to avoid collisions with unique IDs.
-    s->eqClass[0] = xxh3_64bits(s->content()) | (1U << 31);
-  });
-
-  // Perform 2 rounds of relocation hash propagation. 2 is an empirical value to
-  // reduce the average sizes of equivalence classes, i.e. segregate() which has
-  // a large time complexity will have less work to do.
-  for (unsigned cnt = 0; cnt != 2; ++cnt) {
+  {
+    llvm::TimeTraceScope timeScope("ICF: hash contents");
     parallelForEach(sections, [&](InputSection *s) {
-      const RelsOrRelas<ELFT> rels = s->template relsOrRelas<ELFT>();
-      if (rels.areRelocsRel())
-        combineRelocHashes<ELFT>(cnt, s, rels.rels);
-      else
-        combineRelocHashes<ELFT>(cnt, s, rels.relas);
+      // Set MSB to 1 to avoid collisions with unique IDs.
+      s->eqClass[0] = xxh3_64bits(s->content()) | (1U << 31);
     });
+
+    // Perform 2 rounds of relocation hash propagation. 2 is an empirical
+    // value to reduce the average sizes of equivalence classes, i.e.
+    // segregate() which has a large time complexity will have less work to
+    // do.
+    for (unsigned cnt = 0; cnt != 2; ++cnt) {
+      parallelForEach(sections, [&](InputSection *s) {
+        const RelsOrRelas<ELFT> rels = s->template relsOrRelas<ELFT>();
+        if (rels.areRelocsRel())
+          combineRelocHashes<ELFT>(cnt, s, rels.rels);
+        else
+          combineRelocHashes<ELFT>(cnt, s, rels.relas);
+      });
+    }
   }
 
   // From now on, sections in Sections vector are ordered so that sections
-  // in the same equivalence class are consecutive in the vector.
-  llvm::stable_sort(sections, [](const InputSection *a, const InputSection *b) {
-    return a->eqClass[0] < b->eqClass[0];
-  });
+  // in the same equivalence class are consecutive in the vector. Sorting by
+  // (class, current position) gives the same order as a stable sort while
+  // allowing the sort itself to run in parallel.
+  {
+    llvm::TimeTraceScope timeScope("ICF: sort sections");
+    SmallVector<std::pair<uint32_t, uint32_t>, 0> order(sections.size());
+    parallelFor(0, sections.size(), [&](size_t i) {
+      order[i] = {sections[i]->eqClass[0], static_cast<uint32_t>(i)};
+    });
+    parallelSort(order.begin(), order.end(), std::less<>());
+    SmallVector<InputSection *, 0> sorted(sections.size());
+    parallelFor(0, sections.size(),
+                [&](size_t i) { sorted[i] = sections[order[i].second]; });
+    sections = std::move(sorted);
+  }
 
   // Compare static contents and assign unique equivalence class IDs for each
   // static content. Use a base offset for these IDs to ensure no overlap with
   // the unique IDs already assigned.
   uint32_t eqClassBase = ++uniqueId;
-  forEachClass([&](size_t begin, size_t end) {
-    segregate(begin, end, eqClassBase, true);
-  });
-
-  // Split groups by comparing relocations until convergence is obtained.
-  do {
-    repeat = false;
+  {
+    llvm::TimeTraceScope timeScope("ICF: segregate by contents");
     forEachClass([&](size_t begin, size_t end) {
-      segregate(begin, end, eqClassBase, false);
+      segregate(begin, end, eqClassBase, true);
     });
-  } while (repeat);
+  }
+
+  // Split groups by comparing relocations until convergence is obtained.
+  {
+    llvm::TimeTraceScope timeScope("ICF: segregate by relocations");
+    do {
+      repeat = false;
+      forEachClass([&](size_t begin, size_t end) {
+        segregate(begin, end, eqClassBase, false);
+      });
+    } while (repeat);
+  }
 
   log("ICF needed " + Twine(cnt) + " iterations");
 
@@ -30,6 +30,7 @@
 #include "llvm/Support/RISCVAttributeParser.h"
 #include "llvm/Support/TarWriter.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/xxhash.h"
 #include <optional>
 
 using namespace llvm;
@@ -245,9 +246,19 @@ std::optional<MemoryBufferRef> elf::readFile(StringRef path) {
     return std::nullopt;
   }
 
+  // Input files are parsed front to back; tell the kernel so it can overlap
+  // readahead with parsing instead of taking demand faults page by page.
+  (*mbOrErr)->adviseSequentialIfMmap();
+  (*mbOrErr)->willNeedIfMmap();
+
   MemoryBufferRef mbref = (*mbOrErr)->getMemBufferRef();
   ctx.memoryBuffers.push_back(std::move(*mbOrErr)); // take MB ownership
 
+  if (config->incremental) {
+    ctx.driver.inputFileHashes.push_back(xxh3_64bits(path));
+    ctx.driver.inputFileHashes.push_back(xxh3_64bits(mbref.getBuffer()));
+  }
+
   if (tar)
     tar->append(relativeToRoot(path), mbref.getBuffer());
   return mbref;
@@ -120,6 +120,10 @@ static void decompressAux(const InputSectionBase &sec, uint8_t *out,
           ": decompress failed: " + llvm::toString(std::move(e)));
 }
 
+void InputSectionBase::decompressInto(uint8_t *buf) const {
+  invokeELFT(decompressAux, *this, buf, size);
+}
+
 void InputSectionBase::decompress() const {
   uint8_t *uncompressedBuf;
   {
@@ -128,7 +132,7 @@ void InputSectionBase::decompress() const {
     uncompressedBuf = bAlloc().Allocate<uint8_t>(size);
   }
 
-  invokeELFT(decompressAux, *this, uncompressedBuf, size);
+  decompressInto(uncompressedBuf);
   content_ = uncompressedBuf;
   compressed = false;
 }
@@ -1332,8 +1336,10 @@ void MergeInputSection::splitNonStrings(ArrayRef<uint8_t> data,
   const bool live = !(flags & SHF_ALLOC) || !config->gcSections;
 
   pieces.resize_for_overwrite(size / entSize);
+  SmallVector<uint64_t, 0> hashes(size / entSize);
+  xxh3_64bits_batch(data, entSize, hashes);
   for (size_t i = 0, j = 0; i != size; i += entSize, j++)
-    pieces[j] = {i, (uint32_t)xxh3_64bits(data.slice(i, entSize)), live};
+    pieces[j] = {i, (uint32_t)hashes[j], live};
 }
 
 template <class ELFT>
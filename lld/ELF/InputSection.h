@@ -175,6 +175,13 @@ public:
     return content();
   }
 
+  // Decompress a compressed section into buf, which must be at least size
+  // bytes. Unlike contentMaybeDecompress, this does not cache the decompressed
+  // contents. Use it when the contents are only needed transiently, so that
+  // the section stays compressed and the write phase can still decompress it
+  // directly into the output buffer.
+  void decompressInto(uint8_t *buf) const;
+
   // The next member in the section group if this section is in a group. This is
   // used by --gc-sections.
   InputSectionBase *nextInSectionGroup = nullptr;
@@ -31,6 +31,7 @@
 #include "lld/Common/Strings.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/Object/ELF.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/TimeProfiler.h"
 #include <vector>
 
@@ -51,11 +52,13 @@ public:
 
 private:
   void enqueue(InputSectionBase *sec, uint64_t offset);
+  void addToQueue(InputSectionBase *sec);
   void markSymbol(Symbol *sym);
   void mark();
 
   template <class RelTy>
-  void resolveReloc(InputSectionBase &sec, RelTy &rel, bool fromFDE);
+  void resolveReloc(InputSectionBase &sec, RelTy &rel, bool fromFDE,
+                    SmallVectorImpl<InputSectionBase *> *edges);
 
   template <class RelTy>
   void scanEhFrameSection(EhInputSection &eh, ArrayRef<RelTy> rels);
@@ -85,10 +88,17 @@ static uint64_t getAddend(InputSectionBase &sec,
   return rel.r_addend;
 }
 
+// Resolve the relocation target and mark it reachable. If edges is null, the
+// target is enqueued directly. Otherwise we are running on a worker thread:
+// piece liveness and symbol use are recorded right away (both are monotonic
+// single-bit transitions, so concurrent stores of the same value are benign),
+// but the partition update and the queue push are deferred to the main thread
+// via the edges vector to keep them race-free and deterministic.
 template <class ELFT>
 template <class RelTy>
 void MarkLive<ELFT>::resolveReloc(InputSectionBase &sec, RelTy &rel,
-                                  bool fromFDE) {
+                                  bool fromFDE,
+                                  SmallVectorImpl<InputSectionBase *> *edges) {
   Symbol &sym = sec.getFile<ELFT>()->getRelocTargetSym(rel);
 
   // If a symbol is referenced in a live section, it is used.
@@ -112,8 +122,19 @@ void MarkLive<ELFT>::resolveReloc(InputSectionBase &sec, RelTy &rel,
     // group/SHF_LINK_ORDER rules (b) if the associated text section should be
     // discarded, marking the LSDA will unnecessarily retain the text section.
     if (!(fromFDE && ((relSec->flags & (SHF_EXECINSTR | SHF_LINK_ORDER)) ||
-                      relSec->nextInSectionGroup)))
-      enqueue(relSec, offset);
+                      relSec->nextInSectionGroup))) {
+      if (!edges) {
+        enqueue(relSec, offset);
+      } else {
+        // Do the piece binary search on the worker; it dominates the cost of
+        // string-heavy links. Reading a possibly stale partition here is fine:
+        // it can only cause a redundant edge, which addToQueue dedups.
+        if (auto *ms = dyn_cast<MergeInputSection>(relSec))
+          ms->getSectionPiece(offset).live = true;
+        if (relSec->partition != 1)
+          edges->push_back(relSec);
+      }
+    }
     return;
   }
 
@@ -121,8 +142,16 @@ void MarkLive<ELFT>::resolveReloc(InputSectionBase &sec, RelTy &rel,
     if (!ss->isWeak())
       cast<SharedFile>(ss->file)->isNeeded = true;
 
-  for (InputSectionBase *sec : cNamedSections.lookup(sym.getName()))
-    enqueue(sec, 0);
+  for (InputSectionBase *named : cNamedSections.lookup(sym.getName())) {
+    if (!edges) {
+      enqueue(named, 0);
+    } else {
+      if (auto *ms = dyn_cast<MergeInputSection>(named))
+        ms->getSectionPiece(0).live = true;
+      if (named->partition != 1)
+        edges->push_back(named);
+    }
+  }
 }
 
 // The .eh_frame section is an unfortunate special case.
@@ -145,7 +174,7 @@ void MarkLive<ELFT>::scanEhFrameSection(EhInputSection &eh,
                                         ArrayRef<RelTy> rels) {
   for (const EhSectionPiece &cie : eh.cies)
     if (cie.firstRelocation != unsigned(-1))
-      resolveReloc(eh, rels[cie.firstRelocation], false);
+      resolveReloc(eh, rels[cie.firstRelocation], false, nullptr);
   for (const EhSectionPiece &fde : eh.fdes) {
     size_t firstRelI = fde.firstRelocation;
     if (firstRelI == (unsigned)-1)
@@ -153,7 +182,7 @@ void MarkLive<ELFT>::scanEhFrameSection(EhInputSection &eh,
     uint64_t pieceEnd = fde.inputOff + fde.size;
     for (size_t j = firstRelI, end2 = rels.size();
          j < end2 && rels[j].r_offset < pieceEnd; ++j)
-      resolveReloc(eh, rels[j], true);
+      resolveReloc(eh, rels[j], true, nullptr);
   }
 }
 
@@ -187,6 +216,10 @@ void MarkLive<ELFT>::enqueue(InputSectionBase *sec, uint64_t offset) {
   if (auto *ms = dyn_cast<MergeInputSection>(sec))
     ms->getSectionPiece(offset).live = true;
 
+  addToQueue(sec);
+}
+
+template <class ELFT> void MarkLive<ELFT>::addToQueue(InputSectionBase *sec) {
   // Set Sec->Partition to the meet (i.e. the "minimum") of Partition and
   // Sec->Partition in the following lattice: 1 < other < 0. If Sec->Partition
   // doesn't change, we don't need to do anything.
@@ -303,15 +336,61 @@ template <class ELFT> void MarkLive<ELFT>::run() {
 }
 
 template <class ELFT> void MarkLive<ELFT>::mark() {
+  // In the common single-partition case the partition field is a plain live
+  // bit and the reachable set is the least fixed point of a monotonic marking
+  // function, so it does not depend on the traversal order. That lets us
+  // expand each frontier of the walk in parallel: workers scan relocations and
+  // collect candidate target sections into per-chunk vectors, and the main
+  // thread then claims the candidates in deterministic chunk order, so every
+  // section is still scanned exactly once. With multiple partitions the
+  // partition meet is order-sensitive under races, so fall back to the serial
+  // walk; loadable partitions are rare and small.
+  if (partitions.size() == 1) {
+    constexpr size_t sectionsPerChunk = 256;
+    SmallVector<InputSection *, 0> frontier;
+    while (!queue.empty()) {
+      frontier = std::move(queue);
+      queue.clear();
+      size_t numChunks =
+          (frontier.size() + sectionsPerChunk - 1) / sectionsPerChunk;
+      SmallVector<SmallVector<InputSectionBase *, 0>, 0> edgeLists(numChunks);
+      parallelFor(0, numChunks, [&](size_t i) {
+        SmallVectorImpl<InputSectionBase *> &edges = edgeLists[i];
+        size_t begin = i * sectionsPerChunk;
+        for (InputSection *isec :
+             ArrayRef(frontier).slice(
+                 begin, std::min(sectionsPerChunk, frontier.size() - begin))) {
+          InputSectionBase &sec = *isec;
+          const RelsOrRelas<ELFT> rels = sec.template relsOrRelas<ELFT>();
+          for (const typename ELFT::Rel &rel : rels.rels)
+            resolveReloc(sec, rel, false, &edges);
+          for (const typename ELFT::Rela &rel : rels.relas)
+            resolveReloc(sec, rel, false, &edges);
+
+          for (InputSectionBase *dep : sec.dependentSections)
+            edges.push_back(dep);
+
+          // Mark the next group member.
+          if (sec.nextInSectionGroup)
+            edges.push_back(sec.nextInSectionGroup);
+        }
+      });
+      for (SmallVectorImpl<InputSectionBase *> &edges : edgeLists)
+        for (InputSectionBase *sec : edges)
+          addToQueue(sec);
+    }
+    return;
+  }
+
   // Mark all reachable sections.
   while (!queue.empty()) {
     InputSectionBase &sec = *queue.pop_back_val();
 
     const RelsOrRelas<ELFT> rels = sec.template relsOrRelas<ELFT>();
     for (const typename ELFT::Rel &rel : rels.rels)
-      resolveReloc(sec, rel, false);
+      resolveReloc(sec, rel, false, nullptr);
     for (const typename ELFT::Rela &rel : rels.relas)
-      resolveReloc(sec, rel, false);
+      resolveReloc(sec, rel, false, nullptr);
 
     for (InputSectionBase *isec : sec.dependentSections)
       enqueue(isec, 0);
@@ -1556,18 +1556,34 @@ template <class ELFT> void elf::scanRelocations() {
   // for parallelism.
   bool serial = !config->zCombreloc || config->emachine == EM_MIPS ||
                 config->emachine == EM_PPC64;
+
+  // Collect the sections to scan and spawn tasks over fixed-size slices
+  // rather than one task per input file. Section counts per file are very
+  // uneven (with full LTO most sections come from a single object file), so
+  // per-file tasks can degenerate to a serial scan. Slicing the flattened
+  // list keeps the workers balanced. In the serial case the slices are
+  // executed in spawn order, which visits sections in the same file order as
+  // before.
+  SmallVector<InputSectionBase *, 0> sections;
+  for (ELFFileBase *f : ctx.objectFiles)
+    for (InputSectionBase *s : f->getSections())
+      if (s && s->kind() == SectionBase::Regular && s->isLive() &&
+          (s->flags & SHF_ALLOC) &&
+          !(s->type == SHT_ARM_EXIDX && config->emachine == EM_ARM))
+        sections.push_back(s);
+
   parallel::TaskGroup tg;
-  for (ELFFileBase *f : ctx.objectFiles) {
-    auto fn = [f]() {
-      RelocationScanner scanner;
-      for (InputSectionBase *s : f->getSections()) {
-        if (s && s->kind() == SectionBase::Regular && s->isLive() &&
-            (s->flags & SHF_ALLOC) &&
-            !(s->type == SHT_ARM_EXIDX && config->emachine == EM_ARM))
-          scanner.template scanSection<ELFT>(*s);
-      }
-    };
-    tg.spawn(fn, serial);
+  constexpr size_t numSectionsPerTask = 256;
+  for (size_t i = 0, e = sections.size(); i != e; i += numSectionsPerTask) {
+    auto slice = ArrayRef<InputSectionBase *>(sections).slice(
+        i, std::min(numSectionsPerTask, e - i));
+    tg.spawn(
+        [slice]() {
+          RelocationScanner scanner;
+          for (InputSectionBase *s : slice)
+            scanner.template scanSection<ELFT>(*s);
+        },
+        serial);
   }
 
   tg.spawn([] {
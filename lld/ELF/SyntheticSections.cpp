@@ -39,6 +39,7 @@
 #include "llvm/Support/LEB128.h"
 #include "llvm/Support/Parallel.h"
 #include "llvm/Support/TimeProfiler.h"
+#include "llvm/Support/xxhash.h"
 #include <cstdlib>
 
 using namespace llvm;
@@ -3240,33 +3241,77 @@ void MergeSyntheticSection::addSection(MergeInputSection *ms) {
   addralign = std::max(addralign, ms->addralign);
 }
 
-MergeTailSection::MergeTailSection(StringRef name, uint32_t type,
-                                   uint64_t flags, uint32_t alignment)
-    : MergeSyntheticSection(name, type, flags, alignment),
-      builder(StringTableBuilder::RAW, llvm::Align(alignment)) {}
-
-size_t MergeTailSection::getSize() const { return builder.getSize(); }
+size_t MergeTailSection::getShardId(StringRef s) {
+  return xxh3_64bits(s.take_back(tailBytes)) & (numShards - 1);
+}
 
-void MergeTailSection::writeTo(uint8_t *buf) { builder.write(buf); }
+void MergeTailSection::writeTo(uint8_t *buf) {
+  parallelFor(0, numShards,
+              [&](size_t i) { shards[i].write(buf + shardOffsets[i]); });
+}
 
+// Like MergeNoTailSection::finalizeContents(), except that pieces are
+// sharded by a suffix hash instead of a whole-string hash so that tail
+// merging stays effective within each shard. Tail merging (a multikey sort
+// over all strings in StringTableBuilder::finalize()) dominates -O2 link
+// time on .debug_str-heavy inputs, and this way it runs once per shard, in
+// parallel, instead of once over the whole section.
 void MergeTailSection::finalizeContents() {
-  // Add all string pieces to the string table builder to create section
-  // contents.
-  for (MergeInputSection *sec : sections)
+  // Initializes string table builders.
+  for (size_t i = 0; i < numShards; ++i)
+    shards.emplace_back(StringTableBuilder::RAW, llvm::Align(addralign));
+
+  // Bucket the pieces. outputOff is dead until the last pass overwrites it,
+  // so use it to stash each piece's shard ID.
+  parallelForEach(sections, [](MergeInputSection *sec) {
     for (size_t i = 0, e = sec->pieces.size(); i != e; ++i)
       if (sec->pieces[i].live)
-        builder.add(sec->getData(i));
+        sec->pieces[i].outputOff = getShardId(sec->getData(i).val());
+  });
+
+  // Concurrency level. Must be a power of 2 to avoid expensive modulo
+  // operations in the following tight loop.
+  const size_t concurrency =
+      llvm::bit_floor(std::min<size_t>(config->threadCount, numShards));
+
+  // Add section pieces to the builders.
+  parallelFor(0, concurrency, [&](size_t threadId) {
+    for (MergeInputSection *sec : sections) {
+      for (size_t i = 0, e = sec->pieces.size(); i != e; ++i) {
+        if (!sec->pieces[i].live)
+          continue;
+        size_t shardId = sec->pieces[i].outputOff;
+        if ((shardId & (concurrency - 1)) == threadId)
+          shards[shardId].add(sec->getData(i));
+      }
+    }
+  });
+
+  // Fix the string table contents. After this, the contents will never
+  // change.
+  parallelFor(0, numShards, [&](size_t i) { shards[i].finalize(); });
 
-  // Fix the string table content. After this, the contents will never change.
-  builder.finalize();
+  // Compute an in-section offset for each shard.
+  size_t off = 0;
+  for (size_t i = 0; i < numShards; ++i) {
+    if (shards[i].getSize() > 0)
+      off = alignToPowerOf2(off, addralign);
+    shardOffsets[i] = off;
+    off += shards[i].getSize();
+  }
+  size = off;
 
-  // finalize() fixed tail-optimized strings, so we can now get
-  // offsets of strings. Get an offset for each string and save it
-  // to a corresponding SectionPiece for easy access.
-  for (MergeInputSection *sec : sections)
+  // finalize() fixed tail-optimized strings, so we can now get offsets of
+  // strings. Get an offset for each string and save it to a corresponding
+  // SectionPiece for easy access.
+  parallelForEach(sections, [&](MergeInputSection *sec) {
     for (size_t i = 0, e = sec->pieces.size(); i != e; ++i)
-      if (sec->pieces[i].live)
-        sec->pieces[i].outputOff = builder.getOffset(sec->getData(i));
+      if (sec->pieces[i].live) {
+        size_t shardId = sec->pieces[i].outputOff;
+        sec->pieces[i].outputOff =
+            shardOffsets[shardId] + shards[shardId].getOffset(sec->getData(i));
+      }
+  });
 }
 
 void MergeNoTailSection::writeTo(uint8_t *buf) {
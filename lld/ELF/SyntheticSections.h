@@ -954,14 +954,30 @@ protected:
 class MergeTailSection final : public MergeSyntheticSection {
 public:
   MergeTailSection(StringRef name, uint32_t type, uint64_t flags,
-                   uint32_t addralign);
+                   uint32_t addralign)
+      : MergeSyntheticSection(name, type, flags, addralign) {}
 
-  size_t getSize() const override;
+  size_t getSize() const override { return size; }
   void writeTo(uint8_t *buf) override;
   void finalizeContents() override;
 
 private:
-  llvm::StringTableBuilder builder;
+  // Pieces are sharded by a hash of their last tailBytes bytes, so a string
+  // and any suffix of it of at least that length land in the same shard.
+  // Tail merging can therefore run on each shard independently; the only
+  // merges lost are of strings shorter than tailBytes into strings placed
+  // in other shards.
+  constexpr static size_t tailBytes = 8;
+  constexpr static size_t numShards = 32;
+
+  static size_t getShardId(StringRef s);
+
+  // Section size
+  size_t size = 0;
+
+  // String table contents
+  SmallVector<llvm::StringTableBuilder, 0> shards;
+  size_t shardOffsets[numShards];
 };
 
 class MergeNoTailSection final : public MergeSyntheticSection {
@@ -646,6 +646,12 @@ template <class ELFT> void Writer<ELFT>::run() {
       writeSectionsBinary();
     }
 
+    // All section bytes are in the output buffer now. Kick off asynchronous
+    // writeback of the dirty pages so the disk flush overlaps the build id
+    // computation (a hash of the entire file) below, instead of happening
+    // entirely inside commit().
+    flushPagesAsync(Out::bufferStart, fileSize);
+
     // Backfill .note.gnu.build-id section content. This is done at last
     // because the content is usually a hash value of the entire output file.
     writeBuildId();
@@ -1379,7 +1385,9 @@ sortISDBySectionOrder(InputSectionDescription *isd,
     }
     orderedSections.push_back({isec, i->second});
   }
-  llvm::sort(orderedSections, llvm::less_second());
+  // With a large --symbol-ordering-file or call graph profile this list can
+  // cover most of .text, so sort it in parallel.
+  parallelSort(orderedSections, llvm::less_second());
 
   // Find an insertion point for the ordered section list in the unordered
   // section list. On targets with limited-range branches, this is the mid-point
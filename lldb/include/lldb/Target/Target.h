@@ -12,6 +12,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -1243,6 +1244,18 @@ public:
       const EvaluateExpressionOptions &options = EvaluateExpressionOptions(),
       std::string *fixed_expression = nullptr, ValueObject *ctx_obj = nullptr);
 
+  /// Return the most recently parsed user expression if \a hash matches the
+  /// hash it was cached under, or an empty shared pointer. The caller is
+  /// responsible for checking that the expression is still valid in its
+  /// execution context before reusing it.
+  lldb::UserExpressionSP GetCachedUserExpression(uint64_t hash);
+
+  /// Remember \a user_expression_sp as the most recently parsed user
+  /// expression, keyed by \a hash, so that a subsequent evaluation of the
+  /// same expression can skip the parse.
+  void SetCachedUserExpression(uint64_t hash,
+                               lldb::UserExpressionSP user_expression_sp);
+
   lldb::ExpressionVariableSP GetPersistentVariable(ConstString name);
 
   lldb::addr_t GetPersistentSymbol(ConstString name);
@@ -1571,6 +1584,13 @@ protected:
   bool m_suppress_stop_hooks; /// Used to not run stop hooks for expressions
   bool m_is_dummy_target;
   unsigned m_next_persistent_variable_index = 0;
+  /// The most recently parsed user expression and the hash of its text and
+  /// parse-relevant options, reused by UserExpression::Evaluate to avoid
+  /// re-running the compiler frontend for repeated evaluations of the same
+  /// expression.
+  lldb::UserExpressionSP m_cached_user_expression_sp;
+  uint64_t m_cached_user_expression_hash = 0;
+  std::mutex m_cached_user_expression_mutex;
   /// An optional \a lldb_private::Trace object containing processor trace
   /// information of this target.
   lldb::TraceSP m_trace_sp;
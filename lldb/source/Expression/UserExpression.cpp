@@ -38,6 +38,7 @@
 #include "lldb/Utility/LLDBLog.h"
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/State.h"
+#include "llvm/ADT/Hashing.h"
 #include "lldb/Utility/StreamString.h"
 
 using namespace lldb_private;
@@ -249,41 +250,71 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
       language = frame->GetLanguage();
   }
 
-  lldb::UserExpressionSP user_expression_sp(
-      target->GetUserExpressionForLanguage(expr, full_prefix, language,
-                                           desired_type, options, ctx_obj,
-                                           error));
-  if (error.Fail() || !user_expression_sp) {
-    LLDB_LOG(log, "== [UserExpression::Evaluate] Getting expression: {0} ==",
-             error.AsCString());
-    return lldb::eExpressionSetupError;
-  }
-
-  LLDB_LOG(log, "== [UserExpression::Evaluate] Parsing expression {0} ==",
-           expr.str());
-
   const bool keep_expression_in_memory = true;
   const bool generate_debug_info = options.GetGenerateDebugInfo();
 
-  if (options.InvokeCancelCallback(lldb::eExpressionEvaluationParse)) {
-    error.SetErrorString("expression interrupted by callback before parse");
-    result_valobj_sp = ValueObjectConstResult::Create(
-        exe_ctx.GetBestExecutionContextScope(), error);
-    return lldb::eExpressionInterrupted;
+  // Check whether the most recently parsed expression for this target can be
+  // reused: the text and parse-relevant options must match, and the
+  // expression must still be valid in this execution context (same process
+  // and same frame code address). Repeated evaluations of the same
+  // expression at the same stop location then skip the compiler frontend
+  // entirely, the same way breakpoint locations reuse their parsed condition
+  // expression.
+  const uint64_t expr_hash = llvm::hash_combine(
+      expr, full_prefix, static_cast<unsigned>(language),
+      static_cast<unsigned>(desired_type),
+      static_cast<unsigned>(execution_policy), generate_debug_info);
+  const bool can_cache_parse = !ctx_obj &&
+                               execution_policy != eExecutionPolicyTopLevel;
+
+  lldb::UserExpressionSP user_expression_sp;
+  if (can_cache_parse) {
+    user_expression_sp = target->GetCachedUserExpression(expr_hash);
+    if (user_expression_sp && (!user_expression_sp->IsParseCacheable() ||
+                               !user_expression_sp->MatchesContext(exe_ctx)))
+      user_expression_sp.reset();
+    if (user_expression_sp)
+      LLDB_LOG(log,
+               "== [UserExpression::Evaluate] Reusing parsed expression {0} ==",
+               expr.str());
   }
 
   DiagnosticManager diagnostic_manager;
-
-  bool parse_success =
-      user_expression_sp->Parse(diagnostic_manager, exe_ctx, execution_policy,
-                                keep_expression_in_memory, generate_debug_info);
+  bool parse_success = (bool)user_expression_sp;
 
   // Calculate the fixed expression always, since we need it for errors.
   std::string tmp_fixed_expression;
   if (fixed_expression == nullptr)
     fixed_expression = &tmp_fixed_expression;
 
-  *fixed_expression = user_expression_sp->GetFixedText().str();
+  if (!user_expression_sp) {
+    user_expression_sp.reset(
+        target->GetUserExpressionForLanguage(expr, full_prefix, language,
+                                             desired_type, options, ctx_obj,
+                                             error));
+    if (error.Fail() || !user_expression_sp) {
+      LLDB_LOG(log, "== [UserExpression::Evaluate] Getting expression: {0} ==",
+               error.AsCString());
+      return lldb::eExpressionSetupError;
+    }
+
+    LLDB_LOG(log, "== [UserExpression::Evaluate] Parsing expression {0} ==",
+             expr.str());
+
+    if (options.InvokeCancelCallback(lldb::eExpressionEvaluationParse)) {
+      error.SetErrorString("expression interrupted by callback before parse");
+      result_valobj_sp = ValueObjectConstResult::Create(
+          exe_ctx.GetBestExecutionContextScope(), error);
+      return lldb::eExpressionInterrupted;
+    }
+
+    parse_success =
+        user_expression_sp->Parse(diagnostic_manager, exe_ctx,
+                                  execution_policy, keep_expression_in_memory,
+                                  generate_debug_info);
+
+    *fixed_expression = user_expression_sp->GetFixedText().str();
+  }
 
   // If there is a fixed expression, try to parse it:
   if (!parse_success) {
@@ -339,6 +370,9 @@ UserExpression::Evaluate(ExecutionContext &exe_ctx,
     }
   }
 
+  if (parse_success && can_cache_parse && user_expression_sp->IsParseCacheable())
+    target->SetCachedUserExpression(expr_hash, user_expression_sp);
+
   if (parse_success) {
     lldb::ExpressionVariableSP expr_result;
 
@@ -10,6 +10,7 @@
 #include "DynamicLoaderPOSIXDYLD.h"
 
 #include "lldb/Breakpoint/BreakpointLocation.h"
+#include "lldb/Core/Debugger.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/PluginManager.h"
@@ -25,6 +26,8 @@
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/ProcessInfo.h"
 
+#include "llvm/Support/ThreadPool.h"
+
 #include <memory>
 #include <optional>
 
@@ -202,12 +205,18 @@ void DynamicLoaderPOSIXDYLD::UpdateLoadedSections(ModuleSP module,
                                                   addr_t link_map_addr,
                                                   addr_t base_addr,
                                                   bool base_addr_is_offset) {
-  m_loaded_modules[module] = link_map_addr;
+  {
+    std::lock_guard<std::mutex> guard(m_loaded_modules_mutex);
+    m_loaded_modules[module] = link_map_addr;
+  }
   UpdateLoadedSectionsCommon(module, base_addr, base_addr_is_offset);
 }
 
 void DynamicLoaderPOSIXDYLD::UnloadSections(const ModuleSP module) {
-  m_loaded_modules.erase(module);
+  {
+    std::lock_guard<std::mutex> guard(m_loaded_modules_mutex);
+    m_loaded_modules.erase(module);
+  }
 
   UnloadSectionsCommon(module);
 }
@@ -415,7 +424,10 @@ void DynamicLoaderPOSIXDYLD::RefreshModules() {
   // The rendezvous class doesn't enumerate the main module, so track that
   // ourselves here.
   ModuleSP executable = GetTargetExecutable();
-  m_loaded_modules[executable] = m_rendezvous.GetLinkMapAddress();
+  {
+    std::lock_guard<std::mutex> guard(m_loaded_modules_mutex);
+    m_loaded_modules[executable] = m_rendezvous.GetLinkMapAddress();
+  }
 
   DYLDRendezvous::iterator I;
   DYLDRendezvous::iterator E;
@@ -632,7 +644,10 @@ void DynamicLoaderPOSIXDYLD::LoadAllCurrentModules() {
   // The rendezvous class doesn't enumerate the main module, so track that
   // ourselves here.
   ModuleSP executable = GetTargetExecutable();
-  m_loaded_modules[executable] = m_rendezvous.GetLinkMapAddress();
+  {
+    std::lock_guard<std::mutex> guard(m_loaded_modules_mutex);
+    m_loaded_modules[executable] = m_rendezvous.GetLinkMapAddress();
+  }
 
   std::vector<FileSpec> module_names;
   for (I = m_rendezvous.begin(), E = m_rendezvous.end(); I != E; ++I)
@@ -640,19 +655,36 @@ void DynamicLoaderPOSIXDYLD::LoadAllCurrentModules() {
   m_process->PrefetchModuleSpecs(
       module_names, m_process->GetTarget().GetArchitecture().GetTriple());
 
-  for (I = m_rendezvous.begin(), E = m_rendezvous.end(); I != E; ++I) {
-    ModuleSP module_sp =
-        LoadModuleAtAddress(I->file_spec, I->link_addr, I->base_addr, true);
-    if (module_sp.get()) {
+  // Load the modules in parallel on the debugger's thread pool, the same
+  // pool the DWARF indexer uses. The per-module work (object file parsing,
+  // symbol preloading) is module-local, and the shared structures touched
+  // on the way (the shared module cache, the target's image list and
+  // section load list, m_loaded_modules) are all mutex-guarded. Results are
+  // collected per index so the load order stays deterministic.
+  std::vector<DYLDRendezvous::SOEntry> entries(m_rendezvous.begin(),
+                                               m_rendezvous.end());
+  std::vector<ModuleSP> loaded_modules(entries.size());
+  llvm::ThreadPoolTaskGroup task_group(Debugger::GetThreadPool());
+  auto load_module_fn = [&](size_t idx) {
+    loaded_modules[idx] = LoadModuleAtAddress(
+        entries[idx].file_spec, entries[idx].link_addr, entries[idx].base_addr,
+        true);
+  };
+  for (size_t i = 0; i < entries.size(); ++i)
+    task_group.async(load_module_fn, i);
+  task_group.wait();
+
+  for (size_t i = 0; i < entries.size(); ++i) {
+    if (ModuleSP module_sp = loaded_modules[i]) {
       LLDB_LOG(log, "LoadAllCurrentModules loading module: {0}",
-               I->file_spec.GetFilename());
+               entries[i].file_spec.GetFilename());
       module_list.Append(module_sp);
     } else {
-      Log *log = GetLog(LLDBLog::DynamicLoader);
       LLDB_LOGF(
           log,
           "DynamicLoaderPOSIXDYLD::%s failed loading module %s at 0x%" PRIx64,
-          __FUNCTION__, I->file_spec.GetPath().c_str(), I->base_addr);
+          __FUNCTION__, entries[i].file_spec.GetPath().c_str(),
+          entries[i].base_addr);
     }
   }
 
@@ -724,15 +756,19 @@ DynamicLoaderPOSIXDYLD::GetThreadLocalData(const lldb::ModuleSP module_sp,
                                            const lldb::ThreadSP thread,
                                            lldb::addr_t tls_file_addr) {
   Log *log = GetLog(LLDBLog::DynamicLoader);
-  auto it = m_loaded_modules.find(module_sp);
-  if (it == m_loaded_modules.end()) {
-    LLDB_LOGF(
-        log, "GetThreadLocalData error: module(%s) not found in loaded modules",
-        module_sp->GetObjectName().AsCString());
-    return LLDB_INVALID_ADDRESS;
+  addr_t link_map = LLDB_INVALID_ADDRESS;
+  {
+    std::lock_guard<std::mutex> guard(m_loaded_modules_mutex);
+    auto it = m_loaded_modules.find(module_sp);
+    if (it == m_loaded_modules.end()) {
+      LLDB_LOGF(log,
+                "GetThreadLocalData error: module(%s) not found in loaded "
+                "modules",
+                module_sp->GetObjectName().AsCString());
+      return LLDB_INVALID_ADDRESS;
+    }
+    link_map = it->second;
   }
-
-  addr_t link_map = it->second;
   if (link_map == LLDB_INVALID_ADDRESS || link_map == 0) {
     LLDB_LOGF(log,
               "GetThreadLocalData error: invalid link map address=0x%" PRIx64,
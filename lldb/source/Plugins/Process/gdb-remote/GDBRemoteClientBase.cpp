@@ -194,6 +194,44 @@ GDBRemoteClientBase::SendPacketAndWaitForResponse(
   return SendPacketAndWaitForResponseNoLock(payload, response);
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteClientBase::SendPacketsAndWaitForResponses(
+    llvm::ArrayRef<std::string> payloads,
+    std::vector<StringExtractorGDBRemote> &responses,
+    std::chrono::seconds interrupt_timeout) {
+  responses.clear();
+  assert(!GetSendAcks() && "packet pipelining requires no-ack mode");
+
+  Lock lock(*this, interrupt_timeout);
+  if (!lock) {
+    if (Log *log = GetLog(GDBRLog::Process))
+      LLDB_LOGF(log,
+                "GDBRemoteClientBase::%s failed to get mutex, not sending "
+                "%zu packets",
+                __FUNCTION__, payloads.size());
+    return PacketResult::ErrorSendFailed;
+  }
+
+  // Send every request before waiting for the first reply. The remote must
+  // answer packets in the order they were received, so replies are matched
+  // to requests by position.
+  for (const std::string &payload : payloads) {
+    PacketResult packet_result = SendPacketNoLock(payload);
+    if (packet_result != PacketResult::Success)
+      return packet_result;
+  }
+
+  responses.resize(payloads.size());
+  for (StringExtractorGDBRemote &response : responses) {
+    PacketResult packet_result = ReadPacket(response, GetPacketTimeout(), true);
+    if (packet_result != PacketResult::Success) {
+      responses.clear();
+      return packet_result;
+    }
+  }
+  return PacketResult::Success;
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteClientBase::ReadPacketWithOutputSupport(
     StringExtractorGDBRemote &response, Timeout<std::micro> timeout,
@@ -11,6 +11,8 @@
 
 #include "GDBRemoteCommunication.h"
 
+#include "llvm/ADT/ArrayRef.h"
+
 #include <condition_variable>
 
 namespace lldb_private {
@@ -58,6 +60,16 @@ public:
       llvm::StringRef payload, StringExtractorGDBRemote &response,
       std::chrono::seconds interrupt_timeout = std::chrono::seconds(0));
 
+  // Send every packet in \a payloads before waiting for the first reply,
+  // then collect one reply per packet, in order, into \a responses. On a
+  // high-latency connection this costs one round trip for the whole batch
+  // instead of one per packet. Only valid in no-ack mode, where sending is
+  // not gated on a '+' from the remote between packets.
+  PacketResult SendPacketsAndWaitForResponses(
+      llvm::ArrayRef<std::string> payloads,
+      std::vector<StringExtractorGDBRemote> &responses,
+      std::chrono::seconds interrupt_timeout = std::chrono::seconds(0));
+
   PacketResult ReadPacketWithOutputSupport(
       StringExtractorGDBRemote &response, Timeout<std::micro> timeout,
       bool sync_on_timeout,
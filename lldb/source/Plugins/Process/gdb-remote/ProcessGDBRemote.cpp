@@ -2549,6 +2549,59 @@ size_t ProcessGDBRemote::DoReadMemory(addr_t addr, void *buf, size_t size,
   size_t max_memory_size =
       binary_memory_read ? m_max_memory_size : m_max_memory_size / 2;
   if (size > max_memory_size) {
+    // An oversized read has to be split into chunks of at most
+    // max_memory_size bytes. Pipeline the chunk requests over the connection
+    // when we can: all request packets go out before the first reply is
+    // awaited, so the whole read costs one round trip instead of one per
+    // chunk. This requires no-ack mode, since in ack mode every send blocks
+    // on a '+' from the remote.
+    if (!m_gdb_comm.GetSendAcks()) {
+      std::vector<std::string> packets;
+      for (size_t offset = 0; offset < size; offset += max_memory_size) {
+        char chunk_packet[64];
+        int chunk_packet_len = ::snprintf(
+            chunk_packet, sizeof(chunk_packet), "%c%" PRIx64 ",%" PRIx64,
+            binary_memory_read ? 'x' : 'm', (uint64_t)(addr + offset),
+            (uint64_t)std::min(max_memory_size, size - offset));
+        assert(chunk_packet_len + 1 < (int)sizeof(chunk_packet));
+        UNUSED_IF_ASSERT_DISABLED(chunk_packet_len);
+        packets.emplace_back(chunk_packet);
+      }
+      std::vector<StringExtractorGDBRemote> responses;
+      if (m_gdb_comm.SendPacketsAndWaitForResponses(packets, responses,
+                                                    GetInterruptTimeout()) ==
+          GDBRemoteCommunication::PacketResult::Success) {
+        size_t bytes_read = 0;
+        for (StringExtractorGDBRemote &chunk_response : responses) {
+          if (!chunk_response.IsNormalResponse())
+            break;
+          const size_t chunk_size =
+              std::min(max_memory_size, size - bytes_read);
+          size_t chunk_bytes_read;
+          if (binary_memory_read) {
+            chunk_bytes_read =
+                std::min(chunk_response.GetBytesLeft(), chunk_size);
+            memcpy((uint8_t *)buf + bytes_read,
+                   chunk_response.GetStringRef().data(), chunk_bytes_read);
+          } else {
+            chunk_bytes_read = chunk_response.GetHexBytes(
+                llvm::MutableArrayRef<uint8_t>((uint8_t *)buf + bytes_read,
+                                               chunk_size),
+                '\xdd');
+          }
+          bytes_read += chunk_bytes_read;
+          // A short chunk means the rest of the range is unreadable.
+          if (chunk_bytes_read < chunk_size)
+            break;
+        }
+        if (bytes_read > 0) {
+          error.Clear();
+          return bytes_read;
+        }
+      }
+      // Fall through to the single packet path on failure so that it can
+      // produce a precise error for the first chunk.
+    }
     // Keep memory read sizes down to a sane limit. This function will be
     // called multiple times in order to complete the task by
     // lldb_private::Process so it is ok to do this.
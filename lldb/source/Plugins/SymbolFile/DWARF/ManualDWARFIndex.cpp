@@ -119,6 +119,12 @@ void ManualDWARFIndex::Index() {
 
   auto finalize_fn = [this, &sets, &progress](NameToDIE(IndexSet::*index)) {
     NameToDIE &result = m_set.*index;
+    // Reserve the final size up front so the per-unit appends don't
+    // repeatedly regrow the map while the merge runs.
+    size_t size = result.GetSize();
+    for (auto &set : sets)
+      size += (set.*index).GetSize();
+    result.Reserve(size);
     for (auto &set : sets)
       result.Append(set.*index);
     result.Finalize();
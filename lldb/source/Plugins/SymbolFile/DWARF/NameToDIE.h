@@ -34,6 +34,12 @@ public:
 
   void Finalize();
 
+  size_t GetSize() const { return m_map.GetSize(); }
+
+  /// Reserve memory for at least \a n entries, useful before a series of
+  /// Append calls whose total size is known.
+  void Reserve(size_t n) { m_map.Reserve(n); }
+
   bool Find(ConstString name,
             llvm::function_ref<bool(DIERef ref)> callback) const;
 
@@ -1726,6 +1726,9 @@ void Target::SymbolsDidLoad(ModuleList &module_list) {
 
 void Target::ModulesDidUnload(ModuleList &module_list, bool delete_locations) {
   if (m_valid && module_list.GetSize()) {
+    // The cached user expression may reference types and symbols from the
+    // unloaded modules; drop it rather than risk reusing stale state.
+    SetCachedUserExpression(0, lldb::UserExpressionSP());
     UnloadModuleSections(module_list);
     BroadcastEvent(eBroadcastBitModulesUnloaded,
                    new TargetEventData(this->shared_from_this(), module_list));
@@ -2727,6 +2730,20 @@ ExpressionResults Target::EvaluateExpression(
   return execution_results;
 }
 
+lldb::UserExpressionSP Target::GetCachedUserExpression(uint64_t hash) {
+  std::lock_guard<std::mutex> guard(m_cached_user_expression_mutex);
+  if (m_cached_user_expression_sp && m_cached_user_expression_hash == hash)
+    return m_cached_user_expression_sp;
+  return lldb::UserExpressionSP();
+}
+
+void Target::SetCachedUserExpression(uint64_t hash,
+                                     lldb::UserExpressionSP user_expression_sp) {
+  std::lock_guard<std::mutex> guard(m_cached_user_expression_mutex);
+  m_cached_user_expression_hash = hash;
+  m_cached_user_expression_sp = std::move(user_expression_sp);
+}
+
 lldb::ExpressionVariableSP Target::GetPersistentVariable(ConstString name) {
   lldb::ExpressionVariableSP variable_sp;
   m_scratch_type_system_map.ForEach(
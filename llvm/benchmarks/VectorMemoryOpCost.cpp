@@ -0,0 +1,286 @@
+//===- VectorMemoryOpCost.cpp - measured vs modeled vector memory cost ----===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// JIT-compiles kernels shaped like the code LoopVectorize and
+// InterleavedAccessPass emit for interleaved loads and gathers, times them on
+// the host CPU, and reports the cost model's prediction for the key memory
+// operation (TTI::getInterleavedMemoryOpCost / getGatherScatterOpCost) as a
+// counter next to the measured time. Tracking the two together makes cost
+// table drift in lib/Target/*TargetTransformInfo.cpp visible per CPU.
+//
+//===----------------------------------------------------------------------===//
+
+#include "benchmark/benchmark.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Analysis/TargetTransformInfo.h"
+#include "llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h"
+#include "llvm/ExecutionEngine/Orc/LLJIT.h"
+#include "llvm/ExecutionEngine/Orc/ThreadSafeModule.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/IRBuilder.h"
+#include "llvm/IR/LLVMContext.h"
+#include "llvm/IR/Module.h"
+#include "llvm/IR/Verifier.h"
+#include "llvm/Support/TargetSelect.h"
+#include "llvm/Target/TargetMachine.h"
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using namespace llvm;
+using namespace llvm::orc;
+
+namespace {
+
+// Number of output elements each kernel produces per call; a multiple of all
+// vectorization factors used below.
+constexpr int64_t NumElements = 1 << 16;
+
+// Build:
+//   void kernel(float *dst, const float *src, i64 n)
+// Each iteration loads Factor * VF consecutive floats, deinterleaves them
+// with shufflevectors the way InterleavedAccessPass lowers vectorized strided
+// loads, sums the Factor lanes and stores VF floats.
+std::unique_ptr<Module> buildInterleavedKernel(LLVMContext &Ctx, unsigned VF,
+                                               unsigned Factor) {
+  auto M = std::make_unique<Module>("kernel", Ctx);
+  Type *FloatTy = Type::getFloatTy(Ctx);
+  Type *I64 = Type::getInt64Ty(Ctx);
+  auto *WideTy = FixedVectorType::get(FloatTy, VF * Factor);
+  PointerType *PtrTy = PointerType::getUnqual(Ctx);
+  auto *FTy =
+      FunctionType::get(Type::getVoidTy(Ctx), {PtrTy, PtrTy, I64}, false);
+  Function *F =
+      Function::Create(FTy, Function::ExternalLinkage, "kernel", M.get());
+  Argument *Dst = F->getArg(0);
+  Argument *Src = F->getArg(1);
+  Argument *N = F->getArg(2);
+
+  BasicBlock *Entry = BasicBlock::Create(Ctx, "entry", F);
+  BasicBlock *Loop = BasicBlock::Create(Ctx, "loop", F);
+  BasicBlock *Exit = BasicBlock::Create(Ctx, "exit", F);
+
+  IRBuilder<> B(Entry);
+  B.CreateCondBr(B.CreateICmpSGT(N, ConstantInt::get(I64, 0)), Loop, Exit);
+
+  B.SetInsertPoint(Loop);
+  PHINode *IV = B.CreatePHI(I64, 2, "iv");
+  IV->addIncoming(ConstantInt::get(I64, 0), Entry);
+  Value *SrcPtr = B.CreateGEP(
+      FloatTy, Src, B.CreateMul(IV, ConstantInt::get(I64, Factor)));
+  Value *Wide = B.CreateAlignedLoad(WideTy, SrcPtr, Align(4), "wide");
+  Value *Acc = nullptr;
+  for (unsigned J = 0; J != Factor; ++J) {
+    SmallVector<int, 16> Mask;
+    for (unsigned L = 0; L != VF; ++L)
+      Mask.push_back(L * Factor + J);
+    Value *Lane = B.CreateShuffleVector(Wide, Mask);
+    Acc = Acc ? B.CreateFAdd(Acc, Lane) : Lane;
+  }
+  B.CreateAlignedStore(Acc, B.CreateGEP(FloatTy, Dst, IV), Align(4));
+  Value *Next = B.CreateAdd(IV, ConstantInt::get(I64, VF));
+  IV->addIncoming(Next, Loop);
+  B.CreateCondBr(B.CreateICmpSLT(Next, N), Loop, Exit);
+
+  B.SetInsertPoint(Exit);
+  B.CreateRetVoid();
+
+  assert(!verifyModule(*M, &errs()));
+  return M;
+}
+
+// Build:
+//   void kernel(float *dst, const float *src, const i32 *idx, i64 n)
+// Each iteration loads VF indices and gathers VF floats through them with
+// llvm.masked.gather, as LoopVectorize emits for indexed loads.
+std::unique_ptr<Module> buildGatherKernel(LLVMContext &Ctx, unsigned VF) {
+  auto M = std::make_unique<Module>("kernel", Ctx);
+  Type *FloatTy = Type::getFloatTy(Ctx);
+  Type *I32 = Type::getInt32Ty(Ctx);
+  Type *I64 = Type::getInt64Ty(Ctx);
+  auto *VecTy = FixedVectorType::get(FloatTy, VF);
+  auto *IdxTy = FixedVectorType::get(I32, VF);
+  PointerType *PtrTy = PointerType::getUnqual(Ctx);
+  auto *FTy = FunctionType::get(Type::getVoidTy(Ctx),
+                                {PtrTy, PtrTy, PtrTy, I64}, false);
+  Function *F =
+      Function::Create(FTy, Function::ExternalLinkage, "kernel", M.get());
+  Argument *Dst = F->getArg(0);
+  Argument *Src = F->getArg(1);
+  Argument *Idx = F->getArg(2);
+  Argument *N = F->getArg(3);
+
+  BasicBlock *Entry = BasicBlock::Create(Ctx, "entry", F);
+  BasicBlock *Loop = BasicBlock::Create(Ctx, "loop", F);
+  BasicBlock *Exit = BasicBlock::Create(Ctx, "exit", F);
+
+  IRBuilder<> B(Entry);
+  B.CreateCondBr(B.CreateICmpSGT(N, ConstantInt::get(I64, 0)), Loop, Exit);
+
+  B.SetInsertPoint(Loop);
+  PHINode *IV = B.CreatePHI(I64, 2, "iv");
+  IV->addIncoming(ConstantInt::get(I64, 0), Entry);
+  Value *VIdx =
+      B.CreateAlignedLoad(IdxTy, B.CreateGEP(I32, Idx, IV), Align(4));
+  Value *Ptrs = B.CreateGEP(
+      FloatTy, Src, B.CreateZExt(VIdx, FixedVectorType::get(I64, VF)));
+  Value *Mask = Constant::getAllOnesValue(
+      FixedVectorType::get(Type::getInt1Ty(Ctx), VF));
+  Value *Gathered =
+      B.CreateMaskedGather(VecTy, Ptrs, Align(4), Mask, PoisonValue::get(VecTy));
+  B.CreateAlignedStore(Gathered, B.CreateGEP(FloatTy, Dst, IV), Align(4));
+  Value *Next = B.CreateAdd(IV, ConstantInt::get(I64, VF));
+  IV->addIncoming(Next, Loop);
+  B.CreateCondBr(B.CreateICmpSLT(Next, N), Loop, Exit);
+
+  B.SetInsertPoint(Exit);
+  B.CreateRetVoid();
+
+  assert(!verifyModule(*M, &errs()));
+  return M;
+}
+
+void initNativeTarget() {
+  static bool Initialized = [] {
+    InitializeNativeTarget();
+    InitializeNativeTargetAsmPrinter();
+    return true;
+  }();
+  (void)Initialized;
+}
+
+// JIT-compile the module's "kernel" function for the host.
+Expected<std::pair<std::unique_ptr<LLJIT>, void *>>
+compileKernel(std::unique_ptr<LLVMContext> Ctx, std::unique_ptr<Module> M) {
+  auto JIT = LLJITBuilder().create();
+  if (!JIT)
+    return JIT.takeError();
+  if (Error E =
+          (*JIT)->addIRModule(ThreadSafeModule(std::move(M), std::move(Ctx))))
+    return std::move(E);
+  auto Sym = (*JIT)->lookup("kernel");
+  if (!Sym)
+    return Sym.takeError();
+  return std::make_pair(std::move(*JIT), Sym->toPtr<void *>());
+}
+
+// Run Callback on a TargetTransformInfo for the host CPU and return its
+// result, or -1 if the host target is unavailable.
+template <typename CallbackT> int64_t withHostTTI(CallbackT Callback) {
+  auto JTMB = JITTargetMachineBuilder::detectHost();
+  if (!JTMB) {
+    consumeError(JTMB.takeError());
+    return -1;
+  }
+  auto TM = JTMB->createTargetMachine();
+  if (!TM) {
+    consumeError(TM.takeError());
+    return -1;
+  }
+  LLVMContext Ctx;
+  Module M("cost", Ctx);
+  M.setTargetTriple((*TM)->getTargetTriple().str());
+  M.setDataLayout((*TM)->createDataLayout());
+  Function *F = Function::Create(
+      FunctionType::get(Type::getVoidTy(Ctx), false),
+      Function::ExternalLinkage, "f", &M);
+  TargetTransformInfo TTI = (*TM)->getTargetTransformInfo(*F);
+  InstructionCost Cost = Callback(Ctx, TTI);
+  return Cost.isValid() ? *Cost.getValue() : -1;
+}
+
+int64_t modeledInterleavedCost(unsigned VF, unsigned Factor) {
+  return withHostTTI([&](LLVMContext &Ctx, TargetTransformInfo &TTI) {
+    auto *WideTy = FixedVectorType::get(Type::getFloatTy(Ctx), VF * Factor);
+    SmallVector<unsigned, 4> Indices;
+    for (unsigned I = 0; I != Factor; ++I)
+      Indices.push_back(I);
+    return TTI.getInterleavedMemoryOpCost(
+        Instruction::Load, WideTy, Factor, Indices, Align(4),
+        /*AddressSpace=*/0, TargetTransformInfo::TCK_RecipThroughput);
+  });
+}
+
+int64_t modeledGatherCost(unsigned VF) {
+  return withHostTTI([&](LLVMContext &Ctx, TargetTransformInfo &TTI) {
+    auto *VecTy = FixedVectorType::get(Type::getFloatTy(Ctx), VF);
+    return TTI.getGatherScatterOpCost(
+        Instruction::Load, VecTy, /*Ptr=*/nullptr, /*VariableMask=*/false,
+        Align(4), TargetTransformInfo::TCK_RecipThroughput);
+  });
+}
+
+void BM_InterleavedLoad(benchmark::State &State) {
+  initNativeTarget();
+  const unsigned VF = State.range(0);
+  const unsigned Factor = State.range(1);
+
+  auto Ctx = std::make_unique<LLVMContext>();
+  auto M = buildInterleavedKernel(*Ctx, VF, Factor);
+  auto Compiled = compileKernel(std::move(Ctx), std::move(M));
+  if (!Compiled) {
+    State.SkipWithError(toString(Compiled.takeError()).c_str());
+    return;
+  }
+  using KernelFn = void (*)(float *, const float *, int64_t);
+  auto *Kernel = reinterpret_cast<KernelFn>(Compiled->second);
+
+  std::vector<float> Dst(NumElements);
+  std::vector<float> Src(NumElements * Factor, 1.0f);
+  for (auto _ : State) {
+    Kernel(Dst.data(), Src.data(), NumElements);
+    benchmark::DoNotOptimize(Dst.data());
+    benchmark::ClobberMemory();
+  }
+  State.counters["ModeledCost"] = modeledInterleavedCost(VF, Factor);
+  State.SetItemsProcessed(State.iterations() * NumElements);
+}
+
+void BM_GatherLoad(benchmark::State &State) {
+  initNativeTarget();
+  const unsigned VF = State.range(0);
+
+  auto Ctx = std::make_unique<LLVMContext>();
+  auto M = buildGatherKernel(*Ctx, VF);
+  auto Compiled = compileKernel(std::move(Ctx), std::move(M));
+  if (!Compiled) {
+    State.SkipWithError(toString(Compiled.takeError()).c_str());
+    return;
+  }
+  using KernelFn = void (*)(float *, const float *, const int32_t *, int64_t);
+  auto *Kernel = reinterpret_cast<KernelFn>(Compiled->second);
+
+  std::vector<float> Dst(NumElements);
+  std::vector<float> Src(NumElements, 1.0f);
+  std::vector<int32_t> Idx(NumElements);
+  for (int64_t I = 0; I != NumElements; ++I)
+    Idx[I] = (I * 7) % NumElements;
+  for (auto _ : State) {
+    Kernel(Dst.data(), Src.data(), Idx.data(), NumElements);
+    benchmark::DoNotOptimize(Dst.data());
+    benchmark::ClobberMemory();
+  }
+  State.counters["ModeledCost"] = modeledGatherCost(VF);
+  State.SetItemsProcessed(State.iterations() * NumElements);
+}
+
+} // end anonymous namespace
+
+BENCHMARK(BM_InterleavedLoad)
+    ->ArgNames({"VF", "Factor"})
+    ->Args({4, 2})
+    ->Args({4, 3})
+    ->Args({4, 4})
+    ->Args({8, 2})
+    ->Args({8, 4});
+
+BENCHMARK(BM_GatherLoad)->ArgNames({"VF"})->Arg(4)->Arg(8)->Arg(16);
+
+BENCHMARK_MAIN();
@@ -984,6 +984,16 @@ public:
   static void sdivrem(const APInt &LHS, int64_t RHS, APInt &Quotient,
                       int64_t &Remainder);
 
+  /// Scratch-space multiplication.
+  ///
+  /// Set \p Result to LHS * RHS, truncated to the common bit width, without
+  /// allocating: \p Result must already have the same bit width as the
+  /// operands, and its storage is reused. This lets callers performing many
+  /// multi-word multiplies (e.g. wide-integer constant folding) hoist the
+  /// result allocation out of the loop. \p Result must not alias either
+  /// operand; unlike udivrem, the multiply core cannot work in place.
+  static void mul(const APInt &LHS, const APInt &RHS, APInt &Result);
+
   // Operations that return overflow indicators.
   APInt sadd_ov(const APInt &RHS, bool &Overflow) const;
   APInt uadd_ov(const APInt &RHS, bool &Overflow) const;
@@ -0,0 +1,132 @@
+//===- ConcurrentStringMap.h ------------------------------------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ADT_CONCURRENTSTRINGMAP_H
+#define LLVM_ADT_CONCURRENTSTRINGMAP_H
+
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/Allocator.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/RWMutex.h"
+#include "llvm/Support/Threading.h"
+#include "llvm/Support/xxhash.h"
+#include <memory>
+
+namespace llvm {
+
+/// ConcurrentStringMap - a finely sharded wrapper around StringMap that
+/// allows concurrent insertions and lookups without a global lock.
+///
+/// The map is split into a power-of-two number of shards. Each shard owns an
+/// independent StringMap together with the BumpPtrAllocator that backs its
+/// key storage, guarded by a per-shard reader/writer lock. A key is assigned
+/// to a shard by its hash, so threads inserting distinct keys mostly touch
+/// distinct shards and proceed without contention.
+///
+/// Like StringMap, inserted entries are never moved in memory, so pointers
+/// and references to mapped values remain valid while the map is alive (the
+/// map only grows; erase is intentionally not provided). Unlike StringMap,
+/// iteration is not supported while other threads may be mutating the map;
+/// use forEach() after all concurrent work has completed.
+template <typename ValueTy> class ConcurrentStringMap {
+  struct Shard {
+    mutable sys::SmartRWMutex<true> Mutex;
+    StringMap<ValueTy> Map;
+  };
+
+  std::unique_ptr<Shard[]> Shards;
+  uint64_t ShardMask;
+
+  Shard &getShard(StringRef Key) const {
+    return Shards[xxh3_64bits(Key) & ShardMask];
+  }
+
+public:
+  /// \p ShardCountHint is rounded up to a power of two. The default scales
+  /// with the hardware parallelism so that parallelForEach-style producers
+  /// rarely collide on a shard lock.
+  explicit ConcurrentStringMap(unsigned ShardCountHint = 0) {
+    if (ShardCountHint == 0)
+      ShardCountHint = 4 * hardware_concurrency().compute_thread_count();
+    uint64_t ShardCount = PowerOf2Ceil(std::max(1u, ShardCountHint));
+    Shards = std::make_unique<Shard[]>(ShardCount);
+    ShardMask = ShardCount - 1;
+  }
+
+  ConcurrentStringMap(const ConcurrentStringMap &) = delete;
+  ConcurrentStringMap &operator=(const ConcurrentStringMap &) = delete;
+
+  /// Insert \p Key with a value constructed from \p Args unless it is already
+  /// present. \returns a pointer to the entry and true if an insertion
+  /// happened. The returned entry stays valid for the lifetime of the map.
+  template <typename... ArgsTy>
+  std::pair<StringMapEntry<ValueTy> *, bool> try_emplace(StringRef Key,
+                                                         ArgsTy &&...Args) {
+    Shard &S = getShard(Key);
+    sys::SmartScopedWriter<true> Guard(S.Mutex);
+    auto Res = S.Map.try_emplace(Key, std::forward<ArgsTy>(Args)...);
+    return {&*Res.first, Res.second};
+  }
+
+  /// Insert \p KV if its key is not already present. \returns a pointer to
+  /// the entry and true if an insertion happened.
+  std::pair<StringMapEntry<ValueTy> *, bool>
+  insert(std::pair<StringRef, ValueTy> KV) {
+    return try_emplace(KV.first, std::move(KV.second));
+  }
+
+  /// \returns a pointer to the entry for \p Key, or nullptr if absent. The
+  /// caller must not mutate the mapped value unless it provides its own
+  /// synchronization against concurrent readers.
+  StringMapEntry<ValueTy> *find(StringRef Key) const {
+    Shard &S = getShard(Key);
+    sys::SmartScopedReader<true> Guard(S.Mutex);
+    auto It = S.Map.find(Key);
+    return It == S.Map.end() ? nullptr
+                             : const_cast<StringMapEntry<ValueTy> *>(&*It);
+  }
+
+  /// \returns a copy of the value for \p Key, or a default-constructed value
+  /// if absent.
+  ValueTy lookup(StringRef Key) const {
+    Shard &S = getShard(Key);
+    sys::SmartScopedReader<true> Guard(S.Mutex);
+    return S.Map.lookup(Key);
+  }
+
+  bool contains(StringRef Key) const {
+    Shard &S = getShard(Key);
+    sys::SmartScopedReader<true> Guard(S.Mutex);
+    return S.Map.contains(Key);
+  }
+
+  size_t size() const {
+    size_t Count = 0;
+    for (uint64_t I = 0; I <= ShardMask; ++I) {
+      sys::SmartScopedReader<true> Guard(Shards[I].Mutex);
+      Count += Shards[I].Map.size();
+    }
+    return Count;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  /// Visit every entry. Only safe once all concurrent mutation has finished;
+  /// entries are visited in an unspecified order.
+  template <typename FuncTy> void forEach(FuncTy Func) {
+    for (uint64_t I = 0; I <= ShardMask; ++I) {
+      sys::SmartScopedReader<true> Guard(Shards[I].Mutex);
+      for (StringMapEntry<ValueTy> &Entry : Shards[I].Map)
+        Func(Entry);
+    }
+  }
+};
+
+} // end namespace llvm
+
+#endif // LLVM_ADT_CONCURRENTSTRINGMAP_H
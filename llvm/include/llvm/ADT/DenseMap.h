@@ -32,6 +32,11 @@
 #include <type_traits>
 #include <utility>
 
+#ifdef LLVM_ENABLE_DENSEMAP_STATS
+#include <atomic>
+#include <cstdio>
+#endif
+
 namespace llvm {
 
 namespace detail {
@@ -48,6 +53,60 @@ struct DenseMapPair : public std::pair<KeyT, ValueT> {
   const ValueT &getSecond() const { return std::pair<KeyT, ValueT>::second; }
 };
 
+#ifdef LLVM_ENABLE_DENSEMAP_STATS
+/// Process-wide DenseMap occupancy statistics, for tuning allocation and
+/// growth behavior. Every map records its final bucket count, entry count and
+/// heap footprint when it is destroyed, and the aggregated histograms are
+/// printed to stderr at process exit. This is a profiling aid only; define
+/// LLVM_ENABLE_DENSEMAP_STATS to enable it.
+class DenseMapStats {
+public:
+  static void record(unsigned NumBuckets, unsigned NumEntries,
+                     size_t HeapBytes) {
+    DenseMapStats &S = instance();
+    S.NumMaps.fetch_add(1, std::memory_order_relaxed);
+    S.TotalHeapBytes.fetch_add(HeapBytes, std::memory_order_relaxed);
+    unsigned SizeBin =
+        NumBuckets ? std::min(Log2_32(NumBuckets), kNumSizeBins - 1) : 0;
+    S.BucketHistogram[SizeBin].fetch_add(1, std::memory_order_relaxed);
+    unsigned Decile =
+        NumBuckets ? std::min(NumEntries * 10 / NumBuckets, 10u) : 0;
+    S.OccupancyHistogram[Decile].fetch_add(1, std::memory_order_relaxed);
+  }
+
+private:
+  static const unsigned kNumSizeBins = 32;
+
+  std::atomic<uint64_t> NumMaps{0};
+  std::atomic<uint64_t> TotalHeapBytes{0};
+  std::atomic<uint64_t> BucketHistogram[kNumSizeBins] = {};
+  std::atomic<uint64_t> OccupancyHistogram[11] = {};
+
+  static DenseMapStats &instance() {
+    static DenseMapStats S;
+    return S;
+  }
+
+  DenseMapStats() = default;
+
+  ~DenseMapStats() {
+    fprintf(stderr, "=== DenseMap statistics ===\n");
+    fprintf(stderr, "maps destroyed:   %llu\n",
+            (unsigned long long)NumMaps.load());
+    fprintf(stderr, "total heap bytes: %llu\n",
+            (unsigned long long)TotalHeapBytes.load());
+    fprintf(stderr, "bucket count histogram (log2 buckets : maps):\n");
+    for (unsigned I = 0; I != kNumSizeBins; ++I)
+      if (uint64_t N = BucketHistogram[I].load())
+        fprintf(stderr, "  %2u : %llu\n", I, (unsigned long long)N);
+    fprintf(stderr, "occupancy histogram (decile : maps):\n");
+    for (unsigned I = 0; I != 11; ++I)
+      if (uint64_t N = OccupancyHistogram[I].load())
+        fprintf(stderr, "  %3u%% : %llu\n", I * 10, (unsigned long long)N);
+  }
+};
+#endif // LLVM_ENABLE_DENSEMAP_STATS
+
 } // end namespace detail
 
 template <typename KeyT, typename ValueT,
@@ -778,6 +837,10 @@ public:
   }
 
   ~DenseMap() {
+#ifdef LLVM_ENABLE_DENSEMAP_STATS
+    detail::DenseMapStats::record(NumBuckets, NumEntries,
+                                  sizeof(BucketT) * NumBuckets);
+#endif
     this->destroyAll();
     deallocate_buffer(Buckets, sizeof(BucketT) * NumBuckets, alignof(BucketT));
   }
@@ -957,6 +1020,11 @@ public:
       : SmallDenseMap(Vals.begin(), Vals.end()) {}
 
   ~SmallDenseMap() {
+#ifdef LLVM_ENABLE_DENSEMAP_STATS
+    // Inline storage is not a heap allocation; report zero bytes for it.
+    detail::DenseMapStats::record(this->getNumBuckets(), this->size(),
+                                  Small ? 0 : this->getMemorySize());
+#endif
     this->destroyAll();
     deallocateBuckets();
   }
@@ -0,0 +1,66 @@
+//===- llvm/ADT/InternedArray.h - Hash-consed immutable arrays --*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// This file defines ArrayInterner, which hash-conses immutable arrays into a
+/// caller-provided arena. It is the array analogue of UniqueStringSaver:
+/// interning the same sequence twice yields ArrayRefs with the same data
+/// pointer, so contexts that uniquify many objects holding identical operand
+/// lists (e.g. ScalarEvolution expressions) store each distinct list once.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_ADT_INTERNEDARRAY_H
+#define LLVM_ADT_INTERNEDARRAY_H
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/Support/Allocator.h"
+#include <type_traits>
+
+namespace llvm {
+
+/// Copies arrays into the provided stable storage and returns an ArrayRef
+/// pointing at the canonical copy. Interning an array with the same contents
+/// again returns the existing copy. The interned arrays live as long as the
+/// allocator and are never deallocated individually.
+template <typename T> class ArrayInterner final {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "interned arrays are memcpy'd into the arena and never "
+                "destroyed individually");
+
+  BumpPtrAllocator &Alloc;
+  DenseSet<ArrayRef<T>> Unique;
+
+public:
+  ArrayInterner(BumpPtrAllocator &Alloc) : Alloc(Alloc) {}
+
+  BumpPtrAllocator &getAllocator() const { return Alloc; }
+
+  /// Return the canonical copy of \p A, allocating one if this is the first
+  /// time these contents have been seen.
+  ArrayRef<T> intern(ArrayRef<T> A) {
+    if (A.empty())
+      return ArrayRef<T>();
+    auto It = Unique.find(A);
+    if (It != Unique.end())
+      return *It;
+    T *Mem = Alloc.template Allocate<T>(A.size());
+    std::uninitialized_copy(A.begin(), A.end(), Mem);
+    ArrayRef<T> Canonical(Mem, A.size());
+    Unique.insert(Canonical);
+    return Canonical;
+  }
+
+  /// Number of distinct arrays interned so far.
+  size_t size() const { return Unique.size(); }
+};
+
+} // namespace llvm
+
+#endif // LLVM_ADT_INTERNEDARRAY_H
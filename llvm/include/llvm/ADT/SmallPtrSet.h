@@ -107,6 +107,10 @@ public:
     NumTombstones = 0;
   }
 
+  /// reserve - Grow the set so that \p NumEntries elements fit without a
+  /// further reallocation or rehash.
+  void reserve(size_type NumEntries);
+
 protected:
   static void *getTombstoneMarker() { return reinterpret_cast<void*>(-2); }
 
@@ -393,6 +397,12 @@ public:
 
   template <typename IterT>
   void insert(IterT I, IterT E) {
+    // When the number of elements is known up front, grow the table once
+    // instead of rehashing repeatedly during the insertion loop.
+    if constexpr (std::is_convertible<
+                      typename std::iterator_traits<IterT>::iterator_category,
+                      std::forward_iterator_tag>::value)
+      reserve(this->size() + std::distance(I, E));
     for (; I != E; ++I)
       insert(*I);
   }
@@ -270,6 +270,12 @@ public:
   /// assumption is disproven.
   SmallVector<AAQueryInfo::LocPair, 4> AssumptionBasedResults;
 
+  /// Process-unique id of this query batch. Caches kept on analysis result
+  /// objects beyond a single query (e.g. BasicAA's decomposed-GEP memo)
+  /// compare epochs to detect that a new batch - after which the IR may have
+  /// changed - has started.
+  const uint64_t Epoch = getNextEpoch();
+
   /// Tracks whether the accesses may be on different cycle iterations.
   ///
   /// When interpret "Value" pointer equality as value equality we need to make
@@ -287,6 +293,9 @@ public:
   bool MayBeCrossIteration = false;
 
   AAQueryInfo(AAResults &AAR, CaptureInfo *CI) : AAR(AAR), CI(CI) {}
+
+private:
+  static uint64_t getNextEpoch();
 };
 
 /// AAQueryInfo that uses SimpleCaptureInfo.
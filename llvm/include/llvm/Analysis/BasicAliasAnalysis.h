@@ -48,15 +48,11 @@ class BasicAAResult : public AAResultBase {
 public:
   BasicAAResult(const DataLayout &DL, const Function &F,
                 const TargetLibraryInfo &TLI, AssumptionCache &AC,
-                DominatorTree *DT = nullptr)
-      : DL(DL), F(F), TLI(TLI), AC(AC), DT(DT) {}
+                DominatorTree *DT = nullptr);
 
-  BasicAAResult(const BasicAAResult &Arg)
-      : AAResultBase(Arg), DL(Arg.DL), F(Arg.F), TLI(Arg.TLI), AC(Arg.AC),
-        DT(Arg.DT) {}
-  BasicAAResult(BasicAAResult &&Arg)
-      : AAResultBase(std::move(Arg)), DL(Arg.DL), F(Arg.F), TLI(Arg.TLI),
-        AC(Arg.AC), DT(Arg.DT) {}
+  BasicAAResult(const BasicAAResult &Arg);
+  BasicAAResult(BasicAAResult &&Arg);
+  ~BasicAAResult();
 
   /// Handle invalidation events in the new pass manager.
   bool invalidate(Function &Fn, const PreservedAnalyses &PA,
@@ -93,14 +89,25 @@ public:
 
 private:
   struct DecomposedGEP;
+  struct DecomposedGEPCache;
 
   /// Tracks instructions visited by pointsToConstantMemory.
   SmallPtrSet<const Value *, 16> Visited;
 
+  /// Memoized DecomposeGEPExpression results. The memo is only valid for a
+  /// single AAQueryInfo epoch, i.e. one query or one BatchAAResults batch -
+  /// exactly the window in which callers guarantee the IR is unmodified - and
+  /// is recycled when a batch with a different epoch arrives.
+  std::unique_ptr<DecomposedGEPCache> DGCache;
+  uint64_t DGCacheEpoch = 0;
+
   static DecomposedGEP
   DecomposeGEPExpression(const Value *V, const DataLayout &DL,
                          AssumptionCache *AC, DominatorTree *DT);
 
+  /// Caching wrapper around DecomposeGEPExpression, backed by DGCache.
+  DecomposedGEP getDecomposedGEP(const Value *V, const AAQueryInfo &AAQI);
+
   /// A Heuristic for aliasGEP that searches for a constant offset
   /// between the variables.
   ///
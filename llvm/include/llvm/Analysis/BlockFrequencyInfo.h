@@ -40,6 +40,20 @@ class BlockFrequencyInfo {
 
   std::unique_ptr<ImplType> BFI;
 
+  /// When calculation is deferred (see -bfi-lazy-calculate), the recorded
+  /// inputs of the pending calculation. Cleared once frequencies are actually
+  /// computed; invalidate() accounts for the extra dependencies while these
+  /// are set.
+  const Function *DeferredF = nullptr;
+  const BranchProbabilityInfo *DeferredBPI = nullptr;
+  const LoopInfo *DeferredLI = nullptr;
+
+  void calculateImpl(const Function &F, const BranchProbabilityInfo &BPI,
+                     const LoopInfo &LI);
+
+  /// Run a deferred calculation, if one is pending.
+  void ensureCalculated() const;
+
 public:
   BlockFrequencyInfo();
   BlockFrequencyInfo(const Function &F, const BranchProbabilityInfo &BPI,
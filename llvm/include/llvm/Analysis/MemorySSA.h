@@ -715,10 +715,12 @@ public:
   /// node that exists for that block, if there is one. Otherwise, this will get
   /// a MemoryUseOrDef.
   MemoryUseOrDef *getMemoryAccess(const Instruction *I) const {
+    ensureBuilt();
     return cast_or_null<MemoryUseOrDef>(ValueToMemoryAccess.lookup(I));
   }
 
   MemoryPhi *getMemoryAccess(const BasicBlock *BB) const {
+    ensureBuilt();
     return cast_or_null<MemoryPhi>(ValueToMemoryAccess.lookup(cast<Value>(BB)));
   }
 
@@ -739,6 +741,7 @@ public:
   }
 
   inline MemoryAccess *getLiveOnEntryDef() const {
+    ensureBuilt();
     return LiveOnEntryDef.get();
   }
 
@@ -794,6 +797,15 @@ public:
   /// def-use chain of uses.
   void ensureOptimizedUses();
 
+  /// Under -memssa-lazy-build, SSA construction is deferred from the
+  /// constructor to the first query, so functions whose MemorySSA is computed
+  /// but never consulted pay nothing. All query entry points funnel through
+  /// this; it is a no-op once built (and always, in eager mode).
+  void ensureBuilt() const {
+    if (LLVM_UNLIKELY(!IsBuilt))
+      const_cast<MemorySSA *>(this)->buildLazy();
+  }
+
   AliasAnalysis &getAA() { return *AA; }
 
 protected:
@@ -807,12 +819,14 @@ protected:
 
   // This is used by the use optimizer and updater.
   AccessList *getWritableBlockAccesses(const BasicBlock *BB) const {
+    ensureBuilt();
     auto It = PerBlockAccesses.find(BB);
     return It == PerBlockAccesses.end() ? nullptr : It->second.get();
   }
 
   // This is used by the use optimizer and updater.
   DefsList *getWritableBlockDefs(const BasicBlock *BB) const {
+    ensureBuilt();
     auto It = PerBlockDefs.find(BB);
     return It == PerBlockDefs.end() ? nullptr : It->second.get();
   }
@@ -848,6 +862,7 @@ private:
 
   CachingWalker *getWalkerImpl();
   void buildMemorySSA(BatchAAResults &BAA);
+  void buildLazy();
 
   void prepareForMoveTo(MemoryAccess *, BasicBlock *);
   void verifyUseInDefs(MemoryAccess *, MemoryAccess *) const;
@@ -898,6 +913,7 @@ private:
   std::unique_ptr<SkipSelfWalker> SkipWalker;
   unsigned NextID = 0;
   bool IsOptimized = false;
+  bool IsBuilt = false;
 };
 
 /// Enables verification of MemorySSA.
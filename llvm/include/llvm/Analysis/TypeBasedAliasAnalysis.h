@@ -15,6 +15,7 @@
 #ifndef LLVM_ANALYSIS_TYPEBASEDALIASANALYSIS_H
 #define LLVM_ANALYSIS_TYPEBASEDALIASANALYSIS_H
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/IR/PassManager.h"
 #include "llvm/Pass.h"
@@ -51,6 +52,14 @@ public:
                            AAQueryInfo &AAQI);
 
 private:
+  /// Memoized access-tag match results. Uniqued TBAA nodes are immutable and
+  /// live for the lifetime of the context, and programs use a small set of
+  /// distinct tags, so the tag-pair universe is tiny compared to the number
+  /// of queries; most queries reduce to one hash lookup instead of a pair of
+  /// type-DAG walks.
+  mutable SmallDenseMap<std::pair<const MDNode *, const MDNode *>, bool, 16>
+      MatchCache;
+
   bool Aliases(const MDNode *A, const MDNode *B) const;
 };
 
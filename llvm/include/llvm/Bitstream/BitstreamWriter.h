@@ -374,6 +374,37 @@ private:
     }
   }
 
+  /// EmitAbbreviatedArrayElts - Emit the elements of an abbreviated array
+  /// operand. Fixed and Char6 elements are packed LSB-first into 32-bit
+  /// chunks, several per Emit() call; the emitted bits are identical to
+  /// emitting each element separately.
+  template <typename uintty>
+  void EmitAbbreviatedArrayElts(const BitCodeAbbrevOp &EltEnc,
+                                ArrayRef<uintty> Vals) {
+    unsigned PackWidth = 0;
+    if (EltEnc.getEncoding() == BitCodeAbbrevOp::Char6)
+      PackWidth = 6;
+    else if (EltEnc.getEncoding() == BitCodeAbbrevOp::Fixed)
+      PackWidth = (unsigned)EltEnc.getEncodingData();
+    if (PackWidth >= 1 && PackWidth <= 16) {
+      const unsigned PerEmit = 32 / PackWidth;
+      while (Vals.size() >= PerEmit) {
+        uint32_t Packed = 0;
+        for (unsigned J = 0; J != PerEmit; ++J) {
+          uint32_t Elt = EltEnc.getEncoding() == BitCodeAbbrevOp::Char6
+                             ? BitCodeAbbrevOp::EncodeChar6((char)Vals[J])
+                             : (uint32_t)Vals[J];
+          assert((Elt >> PackWidth) == 0 && "High bits set!");
+          Packed |= Elt << (J * PackWidth);
+        }
+        Emit(Packed, PerEmit * PackWidth);
+        Vals = Vals.drop_front(PerEmit);
+      }
+    }
+    for (uintty V : Vals)
+      EmitAbbreviatedField(EltEnc, V);
+  }
+
   /// EmitRecordWithAbbrevImpl - This is the core implementation of the record
   /// emission code.  If BlobData is non-null, then it specifies an array of
   /// data that should be emitted as part of the Blob or Array operand that is
@@ -427,8 +458,9 @@ private:
           EmitVBR(static_cast<uint32_t>(BlobLen), 6);
 
           // Emit each field.
-          for (unsigned i = 0; i != BlobLen; ++i)
-            EmitAbbreviatedField(EltEnc, (unsigned char)BlobData[i]);
+          EmitAbbreviatedArrayElts(
+              EltEnc, ArrayRef<uint8_t>(
+                          reinterpret_cast<const uint8_t *>(BlobData), BlobLen));
 
           // Know that blob data is consumed for assertion below.
           BlobData = nullptr;
@@ -437,8 +469,8 @@ private:
           EmitVBR(static_cast<uint32_t>(Vals.size()-RecordIdx), 6);
 
           // Emit each field.
-          for (unsigned e = Vals.size(); RecordIdx != e; ++RecordIdx)
-            EmitAbbreviatedField(EltEnc, Vals[RecordIdx]);
+          EmitAbbreviatedArrayElts(EltEnc, Vals.slice(RecordIdx));
+          RecordIdx = Vals.size();
         }
       } else if (Op.getEncoding() == BitCodeAbbrevOp::Blob) {
         // If this record has blob data, emit it, otherwise we must have record
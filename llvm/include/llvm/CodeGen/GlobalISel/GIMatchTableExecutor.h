@@ -18,6 +18,7 @@
 #include "llvm/ADT/Bitset.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/CodeGen/GlobalISel/Utils.h"
 #include "llvm/CodeGen/LowLevelType.h"
 #include "llvm/CodeGen/MachineFunction.h"
@@ -507,7 +508,7 @@ enum {
 /// apply MIR patterns.
 class GIMatchTableExecutor {
 public:
-  virtual ~GIMatchTableExecutor() = default;
+  virtual ~GIMatchTableExecutor();
 
   CodeGenCoverage *CoverageInfo = nullptr;
   GISelKnownBits *KB = nullptr;
@@ -588,6 +589,34 @@ public:
 protected:
   GIMatchTableExecutor();
 
+  /// Decoded header of the GIM_SwitchOpcode that generated match tables begin
+  /// with. It is filled in lazily the first time a table is executed; later
+  /// executions of the same table dispatch straight to the rule group for the
+  /// root instruction's opcode instead of re-interpreting the header.
+  struct MatchTableDispatch {
+    const int64_t *Table = nullptr;
+    int64_t LowerBound = 0;
+    int64_t UpperBound = 0;
+    uint64_t Default = 0;
+    const int64_t *JumpTable = nullptr;
+  };
+  mutable MatchTableDispatch Dispatch;
+
+  /// True if -gisel-match-table-stats is enabled. Sampled once at
+  /// construction so the hot path only tests a member.
+  bool CollectMatchTableStats;
+
+  /// Match table executions and successful matches keyed by the root
+  /// instruction's opcode name. Only populated when CollectMatchTableStats is
+  /// set; the accumulated hit rates are printed when the executor is
+  /// destroyed.
+  mutable StringMap<std::pair<uint64_t, uint64_t>> MatchTableStats;
+
+  /// Count one execution of the match table for root opcode \p Opcode, or one
+  /// successful match of it when \p Matched is true.
+  void recordMatchTableAttempt(unsigned Opcode, const TargetInstrInfo &TII,
+                               bool Matched) const;
+
   /// Execute a given matcher table and return true if the match was successful
   /// and false otherwise.
   template <class TgtExecutor, class PredicateBitset, class ComplexMatcherMemFn,
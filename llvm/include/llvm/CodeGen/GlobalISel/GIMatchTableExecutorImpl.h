@@ -56,6 +56,29 @@ bool GIMatchTableExecutor::executeMatchTable(
   SmallVector<uint64_t, 4> OnFailResumeAt;
   NewMIVector OutMIs;
 
+  const unsigned RootOpcode = State.MIs[0]->getOpcode();
+  if (LLVM_UNLIKELY(CollectMatchTableStats))
+    recordMatchTableAttempt(RootOpcode, TII, /*Matched=*/false);
+
+  // Generated match tables begin with a GIM_SwitchOpcode on the root
+  // instruction. Decode its header the first time a table is executed and
+  // dispatch straight to the rule group for the root opcode afterwards.
+  if (MatchTable == Dispatch.Table) {
+    const int64_t Opcode = RootOpcode;
+    if (Opcode < Dispatch.LowerBound || Dispatch.UpperBound <= Opcode) {
+      CurrentIdx = Dispatch.Default;
+    } else if (int64_t Target =
+                   Dispatch.JumpTable[Opcode - Dispatch.LowerBound]) {
+      CurrentIdx = Target;
+      OnFailResumeAt.push_back(Dispatch.Default);
+    } else {
+      CurrentIdx = Dispatch.Default;
+    }
+  } else if (MatchTable[0] == GIM_SwitchOpcode && MatchTable[1] == 0) {
+    Dispatch = {MatchTable, MatchTable[2], MatchTable[3],
+                static_cast<uint64_t>(MatchTable[4]), MatchTable + 5};
+  }
+
   GISelChangeObserver *Observer = Builder.getObserver();
   // Bypass the flag check on the instruction, and only look at the MCInstrDesc.
   bool NoFPException = !State.MIs[0]->getDesc().mayRaiseFPException();
@@ -1418,6 +1441,8 @@ bool GIMatchTableExecutor::executeMatchTable(
       DEBUG_WITH_TYPE(TgtExecutor::getName(),
                       dbgs() << CurrentIdx << ": GIR_Done\n");
       propagateFlags();
+      if (LLVM_UNLIKELY(CollectMatchTableStats))
+        recordMatchTableAttempt(RootOpcode, TII, /*Matched=*/true);
       return true;
     default:
       llvm_unreachable("Unexpected command");
@@ -16,6 +16,8 @@
 #ifndef LLVM_CODEGEN_LIVEINTERVALUNION_H
 #define LLVM_CODEGEN_LIVEINTERVALUNION_H
 
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/BitVector.h"
 #include "llvm/ADT/IntervalMap.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/CodeGen/LiveInterval.h"
@@ -193,6 +195,12 @@ public:
       assert(Idx < Size && "Idx out of bounds");
       return LIUs[Idx];
     }
+
+    /// Check \p LR for interference against several of the unions in this
+    /// array in a single pass over its segments. Returns a bit vector
+    /// parallel to \p Units with a bit set for every union \p LR overlaps.
+    BitVector checkInterference(const LiveRange &LR,
+                                ArrayRef<unsigned> Units) const;
   };
 };
 
@@ -275,10 +275,14 @@ class VirtRegMap;
     }
 
     void RemoveMachineInstrFromMaps(MachineInstr &MI) {
+      if (!RepairQueue.empty())
+        updateQueuedRepairsForRemoval(MI);
       Indexes->removeMachineInstrFromMaps(MI);
     }
 
     SlotIndex ReplaceMachineInstrInMaps(MachineInstr &MI, MachineInstr &NewMI) {
+      if (!RepairQueue.empty())
+        updateQueuedRepairsForRemoval(MI);
       return Indexes->replaceMachineInstrInMaps(MI, NewMI);
     }
 
@@ -336,6 +340,25 @@ class VirtRegMap;
                                 MachineBasicBlock::iterator End,
                                 ArrayRef<Register> OrigRegs);
 
+    /// Queue a range for repair by applyQueuedRepairs(). Queued ranges in the
+    /// same basic block are coalesced when they overlap, so a pass rewriting
+    /// several neighbouring instruction sequences pays for one walk of the
+    /// combined range instead of one walk per rewrite. Pending repairs are
+    /// applied automatically before handleMove() changes the instruction
+    /// order; until they are applied, queries about registers in a queued
+    /// range see unrepaired intervals, so callers must applyQueuedRepairs()
+    /// before making such queries.
+    void queueRepairIntervalsInRange(MachineBasicBlock *MBB,
+                                     MachineBasicBlock::iterator Begin,
+                                     MachineBasicBlock::iterator End,
+                                     ArrayRef<Register> OrigRegs);
+
+    /// Apply and clear all repairs queued by queueRepairIntervalsInRange().
+    void applyQueuedRepairs() {
+      if (!RepairQueue.empty())
+        applyQueuedRepairsImpl();
+    }
+
     // Register mask functions.
     //
     // Machine instructions may use a register mask operand to indicate that a
@@ -487,6 +510,25 @@ class VirtRegMap;
                              Register Reg,
                              LaneBitmask LaneMask = LaneBitmask::getAll());
 
+    /// A repair request queued by queueRepairIntervalsInRange(). The range is
+    /// delimited by indexed instructions only: it covers the instructions
+    /// after BeginIdx (from the block start if invalid) up to and including
+    /// EndIdx (to the block end if invalid), so no iterator to an unindexed
+    /// instruction outlives the call that queued it.
+    struct QueuedRepair {
+      MachineBasicBlock *MBB;
+      SlotIndex BeginIdx;
+      SlotIndex EndIdx;
+      SmallVector<Register, 8> OrigRegs;
+    };
+    SmallVector<QueuedRepair, 4> RepairQueue;
+
+    void applyQueuedRepairsImpl();
+
+    /// Re-anchor any queued repair delimited by \p MI, which is about to be
+    /// removed from the maps.
+    void updateQueuedRepairsForRemoval(MachineInstr &MI);
+
     class HMEditor;
   };
 
@@ -472,6 +472,11 @@ private:
   int calculateResMIIDFA() const;
   /// Check if MRT is overbooked
   bool isOverbooked() const;
+  /// Check if the MRT entries touched by scheduling \p SCDesc at \p Cycle are
+  /// overbooked. Equivalent to isOverbooked() right after reserving \p SCDesc
+  /// at \p Cycle, since committed reservations never overbook, but only scans
+  /// the touched slots instead of the whole table.
+  bool isOverbooked(const MCSchedClassDesc *SCDesc, int Cycle) const;
   /// Reserve resources on MRT
   void reserveResources(const MCSchedClassDesc *SCDesc, int Cycle);
   /// Unreserve resources on MRT
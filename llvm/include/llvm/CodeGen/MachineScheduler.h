@@ -200,6 +200,14 @@ struct MachineSchedPolicy {
   // Compute DFSResult for use in scheduling heuristics.
   bool ComputeDFSResult = false;
 
+  // Cap the number of instructions scheduled at once. Regions larger than
+  // this are split into windows of at most MaxRegionInstrs instructions that
+  // are scheduled independently, bounding the size (and construction cost) of
+  // the dependency DAG. 0 means regions are never split. Windows should
+  // comfortably exceed the critical path length of the subtarget's
+  // SchedModel, otherwise latency hiding degrades at the window seams.
+  unsigned MaxRegionInstrs = 0;
+
   MachineSchedPolicy() = default;
 };
 
@@ -235,6 +243,11 @@ public:
   // beginning with the topmost region of MBB.
   virtual bool doMBBSchedRegionsTopDown() const { return false; }
 
+  /// Cap on the number of instructions scheduled at once, or 0 if regions may
+  /// be arbitrarily large. Called after initPolicy() for each region; see
+  /// MachineSchedPolicy::MaxRegionInstrs.
+  virtual unsigned maxRegionInstrs() const { return 0; }
+
   /// Initialize the strategy after building the DAG for a new region.
   virtual void initialize(ScheduleDAGMI *DAG) = 0;
 
@@ -314,6 +327,10 @@ public:
     return SchedImpl->doMBBSchedRegionsTopDown();
   }
 
+  unsigned maxRegionInstrs() const override {
+    return SchedImpl->maxRegionInstrs();
+  }
+
   // Returns LiveIntervals instance for use in DAG mutators and such.
   LiveIntervals *getLIS() const { return LIS; }
 
@@ -1227,6 +1244,10 @@ public:
     return RegionPolicy.ShouldTrackLaneMasks;
   }
 
+  unsigned maxRegionInstrs() const override {
+    return RegionPolicy.MaxRegionInstrs;
+  }
+
   void initialize(ScheduleDAGMI *dag) override;
 
   SUnit *pickNode(bool &IsTopNode) override;
@@ -292,6 +292,12 @@ namespace llvm {
     /// beginning with the topmost region of MBB.
     virtual bool doMBBSchedRegionsTopDown() const { return false; }
 
+    /// Cap on the number of instructions to schedule at once, or 0 if
+    /// regions may be arbitrarily large. Oversized regions are split into
+    /// windows of at most this many instructions that are scheduled
+    /// independently. Only meaningful inside a region, after enterRegion().
+    virtual unsigned maxRegionInstrs() const { return 0; }
+
     /// Prepares to perform scheduling in the given block.
     virtual void startBlock(MachineBasicBlock *BB);
 
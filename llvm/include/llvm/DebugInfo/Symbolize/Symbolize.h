@@ -248,7 +248,11 @@ public:
       Evictor();
   }
 
-  size_t size() { return Bin.getBinary()->getData().size(); }
+  size_t size() {
+    // Negative cache entries (failed lookups) hold no binary.
+    Binary *B = Bin.getBinary();
+    return B ? B->getData().size() : 0;
+  }
 
 private:
   OwningBinary<Binary> Bin;
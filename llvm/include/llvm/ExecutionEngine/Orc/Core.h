@@ -1454,10 +1454,30 @@ public:
 
   /// Run the given lambda with the session mutex locked.
   template <typename Func> decltype(auto) runSessionLocked(Func &&F) {
-    std::lock_guard<std::recursive_mutex> Lock(SessionMutex);
+    std::unique_lock<std::recursive_mutex> Lock(SessionMutex, std::try_to_lock);
+    if (!Lock.owns_lock()) {
+      ++ContendedSessionLockAcquisitions;
+      Lock.lock();
+    }
+    ++SessionLockAcquisitions;
     return F();
   }
 
+  /// Total number of session lock acquisitions so far.
+  uint64_t getTotalSessionLockAcquisitions() const {
+    return SessionLockAcquisitions;
+  }
+
+  /// Number of session lock acquisitions that had to wait because another
+  /// thread held the lock. A high contended/total ratio suggests that symbols
+  /// are being moved through their states individually rather than in bulk:
+  /// prefer a single notifyResolved / notifyEmitted call covering a whole
+  /// SymbolMap, which performs one state transition per phase under one lock
+  /// acquisition.
+  uint64_t getContendedSessionLockAcquisitions() const {
+    return ContendedSessionLockAcquisitions;
+  }
+
   /// Register the given ResourceManager with this ExecutionSession.
   /// Managers will be notified of events in reverse order of registration.
   void registerResourceManager(ResourceManager &RM);
@@ -1792,6 +1812,8 @@ private:
 #endif // NDEBUG
 
   mutable std::recursive_mutex SessionMutex;
+  mutable std::atomic<uint64_t> SessionLockAcquisitions{0};
+  mutable std::atomic<uint64_t> ContendedSessionLockAcquisitions{0};
   bool SessionOpen = true;
   std::unique_ptr<ExecutorProcessControl> EPC;
   std::unique_ptr<Platform> P;
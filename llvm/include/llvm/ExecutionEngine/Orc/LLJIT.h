@@ -319,6 +319,7 @@ public:
   ProcessSymbolsJITDylibSetupFunction SetupProcessSymbolsJITDylib;
   ObjectLinkingLayerCreator CreateObjectLinkingLayer;
   CompileFunctionCreator CreateCompileFunction;
+  ObjectCache *ObjCache = nullptr;
   unique_function<Error(LLJIT &)> PrePlatformSetup;
   PlatformSetupFunction SetUpPlatform;
   unsigned NumCompileThreads = 0;
@@ -418,6 +419,18 @@ public:
     return impl();
   }
 
+  /// Set an ObjectCache for the default compile function to consult before
+  /// compiling, and to notify of each newly compiled object. Modules whose
+  /// objects are found in the cache skip IR optimization and codegen
+  /// entirely. The cache is not owned and must outlive the JIT.
+  ///
+  /// This setting is ignored if a custom CompileFunctionCreator is installed;
+  /// such creators can wire a cache into their own compiler directly.
+  SetterImpl &setObjectCache(ObjectCache *ObjCache) {
+    impl().ObjCache = ObjCache;
+    return impl();
+  }
+
   /// Set a setup function to be run just before the PlatformSetupFunction is
   /// run.
   ///
@@ -16,6 +16,7 @@
 #include "llvm/Analysis/BranchProbabilityInfo.h"
 #include "llvm/ExecutionEngine/Orc/Core.h"
 #include "llvm/ExecutionEngine/Orc/Speculation.h"
+#include "llvm/Support/MemoryBuffer.h"
 
 namespace llvm {
 
@@ -76,6 +77,28 @@ public:
   ResultTy operator()(Function &F);
 };
 
+// Predicts likely functions from a call-order profile gathered on a previous
+// run: a plain text file with one IR function name per line, in order of
+// first execution ('#' lines are comments). For a function at position I in
+// the profile, the next LookaheadWindow entries are reported as likely, so
+// their compilation is kicked off before control reaches them.
+class CallOrderProfileQuery : public SpeculateQuery {
+public:
+  static Expected<CallOrderProfileQuery>
+  fromFile(StringRef ProfilePath, unsigned LookaheadWindow = 4);
+
+  ResultTy operator()(Function &F);
+
+private:
+  CallOrderProfileQuery(std::unique_ptr<MemoryBuffer> ProfileBuffer,
+                        unsigned LookaheadWindow);
+
+  // Owns the storage the StringRefs in FollowersMap point into; shared so
+  // copies of the query (it is carried around in a std::function) are cheap.
+  std::shared_ptr<MemoryBuffer> ProfileBuffer;
+  StringMap<SmallVector<StringRef, 4>> FollowersMap;
+};
+
 } // namespace orc
 } // namespace llvm
 
@@ -18,6 +18,7 @@
 #include "llvm/ExecutionEngine/Orc/DebugUtils.h"
 #include "llvm/ExecutionEngine/Orc/IRCompileLayer.h"
 #include "llvm/Support/Debug.h"
+#include <atomic>
 #include <mutex>
 #include <type_traits>
 #include <utility>
@@ -77,10 +78,13 @@ private:
     {
       std::lock_guard<std::mutex> Lockit(ConcurrentAccess);
       auto It = GlobalSpecMap.find(FAddr);
-      if (It == GlobalSpecMap.end())
+      if (It == GlobalSpecMap.end()) {
+        ++SpeculationsWithoutPrediction;
         return;
+      }
       CandidateSet = It->getSecond();
     }
+    ++SpeculationsLaunched;
 
     SymbolDependenceMap SpeculativeLookUpImpls;
 
@@ -93,6 +97,7 @@ private:
       JITDylib *ImplJD = ImplSymbol->second;
       auto &SymbolsInJD = SpeculativeLookUpImpls[ImplJD];
       SymbolsInJD.insert(ImplSymbolName);
+      ++SymbolsSpeculated;
     }
 
     DEBUG_WITH_TYPE("orc", {
@@ -160,12 +165,26 @@ public:
 
   ExecutionSession &getES() { return ES; }
 
+  /// Telemetry, so clients can judge how well their query predicts execution.
+  /// Number of stub entries that triggered a speculative lookup.
+  uint64_t getNumSpeculationsLaunched() const { return SpeculationsLaunched; }
+  /// Number of stub entries for which no prediction was registered.
+  uint64_t getNumSpeculationsWithoutPrediction() const {
+    return SpeculationsWithoutPrediction;
+  }
+  /// Number of individual symbols whose compilation was requested ahead of
+  /// first call.
+  uint64_t getNumSymbolsSpeculated() const { return SymbolsSpeculated; }
+
 private:
   static void speculateForEntryPoint(Speculator *Ptr, uint64_t StubId);
   std::mutex ConcurrentAccess;
   ImplSymbolMap &AliaseeImplTable;
   ExecutionSession &ES;
   StubAddrLikelies GlobalSpecMap;
+  std::atomic<uint64_t> SpeculationsLaunched{0};
+  std::atomic<uint64_t> SpeculationsWithoutPrediction{0};
+  std::atomic<uint64_t> SymbolsSpeculated{0};
 };
 
 class IRSpeculationLayer : public IRLayer {
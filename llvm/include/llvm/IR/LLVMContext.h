@@ -31,6 +31,7 @@ class Instruction;
 class LLVMContextImpl;
 class Module;
 class OptPassGate;
+class raw_ostream;
 template <typename T> class SmallVectorImpl;
 template <typename T> class StringMapEntry;
 class StringRef;
@@ -149,6 +150,12 @@ public:
   /// especially in release mode.
   void setDiscardValueNames(bool Discard);
 
+  /// Print entry counts and approximate byte sizes of this context's uniquing
+  /// tables and allocators to \p OS, for attributing context memory growth to
+  /// specific tables. Also available at context destruction via the
+  /// -print-context-stats flag.
+  void printStats(raw_ostream &OS) const;
+
   /// Whether there is a string map for uniquing debug info
   /// identifiers across the context.  Off by default.
   bool isODRUniquingDebugTypes() const;
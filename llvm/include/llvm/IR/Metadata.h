@@ -1152,7 +1152,10 @@ protected:
   ~MDNode() = default;
 
   void *operator new(size_t Size, size_t NumOps, StorageType Storage);
-  void operator delete(void *Mem);
+  // Sized so deleteAsSubclass() can hand small nodes back to the per-thread
+  // size-class pool (see Metadata.cpp). Deletion always happens through the
+  // concrete subclass, so Size is the exact size passed to operator new.
+  void operator delete(void *Mem, size_t Size);
 
   /// Required by std, but never called.
   void operator delete(void *, unsigned) {
@@ -1219,6 +1219,13 @@ using ModuleAnalysisManagerFunctionProxy =
 /// Note that although function passes can access module analyses, module
 /// analyses are not invalidated while the function passes are running, so they
 /// may be stale.  Function analyses will not be stale.
+///
+/// The adaptor deliberately runs functions serially. Even under the exclusive
+/// access rules above, function passes constantly create constants, types and
+/// metadata, which are uniqued in the shared LLVMContext, and manipulate the
+/// use lists of globals; none of that is synchronized. Until it is, the unit
+/// of safe parallelism is the LLVMContext, which is what ThinLTO backends and
+/// split codegen parallelize over.
 class ModuleToFunctionPassAdaptor
     : public PassInfoMixin<ModuleToFunctionPassAdaptor> {
 public:
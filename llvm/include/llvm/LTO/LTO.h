@@ -228,12 +228,19 @@ ThinBackend createInProcessThinBackend(ThreadPoolStrategy Parallelism,
 /// the objects with NativeObjectPrefix instead of NewPrefix. OnWrite is
 /// callback which receives module identifier and notifies LTO user that index
 /// file for the module (and optionally imports file) was created.
-ThinBackend createWriteIndexesThinBackend(std::string OldPrefix,
-                                          std::string NewPrefix,
-                                          std::string NativeObjectPrefix,
-                                          bool ShouldEmitImportsFiles,
-                                          raw_fd_ostream *LinkedObjectsFile,
-                                          IndexWriteCallback OnWrite);
+/// GetIndexStream, if non-null, supplies the output stream for each module's
+/// sharded index instead of a ".thinlto.bc" file next to the module; this
+/// lets distributed build clients ship each backend job only its own summary
+/// slice (e.g. over a network transport) rather than going through a shared
+/// filesystem.
+using IndexWriteStreamCallback =
+    std::function<Expected<std::unique_ptr<raw_ostream>>(
+        const std::string &ModulePath)>;
+ThinBackend createWriteIndexesThinBackend(
+    std::string OldPrefix, std::string NewPrefix,
+    std::string NativeObjectPrefix, bool ShouldEmitImportsFiles,
+    raw_fd_ostream *LinkedObjectsFile, IndexWriteCallback OnWrite,
+    IndexWriteStreamCallback GetIndexStream = nullptr);
 
 /// This class implements a resolution-based interface to LLVM's LTO
 /// functionality. It supports regular LTO, parallel LTO code generation and
@@ -65,6 +65,12 @@ public:
     Hardware.push_back(std::move(H));
   }
 
+  /// Release the hardware units owned by this context. Units accumulate with
+  /// every pipeline created from this context, so a driver that simulates many
+  /// code regions with one context should call this between regions, once the
+  /// pipelines referencing the units have been destroyed.
+  void clearHardwareUnits() { Hardware.clear(); }
+
   /// Construct a basic pipeline for simulating an out-of-order pipeline.
   /// This pipeline consists of Fetch, Dispatch, Execute, and Retire stages.
   std::unique_ptr<Pipeline> createDefaultPipeline(const PipelineOptions &Opts,
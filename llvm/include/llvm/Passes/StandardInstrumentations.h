@@ -15,12 +15,14 @@
 #ifndef LLVM_PASSES_STANDARDINSTRUMENTATIONS_H
 #define LLVM_PASSES_STANDARDINSTRUMENTATIONS_H
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/IR/BasicBlock.h"
 #include "llvm/IR/OptBisect.h"
 #include "llvm/IR/PassTimingInfo.h"
+#include "llvm/IR/StructuralHash.h"
 #include "llvm/IR/ValueHandle.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/TimeProfiler.h"
@@ -100,6 +102,22 @@ public:
   void registerCallbacks(PassInstrumentationCallbacks &PIC);
 };
 
+/// Skips optional function passes that cannot usefully fire on a function,
+/// based on cheap syntactic features: instruction count, presence of loops
+/// and presence of floating-point operations. Only passes on the gating
+/// lists (loop-dependent and FP-dependent, overridable on the command line)
+/// are ever skipped, and only on functions small enough that the feature
+/// scan itself is trivial. Off by default; enable with
+/// -enable-pipeline-gating. Skip counts are reported through -stats so that
+/// gated and ungated runs can be compared.
+class PipelineGatingInstrumentation {
+public:
+  void registerCallbacks(PassInstrumentationCallbacks &PIC);
+
+private:
+  bool shouldRun(StringRef PassID, Any IR);
+};
+
 struct PrintPassOptions {
   /// Print adaptors and pass managers.
   bool Verbose = false;
@@ -446,6 +464,11 @@ protected:
 class VerifyInstrumentation {
   bool DebugLogging;
 
+  /// Per-function structural hashes snapshotted before each module pass,
+  /// used by -verify-each-incremental to re-verify only the functions the
+  /// pass actually changed.
+  DenseMap<const Function *, IRHash> FunctionHashes;
+
 public:
   VerifyInstrumentation(bool DebugLogging) : DebugLogging(DebugLogging) {}
   void registerCallbacks(PassInstrumentationCallbacks &PIC);
@@ -467,6 +490,12 @@ private:
   // Implementation of pass instrumentation callbacks.
   void runBeforePass(StringRef PassID, Any IR);
   void runAfterPass();
+  void runAfterPassInvalidated();
+
+  // IR units of the currently open time sections, innermost last. Kept so
+  // the section detail (the IR name) can be computed lazily when a section
+  // closes instead of on every pass entry.
+  SmallVector<Any, 8> TimedIR;
 };
 
 // Class that holds transitions between basic blocks.  The transitions
@@ -572,6 +601,7 @@ class StandardInstrumentations {
   TimeProfilingPassesHandler TimeProfilingPasses;
   OptNoneInstrumentation OptNone;
   OptPassGateInstrumentation OptPassGate;
+  PipelineGatingInstrumentation PipelineGating;
   PreservedCFGCheckerInstrumentation PreservedCFGChecker;
   IRChangedPrinter PrintChangedIR;
   PseudoProbeVerifier PseudoProbeVerification;
@@ -33,6 +33,7 @@
 #include <cstdint>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <system_error>
 #include <tuple>
@@ -584,6 +585,11 @@ class CoverageMapping {
   DenseMap<size_t, SmallVector<unsigned, 0>> FilenameHash2RecordIndices;
   std::vector<std::pair<std::string, uint64_t>> FuncHashMismatches;
 
+  /// Serializes concurrent calls to \c loadFromFile: neither the maps above
+  /// nor the shared profile reader are synchronized, so only the object
+  /// parsing and record decoding stages run in parallel.
+  std::mutex LoadLock;
+
   CoverageMapping() = default;
 
   // Load coverage records from readers.
@@ -30,6 +30,7 @@
 #ifndef LLVM_REMARKS_REMARKSTREAMER_H
 #define LLVM_REMARKS_REMARKSTREAMER_H
 
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Remarks/RemarkSerializer.h"
 #include "llvm/Support/Error.h"
 #include "llvm/Support/Regex.h"
@@ -48,6 +49,9 @@ class RemarkStreamer final {
   std::unique_ptr<remarks::RemarkSerializer> RemarkSerializer;
   /// The filename that the remark diagnostics are emitted to.
   const std::optional<std::string> Filename;
+  /// Number of remarks seen so far for each remark name, used to decimate
+  /// high-frequency remarks when sampling is enabled.
+  StringMap<uint64_t> RemarkCounts;
 
 public:
   RemarkStreamer(std::unique_ptr<remarks::RemarkSerializer> RemarkSerializer,
@@ -66,6 +70,12 @@ public:
   Error setFilter(StringRef Filter);
   /// Check wether the string matches the filter.
   bool matchesFilter(StringRef Str);
+  /// Decide whether one more remark named \p RemarkName should be emitted or
+  /// dropped by sampling. Once more than remarks-sample-threshold remarks
+  /// with the same name have been seen, only one out of every
+  /// remarks-sample-rate further occurrences is kept. Each call counts one
+  /// occurrence.
+  bool shouldSampleRemark(StringRef RemarkName);
   /// Check if the remarks also need to have associated metadata in a section.
   bool needsSection() const;
 };
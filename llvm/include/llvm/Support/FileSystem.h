@@ -1297,6 +1297,8 @@ private:
 
   void unmapImpl();
   void dontNeedImpl();
+  void adviseSequentialImpl();
+  void willNeedImpl(size_t Offset, size_t Length);
 
   std::error_code init(sys::fs::file_t FD, uint64_t Offset, mapmode Mode);
 
@@ -1328,6 +1330,17 @@ public:
   }
   void dontNeed() { dontNeedImpl(); }
 
+  /// Hint to the OS that the mapping will be read front to back, so it can
+  /// use a more aggressive readahead window.
+  void adviseSequential() { adviseSequentialImpl(); }
+
+  /// Hint to the OS to start paging in [\p Offset, \p Offset + \p Length)
+  /// of the mapping in the background. \p Length of 0 means up to the end of
+  /// the mapping. Returns immediately; the read happens asynchronously.
+  void willNeed(size_t Offset = 0, size_t Length = 0) {
+    willNeedImpl(Offset, Length);
+  }
+
   size_t size() const;
   char *data() const;
 
@@ -131,6 +131,13 @@ inline unsigned encodeULEB128(uint64_t Value, uint8_t *p,
 inline uint64_t decodeULEB128(const uint8_t *p, unsigned *n = nullptr,
                               const uint8_t *end = nullptr,
                               const char **error = nullptr) {
+  // Single-byte values are by far the most common; decode them without the
+  // shift/accumulate loop.
+  if (LLVM_LIKELY(p != end && *p < 0x80)) {
+    if (n)
+      *n = 1;
+    return *p;
+  }
   const uint8_t *orig_p = p;
   uint64_t Value = 0;
   unsigned Shift = 0;
@@ -165,6 +172,14 @@ inline uint64_t decodeULEB128(const uint8_t *p, unsigned *n = nullptr,
 inline int64_t decodeSLEB128(const uint8_t *p, unsigned *n = nullptr,
                              const uint8_t *end = nullptr,
                              const char **error = nullptr) {
+  // Single-byte values are by far the most common; decode them without the
+  // shift/accumulate loop. Shifting bit 6 into the sign position and back
+  // sign-extends the 7-bit payload.
+  if (LLVM_LIKELY(p != end && *p < 0x80)) {
+    if (n)
+      *n = 1;
+    return int64_t(int8_t(*p << 1)) >> 1;
+  }
   const uint8_t *orig_p = p;
   int64_t Value = 0;
   unsigned Shift = 0;
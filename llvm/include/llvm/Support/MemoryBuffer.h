@@ -82,6 +82,17 @@ public:
   /// function should not be called on a writable buffer.
   virtual void dontNeedIfMmap() {}
 
+  /// For read-only MemoryBuffer_MMap, hint to the kernel that the buffer
+  /// will be read sequentially, enabling aggressive readahead. No-op for
+  /// other buffer kinds.
+  virtual void adviseSequentialIfMmap() {}
+
+  /// For read-only MemoryBuffer_MMap, ask the kernel to start paging in
+  /// [\p Offset, \p Offset + \p Length) of the buffer in the background
+  /// (\p Length of 0 means up to the end). Returns immediately, so callers
+  /// can overlap page-in with parsing. No-op for other buffer kinds.
+  virtual void willNeedIfMmap(size_t Offset = 0, size_t Length = 0) {}
+
   /// Open the specified file as a MemoryBuffer, returning a new MemoryBuffer
   /// if successful, otherwise returning null.
   ///
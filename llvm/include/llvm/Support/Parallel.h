@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <condition_variable>
 #include <functional>
+#include <memory>
 #include <mutex>
 
 namespace llvm {
@@ -111,6 +112,13 @@ namespace detail {
 #if LLVM_ENABLE_THREADS
 const ptrdiff_t MinParallelSize = 1024;
 
+// TaskGroup has a relatively high overhead, so we want to reduce
+// the number of spawn() calls. We'll create up to 1024 tasks here.
+// (Note that 1024 is an arbitrary number. This code probably needs
+// improving to take the number of available cores into account.)
+enum { MaxTasksPerGroup = 1024 };
+
+
 /// Inclusive median.
 template <class RandomAccessIterator, class Comparator>
 RandomAccessIterator medianOf3(RandomAccessIterator Start,
@@ -150,20 +158,134 @@ void parallel_quick_sort(RandomAccessIterator Start, RandomAccessIterator End,
   parallel_quick_sort(Pivot + 1, End, Comp, TG, Depth - 1);
 }
 
+/// \returns how many elements of [\p A, \p A + \p LenA) precede the K-th
+/// element of the sequence that merging [A, A+LenA) and [B, B+LenB) would
+/// produce. Ties are resolved towards A, which keeps the merge stable.
+template <class RandomAccessIterator, class Comparator>
+size_t merge_split_point(RandomAccessIterator A, size_t LenA,
+                         RandomAccessIterator B, size_t LenB, size_t K,
+                         const Comparator &Comp) {
+  size_t Lo = K > LenB ? K - LenB : 0;
+  size_t Hi = std::min(K, LenA);
+  while (Lo < Hi) {
+    size_t Mid = Lo + (Hi - Lo) / 2;
+    if (Comp(*(B + (K - Mid - 1)), *(A + Mid)))
+      Hi = Mid;
+    else
+      Lo = Mid + 1;
+  }
+  return Lo;
+}
+
+/// Merge the sorted ranges [\p ABegin, \p AEnd) and [\p BBegin, \p BEnd) into
+/// \p Out, splitting the work into independent chunks of roughly
+/// \p ChunkSize elements that are spawned on \p TG. Unlike a plain pairwise
+/// merge, the critical path stays O(ChunkSize) regardless of input size.
+template <class RandomAccessIterator, class OutputIterator, class Comparator>
+void parallel_merge(RandomAccessIterator ABegin, RandomAccessIterator AEnd,
+                    RandomAccessIterator BBegin, RandomAccessIterator BEnd,
+                    OutputIterator Out, size_t ChunkSize, TaskGroup &TG,
+                    const Comparator &Comp) {
+  size_t LenA = std::distance(ABegin, AEnd);
+  size_t LenB = std::distance(BBegin, BEnd);
+  size_t Total = LenA + LenB;
+  size_t PrevA = 0, PrevB = 0;
+  for (size_t Pos = 0; Pos < Total;) {
+    size_t K = std::min(Pos + ChunkSize, Total);
+    size_t SplitA = merge_split_point(ABegin, LenA, BBegin, LenB, K, Comp);
+    size_t SplitB = K - SplitA;
+    TG.spawn([=, &Comp] {
+      std::merge(ABegin + PrevA, ABegin + SplitA, BBegin + PrevB,
+                 BBegin + SplitB, Out + Pos, Comp);
+    });
+    PrevA = SplitA;
+    PrevB = SplitB;
+    Pos = K;
+  }
+}
+
+/// Stable parallel merge sort: sort cache-sized blocks in parallel, then merge
+/// them pairwise in parallel rounds, splitting each merge so no thread ever
+/// works on more than one block worth of data. Unlike parallel_quick_sort,
+/// whose top-level partition is sequential over the whole input, every phase
+/// here scales with the number of cores.
+///
+/// Restricted to trivially copyable types because elements round-trip through
+/// an uninitialized bounce buffer.
+template <class RandomAccessIterator, class Comparator>
+void parallel_merge_sort(RandomAccessIterator Start, RandomAccessIterator End,
+                         const Comparator &Comp) {
+  using T = typename std::iterator_traits<RandomAccessIterator>::value_type;
+  static_assert(std::is_trivially_copyable<T>::value,
+                "parallel_merge_sort requires trivially copyable elements");
+  size_t N = std::distance(Start, End);
+  // Pick a block size that keeps a block resident in a typical L2 while
+  // leaving enough blocks to occupy every core, and cap the task count like
+  // parallel_transform_reduce does.
+  size_t BlockSize =
+      std::max<size_t>(MinParallelSize, (size_t(256) << 10) / sizeof(T));
+  size_t NumBlocks = (N + BlockSize - 1) / BlockSize;
+  if (NumBlocks > MaxTasksPerGroup) {
+    NumBlocks = MaxTasksPerGroup;
+    BlockSize = (N + NumBlocks - 1) / NumBlocks;
+  }
+  if (NumBlocks <= 1) {
+    llvm::sort(Start, End, Comp);
+    return;
+  }
+
+  {
+    TaskGroup TG;
+    for (size_t Lo = 0; Lo < N; Lo += BlockSize) {
+      size_t Hi = std::min(Lo + BlockSize, N);
+      TG.spawn([=, &Comp] { llvm::sort(Start + Lo, Start + Hi, Comp); });
+    }
+  }
+
+  std::unique_ptr<char[]> Raw(new char[N * sizeof(T)]);
+  T *Buf = reinterpret_cast<T *>(Raw.get());
+  bool InBuf = false;
+  for (size_t Width = BlockSize; Width < N; Width *= 2) {
+    TaskGroup TG;
+    for (size_t Lo = 0; Lo < N; Lo += 2 * Width) {
+      size_t Mid = std::min(Lo + Width, N);
+      size_t Hi = std::min(Lo + 2 * Width, N);
+      if (InBuf)
+        parallel_merge(Buf + Lo, Buf + Mid, Buf + Mid, Buf + Hi, Start + Lo,
+                       BlockSize, TG, Comp);
+      else
+        parallel_merge(Start + Lo, Start + Mid, Start + Mid, Start + Hi,
+                       Buf + Lo, BlockSize, TG, Comp);
+    }
+    // TaskGroup destruction syncs the round before the next one starts.
+    InBuf = !InBuf;
+  }
+  if (InBuf) {
+    TaskGroup TG;
+    for (size_t Lo = 0; Lo < N; Lo += BlockSize) {
+      size_t Hi = std::min(Lo + BlockSize, N);
+      TG.spawn([=] { std::copy(Buf + Lo, Buf + Hi, Start + Lo); });
+    }
+  }
+}
+
 template <class RandomAccessIterator, class Comparator>
 void parallel_sort(RandomAccessIterator Start, RandomAccessIterator End,
                    const Comparator &Comp) {
-  TaskGroup TG;
-  parallel_quick_sort(Start, End, Comp, TG,
-                      llvm::Log2_64(std::distance(Start, End)) + 1);
+  using T = typename std::iterator_traits<RandomAccessIterator>::value_type;
+  // The merge sort bounces elements through an uninitialized buffer, which is
+  // only valid for trivially copyable, normally aligned types; everything
+  // else takes the quick sort path.
+  if constexpr (std::is_trivially_copyable<T>::value &&
+                alignof(T) <= alignof(std::max_align_t)) {
+    parallel_merge_sort(Start, End, Comp);
+  } else {
+    TaskGroup TG;
+    parallel_quick_sort(Start, End, Comp, TG,
+                        llvm::Log2_64(std::distance(Start, End)) + 1);
+  }
 }
 
-// TaskGroup has a relatively high overhead, so we want to reduce
-// the number of spawn() calls. We'll create up to 1024 tasks here.
-// (Note that 1024 is an arbitrary number. This code probably needs
-// improving to take the number of available cores into account.)
-enum { MaxTasksPerGroup = 1024 };
-
 template <class IterTy, class ResultTy, class ReduceFuncTy,
           class TransformFuncTy>
 ResultTy parallel_transform_reduce(IterTy Begin, IterTy End, ResultTy Init,
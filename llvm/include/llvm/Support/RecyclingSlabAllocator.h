@@ -0,0 +1,101 @@
+//===- RecyclingSlabAllocator.h - Slab-recycling allocator ------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+/// \file
+///
+/// This file defines RecyclingSlabAllocator, an underlying allocator for
+/// BumpPtrAllocatorImpl that recycles slabs through a process-wide cache
+/// instead of returning them to malloc. Long-running hosts that create and
+/// destroy many allocators (libClang serving thousands of in-process
+/// compiles, per-function codegen allocators) avoid repeated page-fault
+/// storms by drawing warm slabs from the cache.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SUPPORT_RECYCLINGSLABALLOCATOR_H
+#define LLVM_SUPPORT_RECYCLINGSLABALLOCATOR_H
+
+#include "llvm/Support/Allocator.h"
+#include "llvm/Support/AllocatorBase.h"
+#include <cstddef>
+
+namespace llvm {
+
+/// A process-wide cache of freed slabs, bucketed by power-of-two size class.
+///
+/// Slabs released by a RecyclingSlabAllocator are parked here (up to a
+/// configurable byte limit) and handed back to later allocation requests of
+/// the same size class. Each thread keeps a small lock-free front cache of
+/// the most recently freed slabs, so the common compile/destroy/compile
+/// cycle on one thread never touches the shared lists; this also keeps
+/// recycled memory local to the node that last wrote it on NUMA machines.
+class SlabCache {
+public:
+  /// \returns the process-wide cache instance.
+  static SlabCache &getProcessCache();
+
+  /// Fetch a cached slab of exactly \p Size bytes (which must be a size-class
+  /// size, see isCacheableSize()), or nullptr if none is available.
+  void *pop(size_t Size);
+
+  /// Park \p Ptr, a slab of \p Size bytes, for reuse. \returns false if the
+  /// cache is full or the size is not cacheable; the caller then frees the
+  /// slab itself.
+  bool push(void *Ptr, size_t Size);
+
+  /// \returns true if slabs of \p Size bytes are recycled rather than passed
+  /// through to malloc. Only power-of-two sizes in [MinSlabSize, MaxSlabSize]
+  /// qualify, which covers every non-custom slab BumpPtrAllocator creates.
+  static bool isCacheableSize(size_t Size);
+
+  /// Cap the total bytes parked in the shared cache. Excess slabs are freed
+  /// eagerly. Does not affect the per-thread front caches.
+  void setMaxCachedBytes(size_t Bytes);
+
+  /// \returns total bytes currently parked in the shared cache.
+  size_t getCachedBytes() const;
+
+  /// Free every slab parked in the shared cache.
+  void clear();
+
+  static constexpr size_t MinSlabSize = 4096;
+  static constexpr size_t MaxSlabSize = 16 * 1024 * 1024;
+  static constexpr size_t DefaultMaxCachedBytes = 64 * 1024 * 1024;
+};
+
+/// An allocator conforming to the LLVM "Allocator" concept that routes
+/// standard-sized slabs through the process-wide SlabCache. Use it as the
+/// underlying allocator of a BumpPtrAllocator:
+///
+/// \code
+///   RecyclingBumpPtrAllocator Alloc;
+/// \endcode
+///
+/// Allocations whose size is not a cacheable slab size fall through to
+/// malloc, so custom-sized slabs behave exactly as with MallocAllocator.
+class RecyclingSlabAllocator
+    : public AllocatorBase<RecyclingSlabAllocator> {
+public:
+  LLVM_ATTRIBUTE_RETURNS_NONNULL void *Allocate(size_t Size,
+                                                size_t Alignment);
+
+  // Pull in base class overloads.
+  using AllocatorBase<RecyclingSlabAllocator>::Allocate;
+
+  void Deallocate(const void *Ptr, size_t Size, size_t Alignment);
+
+  // Pull in base class overloads.
+  using AllocatorBase<RecyclingSlabAllocator>::Deallocate;
+};
+
+/// A BumpPtrAllocator that reuses slabs across allocator lifetimes via the
+/// process-wide SlabCache.
+using RecyclingBumpPtrAllocator = BumpPtrAllocatorImpl<RecyclingSlabAllocator>;
+
+} // end namespace llvm
+
+#endif // LLVM_SUPPORT_RECYCLINGSLABALLOCATOR_H
@@ -123,6 +123,11 @@ protected:
     unsigned match(StringRef Query) const;
 
   private:
+    /// Patterns without any glob or regex metacharacters, matched by a plain
+    /// hash lookup. Large sanitizer ignorelists are dominated by such
+    /// entries, and keeping them out of Globs/RegExes avoids both compiling
+    /// a pattern per line and the linear scan on every query.
+    StringMap<unsigned> Strings;
     StringMap<std::pair<GlobPattern, unsigned>> Globs;
     std::vector<std::pair<std::unique_ptr<Regex>, unsigned>> RegExes;
   };
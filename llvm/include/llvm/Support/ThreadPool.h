@@ -21,17 +21,48 @@
 
 #include <future>
 
+#include <atomic>
 #include <condition_variable>
 #include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <utility>
+#include <vector>
 
 namespace llvm {
 
 class ThreadPoolTaskGroup;
 
+namespace detail {
+
+/// Helpers to create a promise and a callable wrapper of \p Task that sets
+/// the result of the promise. Returns the callable and a future to access the
+/// result.
+template <typename ResTy>
+std::pair<std::function<void()>, std::future<ResTy>>
+createTaskAndFuture(std::function<ResTy()> Task) {
+  std::shared_ptr<std::promise<ResTy>> Promise =
+      std::make_shared<std::promise<ResTy>>();
+  auto F = Promise->get_future();
+  return {
+      [Promise = std::move(Promise), Task]() { Promise->set_value(Task()); },
+      std::move(F)};
+}
+inline std::pair<std::function<void()>, std::future<void>>
+createTaskAndFuture(std::function<void()> Task) {
+  std::shared_ptr<std::promise<void>> Promise =
+      std::make_shared<std::promise<void>>();
+  auto F = Promise->get_future();
+  return {[Promise = std::move(Promise), Task]() {
+            Task();
+            Promise->set_value();
+          },
+          std::move(F)};
+}
+
+} // namespace detail
+
 /// A ThreadPool for asynchronous parallel execution on a defined number of
 /// threads.
 ///
@@ -113,31 +144,6 @@ public:
   bool isWorkerThread() const;
 
 private:
-  /// Helpers to create a promise and a callable wrapper of \p Task that sets
-  /// the result of the promise. Returns the callable and a future to access the
-  /// result.
-  template <typename ResTy>
-  static std::pair<std::function<void()>, std::future<ResTy>>
-  createTaskAndFuture(std::function<ResTy()> Task) {
-    std::shared_ptr<std::promise<ResTy>> Promise =
-        std::make_shared<std::promise<ResTy>>();
-    auto F = Promise->get_future();
-    return {
-        [Promise = std::move(Promise), Task]() { Promise->set_value(Task()); },
-        std::move(F)};
-  }
-  static std::pair<std::function<void()>, std::future<void>>
-  createTaskAndFuture(std::function<void()> Task) {
-    std::shared_ptr<std::promise<void>> Promise =
-        std::make_shared<std::promise<void>>();
-    auto F = Promise->get_future();
-    return {[Promise = std::move(Promise), Task]() {
-              Task();
-              Promise->set_value();
-            },
-            std::move(F)};
-  }
-
   /// Returns true if all tasks in the given group have finished (nullptr means
   /// all tasks regardless of their group). QueueLock must be locked.
   bool workCompletedUnlocked(ThreadPoolTaskGroup *Group) const;
@@ -151,7 +157,7 @@ private:
 #if LLVM_ENABLE_THREADS
     /// Wrap the Task in a std::function<void()> that sets the result of the
     /// corresponding future.
-    auto R = createTaskAndFuture(Task);
+    auto R = detail::createTaskAndFuture(Task);
 
     int requestedThreads;
     {
@@ -244,6 +250,126 @@ private:
   ThreadPool &Pool;
 };
 
+/// A work-stealing alternative to ThreadPool for fine-grained tasks.
+///
+/// Each worker owns a lock-free deque (see WorkStealingQueue): tasks spawned
+/// from a worker are pushed and popped LIFO on its own deque for locality,
+/// and idle workers steal FIFO from randomly chosen victims instead of
+/// contending on one shared queue. Submissions from non-worker threads go
+/// through small per-worker inboxes that workers drain into their deques.
+///
+/// asyncWithAffinity() routes a task to a specific worker's queue, so related
+/// tasks (e.g. codegen for one module) tend to run on the same core; the hint
+/// is advisory and idle workers may still steal such tasks.
+///
+/// Compared to ThreadPool: all worker threads are started eagerly, task
+/// groups are not supported, and wait() must not be called from a worker
+/// thread.
+class WorkStealingThreadPool {
+public:
+  /// No affinity preference; the task may run on any worker.
+  static constexpr unsigned NoAffinity = ~0U;
+
+  /// Construct a pool using the hardware strategy \p S for mapping hardware
+  /// execution resources. All worker threads are started immediately.
+  WorkStealingThreadPool(ThreadPoolStrategy S = hardware_concurrency());
+
+  /// Blocking destructor: the pool will wait for all pending tasks to
+  /// complete.
+  ~WorkStealingThreadPool();
+
+  /// Asynchronous submission of a task to the pool. The returned future can
+  /// be used to wait for the task to finish and is *non-blocking* on
+  /// destruction.
+  template <typename Function, typename... Args>
+  auto async(Function &&F, Args &&...ArgList) {
+    auto Task =
+        std::bind(std::forward<Function>(F), std::forward<Args>(ArgList)...);
+    return async(std::move(Task));
+  }
+
+  template <typename Func>
+  auto async(Func &&F) -> std::shared_future<decltype(F())> {
+    return asyncImpl(std::function<decltype(F())()>(std::forward<Func>(F)),
+                     NoAffinity);
+  }
+
+  /// Like async(), but routes the task to worker \p AffinityHint modulo the
+  /// thread count. Tasks with equal hints share a queue and (absent stealing)
+  /// a core, keeping their working set warm in that core's cache.
+  template <typename Func>
+  auto asyncWithAffinity(unsigned AffinityHint, Func &&F)
+      -> std::shared_future<decltype(F())> {
+    return asyncImpl(std::function<decltype(F())()>(std::forward<Func>(F)),
+                     AffinityHint);
+  }
+
+  /// Blocking wait for all the tasks to complete and every queue to be empty.
+  /// It is an error to call this from a worker thread or to enqueue new tasks
+  /// from other threads while blocking on this call.
+  void wait();
+
+  /// Returns the number of worker threads in the pool.
+  unsigned getThreadCount() const { return ThreadCount; }
+
+  /// Returns true if the current thread is a worker thread of this pool.
+  bool isWorkerThread() const;
+
+private:
+  template <typename ResTy>
+  std::shared_future<ResTy> asyncImpl(std::function<ResTy()> Task,
+                                      unsigned AffinityHint) {
+#if LLVM_ENABLE_THREADS
+    auto R = detail::createTaskAndFuture(Task);
+    enqueue(std::move(R.first), AffinityHint);
+    return R.second.share();
+#else
+    // Sequential fallback mirroring ThreadPool: defer until wait().
+    auto Future = std::async(std::launch::deferred, std::move(Task)).share();
+    DeferredTasks.emplace_back([Future]() { Future.get(); });
+    return Future;
+#endif
+  }
+
+#if LLVM_ENABLE_THREADS
+  /// Hand \p Task to the worker selected by \p AffinityHint (or round-robin
+  /// for NoAffinity) and wake a sleeping worker. Defined in ThreadPool.cpp.
+  void enqueue(std::function<void()> Task, unsigned AffinityHint);
+
+  void processTasksUntilShutdown(unsigned WorkerID);
+
+  struct WorkerState;
+
+  /// Per-worker state; stable addresses, created before threads start.
+  std::vector<std::unique_ptr<WorkerState>> Workers;
+
+  /// Threads in flight.
+  std::vector<llvm::thread> Threads;
+
+  /// Round-robin cursor for submissions without an affinity hint.
+  std::atomic<unsigned> NextVictim{0};
+
+  /// Tasks queued (in a deque or inbox) but not yet picked up by a worker.
+  std::atomic<int64_t> AvailableTasks{0};
+
+  /// Tasks enqueued and not yet finished executing.
+  std::atomic<int64_t> OutstandingTasks{0};
+
+  /// Guards sleeping workers and completion waiters.
+  std::mutex SleepLock;
+  std::condition_variable WakeCondition;
+  std::condition_variable CompletionCondition;
+
+  /// Signal for the destruction of the pool, asking threads to exit.
+  bool EnableFlag = true;
+#else
+  std::deque<std::function<void()>> DeferredTasks;
+#endif
+
+  const ThreadPoolStrategy Strategy;
+  const unsigned ThreadCount;
+};
+
 } // namespace llvm
 
 #endif // LLVM_SUPPORT_THREADPOOL_H
@@ -127,6 +127,12 @@ void timeTraceProfilerBegin(StringRef Name,
 /// Manually end the last time section.
 void timeTraceProfilerEnd();
 
+/// Manually end the last time section, attaching a detail computed by
+/// \p Detail. The callback is only invoked if the section is long enough to
+/// pass the granularity filter, so callers on hot paths can avoid building
+/// detail strings for sections that would be discarded anyway.
+void timeTraceProfilerEnd(llvm::function_ref<std::string()> Detail);
+
 /// The TimeTraceScope is a helper class to call the begin and end functions
 /// of the time trace profiler.  When the object is constructed, it begins
 /// the section; and when it is destroyed, it stops it. If the time profiler
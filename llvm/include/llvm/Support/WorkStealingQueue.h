@@ -0,0 +1,151 @@
+//===- WorkStealingQueue.h - Chase-Lev work-stealing deque ------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+/// \file
+///
+/// This file defines WorkStealingQueue, a lock-free single-owner/multi-thief
+/// deque following the Chase-Lev algorithm (with the C11 memory-order fixes
+/// from Lê et al., "Correct and Efficient Work-Stealing for Weak Memory
+/// Models"). The owner thread pushes and pops at the bottom in LIFO order;
+/// any other thread may steal from the top in FIFO order.
+///
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_SUPPORT_WORKSTEALINGQUEUE_H
+#define LLVM_SUPPORT_WORKSTEALINGQUEUE_H
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/MathExtras.h"
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+
+namespace llvm {
+
+/// A lock-free work-stealing deque of trivially copyable items (typically
+/// pointers to task objects).
+///
+/// Thread-safety contract: exactly one thread (the owner) may call push() and
+/// pop(); any number of threads may call steal() concurrently with owner
+/// operations. The queue grows on demand; retired backing arrays are kept
+/// alive until destruction so racing thieves never read freed memory.
+template <typename T> class WorkStealingQueue {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "WorkStealingQueue requires trivially copyable items; "
+                "store pointers to larger task objects");
+
+  struct CircularArray {
+    int64_t Capacity; // Always a power of two.
+    std::unique_ptr<std::atomic<T>[]> Data;
+
+    explicit CircularArray(int64_t Capacity)
+        : Capacity(Capacity), Data(new std::atomic<T>[Capacity]) {}
+
+    T get(int64_t Idx) const {
+      return Data[Idx & (Capacity - 1)].load(std::memory_order_relaxed);
+    }
+    void put(int64_t Idx, T Item) {
+      Data[Idx & (Capacity - 1)].store(Item, std::memory_order_relaxed);
+    }
+  };
+
+  // Top is the next index to steal from; Bottom is the next index to push to.
+  std::atomic<int64_t> Top{0};
+  std::atomic<int64_t> Bottom{0};
+  std::atomic<CircularArray *> Array;
+  // Retired arrays; must stay alive while thieves may still reference them.
+  SmallVector<std::unique_ptr<CircularArray>, 4> Retired;
+
+public:
+  explicit WorkStealingQueue(int64_t InitialCapacity = 64) {
+    assert(llvm::isPowerOf2_64(InitialCapacity) && "capacity must be 2^n");
+    Array.store(new CircularArray(InitialCapacity),
+                std::memory_order_relaxed);
+  }
+
+  ~WorkStealingQueue() { delete Array.load(std::memory_order_relaxed); }
+
+  WorkStealingQueue(const WorkStealingQueue &) = delete;
+  WorkStealingQueue &operator=(const WorkStealingQueue &) = delete;
+
+  /// \returns true if the queue appears empty. Inherently racy when other
+  /// threads are active; only advisory.
+  bool empty() const {
+    int64_t Bot = Bottom.load(std::memory_order_relaxed);
+    int64_t Tp = Top.load(std::memory_order_relaxed);
+    return Bot <= Tp;
+  }
+
+  /// Push \p Item at the bottom. Owner thread only.
+  void push(T Item) {
+    int64_t Bot = Bottom.load(std::memory_order_relaxed);
+    int64_t Tp = Top.load(std::memory_order_acquire);
+    CircularArray *A = Array.load(std::memory_order_relaxed);
+    if (Bot - Tp > A->Capacity - 1)
+      A = grow(A, Bot, Tp);
+    A->put(Bot, Item);
+    std::atomic_thread_fence(std::memory_order_release);
+    Bottom.store(Bot + 1, std::memory_order_relaxed);
+  }
+
+  /// Pop the most recently pushed item (LIFO). Owner thread only.
+  std::optional<T> pop() {
+    int64_t Bot = Bottom.load(std::memory_order_relaxed) - 1;
+    CircularArray *A = Array.load(std::memory_order_relaxed);
+    Bottom.store(Bot, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t Tp = Top.load(std::memory_order_relaxed);
+    if (Tp > Bot) {
+      // Queue was already empty; restore the invariant.
+      Bottom.store(Bot + 1, std::memory_order_relaxed);
+      return std::nullopt;
+    }
+    std::optional<T> Item = A->get(Bot);
+    if (Tp == Bot) {
+      // Racing against thieves for the last item.
+      if (!Top.compare_exchange_strong(Tp, Tp + 1, std::memory_order_seq_cst,
+                                       std::memory_order_relaxed))
+        Item = std::nullopt;
+      Bottom.store(Bot + 1, std::memory_order_relaxed);
+    }
+    return Item;
+  }
+
+  /// Steal the oldest item (FIFO). Safe from any thread. \returns nullopt if
+  /// the queue is empty or the steal lost a race (the caller is expected to
+  /// pick another victim rather than spin here).
+  std::optional<T> steal() {
+    int64_t Tp = Top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t Bot = Bottom.load(std::memory_order_acquire);
+    if (Tp >= Bot)
+      return std::nullopt;
+    CircularArray *A = Array.load(std::memory_order_consume);
+    T Item = A->get(Tp);
+    if (!Top.compare_exchange_strong(Tp, Tp + 1, std::memory_order_seq_cst,
+                                     std::memory_order_relaxed))
+      return std::nullopt;
+    return Item;
+  }
+
+private:
+  CircularArray *grow(CircularArray *Old, int64_t Bot, int64_t Tp) {
+    auto *New = new CircularArray(Old->Capacity * 2);
+    for (int64_t I = Tp; I < Bot; ++I)
+      New->put(I, Old->get(I));
+    Retired.emplace_back(Old);
+    Array.store(New, std::memory_order_release);
+    return New;
+  }
+};
+
+} // end namespace llvm
+
+#endif // LLVM_SUPPORT_WORKSTEALINGQUEUE_H
@@ -13,6 +13,7 @@
 #ifndef LLVM_SUPPORT_RAW_OSTREAM_H
 #define LLVM_SUPPORT_RAW_OSTREAM_H
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/DataTypes.h"
@@ -382,6 +383,12 @@ protected:
   /// Return an efficient buffer size for the underlying output mechanism.
   virtual size_t preferred_buffer_size() const;
 
+  /// Write the given regions to the stream in order as one logical
+  /// operation. The default implementation issues one write_impl call per
+  /// non-empty region; subclasses backed by scatter/gather I/O override this
+  /// to emit all regions with a single system call.
+  virtual void write_vectored_impl(ArrayRef<StringRef> Buffers);
+
   /// Return the beginning of the current stream buffer, or 0 if the stream is
   /// unbuffered.
   const char *getBufferStart() const { return OutBufStart; }
@@ -471,6 +478,10 @@ class raw_fd_ostream : public raw_pwrite_stream {
   /// See raw_ostream::write_impl.
   void write_impl(const char *Ptr, size_t Size) override;
 
+  /// Emit all regions with a single writev(2) call where the platform
+  /// supports it.
+  void write_vectored_impl(ArrayRef<StringRef> Buffers) override;
+
   void pwrite_impl(const char *Ptr, size_t Size, uint64_t Offset) override;
 
   /// Return the current position within the stream, not counting the bytes
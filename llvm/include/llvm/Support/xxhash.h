@@ -49,6 +49,20 @@ uint64_t xxh3_64bits(ArrayRef<uint8_t> data);
 inline uint64_t xxh3_64bits(StringRef data) {
   return xxh3_64bits(ArrayRef(data.bytes_begin(), data.size()));
 }
+
+/// Hash every element of \p data into the corresponding slot of \p results.
+/// Equivalent to N calls of xxh3_64bits but amortizes call overhead and
+/// prefetches the next key while hashing the current one, which matters when
+/// the keys are cold (ICF content hashing, string deduplication).
+void xxh3_64bits_batch(ArrayRef<ArrayRef<uint8_t>> data,
+                       MutableArrayRef<uint64_t> results);
+void xxh3_64bits_batch(ArrayRef<StringRef> data,
+                       MutableArrayRef<uint64_t> results);
+
+/// Hash each consecutive \p stride bytes of \p data into the corresponding
+/// slot of \p results. \p data must be exactly results.size() * stride bytes.
+void xxh3_64bits_batch(ArrayRef<uint8_t> data, size_t stride,
+                       MutableArrayRef<uint64_t> results);
 }
 
 #endif
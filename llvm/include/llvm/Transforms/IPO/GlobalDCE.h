@@ -51,8 +51,9 @@ private:
   DenseMap<GlobalValue *, SmallPtrSet<GlobalValue *, 4>> GVDependencies;
 
   /// Constant -> Globals that use this global cache.
-  std::unordered_map<Constant *, SmallPtrSet<GlobalValue *, 8>>
-      ConstantDependenciesCache;
+  using ConstantDependenciesCacheTy =
+      std::unordered_map<Constant *, SmallPtrSet<GlobalValue *, 8>>;
+  ConstantDependenciesCacheTy ConstantDependenciesCache;
 
   /// Comdat -> Globals in that Comdat section.
   std::unordered_multimap<Comdat *, GlobalValue *> ComdatMembers;
@@ -65,6 +66,10 @@ private:
   // about to safely do dead virtual function elimination.
   SmallPtrSet<GlobalValue *, 32> VFESafeVTables;
 
+  void ComputeGVDependencies(GlobalValue &GV, ConstantDependenciesCacheTy &Cache,
+                             SmallPtrSetImpl<GlobalValue *> &Deps);
+  void CommitGVDependencies(GlobalValue &GV,
+                            const SmallPtrSetImpl<GlobalValue *> &Deps);
   void UpdateGVDependencies(GlobalValue &GV);
   void MarkLive(GlobalValue &GV,
                 SmallVectorImpl<GlobalValue *> *Updates = nullptr);
@@ -75,7 +80,8 @@ private:
   void ScanTypeCheckedLoadIntrinsics(Module &M);
   void ScanVTableLoad(Function *Caller, Metadata *TypeId, uint64_t CallOffset);
 
-  void ComputeDependencies(Value *V, SmallPtrSetImpl<GlobalValue *> &U);
+  void ComputeDependencies(Value *V, ConstantDependenciesCacheTy &Cache,
+                           SmallPtrSetImpl<GlobalValue *> &U);
 };
 
 }
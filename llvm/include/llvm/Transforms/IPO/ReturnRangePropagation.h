@@ -0,0 +1,32 @@
+//===- ReturnRangePropagation.h - Propagate return ranges -------*- C++ -*-===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements a transformation that computes a constant-range summary
+// of each function's return value, bottom-up over the call graph, and attaches
+// !range metadata to direct call sites of summarized functions. The metadata
+// is consumed by intraprocedural range analyses such as LazyValueInfo, giving
+// passes like CorrelatedValuePropagation interprocedural range facts without
+// any change to their solvers.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_TRANSFORMS_IPO_RETURNRANGEPROPAGATION_H
+#define LLVM_TRANSFORMS_IPO_RETURNRANGEPROPAGATION_H
+
+#include "llvm/IR/PassManager.h"
+
+namespace llvm {
+
+class ReturnRangePropagationPass
+    : public PassInfoMixin<ReturnRangePropagationPass> {
+public:
+  PreservedAnalyses run(Module &M, ModuleAnalysisManager &);
+};
+} // namespace llvm
+
+#endif // LLVM_TRANSFORMS_IPO_RETURNRANGEPROPAGATION_H
@@ -15,6 +15,7 @@
 
 #include "llvm/Analysis/IVDescriptors.h"
 #include "llvm/Analysis/LoopAccessAnalysis.h"
+#include "llvm/Analysis/MemoryLocation.h"
 #include "llvm/Transforms/Utils/ValueMapper.h"
 
 namespace llvm {
@@ -26,6 +27,7 @@ class StringRef;
 class AnalysisUsage;
 class TargetTransformInfo;
 class AAResults;
+class BatchAAResults;
 class BasicBlock;
 class ICFLoopSafetyInfo;
 class IRBuilderBase;
@@ -130,12 +132,24 @@ public:
   bool tooManyClobberingCalls() { return LicmMssaOptCounter >= LicmMssaOptCap; }
   void incrementClobberingCalls() { ++LicmMssaOptCounter; }
 
+  /// Returns true if no may-write in \p L aliases \p Loc, turning the
+  /// invariance query into set-membership tests against a per-loop may-write
+  /// summary. The summary is built from \p MSSA on first use and kept for the
+  /// lifetime of these flags; moving accesses out of the loop only makes it
+  /// over-conservative. Returns false if the loop writes through operations
+  /// that cannot be summarized as locations (calls, fences, ordered accesses).
+  bool mayWriteSetInvariant(const MemoryLocation &Loc, BatchAAResults &BAA,
+                            MemorySSA &MSSA, const Loop &L);
+
 protected:
   bool NoOfMemAccTooLarge = false;
   unsigned LicmMssaOptCounter = 0;
   unsigned LicmMssaOptCap;
   unsigned LicmMssaNoAccForPromotionCap;
   bool IsSink;
+  SmallVector<MemoryLocation, 8> LoopMayWriteLocs;
+  bool MayWriteSummaryBuilt = false;
+  bool MayWriteSummaryValid = false;
 };
 
 /// Walk the specified region of the CFG (defined by all blocks
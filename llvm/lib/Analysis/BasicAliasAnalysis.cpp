@@ -71,6 +71,10 @@ static cl::opt<bool> EnableRecPhiAnalysis("basic-aa-recphi", cl::Hidden,
 static cl::opt<bool> EnableSeparateStorageAnalysis("basic-aa-separate-storage",
                                                    cl::Hidden, cl::init(false));
 
+/// Memoize GEP decompositions for the duration of a query batch.
+static cl::opt<bool> EnableDecomposedGEPCache("basic-aa-decomposed-gep-cache",
+                                              cl::Hidden, cl::init(true));
+
 /// SearchLimitReached / SearchTimes shows how often the limit of
 /// to decompose GEPs is reached. It will affect the precision
 /// of basic alias analysis.
@@ -536,6 +540,46 @@ struct BasicAAResult::DecomposedGEP {
   }
 };
 
+// Memo of DecomposeGEPExpression results for one query batch; see the
+// declaration of DGCache for the validity rules.
+struct BasicAAResult::DecomposedGEPCache {
+  SmallDenseMap<const Value *, DecomposedGEP, 8> Map;
+};
+
+BasicAAResult::BasicAAResult(const DataLayout &DL, const Function &F,
+                             const TargetLibraryInfo &TLI, AssumptionCache &AC,
+                             DominatorTree *DT)
+    : DL(DL), F(F), TLI(TLI), AC(AC), DT(DT) {}
+
+BasicAAResult::BasicAAResult(const BasicAAResult &Arg)
+    : AAResultBase(Arg), DL(Arg.DL), F(Arg.F), TLI(Arg.TLI), AC(Arg.AC),
+      DT(Arg.DT) {}
+
+BasicAAResult::BasicAAResult(BasicAAResult &&Arg)
+    : AAResultBase(std::move(Arg)), DL(Arg.DL), F(Arg.F), TLI(Arg.TLI),
+      AC(Arg.AC), DT(Arg.DT) {}
+
+BasicAAResult::~BasicAAResult() = default;
+
+BasicAAResult::DecomposedGEP
+BasicAAResult::getDecomposedGEP(const Value *V, const AAQueryInfo &AAQI) {
+  if (!EnableDecomposedGEPCache)
+    return DecomposeGEPExpression(V, DL, &AC, DT);
+
+  if (!DGCache)
+    DGCache = std::make_unique<DecomposedGEPCache>();
+  else if (DGCacheEpoch != AAQI.Epoch)
+    DGCache->Map.clear();
+  DGCacheEpoch = AAQI.Epoch;
+
+  auto It = DGCache->Map.find(V);
+  if (It != DGCache->Map.end())
+    return It->second;
+
+  DecomposedGEP Decomposed = DecomposeGEPExpression(V, DL, &AC, DT);
+  DGCache->Map.try_emplace(V, Decomposed);
+  return Decomposed;
+}
 
 /// If V is a symbolic pointer expression, decompose it into a base pointer
 /// with a constant offset and a number of scaled symbolic offsets.
@@ -1061,8 +1105,8 @@ AliasResult BasicAAResult::aliasGEP(
                                              : AliasResult::MayAlias;
   }
 
-  DecomposedGEP DecompGEP1 = DecomposeGEPExpression(GEP1, DL, &AC, DT);
-  DecomposedGEP DecompGEP2 = DecomposeGEPExpression(V2, DL, &AC, DT);
+  DecomposedGEP DecompGEP1 = getDecomposedGEP(GEP1, AAQI);
+  DecomposedGEP DecompGEP2 = getDecomposedGEP(V2, AAQI);
 
   // Bail if we were not able to decompose anything.
   if (DecompGEP1.Base == GEP1 && DecompGEP2.Base == V2)
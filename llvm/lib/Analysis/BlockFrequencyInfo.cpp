@@ -81,6 +81,12 @@ cl::opt<PGOViewCountsType> PGOViewCounts(
 static cl::opt<bool> PrintBFI("print-bfi", cl::init(false), cl::Hidden,
                               cl::desc("Print the block frequency info."));
 
+static cl::opt<bool> LazyBFICalculation(
+    "bfi-lazy-calculate", cl::init(false), cl::Hidden,
+    cl::desc("Defer the block frequency propagation until the first query, "
+             "so functions whose BFI is requested but never consulted are "
+             "free."));
+
 cl::opt<std::string>
     PrintBFIFuncName("print-bfi-func-name", cl::Hidden,
                      cl::desc("The option to specify the name of the function "
@@ -158,11 +164,22 @@ BlockFrequencyInfo::BlockFrequencyInfo(const Function &F,
 }
 
 BlockFrequencyInfo::BlockFrequencyInfo(BlockFrequencyInfo &&Arg)
-    : BFI(std::move(Arg.BFI)) {}
+    : BFI(std::move(Arg.BFI)), DeferredF(Arg.DeferredF),
+      DeferredBPI(Arg.DeferredBPI), DeferredLI(Arg.DeferredLI) {
+  Arg.DeferredF = nullptr;
+  Arg.DeferredBPI = nullptr;
+  Arg.DeferredLI = nullptr;
+}
 
 BlockFrequencyInfo &BlockFrequencyInfo::operator=(BlockFrequencyInfo &&RHS) {
   releaseMemory();
   BFI = std::move(RHS.BFI);
+  DeferredF = RHS.DeferredF;
+  DeferredBPI = RHS.DeferredBPI;
+  DeferredLI = RHS.DeferredLI;
+  RHS.DeferredF = nullptr;
+  RHS.DeferredBPI = nullptr;
+  RHS.DeferredLI = nullptr;
   return *this;
 }
 
@@ -173,7 +190,13 @@ BlockFrequencyInfo &BlockFrequencyInfo::operator=(BlockFrequencyInfo &&RHS) {
 BlockFrequencyInfo::~BlockFrequencyInfo() = default;
 
 bool BlockFrequencyInfo::invalidate(Function &F, const PreservedAnalyses &PA,
-                                    FunctionAnalysisManager::Invalidator &) {
+                                    FunctionAnalysisManager::Invalidator &Inv) {
+  // While a deferred calculation is pending we hold on to the BPI and LoopInfo
+  // results, so we additionally depend on them staying valid.
+  if (DeferredF && (Inv.invalidate<BranchProbabilityAnalysis>(F, PA) ||
+                    Inv.invalidate<LoopAnalysis>(F, PA)))
+    return true;
+
   // Check whether the analysis, all analyses on functions, or the function's
   // CFG have been preserved.
   auto PAC = PA.getChecker<BlockFrequencyAnalysis>();
@@ -184,6 +207,32 @@ bool BlockFrequencyInfo::invalidate(Function &F, const PreservedAnalyses &PA,
 void BlockFrequencyInfo::calculate(const Function &F,
                                    const BranchProbabilityInfo &BPI,
                                    const LoopInfo &LI) {
+  if (LazyBFICalculation) {
+    // Record the inputs and let the first query run the propagation.
+    DeferredF = &F;
+    DeferredBPI = &BPI;
+    DeferredLI = &LI;
+    return;
+  }
+  calculateImpl(F, BPI, LI);
+}
+
+void BlockFrequencyInfo::ensureCalculated() const {
+  if (!DeferredF)
+    return;
+  auto *Self = const_cast<BlockFrequencyInfo *>(this);
+  const Function &F = *DeferredF;
+  const BranchProbabilityInfo &BPI = *DeferredBPI;
+  const LoopInfo &LI = *DeferredLI;
+  Self->DeferredF = nullptr;
+  Self->DeferredBPI = nullptr;
+  Self->DeferredLI = nullptr;
+  Self->calculateImpl(F, BPI, LI);
+}
+
+void BlockFrequencyInfo::calculateImpl(const Function &F,
+                                       const BranchProbabilityInfo &BPI,
+                                       const LoopInfo &LI) {
   if (!BFI)
     BFI.reset(new ImplType);
   BFI->calculate(F, BPI, LI);
@@ -199,12 +248,14 @@ void BlockFrequencyInfo::calculate(const Function &F,
 }
 
 BlockFrequency BlockFrequencyInfo::getBlockFreq(const BasicBlock *BB) const {
+  ensureCalculated();
   return BFI ? BFI->getBlockFreq(BB) : BlockFrequency(0);
 }
 
 std::optional<uint64_t>
 BlockFrequencyInfo::getBlockProfileCount(const BasicBlock *BB,
                                          bool AllowSynthetic) const {
+  ensureCalculated();
   if (!BFI)
     return std::nullopt;
 
@@ -213,18 +264,21 @@ BlockFrequencyInfo::getBlockProfileCount(const BasicBlock *BB,
 
 std::optional<uint64_t>
 BlockFrequencyInfo::getProfileCountFromFreq(BlockFrequency Freq) const {
+  ensureCalculated();
   if (!BFI)
     return std::nullopt;
   return BFI->getProfileCountFromFreq(*getFunction(), Freq);
 }
 
 bool BlockFrequencyInfo::isIrrLoopHeader(const BasicBlock *BB) {
+  ensureCalculated();
   assert(BFI && "Expected analysis to be available");
   return BFI->isIrrLoopHeader(BB);
 }
 
 void BlockFrequencyInfo::setBlockFreq(const BasicBlock *BB,
                                       BlockFrequency Freq) {
+  ensureCalculated();
   assert(BFI && "Expected analysis to be available");
   BFI->setBlockFreq(BB, Freq);
 }
@@ -232,6 +286,7 @@ void BlockFrequencyInfo::setBlockFreq(const BasicBlock *BB,
 void BlockFrequencyInfo::setBlockFreqAndScale(
     const BasicBlock *ReferenceBB, BlockFrequency Freq,
     SmallPtrSetImpl<BasicBlock *> &BlocksToScale) {
+  ensureCalculated();
   assert(BFI && "Expected analysis to be available");
   // Use 128 bits APInt to avoid overflow.
   APInt NewFreq(128, Freq.getFrequency());
@@ -254,29 +309,42 @@ void BlockFrequencyInfo::setBlockFreqAndScale(
 /// Pop up a ghostview window with the current block frequency propagation
 /// rendered using dot.
 void BlockFrequencyInfo::view(StringRef title) const {
+  ensureCalculated();
   ViewGraph(const_cast<BlockFrequencyInfo *>(this), title);
 }
 
 const Function *BlockFrequencyInfo::getFunction() const {
+  if (DeferredF)
+    return DeferredF;
   return BFI ? BFI->getFunction() : nullptr;
 }
 
 const BranchProbabilityInfo *BlockFrequencyInfo::getBPI() const {
+  ensureCalculated();
   return BFI ? &BFI->getBPI() : nullptr;
 }
 
 BlockFrequency BlockFrequencyInfo::getEntryFreq() const {
+  ensureCalculated();
   return BFI ? BFI->getEntryFreq() : BlockFrequency(0);
 }
 
-void BlockFrequencyInfo::releaseMemory() { BFI.reset(); }
+void BlockFrequencyInfo::releaseMemory() {
+  BFI.reset();
+  DeferredF = nullptr;
+  DeferredBPI = nullptr;
+  DeferredLI = nullptr;
+}
 
 void BlockFrequencyInfo::print(raw_ostream &OS) const {
+  ensureCalculated();
   if (BFI)
     BFI->print(OS);
 }
 
 void BlockFrequencyInfo::verifyMatch(BlockFrequencyInfo &Other) const {
+  ensureCalculated();
+  Other.ensureCalculated();
   if (BFI)
     BFI->verifyMatch(*Other.BFI);
 }
@@ -12,6 +12,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Analysis/DomTreeUpdater.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/Analysis/PostDominators.h"
 #include "llvm/IR/Constants.h"
@@ -55,6 +56,32 @@ bool DomTreeUpdater::isSelfDominance(
   return Update.getFrom() == Update.getTo();
 }
 
+/// Collapse a pending update sequence to its net effect. Updates to a single
+/// edge must alternate between Insert and Delete, so an even number of
+/// updates to an edge cancels out entirely and an odd number is equivalent to
+/// the last of them alone. The trees perform the same legalization internally,
+/// but compacting here shrinks large queues (e.g. from unrolling) before they
+/// reach the incremental repair, and does the work once rather than once per
+/// tree when both a DomTree and a PostDomTree are attached.
+static SmallVector<DominatorTree::UpdateType, 32>
+compactPendingUpdates(ArrayRef<DominatorTree::UpdateType> Updates) {
+  SmallDenseMap<std::pair<BasicBlock *, BasicBlock *>, unsigned, 32> EdgeCount;
+  for (const auto &U : Updates)
+    ++EdgeCount[{U.getFrom(), U.getTo()}];
+
+  // Keep only the last update of each odd-count edge. After compaction every
+  // edge carries at most one update, so the relative order of the survivors
+  // does not matter.
+  SmallVector<DominatorTree::UpdateType, 32> Compacted;
+  for (const auto &U : reverse(Updates)) {
+    unsigned &Count = EdgeCount[{U.getFrom(), U.getTo()}];
+    if (Count & 1)
+      Compacted.push_back(U);
+    Count = 0;
+  }
+  return Compacted;
+}
+
 void DomTreeUpdater::applyDomTreeUpdates() {
   // No pending DomTreeUpdates.
   if (Strategy != UpdateStrategy::Lazy || !DT)
@@ -65,7 +92,8 @@ void DomTreeUpdater::applyDomTreeUpdates() {
     const auto I = PendUpdates.begin() + PendDTUpdateIndex;
     const auto E = PendUpdates.end();
     assert(I < E && "Iterator range invalid; there should be DomTree updates.");
-    DT->applyUpdates(ArrayRef<DominatorTree::UpdateType>(I, E));
+    DT->applyUpdates(
+        compactPendingUpdates(ArrayRef<DominatorTree::UpdateType>(I, E)));
     PendDTUpdateIndex = PendUpdates.size();
   }
 }
@@ -87,7 +115,8 @@ void DomTreeUpdater::applyPostDomTreeUpdates() {
     const auto E = PendUpdates.end();
     assert(I < E &&
            "Iterator range invalid; there should be PostDomTree updates.");
-    PDT->applyUpdates(ArrayRef<DominatorTree::UpdateType>(I, E));
+    PDT->applyUpdates(
+        compactPendingUpdates(ArrayRef<DominatorTree::UpdateType>(I, E)));
     PendPDTUpdateIndex = PendUpdates.size();
   }
 }
@@ -11,11 +11,14 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/Analysis/InlineCost.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringSwitch.h"
 #include "llvm/Analysis/AssumptionCache.h"
 #include "llvm/Analysis/BlockFrequencyInfo.h"
 #include "llvm/Analysis/CodeMetrics.h"
@@ -39,10 +42,14 @@
 #include "llvm/IR/IntrinsicInst.h"
 #include "llvm/IR/Operator.h"
 #include "llvm/IR/PatternMatch.h"
+#include "llvm/IR/StructuralHash.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/FormattedStream.h"
+#include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/Mutex.h"
 #include "llvm/Support/raw_ostream.h"
+#include <chrono>
 #include <climits>
 #include <limits>
 #include <optional>
@@ -71,6 +78,15 @@ static cl::opt<bool> PrintInstructionComments(
     "print-instruction-comments", cl::Hidden, cl::init(false),
     cl::desc("Prints comments for instruction based on inline cost analysis"));
 
+static cl::opt<bool> InlineCostStats(
+    "inline-cost-stats", cl::Hidden, cl::init(false),
+    cl::desc("Dump per-callee inline cost analysis counts and times on exit"));
+
+static cl::opt<bool> InlineCostCacheVerdicts(
+    "inline-cost-cache", cl::Hidden, cl::init(false),
+    cl::desc("Cache structurally never-inlinable verdicts per callee version "
+             "so repeated analyses become lookups"));
+
 static cl::opt<int> InlineThreshold(
     "inline-threshold", cl::Hidden, cl::init(225),
     cl::desc("Control the amount of inlining to perform (default = 225)"));
@@ -3043,6 +3059,74 @@ std::optional<InlineResult> llvm::getAttributeBasedInliningDecision(
   return std::nullopt;
 }
 
+namespace {
+
+/// Process-wide per-callee counters behind -inline-cost-stats, printed when
+/// the process shuts down. Guarded by a mutex so parallel ThinLTO backends in
+/// one process can share it.
+struct InlineCostStatsCollector {
+  sys::SmartMutex<true> Lock;
+  /// Maps callee name to the number of full cost analyses and the cumulative
+  /// analysis time in microseconds.
+  StringMap<std::pair<uint64_t, uint64_t>> Analyses;
+
+  void record(StringRef Callee, uint64_t Micros) {
+    sys::SmartScopedLock<true> Guard(Lock);
+    auto &Entry = Analyses[Callee];
+    ++Entry.first;
+    Entry.second += Micros;
+  }
+
+  ~InlineCostStatsCollector() {
+    if (Analyses.empty())
+      return;
+    std::vector<const StringMapEntry<std::pair<uint64_t, uint64_t>> *> Sorted;
+    Sorted.reserve(Analyses.size());
+    for (const auto &Entry : Analyses)
+      Sorted.push_back(&Entry);
+    llvm::sort(Sorted, [](const auto *LHS, const auto *RHS) {
+      if (LHS->second.first != RHS->second.first)
+        return LHS->second.first > RHS->second.first;
+      return LHS->first() < RHS->first();
+    });
+    errs() << "*** Inline cost analyses ***\n";
+    for (const auto *Entry : Sorted)
+      errs() << "  " << Entry->second.first << " analyses, "
+             << Entry->second.second << "us: " << Entry->first() << "\n";
+  }
+};
+
+/// Never-inline verdicts cached per callee for call sites that cannot
+/// specialize the analysis. A structural hash of the callee stands in for its
+/// version: an entry recorded before the function was modified (or before its
+/// address was reused) fails the hash comparison and is simply recomputed.
+struct InlineCostVerdictCache {
+  struct Verdict {
+    uint64_t CalleeHash;
+    const char *FailureReason;
+  };
+
+  sys::SmartMutex<true> Lock;
+  DenseMap<const Function *, Verdict> Verdicts;
+};
+
+} // namespace
+
+static ManagedStatic<InlineCostStatsCollector> CostStats;
+static ManagedStatic<InlineCostVerdictCache> VerdictCache;
+
+/// Whether an analysis failure with reason \p Reason depends only on the
+/// callee body, as opposed to the call site or caller (e.g. "noduplicate",
+/// "stacksize" and the threshold-based reasons do not qualify). Only such
+/// failures may be served to other call sites from the verdict cache.
+static bool isCallSiteIndependentFailure(const char *Reason) {
+  return StringSwitch<bool>(Reason)
+      .Cases("recursive", "exposes returns twice", "dynamic alloca", true)
+      .Cases("indirect branch", "uninlinable intrinsic", "varargs", true)
+      .Case("blockaddress used outside of callbr", true)
+      .Default(false);
+}
+
 InlineCost llvm::getInlineCost(
     CallBase &Call, Function *Callee, const InlineParams &Params,
     TargetTransformInfo &CalleeTTI,
@@ -3064,10 +3148,48 @@ InlineCost llvm::getInlineCost(
                           << "... (caller:" << Call.getCaller()->getName()
                           << ")\n");
 
+  // A call site can only specialize the analysis if an argument gives the
+  // analyzer something to work with: a constant to simplify against or an
+  // alloca SROA could split. Without either, a verdict that rejected the
+  // callee for a structural reason holds for every call site, so serve it
+  // from the cache instead of walking the callee again.
+  bool GenericCallSite =
+      InlineCostCacheVerdicts && llvm::none_of(Call.args(), [](const Use &U) {
+        return isa<Constant>(U.get()) ||
+               isa<AllocaInst>(U.get()->stripPointerCasts());
+      });
+  uint64_t CalleeHash = 0;
+  if (GenericCallSite) {
+    CalleeHash = StructuralHash(*Callee);
+    sys::SmartScopedLock<true> Guard(VerdictCache->Lock);
+    auto It = VerdictCache->Verdicts.find(Callee);
+    if (It != VerdictCache->Verdicts.end() &&
+        It->second.CalleeHash == CalleeHash)
+      return llvm::InlineCost::getNever(It->second.FailureReason);
+  }
+
+  std::chrono::steady_clock::time_point StatsStart;
+  if (InlineCostStats)
+    StatsStart = std::chrono::steady_clock::now();
+
   InlineCostCallAnalyzer CA(*Callee, Call, Params, CalleeTTI,
                             GetAssumptionCache, GetBFI, PSI, ORE);
   InlineResult ShouldInline = CA.analyze();
 
+  if (InlineCostStats)
+    CostStats->record(Callee->getName(),
+                      std::chrono::duration_cast<std::chrono::microseconds>(
+                          std::chrono::steady_clock::now() - StatsStart)
+                          .count());
+
+  if (GenericCallSite && !ShouldInline.isSuccess() &&
+      !CA.wasDecidedByCostThreshold() && !CA.wasDecidedByCostBenefit() &&
+      isCallSiteIndependentFailure(ShouldInline.getFailureReason())) {
+    sys::SmartScopedLock<true> Guard(VerdictCache->Lock);
+    VerdictCache->Verdicts[Callee] = {CalleeHash,
+                                      ShouldInline.getFailureReason()};
+  }
+
   LLVM_DEBUG(CA.dump());
 
   // Always make cost benefit based decision explicit.
@@ -23,9 +23,11 @@
 #include "llvm/IR/Module.h"
 #include "llvm/IR/PassManager.h"
 #include "llvm/Support/Casting.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/GraphWriter.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 
@@ -37,6 +39,15 @@ using namespace llvm;
 
 #define DEBUG_TYPE "lcg"
 
+/// Scan every defined function's body up front, in parallel, instead of
+/// populating edge lists lazily during the (serial) RefSCC DFS. The DFS
+/// itself stays serial and deterministic; only the per-function reference
+/// extraction, which dominates construction time on large modules, is
+/// distributed across threads.
+static cl::opt<bool> ParallelPopulate(
+    "lcg-parallel-populate", cl::Hidden, cl::init(false),
+    cl::desc("Eagerly populate lazy call graph edge lists in parallel"));
+
 void LazyCallGraph::EdgeSequence::insertEdgeInternal(Node &TargetN,
                                                      Edge::Kind EK) {
   EdgeIndexMap.try_emplace(&TargetN, Edges.size());
@@ -202,6 +213,19 @@ LazyCallGraph::LazyCallGraph(
     addEdge(EntryEdges.Edges, EntryEdges.EdgeIndexMap, get(F),
             LazyCallGraph::Edge::Ref);
   });
+
+  if (ParallelPopulate) {
+    // Create the node for every defined function up front. Edge targets are
+    // always defined functions, so once this loop finishes the parallel
+    // population below only ever *looks up* nodes and never mutates the node
+    // map or the allocator.
+    SmallVector<Node *, 16> DefinedNodes;
+    for (Function &F : M)
+      if (!F.isDeclaration())
+        DefinedNodes.push_back(&get(F));
+
+    parallelForEach(DefinedNodes, [](Node *N) { N->populate(); });
+  }
 }
 
 LazyCallGraph::LazyCallGraph(LazyCallGraph &&G)
@@ -58,6 +58,7 @@
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstdint>
 #include <iterator>
 #include <utility>
@@ -139,6 +140,12 @@ static cl::opt<bool> SpeculateUnitStride(
     cl::desc("Speculate that non-constant strides are unit in LAA"),
     cl::init(true));
 
+static cl::opt<bool> LAATimeReport(
+    "laa-time-report", cl::Hidden,
+    cl::desc("Report the time spent analyzing each loop's memory accesses and "
+             "when a cached result is reused"),
+    cl::init(false));
+
 static cl::opt<bool, true> HoistRuntimeChecks(
     "hoist-runtime-checks", cl::Hidden,
     cl::desc(
@@ -2951,9 +2958,24 @@ void LoopAccessInfo::print(raw_ostream &OS, unsigned Depth) const {
 const LoopAccessInfo &LoopAccessInfoManager::getInfo(Loop &L) {
   auto I = LoopAccessInfoMap.insert({&L, nullptr});
 
-  if (I.second)
+  if (I.second) {
+    std::chrono::steady_clock::time_point Start;
+    if (LAATimeReport)
+      Start = std::chrono::steady_clock::now();
     I.first->second =
         std::make_unique<LoopAccessInfo>(&L, &SE, TLI, &AA, &DT, &LI);
+    if (LAATimeReport) {
+      auto Micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - Start)
+                        .count();
+      errs() << "LAA: analyzed loop " << L.getHeader()->getName() << " in "
+             << L.getHeader()->getParent()->getName() << ": " << Micros
+             << "us\n";
+    }
+  } else if (LAATimeReport) {
+    errs() << "LAA: reused cached result for loop " << L.getHeader()->getName()
+           << " in " << L.getHeader()->getParent()->getName() << "\n";
+  }
 
   return *I.first->second;
 }
@@ -76,6 +76,11 @@ static cl::opt<unsigned> MaxCheckLimit(
     cl::desc("The maximum number of stores/phis MemorySSA"
              "will consider trying to walk past (default = 100)"));
 
+static cl::opt<bool> LazyMemorySSABuild(
+    "memssa-lazy-build", cl::Hidden, cl::init(false),
+    cl::desc("Defer MemorySSA construction until the first query, so that "
+             "functions whose MemorySSA is requested but never used are free"));
+
 // Always verify MemorySSA if expensive checking is enabled.
 #ifdef EXPENSIVE_CHECKS
 bool llvm::VerifyMemorySSA = true;
@@ -1236,12 +1241,27 @@ MemorySSA::MemorySSA(Function &Func, AliasAnalysis *AA, DominatorTree *DT)
   // significantly reduce the time spent by the compiler in AA, because we will
   // make queries about all the instructions in the Function.
   assert(AA && "No alias analysis?");
-  BatchAAResults BatchAA(*AA);
-  buildMemorySSA(BatchAA);
+  if (!LazyMemorySSABuild) {
+    BatchAAResults BatchAA(*AA);
+    buildMemorySSA(BatchAA);
+    IsBuilt = true;
+  }
   // Intentionally leave AA to nullptr while building so we don't accidently
   // use non-batch AliasAnalysis.
   this->AA = AA;
-  // Also create the walker here.
+  // Also create the walker here. In lazy mode both the build and the walker
+  // are deferred to the first query via ensureBuilt().
+  if (IsBuilt)
+    getWalker();
+}
+
+void MemorySSA::buildLazy() {
+  assert(!IsBuilt && "Must only be lazily built once!");
+  // Set this first: the build machinery itself goes through accessors that
+  // funnel into ensureBuilt().
+  IsBuilt = true;
+  BatchAAResults BatchAA(*AA);
+  buildMemorySSA(BatchAA);
   getWalker();
 }
 
@@ -1547,6 +1567,7 @@ void MemorySSA::buildMemorySSA(BatchAAResults &BAA) {
 MemorySSAWalker *MemorySSA::getWalker() { return getWalkerImpl(); }
 
 MemorySSA::CachingWalker *MemorySSA::getWalkerImpl() {
+  ensureBuilt();
   if (Walker)
     return Walker.get();
 
@@ -1558,6 +1579,7 @@ MemorySSA::CachingWalker *MemorySSA::getWalkerImpl() {
 }
 
 MemorySSAWalker *MemorySSA::getSkipSelfWalker() {
+  ensureBuilt();
   if (SkipWalker)
     return SkipWalker.get();
 
@@ -1684,6 +1706,7 @@ MemoryUseOrDef *MemorySSA::createDefinedAccess(Instruction *I,
                                                const MemoryUseOrDef *Template,
                                                bool CreationMustSucceed) {
   assert(!isa<PHINode>(I) && "Cannot create a defined access for a PHI");
+  ensureBuilt();
   MemoryUseOrDef *NewAccess = createNewAccess(I, AA, Template);
   if (CreationMustSucceed)
     assert(NewAccess != nullptr && "Tried to create a memory access for a "
@@ -1846,6 +1869,7 @@ void MemorySSA::removeFromLists(MemoryAccess *MA, bool ShouldDelete) {
 }
 
 void MemorySSA::print(raw_ostream &OS) const {
+  ensureBuilt();
   MemorySSAAnnotatedWriter Writer(this);
   F.print(OS, &Writer);
 }
@@ -1855,6 +1879,7 @@ LLVM_DUMP_METHOD void MemorySSA::dump() const { print(dbgs()); }
 #endif
 
 void MemorySSA::verifyMemorySSA(VerificationLevel VL) const {
+  ensureBuilt();
 #if !defined(NDEBUG) && defined(EXPENSIVE_CHECKS)
   VL = VerificationLevel::Full;
 #endif
@@ -2138,6 +2163,7 @@ void MemorySSA::ensureOptimizedUses() {
   if (IsOptimized)
     return;
 
+  ensureBuilt();
   BatchAAResults BatchAA(*AA);
   ClobberWalkerBase WalkerBase(this, DT);
   CachingWalker WalkerLocal(this, &WalkerBase);
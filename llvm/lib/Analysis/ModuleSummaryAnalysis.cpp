@@ -54,6 +54,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
+#include <optional>
 #include <vector>
 
 using namespace llvm;
@@ -178,7 +179,7 @@ static void addIntrinsicToSummary(
     SetVector<FunctionSummary::ConstVCall,
               std::vector<FunctionSummary::ConstVCall>>
         &TypeCheckedLoadConstVCalls,
-    DominatorTree &DT) {
+    function_ref<DominatorTree &()> GetDT) {
   switch (CI->getCalledFunction()->getIntrinsicID()) {
   case Intrinsic::type_test:
   case Intrinsic::public_type_test: {
@@ -200,7 +201,7 @@ static void addIntrinsicToSummary(
 
     SmallVector<DevirtCallSite, 4> DevirtCalls;
     SmallVector<CallInst *, 4> Assumes;
-    findDevirtualizableCallsForTypeTest(DevirtCalls, Assumes, CI, DT);
+    findDevirtualizableCallsForTypeTest(DevirtCalls, Assumes, CI, GetDT());
     for (auto &Call : DevirtCalls)
       addVCallToSet(Call, Guid, TypeTestAssumeVCalls,
                     TypeTestAssumeConstVCalls);
@@ -221,7 +222,7 @@ static void addIntrinsicToSummary(
     SmallVector<Instruction *, 4> Preds;
     bool HasNonCallUses = false;
     findDevirtualizableCallsForTypeCheckedLoad(DevirtCalls, LoadedPtrs, Preds,
-                                               HasNonCallUses, CI, DT);
+                                               HasNonCallUses, CI, GetDT());
     // Any non-call uses of the result of llvm.type.checked.load will
     // prevent us from optimizing away the llvm.type.test.
     if (HasNonCallUses)
@@ -265,9 +266,9 @@ static bool mustBeUnreachableFunction(const Function &F) {
 
 static void computeFunctionSummary(
     ModuleSummaryIndex &Index, const Module &M, const Function &F,
-    BlockFrequencyInfo *BFI, ProfileSummaryInfo *PSI, DominatorTree &DT,
-    bool HasLocalsInUsedOrAsm, DenseSet<GlobalValue::GUID> &CantBePromoted,
-    bool IsThinLTO,
+    BlockFrequencyInfo *BFI, ProfileSummaryInfo *PSI,
+    function_ref<DominatorTree &()> GetDT, bool HasLocalsInUsedOrAsm,
+    DenseSet<GlobalValue::GUID> &CantBePromoted, bool IsThinLTO,
     std::function<const StackSafetyInfo *(const Function &F)> GetSSICallback) {
   // Summary not currently supported for anonymous functions, they should
   // have been named.
@@ -391,7 +392,7 @@ static void computeFunctionSummary(
         if (CI && CalledFunction->isIntrinsic()) {
           addIntrinsicToSummary(
               CI, TypeTests, TypeTestAssumeVCalls, TypeCheckedLoadVCalls,
-              TypeTestAssumeConstVCalls, TypeCheckedLoadConstVCalls, DT);
+              TypeTestAssumeConstVCalls, TypeCheckedLoadConstVCalls, GetDT);
           continue;
         }
         // We should have named any anonymous globals
@@ -919,19 +920,27 @@ ModuleSummaryIndex llvm::buildModuleSummaryIndex(
     if (F.isDeclaration())
       continue;
 
-    DominatorTree DT(const_cast<Function &>(F));
+    // Most functions need no dominator tree: it is only consumed when
+    // summarizing type test/checked load intrinsics and when computing block
+    // frequencies below, so build it on first use.
+    std::optional<DominatorTree> DT;
+    auto GetDT = [&]() -> DominatorTree & {
+      if (!DT)
+        DT.emplace(const_cast<Function &>(F));
+      return *DT;
+    };
     BlockFrequencyInfo *BFI = nullptr;
     std::unique_ptr<BlockFrequencyInfo> BFIPtr;
     if (GetBFICallback)
       BFI = GetBFICallback(F);
     else if (F.hasProfileData()) {
-      LoopInfo LI{DT};
+      LoopInfo LI{GetDT()};
       BranchProbabilityInfo BPI{F, LI};
       BFIPtr = std::make_unique<BlockFrequencyInfo>(F, BPI, LI);
       BFI = BFIPtr.get();
     }
 
-    computeFunctionSummary(Index, M, F, BFI, PSI, DT,
+    computeFunctionSummary(Index, M, F, BFI, PSI, GetDT,
                            !LocalsUsed.empty() || HasLocalInlineAsmSymbol,
                            CantBePromoted, IsThinLTO, GetSSICallback);
   }
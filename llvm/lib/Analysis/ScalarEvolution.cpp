@@ -142,6 +142,10 @@ STATISTIC(NumExitCountsNotComputed,
           "Number of loop exits without predictable exit counts");
 STATISTIC(NumBruteForceTripCountsComputed,
           "Number of loops with trip counts computed by force");
+STATISTIC(NumForgottenSCEVs,
+          "Number of SCEV expressions invalidated by forget calls");
+STATISTIC(NumLiveSCEVsAtForget,
+          "Sum of live SCEV expressions over all forget calls");
 
 #ifdef EXPENSIVE_CHECKS
 bool llvm::VerifySCEV = true;
@@ -2990,10 +2994,9 @@ ScalarEvolution::getOrCreateAddExpr(ArrayRef<const SCEV *> Ops,
   SCEVAddExpr *S =
       static_cast<SCEVAddExpr *>(UniqueSCEVs.FindNodeOrInsertPos(ID, IP));
   if (!S) {
-    const SCEV **O = SCEVAllocator.Allocate<const SCEV *>(Ops.size());
-    std::uninitialized_copy(Ops.begin(), Ops.end(), O);
+    ArrayRef<const SCEV *> O = UniqueOperands.intern(Ops);
     S = new (SCEVAllocator)
-        SCEVAddExpr(ID.Intern(SCEVAllocator), O, Ops.size());
+        SCEVAddExpr(ID.Intern(SCEVAllocator), O.data(), O.size());
     UniqueSCEVs.InsertNode(S, IP);
     registerUser(S, Ops);
   }
@@ -3013,10 +3016,9 @@ ScalarEvolution::getOrCreateAddRecExpr(ArrayRef<const SCEV *> Ops,
   SCEVAddRecExpr *S =
       static_cast<SCEVAddRecExpr *>(UniqueSCEVs.FindNodeOrInsertPos(ID, IP));
   if (!S) {
-    const SCEV **O = SCEVAllocator.Allocate<const SCEV *>(Ops.size());
-    std::uninitialized_copy(Ops.begin(), Ops.end(), O);
+    ArrayRef<const SCEV *> O = UniqueOperands.intern(Ops);
     S = new (SCEVAllocator)
-        SCEVAddRecExpr(ID.Intern(SCEVAllocator), O, Ops.size(), L);
+        SCEVAddRecExpr(ID.Intern(SCEVAllocator), O.data(), O.size(), L);
     UniqueSCEVs.InsertNode(S, IP);
     LoopUsers[L].push_back(S);
     registerUser(S, Ops);
@@ -3036,10 +3038,9 @@ ScalarEvolution::getOrCreateMulExpr(ArrayRef<const SCEV *> Ops,
   SCEVMulExpr *S =
     static_cast<SCEVMulExpr *>(UniqueSCEVs.FindNodeOrInsertPos(ID, IP));
   if (!S) {
-    const SCEV **O = SCEVAllocator.Allocate<const SCEV *>(Ops.size());
-    std::uninitialized_copy(Ops.begin(), Ops.end(), O);
-    S = new (SCEVAllocator) SCEVMulExpr(ID.Intern(SCEVAllocator),
-                                        O, Ops.size());
+    ArrayRef<const SCEV *> O = UniqueOperands.intern(Ops);
+    S = new (SCEVAllocator)
+        SCEVMulExpr(ID.Intern(SCEVAllocator), O.data(), O.size());
     UniqueSCEVs.InsertNode(S, IP);
     registerUser(S, Ops);
   }
@@ -3959,10 +3960,9 @@ const SCEV *ScalarEvolution::getMinMaxExpr(SCEVTypes Kind,
   const SCEV *ExistingSCEV = UniqueSCEVs.FindNodeOrInsertPos(ID, IP);
   if (ExistingSCEV)
     return ExistingSCEV;
-  const SCEV **O = SCEVAllocator.Allocate<const SCEV *>(Ops.size());
-  std::uninitialized_copy(Ops.begin(), Ops.end(), O);
+  ArrayRef<const SCEV *> O = UniqueOperands.intern(Ops);
   SCEV *S = new (SCEVAllocator)
-      SCEVMinMaxExpr(ID.Intern(SCEVAllocator), Kind, O, Ops.size());
+      SCEVMinMaxExpr(ID.Intern(SCEVAllocator), Kind, O.data(), O.size());
 
   UniqueSCEVs.InsertNode(S, IP);
   registerUser(S, Ops);
@@ -4285,10 +4285,9 @@ ScalarEvolution::getSequentialMinMaxExpr(SCEVTypes Kind,
   if (ExistingSCEV)
     return ExistingSCEV;
 
-  const SCEV **O = SCEVAllocator.Allocate<const SCEV *>(Ops.size());
-  std::uninitialized_copy(Ops.begin(), Ops.end(), O);
-  SCEV *S = new (SCEVAllocator)
-      SCEVSequentialMinMaxExpr(ID.Intern(SCEVAllocator), Kind, O, Ops.size());
+  ArrayRef<const SCEV *> O = UniqueOperands.intern(Ops);
+  SCEV *S = new (SCEVAllocator) SCEVSequentialMinMaxExpr(
+      ID.Intern(SCEVAllocator), Kind, O.data(), O.size());
 
   UniqueSCEVs.InsertNode(S, IP);
   registerUser(S, Ops);
@@ -8352,6 +8351,18 @@ void ScalarEvolution::forgetLoop(const Loop *L) {
   SmallPtrSet<Instruction *, 16> Visited;
   SmallVector<const SCEV *, 16> ToForget;
 
+  // Drop information about predicated SCEV rewrites for this loop and all
+  // loops contained in it. A single map scan here is cheaper than rescanning
+  // the map once per loop in the nest below.
+  for (auto I = PredicatedSCEVRewrites.begin();
+       I != PredicatedSCEVRewrites.end();) {
+    std::pair<const SCEV *, const Loop *> Entry = I->first;
+    if (L->contains(Entry.second))
+      PredicatedSCEVRewrites.erase(I++);
+    else
+      ++I;
+  }
+
   // Iterate over all the loops and sub-loops to drop SCEV information.
   while (!LoopWorklist.empty()) {
     auto *CurrL = LoopWorklist.pop_back_val();
@@ -8360,16 +8371,6 @@ void ScalarEvolution::forgetLoop(const Loop *L) {
     forgetBackedgeTakenCounts(CurrL, /* Predicated */ false);
     forgetBackedgeTakenCounts(CurrL, /* Predicated */ true);
 
-    // Drop information about predicated SCEV rewrites for this loop.
-    for (auto I = PredicatedSCEVRewrites.begin();
-         I != PredicatedSCEVRewrites.end();) {
-      std::pair<const SCEV *, const Loop *> Entry = I->first;
-      if (Entry.second == CurrL)
-        PredicatedSCEVRewrites.erase(I++);
-      else
-        ++I;
-    }
-
     auto LoopUsersItr = LoopUsers.find(CurrL);
     if (LoopUsersItr != LoopUsers.end()) {
       ToForget.insert(ToForget.end(), LoopUsersItr->second.begin(),
@@ -13815,6 +13816,11 @@ void ScalarEvolution::forgetMemoizedResults(ArrayRef<const SCEV *> SCEVs) {
           Worklist.push_back(User);
   }
 
+  // Track invalidation precision: how much of the expression pool each
+  // forget call actually discards.
+  NumForgottenSCEVs += ToForget.size();
+  NumLiveSCEVsAtForget += UniqueSCEVs.size();
+
   for (const auto *S : ToForget)
     forgetMemoizedResultsImpl(S);
 
@@ -700,7 +700,20 @@ static bool matchAccessTags(const MDNode *A, const MDNode *B,
 /// Aliases - Test whether the access represented by tag A may alias the
 /// access represented by tag B.
 bool TypeBasedAAResult::Aliases(const MDNode *A, const MDNode *B) const {
-  return matchAccessTags(A, B);
+  // Equal or absent tags trivially alias; don't spend cache space on them.
+  if (A == B || !A || !B)
+    return true;
+
+  // matchAccessTags is symmetric, so canonicalize the pair by address.
+  std::pair<const MDNode *, const MDNode *> Key =
+      A < B ? std::make_pair(A, B) : std::make_pair(B, A);
+  auto It = MatchCache.find(Key);
+  if (It != MatchCache.end())
+    return It->second;
+
+  bool Result = matchAccessTags(A, B);
+  MatchCache.try_emplace(Key, Result);
+  return Result;
 }
 
 AnalysisKey TypeBasedAA::Key;
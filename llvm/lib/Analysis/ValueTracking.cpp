@@ -18,6 +18,7 @@
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
@@ -82,11 +83,22 @@
 using namespace llvm;
 using namespace llvm::PatternMatch;
 
+#define DEBUG_TYPE "value-tracking"
+
+STATISTIC(NumKnownBitsMemoLookups,
+          "Number of known-bits memo table lookups");
+STATISTIC(NumKnownBitsMemoHits, "Number of known-bits memo table hits");
+
 // Controls the number of uses of the value searched for possible
 // dominating comparisons.
 static cl::opt<unsigned> DomConditionsMaxUses("dom-conditions-max-uses",
                                               cl::Hidden, cl::init(20));
 
+// Memoize known-bits sub-results within each top-level query (see
+// computeKnownBitsMemoized below).
+static cl::opt<bool> MemoizeKnownBits("value-tracking-memoize-knownbits",
+                                      cl::Hidden, cl::init(false));
+
 
 /// Returns the bitwidth of the given scalar or pointer type. For vector types,
 /// returns the element type's bitwidth.
@@ -1763,9 +1775,9 @@ KnownBits llvm::computeKnownBits(const Value *V, unsigned Depth,
 /// where V is a vector, known zero, and known one values are the
 /// same width as the vector element, and the bit is set only if it is true
 /// for all of the demanded elements in the vector specified by DemandedElts.
-void computeKnownBits(const Value *V, const APInt &DemandedElts,
-                      KnownBits &Known, unsigned Depth,
-                      const SimplifyQuery &Q) {
+static void computeKnownBitsImpl(const Value *V, const APInt &DemandedElts,
+                                 KnownBits &Known, unsigned Depth,
+                                 const SimplifyQuery &Q) {
   if (!DemandedElts) {
     // No demanded elts, better to assume we don't know anything.
     Known.resetAll();
@@ -1897,6 +1909,70 @@ void computeKnownBits(const Value *V, const APInt &DemandedElts,
   assert((Known.Zero & Known.One) == 0 && "Bits known to be one AND zero?");
 }
 
+namespace {
+/// Memo of known-bits sub-results for one top-level query. The use-def walk
+/// below is a depth-limited DAG traversal, so diamond shapes recompute the
+/// same sub-values many times over; within a single top-level query the IR
+/// cannot change, which makes memoization sound. Known bits computed at any
+/// depth are correct facts, so reusing a result across different recursion
+/// depths only ever changes precision, never correctness.
+struct KnownBitsQueryMemo {
+  SmallDenseMap<const Value *, KnownBits, 16> Map;
+  /// The query the memo was opened with. Sub-queries that use a rewritten
+  /// SimplifyQuery (e.g. the per-incoming-block context used for phis) bypass
+  /// the memo, which a pointer comparison detects cheaply.
+  const SimplifyQuery *Q;
+
+  KnownBitsQueryMemo(const SimplifyQuery &Q) : Q(&Q) {}
+};
+} // end anonymous namespace
+
+static LLVM_THREAD_LOCAL KnownBitsQueryMemo *ActiveKnownBitsMemo = nullptr;
+
+static void computeKnownBitsMemoized(const Value *V, const APInt &DemandedElts,
+                                     KnownBits &Known, unsigned Depth,
+                                     const SimplifyQuery &Q) {
+  if (Depth == 0 && !ActiveKnownBitsMemo) {
+    // Open a memo scope covering this top-level query.
+    KnownBitsQueryMemo Memo(Q);
+    ActiveKnownBitsMemo = &Memo;
+    computeKnownBitsMemoized(V, DemandedElts, Known, Depth, Q);
+    ActiveKnownBitsMemo = nullptr;
+    return;
+  }
+
+  // Only scalar sub-results for non-constant operators are worth memoizing,
+  // and only while the query context is the one the memo was opened with.
+  KnownBitsQueryMemo *Memo = ActiveKnownBitsMemo;
+  bool Cacheable = Memo && Memo->Q == &Q && isa<Operator>(V) &&
+                   DemandedElts.getBitWidth() == 1 && DemandedElts[0];
+  if (Cacheable) {
+    ++NumKnownBitsMemoLookups;
+    auto It = Memo->Map.find(V);
+    if (It != Memo->Map.end()) {
+      ++NumKnownBitsMemoHits;
+      Known = It->second;
+      return;
+    }
+  }
+
+  computeKnownBitsImpl(V, DemandedElts, Known, Depth, Q);
+
+  if (Cacheable)
+    Memo->Map[V] = Known;
+}
+
+/// Dispatch to the memoizing path when enabled; see computeKnownBitsImpl for
+/// the actual transfer functions.
+void computeKnownBits(const Value *V, const APInt &DemandedElts,
+                      KnownBits &Known, unsigned Depth,
+                      const SimplifyQuery &Q) {
+  if (LLVM_UNLIKELY(MemoizeKnownBits))
+    computeKnownBitsMemoized(V, DemandedElts, Known, Depth, Q);
+  else
+    computeKnownBitsImpl(V, DemandedElts, Known, Depth, Q);
+}
+
 /// Try to detect a recurrence that the value of the induction variable is
 /// always a power of two (or zero).
 static bool isPowerOfTwoRecurrence(const PHINode *PN, bool OrZero,
@@ -669,6 +669,12 @@ class BitcodeReader : public BitcodeReaderBase, public GVMaterializer {
   /// (e.g.) blockaddress forward references.
   bool WillMaterializeAllForwardRefs = false;
 
+  /// True while materializeModule() is materializing every function body.
+  /// Per-function intrinsic call upgrades are deferred to the single
+  /// whole-module upgrade pass at the end of materializeModule(), instead of
+  /// rescanning every upgraded intrinsic's user list once per function.
+  bool MaterializingAllFunctions = false;
+
   bool StripDebugInfo = false;
   TBAAVerifier TBAAVerifyHelper;
 
@@ -6634,11 +6640,16 @@ Error BitcodeReader::materialize(GlobalValue *GV) {
   if (StripDebugInfo)
     stripDebugInfo(*F);
 
-  // Upgrade any old intrinsic calls in the function.
-  for (auto &I : UpgradedIntrinsics) {
-    for (User *U : llvm::make_early_inc_range(I.first->materialized_users()))
-      if (CallInst *CI = dyn_cast<CallInst>(U))
-        UpgradeIntrinsicCall(CI, I.second);
+  // Upgrade any old intrinsic calls in the function. When the whole module is
+  // being materialized this is deferred to the single pass over each upgraded
+  // intrinsic's users at the end of materializeModule(); nothing observes the
+  // module until that pass has run.
+  if (!MaterializingAllFunctions) {
+    for (auto &I : UpgradedIntrinsics) {
+      for (User *U : llvm::make_early_inc_range(I.first->materialized_users()))
+        if (CallInst *CI = dyn_cast<CallInst>(U))
+          UpgradeIntrinsicCall(CI, I.second);
+    }
   }
 
   // Finish fn->subprogram upgrade for materialized functions.
@@ -6712,11 +6723,16 @@ Error BitcodeReader::materializeModule() {
   WillMaterializeAllForwardRefs = true;
 
   // Iterate over the module, deserializing any functions that are still on
-  // disk.
+  // disk. Intrinsic call upgrades are batched into the whole-module pass
+  // below rather than performed once per function.
+  MaterializingAllFunctions = true;
   for (Function &F : *TheModule) {
-    if (Error Err = materialize(&F))
+    if (Error Err = materialize(&F)) {
+      MaterializingAllFunctions = false;
       return Err;
+    }
   }
+  MaterializingAllFunctions = false;
   // At this point, if there are any function bodies, parse the rest of
   // the bits in the module past the last function block we have recorded
   // through either lazy scanning or the VST.
@@ -6731,10 +6747,10 @@ Error BitcodeReader::materializeModule() {
   if (!BasicBlockFwdRefs.empty())
     return error("Never resolved function from blockaddress");
 
-  // Upgrade any intrinsic calls that slipped through (should not happen!) and
-  // delete the old functions to clean up. We can't do this unless the entire
-  // module is materialized because there could always be another function body
-  // with calls to the old function.
+  // Upgrade all remaining intrinsic calls (per-function upgrades were
+  // deferred to this pass above) and delete the old functions to clean up.
+  // We can't do this unless the entire module is materialized because there
+  // could always be another function body with calls to the old function.
   for (auto &I : UpgradedIntrinsics) {
     for (auto *U : I.first->users()) {
       if (CallInst *CI = dyn_cast<CallInst>(U))
@@ -298,14 +298,34 @@ Expected<unsigned> BitstreamCursor::readRecord(unsigned AbbrevID,
       switch (EltEnc.getEncoding()) {
       default:
         return error("Array element type can't be an Array or a Blob");
-      case BitCodeAbbrevOp::Fixed:
+      case BitCodeAbbrevOp::Fixed: {
+        const unsigned EltWidth = (unsigned)EltEnc.getEncodingData();
+        // Fixed-width elements are packed LSB-first, so one word-sized read
+        // holds several of them; split the word with shifts and masks instead
+        // of paying the per-element read overhead.
+        if (EltWidth >= 1 && EltWidth <= MaxChunkSize) {
+          const unsigned BitsInWord = sizeof(word_t) * 8;
+          const unsigned PerRead = BitsInWord / EltWidth;
+          const word_t EltMask = ~word_t(0) >> (BitsInWord - EltWidth);
+          while (NumElts >= PerRead) {
+            Expected<word_t> MaybeBatch = Read(PerRead * EltWidth);
+            if (!MaybeBatch)
+              return MaybeBatch.takeError();
+            word_t Batch = MaybeBatch.get();
+            for (unsigned Elt = 0; Elt != PerRead; ++Elt) {
+              Vals.push_back(Batch & EltMask);
+              Batch >>= EltWidth;
+            }
+            NumElts -= PerRead;
+          }
+        }
         for (; NumElts; --NumElts)
-          if (Expected<SimpleBitstreamCursor::word_t> MaybeVal =
-                  Read((unsigned)EltEnc.getEncodingData()))
+          if (Expected<SimpleBitstreamCursor::word_t> MaybeVal = Read(EltWidth))
             Vals.push_back(MaybeVal.get());
           else
             return MaybeVal.takeError();
         break;
+      }
       case BitCodeAbbrevOp::VBR:
         for (; NumElts; --NumElts)
           if (Expected<uint64_t> MaybeVal =
@@ -315,6 +335,18 @@ Expected<unsigned> BitstreamCursor::readRecord(unsigned AbbrevID,
             return MaybeVal.takeError();
         break;
       case BitCodeAbbrevOp::Char6:
+        // Ten 6-bit characters fit in a single word-sized read.
+        while (NumElts >= 10) {
+          Expected<word_t> MaybeBatch = Read(60);
+          if (!MaybeBatch)
+            return MaybeBatch.takeError();
+          word_t Batch = MaybeBatch.get();
+          for (unsigned Elt = 0; Elt != 10; ++Elt) {
+            Vals.push_back(BitCodeAbbrevOp::DecodeChar6(Batch & 0x3f));
+            Batch >>= 6;
+          }
+          NumElts -= 10;
+        }
         for (; NumElts; --NumElts)
           if (Expected<SimpleBitstreamCursor::word_t> MaybeVal = Read(6))
             Vals.push_back(BitCodeAbbrevOp::DecodeChar6(MaybeVal.get()));
@@ -18,8 +18,10 @@
 #include "llvm/BinaryFormat/Dwarf.h"
 #include "llvm/CodeGen/AsmPrinter.h"
 #include "llvm/CodeGen/DIE.h"
+#include "llvm/IR/PassTimingInfo.h"
 #include "llvm/MC/MCStreamer.h"
 #include "llvm/MC/MCSymbol.h"
+#include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Target/TargetLoweringObjectFile.h"
 #include <algorithm>
@@ -30,6 +32,11 @@
 
 using namespace llvm;
 
+static const char AccelTimerName[] = "accel";
+static const char AccelTimerDescription[] = "Accelerator Table Emission";
+static const char AccelGroupName[] = "dwarf";
+static const char AccelGroupDescription[] = "DWARF Emission";
+
 void AccelTableBase::computeBucketCount() {
   // First get the number of unique hashes.
   std::vector<uint32_t> Uniques;
@@ -630,6 +637,11 @@ void llvm::emitDWARF5AccelTable(
   Asm->OutStreamer->switchSection(
       Asm->getObjFileLowering().getDwarfDebugNamesSection());
 
+  // Bucketing and emission are a visible serial tail of -g compiles; time
+  // them under the DWARF emission group so -time-passes accounts for them
+  // separately.
+  NamedRegionTimer T(AccelTimerName, AccelTimerDescription, AccelGroupName,
+                     AccelGroupDescription, TimePassesIsEnabled);
   Contents.finalize(Asm, "names");
   dwarf::Form CUIndexForm =
       DIEInteger::BestForm(/*IsSigned*/ false, CompUnits.size() - 1);
@@ -666,6 +678,8 @@ void llvm::emitDWARF5AccelTable(
         const DWARF5AccelTableData &)>
         getIndexForEntry) {
   std::vector<std::variant<MCSymbol *, uint64_t>> TypeUnits;
+  NamedRegionTimer T(AccelTimerName, AccelTimerDescription, AccelGroupName,
+                     AccelGroupDescription, TimePassesIsEnabled);
   Contents.finalize(Asm, "names");
   Dwarf5AccelTableWriter<DWARF5AccelTableData>(Asm, Contents, CUs, TypeUnits,
                                                getIndexForEntry, false)
@@ -12,19 +12,61 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/CodeGen/GlobalISel/GIMatchTableExecutor.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/CodeGen/GlobalISel/Utils.h"
 #include "llvm/CodeGen/MachineInstr.h"
 #include "llvm/CodeGen/MachineOperand.h"
 #include "llvm/CodeGen/MachineRegisterInfo.h"
+#include "llvm/CodeGen/TargetInstrInfo.h"
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
 
 #define DEBUG_TYPE "gi-match-table-executor"
 
 using namespace llvm;
 
+static cl::opt<bool> GIMatchTableStats(
+    "gisel-match-table-stats", cl::Hidden, cl::init(false),
+    cl::desc("Count match table executions and successful matches per root "
+             "opcode and print the hit rates on exit"));
+
 GIMatchTableExecutor::MatcherState::MatcherState(unsigned MaxRenderers)
     : Renderers(MaxRenderers) {}
 
-GIMatchTableExecutor::GIMatchTableExecutor() = default;
+GIMatchTableExecutor::GIMatchTableExecutor()
+    : CollectMatchTableStats(GIMatchTableStats) {}
+
+GIMatchTableExecutor::~GIMatchTableExecutor() {
+  if (MatchTableStats.empty())
+    return;
+
+  SmallVector<const StringMapEntry<std::pair<uint64_t, uint64_t>> *, 0> Rows;
+  for (const auto &Entry : MatchTableStats)
+    Rows.push_back(&Entry);
+  llvm::sort(Rows, [](const auto *A, const auto *B) {
+    return A->second.first > B->second.first;
+  });
+
+  errs() << "Match table hit rates:\n";
+  for (const auto *Row : Rows) {
+    auto [Executions, Matches] = Row->second;
+    errs() << format("  %-24s %12" PRIu64 " executions, %12" PRIu64
+                     " matches (%5.1f%%)\n",
+                     Row->first().str().c_str(), Executions, Matches,
+                     Executions ? 100.0 * Matches / Executions : 0.0);
+  }
+}
+
+void GIMatchTableExecutor::recordMatchTableAttempt(unsigned Opcode,
+                                                   const TargetInstrInfo &TII,
+                                                   bool Matched) const {
+  auto &Counters = MatchTableStats[TII.getName(Opcode)];
+  if (Matched)
+    ++Counters.second;
+  else
+    ++Counters.first;
+}
 
 bool GIMatchTableExecutor::isOperandImmEqual(const MachineOperand &MO,
                                              int64_t Value,
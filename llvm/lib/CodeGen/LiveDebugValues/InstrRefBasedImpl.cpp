@@ -81,6 +81,7 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/PostOrderIterator.h"
 #include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/ADT/SmallVector.h"
@@ -136,6 +137,9 @@ using namespace LiveDebugValues;
 #undef DEBUG_TYPE
 #define DEBUG_TYPE "livedebugvalues"
 
+STATISTIC(NumScopesSkipped,
+          "Number of lexical scopes exceeding the scope work limit");
+
 // Act more like the VarLoc implementation, by propagating some locations too
 // far and ignoring some transfers.
 static cl::opt<bool> EmulateOldLDV("emulate-old-livedebugvalues", cl::Hidden,
@@ -156,6 +160,18 @@ static cl::opt<unsigned>
                          cl::desc("livedebugvalues-stack-ws-limit"),
                          cl::init(250));
 
+// Variable values are solved per lexical scope, over the scope's blocks and
+// variables. This caps how large that product may grow before the scope's
+// cross-block propagation is skipped: its variables then keep their
+// block-local locations, trading debug-info coverage for compile time on
+// pathological functions. A quality knob rather than a correctness one.
+static cl::opt<unsigned> ScopeWorkLimit(
+    "livedebugvalues-scope-work-limit", cl::Hidden,
+    cl::desc("Maximum product of blocks and variables in one lexical scope "
+             "for which variable values are propagated across blocks "
+             "(0 = unlimited)"),
+    cl::init(0));
+
 DbgOpID DbgOpID::UndefID = DbgOpID(0xffffffff);
 
 /// Tracker for converting machine value locations and variable values into
@@ -3552,8 +3568,21 @@ bool InstrRefBasedLDV::depthFirstVLocAndEmit(
       auto &VarsWeCareAbout = ScopeToVars.find(WS)->second;
       auto &BlocksInScope = ScopeToAssignBlocks.find(WS)->second;
 
-      buildVLocValueMap(DILoc, VarsWeCareAbout, BlocksInScope, Output, MOutLocs,
-                        MInLocs, AllTheVLocs);
+      // Skip propagation for scopes whose dataflow problem is deemed too
+      // expensive; their variables keep the block-local locations installed
+      // when each block is ejected below.
+      if (ScopeWorkLimit != 0 &&
+          VarsWeCareAbout.size() * BlocksInScope.size() > ScopeWorkLimit) {
+        ++NumScopesSkipped;
+        LLVM_DEBUG(dbgs() << "Skipping VLoc propagation for scope with "
+                          << VarsWeCareAbout.size() << " variables over "
+                          << BlocksInScope.size()
+                          << " assignment blocks, exceeding scope work "
+                             "limit\n");
+      } else {
+        buildVLocValueMap(DILoc, VarsWeCareAbout, BlocksInScope, Output,
+                          MOutLocs, MInLocs, AllTheVLocs);
+      }
     }
 
     HighestDFSIn = std::max(HighestDFSIn, WS->getDFSIn());
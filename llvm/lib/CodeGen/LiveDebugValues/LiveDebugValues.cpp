@@ -8,11 +8,14 @@
 
 #include "LiveDebugValues.h"
 
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
 #include "llvm/CodeGen/MachineDominators.h"
 #include "llvm/CodeGen/MachineFunction.h"
 #include "llvm/CodeGen/MachineFunctionPass.h"
+#include "llvm/CodeGen/MachineOptimizationRemarkEmitter.h"
 #include "llvm/CodeGen/Passes.h"
 #include "llvm/CodeGen/TargetPassConfig.h"
+#include "llvm/IR/DiagnosticInfo.h"
 #include "llvm/InitializePasses.h"
 #include "llvm/Pass.h"
 #include "llvm/PassRegistry.h"
@@ -20,6 +23,8 @@
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/TargetParser/Triple.h"
 
+#include <chrono>
+
 /// \file LiveDebugValues.cpp
 ///
 /// The LiveDebugValues pass extends the range of variable locations
@@ -75,6 +80,7 @@ public:
 
   void getAnalysisUsage(AnalysisUsage &AU) const override {
     AU.setPreservesCFG();
+    AU.addRequired<MachineOptimizationRemarkEmitterPass>();
     MachineFunctionPass::getAnalysisUsage(AU);
   }
 
@@ -90,8 +96,11 @@ char LiveDebugValues::ID = 0;
 
 char &llvm::LiveDebugValuesID = LiveDebugValues::ID;
 
-INITIALIZE_PASS(LiveDebugValues, DEBUG_TYPE, "Live DEBUG_VALUE analysis", false,
-                false)
+INITIALIZE_PASS_BEGIN(LiveDebugValues, DEBUG_TYPE, "Live DEBUG_VALUE analysis",
+                      false, false)
+INITIALIZE_PASS_DEPENDENCY(MachineOptimizationRemarkEmitterPass)
+INITIALIZE_PASS_END(LiveDebugValues, DEBUG_TYPE, "Live DEBUG_VALUE analysis",
+                    false, false)
 
 /// Default construct and initialize the pass.
 LiveDebugValues::LiveDebugValues() : MachineFunctionPass(ID) {
@@ -124,8 +133,33 @@ bool LiveDebugValues::runOnMachineFunction(MachineFunction &MF) {
     TheImpl = &*InstrRefImpl;
   }
 
-  return TheImpl->ExtendRanges(MF, DomTree, TPC, InputBBLimit,
-                               InputDbgValueLimit);
+  // Report how long location propagation takes, per function, when analysis
+  // remarks are requested. This is cheap enough to measure unconditionally,
+  // but only worth measuring when someone will see it.
+  MachineOptimizationRemarkEmitter &ORE =
+      getAnalysis<MachineOptimizationRemarkEmitterPass>().getORE();
+  bool TimeIt = ORE.allowExtraAnalysis(DEBUG_TYPE);
+  std::chrono::steady_clock::time_point Start;
+  if (TimeIt)
+    Start = std::chrono::steady_clock::now();
+
+  bool Changed = TheImpl->ExtendRanges(MF, DomTree, TPC, InputBBLimit,
+                                       InputDbgValueLimit);
+
+  if (TimeIt) {
+    auto Micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                      std::chrono::steady_clock::now() - Start)
+                      .count();
+    ORE.emit([&]() {
+      return MachineOptimizationRemarkAnalysis(DEBUG_TYPE, "LDVTime",
+                                               MF.getFunction().getSubprogram(),
+                                               &MF.front())
+             << "extending debug value ranges took "
+             << ore::NV("Microseconds", (unsigned long long)Micros)
+             << " microseconds";
+    });
+  }
+  return Changed;
 }
 
 bool llvm::debuginfoShouldUseDebugInstrRef(const Triple &T) {
@@ -190,6 +190,62 @@ LiveIntervalUnion::Query::collectInterferingVRegs(unsigned MaxInterferingRegs) {
   return InterferingVRegs.size();
 }
 
+// Check LR against several unions at once. A single walk over LR's segments
+// drives a parallel merge through each candidate union, so LR's segment array
+// stays hot in cache instead of being re-walked once per candidate, and a
+// candidate drops out of the scan as soon as its first interference is found.
+BitVector
+LiveIntervalUnion::Array::checkInterference(const LiveRange &LR,
+                                            ArrayRef<unsigned> Units) const {
+  BitVector Interference(Units.size());
+  if (LR.empty())
+    return Interference;
+
+  // Per-candidate union iterators. An invalid iterator means the union is
+  // empty or exhausted and can no longer interfere.
+  SmallVector<ConstSegmentIter, 8> UnionI(Units.size());
+  unsigned RemainingUnits = 0;
+  for (unsigned Idx = 0, E = Units.size(); Idx != E; ++Idx) {
+    const LiveIntervalUnion &LIU = (*this)[Units[Idx]];
+    if (LIU.empty())
+      continue;
+    UnionI[Idx].setMap(LIU.getMap());
+    UnionI[Idx].find(LR.begin()->start);
+    if (UnionI[Idx].valid())
+      ++RemainingUnits;
+  }
+
+  for (const LiveRange::Segment &Seg : LR) {
+    if (!RemainingUnits)
+      break;
+    for (unsigned Idx = 0, E = Units.size(); Idx != E; ++Idx) {
+      if (Interference.test(Idx))
+        continue;
+      ConstSegmentIter &UI = UnionI[Idx];
+      if (!UI.valid())
+        continue;
+      // Only advance on monotonically increasing keys.
+      if (UI.stop() < Seg.start)
+        UI.advanceTo(Seg.start);
+      // A union segment ending exactly at Seg.start does not overlap the
+      // half-open live range segment; step past it.
+      while (UI.valid() && UI.stop() <= Seg.start)
+        ++UI;
+      if (!UI.valid()) {
+        --RemainingUnits;
+        continue;
+      }
+      // UI.stop() > Seg.start here, so this is an overlap iff the union
+      // segment also starts before Seg ends.
+      if (UI.start() < Seg.end) {
+        Interference.set(Idx);
+        --RemainingUnits;
+      }
+    }
+  }
+  return Interference;
+}
+
 void LiveIntervalUnion::Array::init(LiveIntervalUnion::Allocator &Alloc,
                                     unsigned NSize) {
   // Reuse existing allocation.
@@ -113,6 +113,8 @@ void LiveIntervals::releaseMemory() {
     delete LR;
   RegUnitRanges.clear();
 
+  RepairQueue.clear();
+
   // Release VNInfo memory regions, VNInfo objects don't need to be dtor'd.
   VNInfoAllocator.Reset();
 }
@@ -1496,6 +1498,10 @@ private:
 };
 
 void LiveIntervals::handleMove(MachineInstr &MI, bool UpdateFlags) {
+  // Queued repairs reason about the instruction order; apply them before it
+  // changes.
+  applyQueuedRepairs();
+
   // It is fine to move a bundle as a whole, but not an individual instruction
   // inside it.
   assert((!MI.isBundled() || MI.getOpcode() == TargetOpcode::BUNDLE) &&
@@ -1513,6 +1519,8 @@ void LiveIntervals::handleMove(MachineInstr &MI, bool UpdateFlags) {
 
 void LiveIntervals::handleMoveIntoNewBundle(MachineInstr &BundleStart,
                                             bool UpdateFlags) {
+  applyQueuedRepairs();
+
   assert((BundleStart.getOpcode() == TargetOpcode::BUNDLE) &&
          "Bundle start is not a bundle");
   SmallVector<SlotIndex, 16> ToProcess;
@@ -1699,6 +1707,99 @@ LiveIntervals::repairIntervalsInRange(MachineBasicBlock *MBB,
   }
 }
 
+void LiveIntervals::queueRepairIntervalsInRange(
+    MachineBasicBlock *MBB, MachineBasicBlock::iterator Begin,
+    MachineBasicBlock::iterator End, ArrayRef<Register> OrigRegs) {
+  // Anchor the range at indexed instructions, like repairIntervalsInRange()
+  // does, so that it can be described without holding iterators to possibly
+  // short-lived unindexed instructions.
+  while (Begin != MBB->begin() && !Indexes->hasIndex(*std::prev(Begin)))
+    --Begin;
+  while (End != MBB->end() && !Indexes->hasIndex(*End))
+    ++End;
+
+  SlotIndex BeginIdx = Begin == MBB->begin()
+                           ? SlotIndex()
+                           : getInstructionIndex(*std::prev(Begin));
+  SlotIndex EndIdx = End == MBB->end() ? SlotIndex() : getInstructionIndex(*End);
+  SlotIndex OrdBegin = BeginIdx.isValid() ? BeginIdx : getMBBStartIdx(MBB);
+  SlotIndex OrdEnd = EndIdx.isValid() ? EndIdx : getMBBEndIdx(MBB);
+
+  // Coalesce with a queued range in the same block when the two overlap. One
+  // repair of the combined range subsumes both, since a repair only modifies
+  // live segments intersecting its range.
+  for (QueuedRepair &QR : RepairQueue) {
+    if (QR.MBB != MBB)
+      continue;
+    SlotIndex QROrdBegin =
+        QR.BeginIdx.isValid() ? QR.BeginIdx : getMBBStartIdx(MBB);
+    SlotIndex QROrdEnd = QR.EndIdx.isValid() ? QR.EndIdx : getMBBEndIdx(MBB);
+    if (OrdEnd < QROrdBegin || QROrdEnd < OrdBegin)
+      continue;
+    if (OrdBegin < QROrdBegin)
+      QR.BeginIdx = BeginIdx;
+    if (QROrdEnd < OrdEnd)
+      QR.EndIdx = EndIdx;
+    for (Register Reg : OrigRegs)
+      if (!is_contained(QR.OrigRegs, Reg))
+        QR.OrigRegs.push_back(Reg);
+    return;
+  }
+
+  QueuedRepair &QR = RepairQueue.emplace_back();
+  QR.MBB = MBB;
+  QR.BeginIdx = BeginIdx;
+  QR.EndIdx = EndIdx;
+  QR.OrigRegs.assign(OrigRegs.begin(), OrigRegs.end());
+}
+
+void LiveIntervals::applyQueuedRepairsImpl() {
+  // Move the queue aside so that reentrant flushes see it empty.
+  SmallVector<QueuedRepair, 4> Repairs = std::move(RepairQueue);
+  RepairQueue.clear();
+  for (const QueuedRepair &QR : Repairs) {
+    MachineBasicBlock::iterator Begin =
+        QR.BeginIdx.isValid()
+            ? std::next(MachineBasicBlock::iterator(
+                  getInstructionFromIndex(QR.BeginIdx)))
+            : QR.MBB->begin();
+    MachineBasicBlock::iterator End =
+        QR.EndIdx.isValid()
+            ? MachineBasicBlock::iterator(getInstructionFromIndex(QR.EndIdx))
+            : QR.MBB->end();
+    repairIntervalsInRange(QR.MBB, Begin, End, QR.OrigRegs);
+  }
+}
+
+void LiveIntervals::updateQueuedRepairsForRemoval(MachineInstr &MI) {
+  // Removing an unindexed instruction cannot affect a queued range, and
+  // removing an indexed instruction strictly inside one leaves the range's
+  // delimiters alone. Only a delimiting instruction needs handling: walk the
+  // delimiter over the removed instruction so the queued range stays
+  // reconstructible. Widening the range this way is always safe.
+  if (!Indexes->hasIndex(MI))
+    return;
+  SlotIndex Idx = getInstructionIndex(MI);
+  for (QueuedRepair &QR : RepairQueue) {
+    if (QR.MBB != MI.getParent())
+      continue;
+    if (QR.BeginIdx == Idx) {
+      MachineBasicBlock::iterator It = MI.getIterator();
+      while (It != QR.MBB->begin() && !Indexes->hasIndex(*std::prev(It)))
+        --It;
+      QR.BeginIdx = It == QR.MBB->begin() ? SlotIndex()
+                                          : getInstructionIndex(*std::prev(It));
+    }
+    if (QR.EndIdx == Idx) {
+      MachineBasicBlock::iterator It = std::next(MI.getIterator());
+      while (It != QR.MBB->end() && !Indexes->hasIndex(*It))
+        ++It;
+      QR.EndIdx =
+          It == QR.MBB->end() ? SlotIndex() : getInstructionIndex(*It);
+    }
+  }
+}
+
 void LiveIntervals::removePhysRegDefAt(MCRegister Reg, SlotIndex Pos) {
   for (MCRegUnit Unit : TRI->regunits(Reg)) {
     if (LiveRange *LR = getCachedRegUnit(Unit))
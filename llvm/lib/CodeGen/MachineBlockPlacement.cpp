@@ -33,6 +33,7 @@
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/Analysis/BlockFrequencyInfoImpl.h"
+#include "llvm/Analysis/OptimizationRemarkEmitter.h"
 #include "llvm/Analysis/ProfileSummaryInfo.h"
 #include "llvm/CodeGen/MBFIWrapper.h"
 #include "llvm/CodeGen/MachineBasicBlock.h"
@@ -41,6 +42,7 @@
 #include "llvm/CodeGen/MachineFunction.h"
 #include "llvm/CodeGen/MachineFunctionPass.h"
 #include "llvm/CodeGen/MachineLoopInfo.h"
+#include "llvm/CodeGen/MachineOptimizationRemarkEmitter.h"
 #include "llvm/CodeGen/MachinePostDominators.h"
 #include "llvm/CodeGen/MachineSizeOpts.h"
 #include "llvm/CodeGen/TailDuplicator.h"
@@ -65,6 +67,7 @@
 #include "llvm/Transforms/Utils/CodeLayout.h"
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstdint>
 #include <iterator>
 #include <memory>
@@ -201,6 +204,17 @@ static cl::opt<unsigned> TriangleChainCount(
     cl::init(2),
     cl::Hidden);
 
+// Compile-time escape hatch for pathologically large functions (e.g. huge
+// interpreter loops). Loop placement is unaffected; only the
+// duplication-aware parts of chain formation and the post-layout re-layout
+// are dropped, which is where the cost explodes with block count.
+static cl::opt<unsigned> HugeFunctionThreshold(
+    "block-placement-huge-function-threshold",
+    cl::desc("Basic block count above which placement switches to a cheaper "
+             "strategy: no tail duplication during placement and no "
+             "post-layout tail merging. 0 to disable."),
+    cl::init(0), cl::Hidden);
+
 // Use case: When block layout is visualized after MBP pass, the basic blocks
 // are labeled in layout order; meanwhile blocks could be numbered in a
 // different order. It's hard to map between the graph and pass output.
@@ -374,6 +388,10 @@ class MachineBlockPlacement : public MachineFunctionPass {
   /// Machine Function
   MachineFunction *F = nullptr;
 
+  /// True if the current function exceeds HugeFunctionThreshold and should be
+  /// laid out with the cheaper strategy.
+  bool HugeFunction = false;
+
   /// A handle to the branch probability pass.
   const MachineBranchProbabilityInfo *MBPI = nullptr;
 
@@ -599,7 +617,8 @@ public:
 
   bool allowTailDupPlacement() const {
     assert(F);
-    return TailDupPlacement && !F->getTarget().requiresStructuredCFG();
+    return TailDupPlacement && !HugeFunction &&
+           !F->getTarget().requiresStructuredCFG();
   }
 
   void getAnalysisUsage(AnalysisUsage &AU) const override {
@@ -608,6 +627,7 @@ public:
     if (TailDupPlacement)
       AU.addRequired<MachinePostDominatorTree>();
     AU.addRequired<MachineLoopInfo>();
+    AU.addRequired<MachineOptimizationRemarkEmitterPass>();
     AU.addRequired<ProfileSummaryInfoWrapperPass>();
     AU.addRequired<TargetPassConfig>();
     MachineFunctionPass::getAnalysisUsage(AU);
@@ -626,6 +646,7 @@ INITIALIZE_PASS_DEPENDENCY(MachineBranchProbabilityInfo)
 INITIALIZE_PASS_DEPENDENCY(MachineBlockFrequencyInfo)
 INITIALIZE_PASS_DEPENDENCY(MachinePostDominatorTree)
 INITIALIZE_PASS_DEPENDENCY(MachineLoopInfo)
+INITIALIZE_PASS_DEPENDENCY(MachineOptimizationRemarkEmitterPass)
 INITIALIZE_PASS_DEPENDENCY(ProfileSummaryInfoWrapperPass)
 INITIALIZE_PASS_END(MachineBlockPlacement, DEBUG_TYPE,
                     "Branch Probability Basic Block Placement", false, false)
@@ -3371,6 +3392,7 @@ bool MachineBlockPlacement::runOnMachineFunction(MachineFunction &MF) {
     return false;
 
   F = &MF;
+  HugeFunction = HugeFunctionThreshold && MF.size() > HugeFunctionThreshold;
   MBPI = &getAnalysis<MachineBranchProbabilityInfo>();
   MBFI = std::make_unique<MBFIWrapper>(
       getAnalysis<MachineBlockFrequencyInfo>());
@@ -3380,6 +3402,16 @@ bool MachineBlockPlacement::runOnMachineFunction(MachineFunction &MF) {
   MPDT = nullptr;
   PSI = &getAnalysis<ProfileSummaryInfoWrapperPass>().getPSI();
 
+  // Report per-function layout time as an analysis remark when requested, so
+  // that pathological functions can be found (and the huge-function threshold
+  // tuned) without rerunning with -time-passes.
+  MachineOptimizationRemarkEmitter &ORE =
+      getAnalysis<MachineOptimizationRemarkEmitterPass>().getORE();
+  bool TimeIt = ORE.allowExtraAnalysis(DEBUG_TYPE);
+  std::chrono::steady_clock::time_point StartTime;
+  if (TimeIt)
+    StartTime = std::chrono::steady_clock::now();
+
   initDupThreshold();
 
   // Initialize PreferredLoopExit to nullptr here since it may never be set if
@@ -3433,9 +3465,11 @@ bool MachineBlockPlacement::runOnMachineFunction(MachineFunction &MF) {
   // Changing the layout can create new tail merging opportunities.
   // TailMerge can create jump into if branches that make CFG irreducible for
   // HW that requires structured CFG.
+  // Tail merging after placement forces a second full layout pass when it
+  // changes the function, which huge functions cannot afford.
   bool EnableTailMerge = !MF.getTarget().requiresStructuredCFG() &&
                          PassConfig->getEnableTailMerge() &&
-                         BranchFoldPlacement;
+                         BranchFoldPlacement && !HugeFunction;
   // No tail merging opportunities if the block number is less than four.
   if (MF.size() > 3 && EnableTailMerge) {
     unsigned TailMergeSize = TailDupSize + 1;
@@ -3506,6 +3540,21 @@ bool MachineBlockPlacement::runOnMachineFunction(MachineFunction &MF) {
     MBFI->view("MBP." + MF.getName(), false);
   }
 
+  if (TimeIt) {
+    auto Micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                      std::chrono::steady_clock::now() - StartTime)
+                      .count();
+    ORE.emit([&]() {
+      return MachineOptimizationRemarkAnalysis(DEBUG_TYPE, "PlacementTime",
+                                               MF.getFunction().getSubprogram(),
+                                               &MF.front())
+             << "placed " << ore::NV("NumBlocks", MF.size()) << " blocks in "
+             << ore::NV("Microseconds", (unsigned long long)Micros)
+             << " microseconds"
+             << (HugeFunction ? " using the huge-function strategy" : "");
+    });
+  }
+
   // We always return true as we have no way to track whether the final order
   // differs from the original order.
   return true;
@@ -56,6 +56,7 @@
 //===----------------------------------------------------------------------===//
 #include "llvm/CodeGen/MachineOutliner.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/SmallSet.h"
 #include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/Twine.h"
@@ -121,6 +122,17 @@ static cl::opt<unsigned> OutlinerBenefitThreshold(
     cl::desc(
         "The minimum size in bytes before an outlining candidate is accepted"));
 
+/// Restrict outliner reruns to the functions changed by the previous round.
+/// A sequence repeated only within unchanged functions was already seen by the
+/// previous round and either outlined (which changes those functions) or
+/// rejected by the cost model, which has not changed since. Repeats between a
+/// changed and an unchanged function can be missed, so this trades a little
+/// outlining for much cheaper reruns on very large modules.
+static cl::opt<bool> OutlinerIncrementalReruns(
+    "machine-outliner-incremental-reruns", cl::init(false), cl::Hidden,
+    cl::desc("Restrict outliner reruns to functions changed by the previous "
+             "round"));
+
 namespace {
 
 /// Maps \p MachineInstrs to unsigned integers and stores the mappings.
@@ -405,6 +417,10 @@ struct MachineOutliner : public ModulePass {
   /// The current repeat number of machine outlining.
   unsigned OutlineRepeatedNum = 0;
 
+  /// Functions created or modified by the previous outlining round. Only
+  /// maintained when -machine-outliner-incremental-reruns is set.
+  DenseSet<Function *> TouchedFunctions;
+
   /// Set to true if the outliner should run on all functions in the module
   /// considered safe for outlining.
   /// Set to true by default for compatibility with llc's -run-pass option.
@@ -829,6 +845,8 @@ bool MachineOutliner::outline(Module &M,
                     << "\n");
   bool OutlinedSomething = false;
 
+  TouchedFunctions.clear();
+
   // Sort by benefit. The most beneficial functions should be outlined first.
   stable_sort(FunctionList,
               [](const OutlinedFunction &LHS, const OutlinedFunction &RHS) {
@@ -880,6 +898,9 @@ bool MachineOutliner::outline(Module &M,
     const TargetSubtargetInfo &STI = MF->getSubtarget();
     const TargetInstrInfo &TII = *STI.getInstrInfo();
 
+    if (OutlinerIncrementalReruns)
+      TouchedFunctions.insert(&MF->getFunction());
+
     // Replace occurrences of the sequence with calls to the new function.
     LLVM_DEBUG(dbgs() << "CREATE OUTLINED CALLS\n");
     for (Candidate &C : OF.Candidates) {
@@ -887,6 +908,9 @@ bool MachineOutliner::outline(Module &M,
       MachineBasicBlock::iterator StartIt = C.front();
       MachineBasicBlock::iterator EndIt = C.back();
 
+      if (OutlinerIncrementalReruns)
+        TouchedFunctions.insert(&MBB.getParent()->getFunction());
+
       // Insert the call.
       auto CallInst = TII.insertOutlinedCall(M, MBB, StartIt, *MF, C);
 // Insert the call.
@@ -994,6 +1018,14 @@ void MachineOutliner::populateMapper(InstructionMapper &Mapper, Module &M,
       continue;
     }
 
+    // On an incremental rerun, limit the search to functions changed by the
+    // previous round.
+    if (OutlinerIncrementalReruns && OutlineRepeatedNum > 0 &&
+        !TouchedFunctions.contains(&F)) {
+      LLVM_DEBUG(dbgs() << "SKIP: Function unchanged since previous round\n");
+      continue;
+    }
+
     // There's something in F. Check if it has a MachineFunction associated with
     // it.
     MachineFunction *MF = MMI.getMachineFunction(F);
@@ -3052,7 +3052,9 @@ bool ResourceManager::canReserveResources(SUnit &SU, int Cycle) {
   }
 
   reserveResources(SCDesc, Cycle);
-  bool Result = !isOverbooked();
+  bool Result = !isOverbooked(SCDesc, Cycle);
+  assert(Result == !isOverbooked() &&
+         "Overbooked entry in a slot not touched by this reservation");
   unreserveResources(SCDesc, Cycle);
 
   LLVM_DEBUG(if (SwpDebugResource) dbgs() << "return " << Result << "\n\n";);
@@ -3111,6 +3113,24 @@ void ResourceManager::unreserveResources(const MCSchedClassDesc *SCDesc,
     --NumScheduledMops[positiveModulo(C, InitiationInterval)];
 }
 
+bool ResourceManager::isOverbooked(const MCSchedClassDesc *SCDesc,
+                                   int Cycle) const {
+  assert(!UseDFA);
+  for (const MCWriteProcResEntry &PRE : make_range(
+           STI->getWriteProcResBegin(SCDesc), STI->getWriteProcResEnd(SCDesc))) {
+    const MCProcResourceDesc *Desc = SM.getProcResource(PRE.ProcResourceIdx);
+    for (int C = Cycle; C < Cycle + PRE.ReleaseAtCycle; ++C)
+      if (MRT[positiveModulo(C, InitiationInterval)][PRE.ProcResourceIdx] >
+          Desc->NumUnits)
+        return true;
+  }
+
+  for (int C = Cycle; C < Cycle + SCDesc->NumMicroOps; ++C)
+    if (NumScheduledMops[positiveModulo(C, InitiationInterval)] > IssueWidth)
+      return true;
+  return false;
+}
+
 bool ResourceManager::isOverbooked() const {
   assert(!UseDFA);
   for (int Slot = 0; Slot < InitiationInterval; ++Slot) {
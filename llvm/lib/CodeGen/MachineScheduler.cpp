@@ -132,6 +132,13 @@ static cl::opt<unsigned> SchedOnlyBlock("misched-only-block", cl::Hidden,
 static cl::opt<unsigned> ReadyListLimit("misched-limit", cl::Hidden,
   cl::desc("Limit ready list to N instructions"), cl::init(256));
 
+/// Avoid quadratic DAG construction cost in huge scheduling regions by
+/// splitting them into fixed-size windows that are scheduled independently.
+static cl::opt<unsigned> MISchedMaxRegionInstrs(
+    "misched-max-region-instrs", cl::Hidden, cl::init(0),
+    cl::desc("Split scheduling regions larger than N instructions into "
+             "windows of at most N instructions (0 = no limit)"));
+
 static cl::opt<bool> EnableRegPressure("misched-regpressure", cl::Hidden,
   cl::desc("Enable register pressure scheduling."), cl::init(true));
 
@@ -611,6 +618,41 @@ void MachineSchedulerBase::scheduleRegions(ScheduleDAGInstrs &Scheduler,
         Scheduler.exitRegion();
         continue;
       }
+
+      // If the region exceeds the policy's cap, re-enter it as a sequence of
+      // windows that are scheduled independently. This bounds the size of
+      // the dependency DAG. The windows only reorder instructions within
+      // themselves, so every dependence crossing a window boundary is
+      // trivially preserved.
+      unsigned MaxRegionInstrs = Scheduler.maxRegionInstrs();
+      if (MaxRegionInstrs != 0 && NumRegionInstrs > MaxRegionInstrs) {
+        // Nothing has been reordered yet, so the region iterators are still
+        // valid after closing the region.
+        Scheduler.exitRegion();
+        MachineBasicBlock::iterator WinBegin = I;
+        while (WinBegin != RegionEnd) {
+          MachineBasicBlock::iterator WinEnd = WinBegin;
+          unsigned NumWindowInstrs = 0;
+          while (WinEnd != RegionEnd && NumWindowInstrs < MaxRegionInstrs) {
+            if (!WinEnd->isDebugOrPseudoInstr())
+              ++NumWindowInstrs;
+            ++WinEnd;
+          }
+          LLVM_DEBUG(dbgs() << "********** MI Scheduling **********\n"
+                            << MF->getName() << ":" << printMBBReference(*MBB)
+                            << " " << MBB->getName()
+                            << " WindowInstrs: " << NumWindowInstrs << '\n');
+          // 'WinEnd' stays valid across these calls; scheduling only
+          // reorders instructions within [WinBegin, WinEnd).
+          Scheduler.enterRegion(&*MBB, WinBegin, WinEnd, NumWindowInstrs);
+          if (WinBegin != WinEnd && WinBegin != std::prev(WinEnd))
+            Scheduler.schedule();
+          Scheduler.exitRegion();
+          WinBegin = WinEnd;
+        }
+        continue;
+      }
+
       LLVM_DEBUG(dbgs() << "********** MI Scheduling **********\n");
       LLVM_DEBUG(dbgs() << MF->getName() << ":" << printMBBReference(*MBB)
                         << " " << MBB->getName() << "\n  From: " << *I
@@ -3275,6 +3317,9 @@ void GenericScheduler::initPolicy(MachineBasicBlock::iterator Begin,
     if (RegionPolicy.OnlyTopDown)
       RegionPolicy.OnlyBottomUp = false;
   }
+
+  if (MISchedMaxRegionInstrs.getNumOccurrences() > 0)
+    RegionPolicy.MaxRegionInstrs = MISchedMaxRegionInstrs;
 }
 
 void GenericScheduler::dumpPolicy() const {
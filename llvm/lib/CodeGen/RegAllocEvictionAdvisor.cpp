@@ -13,6 +13,7 @@
 #include "RegAllocEvictionAdvisor.h"
 #include "AllocationOrder.h"
 #include "RegAllocGreedy.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/CodeGen/LiveRegMatrix.h"
 #include "llvm/CodeGen/MachineFunction.h"
 #include "llvm/CodeGen/RegisterClassInfo.h"
@@ -54,6 +55,12 @@ cl::opt<unsigned> EvictInterferenceCutoff(
 }
 
 #define DEBUG_TYPE "regalloc"
+
+STATISTIC(NumEvictionCostCacheHits,
+          "Number of eviction cost computations served from the cache");
+STATISTIC(NumEvictionCostCacheMisses,
+          "Number of eviction cost computations done from scratch");
+
 #ifdef LLVM_HAVE_TF_AOT_REGALLOCEVICTMODEL
 #define LLVM_HAVE_TF_AOT
 #endif
@@ -185,12 +192,6 @@ bool DefaultEvictionAdvisor::canEvictHintInterference(
 bool DefaultEvictionAdvisor::canEvictInterferenceBasedOnCost(
     const LiveInterval &VirtReg, MCRegister PhysReg, bool IsHint,
     EvictionCost &MaxCost, const SmallVirtRegSet &FixedRegisters) const {
-  // It is only possible to evict virtual register interference.
-  if (Matrix->checkInterference(VirtReg, PhysReg) > LiveRegMatrix::IK_VirtReg)
-    return false;
-
-  bool IsLocal = VirtReg.empty() || LIS->intervalIsInOneMBB(VirtReg);
-
   // Find VirtReg's cascade number. This will be unassigned if VirtReg was never
   // involved in an eviction before. If a cascade number was assigned, deny
   // evicting anything with the same or a newer cascade number. This prevents
@@ -200,6 +201,36 @@ bool DefaultEvictionAdvisor::canEvictInterferenceBasedOnCost(
   // anything, and it can be evicted by anything.
   unsigned Cascade = RA.getExtraInfo().getCascadeOrCurrentNext(VirtReg.reg());
 
+  // Reuse a previously computed eviction cost when nothing it depends on has
+  // changed. Last-chance recoloring constrains evictions through
+  // FixedRegisters, which the cache does not model, so bypass it then.
+  const bool CacheUsable = FixedRegisters.empty();
+  const uint64_t CacheKey = (uint64_t(VirtReg.reg().id()) << 32) | PhysReg.id();
+  if (CacheUsable) {
+    auto It = EvictionCostCache.find(CacheKey);
+    if (It != EvictionCostCache.end() &&
+        isEvictionCostCacheEntryValid(It->second, VirtReg, PhysReg, IsHint,
+                                      Cascade, MaxCost)) {
+      ++NumEvictionCostCacheHits;
+      if (!(It->second.Cost < MaxCost))
+        return false;
+      MaxCost = It->second.Cost;
+      return true;
+    }
+    ++NumEvictionCostCacheMisses;
+  }
+
+  // It is only possible to evict virtual register interference.
+  if (Matrix->checkInterference(VirtReg, PhysReg) > LiveRegMatrix::IK_VirtReg)
+    return false;
+
+  bool IsLocal = VirtReg.empty() || LIS->intervalIsInOneMBB(VirtReg);
+
+  // Set if the outcome hinged on a successful canReassign() check. Such a
+  // decision depends on occupancy of other physical registers, which the
+  // cache's per-unit tags do not track, so it must not be memoized.
+  bool DependsOnReassign = false;
+
   EvictionCost Cost;
   for (MCRegUnit Unit : TRI->regunits(PhysReg)) {
     LiveIntervalUnion::Query &Q = Matrix->query(VirtReg, Unit);
@@ -262,16 +293,70 @@ bool DefaultEvictionAdvisor::canEvictInterferenceBasedOnCost(
       // If !MaxCost.isMax(), then we're just looking for a cheap register.
       // Evicting another local live range in this case could lead to suboptimal
       // coloring.
-      if (!MaxCost.isMax() && IsLocal && LIS->intervalIsInOneMBB(*Intf) &&
-          (!EnableLocalReassign || !canReassign(*Intf, PhysReg))) {
-        return false;
+      if (!MaxCost.isMax() && IsLocal && LIS->intervalIsInOneMBB(*Intf)) {
+        if (!EnableLocalReassign || !canReassign(*Intf, PhysReg))
+          return false;
+        DependsOnReassign = true;
       }
     }
   }
+  if (CacheUsable && !DependsOnReassign) {
+    EvictionCostCacheEntry &Entry = EvictionCostCache[CacheKey];
+    Entry.UnitTags.clear();
+    for (MCRegUnit Unit : TRI->regunits(PhysReg))
+      Entry.UnitTags.push_back(Matrix->getLiveUnions()[Unit].getTag());
+    if (VirtReg.empty()) {
+      Entry.Begin = Entry.End = SlotIndex();
+    } else {
+      Entry.Begin = VirtReg.beginIndex();
+      Entry.End = VirtReg.endIndex();
+    }
+    Entry.NumSegments = VirtReg.size();
+    Entry.Weight = VirtReg.weight();
+    Entry.Cascade = Cascade;
+    Entry.IsHint = IsHint;
+    Entry.BoundedCost = !MaxCost.isMax();
+    Entry.Cost = Cost;
+  }
   MaxCost = Cost;
   return true;
 }
 
+bool DefaultEvictionAdvisor::isEvictionCostCacheEntryValid(
+    const EvictionCostCacheEntry &Entry, const LiveInterval &VirtReg,
+    MCRegister PhysReg, bool IsHint, unsigned Cascade,
+    const EvictionCost &MaxCost) const {
+  if (Entry.IsHint != IsHint || Entry.Cascade != Cascade)
+    return false;
+  // An unbounded computation skips the local reassignment policy, so it may
+  // not stand in for a bounded query.
+  if (!Entry.BoundedCost && !MaxCost.isMax())
+    return false;
+  // The querying live range must not have been edited since the cost was
+  // computed; its shape and spill weight feed the eviction policy.
+  if (Entry.NumSegments != VirtReg.size() || Entry.Weight != VirtReg.weight())
+    return false;
+  SlotIndex Begin, End;
+  if (!VirtReg.empty()) {
+    Begin = VirtReg.beginIndex();
+    End = VirtReg.endIndex();
+  }
+  if (Entry.Begin != Begin || Entry.End != End)
+    return false;
+  // All interference the cost was derived from must be unchanged. Any
+  // assignment or unassignment touching one of PhysReg's units (including
+  // evictions, which also update stages, hints and cascades of the evictees)
+  // changes the corresponding LiveIntervalUnion tag.
+  const LiveIntervalUnion *Units = Matrix->getLiveUnions();
+  unsigned I = 0;
+  for (MCRegUnit Unit : TRI->regunits(PhysReg)) {
+    if (I == Entry.UnitTags.size() || Units[Unit].changedSince(Entry.UnitTags[I]))
+      return false;
+    ++I;
+  }
+  return I == Entry.UnitTags.size();
+}
+
 MCRegister DefaultEvictionAdvisor::tryFindEvictionCandidate(
     const LiveInterval &VirtReg, const AllocationOrder &Order,
     uint8_t CostPerUseLimit, const SmallVirtRegSet &FixedRegisters) const {
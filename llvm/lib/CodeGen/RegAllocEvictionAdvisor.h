@@ -10,9 +10,12 @@
 #define LLVM_CODEGEN_REGALLOCEVICTIONADVISOR_H
 
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallSet.h"
+#include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/CodeGen/Register.h"
+#include "llvm/CodeGen/SlotIndexes.h"
 #include "llvm/Config/llvm-config.h"
 #include "llvm/MC/MCRegister.h"
 #include "llvm/Pass.h"
@@ -217,6 +220,43 @@ private:
                                        const SmallVirtRegSet &) const;
   bool shouldEvict(const LiveInterval &A, bool, const LiveInterval &B,
                    bool) const;
+
+  /// Memoized outcome of a canEvictInterferenceBasedOnCost computation that
+  /// ran to completion for a (virtual register, physical register) pair. An
+  /// entry stays valid while the interference on the physical register's
+  /// units and the querying live range are unchanged, which commonly holds
+  /// when the priority queue requeues a live range after an unrelated
+  /// eviction.
+  struct EvictionCostCacheEntry {
+    /// LiveIntervalUnion tags of the physical register's units at the time
+    /// the cost was computed. Assigning or unassigning any of the units
+    /// changes the corresponding tag and invalidates the entry.
+    SmallVector<unsigned, 4> UnitTags;
+    /// Shape of the querying live range; live range edits between requeues
+    /// invalidate the entry.
+    SlotIndex Begin, End;
+    unsigned NumSegments;
+    float Weight;
+    /// Cascade number of the querying live range. The eviction policy keys
+    /// off it, so a cascade assignment invalidates the entry.
+    unsigned Cascade;
+    bool IsHint;
+    /// True if the cost was computed against a bounded (non-max) MaxCost.
+    /// Bounded computations apply the stricter local reassignment policy and
+    /// are valid for both kinds of queries; unbounded ones only for
+    /// unbounded queries.
+    bool BoundedCost;
+    /// The full eviction cost. Only successful computations are cached, so
+    /// the cost is complete and can be compared against any threshold.
+    EvictionCost Cost;
+  };
+  mutable DenseMap<uint64_t, EvictionCostCacheEntry> EvictionCostCache;
+
+  bool isEvictionCostCacheEntryValid(const EvictionCostCacheEntry &Entry,
+                                     const LiveInterval &VirtReg,
+                                     MCRegister PhysReg, bool IsHint,
+                                     unsigned Cascade,
+                                     const EvictionCost &MaxCost) const;
 };
 } // namespace llvm
 
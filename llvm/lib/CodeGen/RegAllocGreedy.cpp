@@ -81,6 +81,7 @@ using namespace llvm;
 STATISTIC(NumGlobalSplits, "Number of split global live ranges");
 STATISTIC(NumLocalSplits,  "Number of split local live ranges");
 STATISTIC(NumEvicted,      "Number of interferences evicted");
+STATISTIC(NumRequeues,     "Number of live ranges requeued");
 
 static cl::opt<SplitEditor::ComplementSpillMode> SplitSpillMode(
     "split-spill-mode", cl::Hidden,
@@ -293,6 +294,10 @@ void RAGreedy::enqueue(PQueue &CurQueue, const LiveInterval *LI) {
   if (Stage == RS_New) {
     Stage = RS_Assign;
     ExtraInfo->setStage(Reg, Stage);
+  } else {
+    // The live range has been queued before: it is coming back after an
+    // eviction or a failed assignment.
+    ++NumRequeues;
   }
 
   unsigned Ret = PriorityAdvisor->getPriority(*LI);
@@ -86,6 +86,9 @@ STATISTIC(OpsNarrowed     , "Number of load/op/store narrowed");
 STATISTIC(LdStFP2Int      , "Number of fp load/store pairs transformed to int");
 STATISTIC(SlicedLoads, "Number of load sliced");
 STATISTIC(NumFPLogicOpsConv, "Number of logic ops converted to fp ops");
+STATISTIC(NumNodeRevisits, "Number of worklist node visits beyond the first");
+STATISTIC(NumVisitBudgetHits,
+          "Number of node visits skipped by the visitation budget");
 
 static cl::opt<bool>
 CombinerGlobalAA("combiner-global-alias-analysis", cl::Hidden,
@@ -137,6 +140,12 @@ static cl::opt<bool> EnableShrinkLoadReplaceStoreWithStore(
     cl::desc("DAG combiner enable load/<replace bytes>/store with "
              "a narrower store"));
 
+static cl::opt<unsigned> CombinerMaxNodeVisits(
+    "combiner-max-node-visits", cl::Hidden, cl::init(0),
+    cl::desc("Limit the number of times one node is visited per combine "
+             "level; nodes requeued beyond the limit are skipped "
+             "(0 = unlimited)"));
+
 static cl::opt<bool> EnableVectorFCopySignExtendRound(
     "combiner-vector-fcopysign-extend-round", cl::Hidden, cl::init(false),
     cl::desc(
@@ -191,6 +200,11 @@ namespace {
     /// candidate again.
     DenseMap<SDNode *, std::pair<SDNode *, unsigned>> StoreRootCountMap;
 
+    /// Number of times each node has been pulled off the worklist during the
+    /// current combine level. Only maintained when the visitation budget is
+    /// active or statistics are enabled.
+    DenseMap<const SDNode *, unsigned> VisitCountMap;
+
     // AA - Used for DAG load/store alias analysis.
     AliasAnalysis *AA;
 
@@ -286,6 +300,9 @@ namespace {
       CombinedNodes.erase(N);
       PruningList.remove(N);
       StoreRootCountMap.erase(N);
+      // Drop the visit count too: deleted nodes' memory can be recycled for
+      // new nodes, which must not inherit a stale count.
+      VisitCountMap.erase(N);
 
       auto It = WorklistMap.find(N);
       if (It == WorklistMap.end())
@@ -1838,6 +1855,19 @@ void DAGCombiner::Run(CombineLevel AtLevel) {
     if (recursivelyDeleteUnusedNodes(N))
       continue;
 
+    // Account for this visit, and honor the visitation budget: a node that
+    // keeps getting requeued without being combined away is unlikely to fold
+    // on yet another visit.
+    if (CombinerMaxNodeVisits || AreStatisticsEnabled()) {
+      unsigned NumVisits = ++VisitCountMap[N];
+      if (NumVisits > 1)
+        ++NumNodeRevisits;
+      if (CombinerMaxNodeVisits && NumVisits > CombinerMaxNodeVisits) {
+        ++NumVisitBudgetHits;
+        continue;
+      }
+    }
+
     WorklistRemover DeadNodes(*this);
 
     // If this combine is running after legalizing the DAG, re-legalize any
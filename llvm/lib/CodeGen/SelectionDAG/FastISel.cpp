@@ -1456,6 +1456,22 @@ bool FastISel::selectBitCast(const User *I) {
 
   // Otherwise, select a BITCAST opcode.
   Register ResultReg = fastEmit_r(SrcVT, DstVT, ISD::BITCAST, Op0);
+
+  // If the target has no pattern for the bitcast, but the source and
+  // destination types use the same register class, the cast is a no-op at the
+  // register level and a plain copy suffices. This covers vector reinterpret
+  // casts (e.g. v2i32 <-> v4i16) that targets rarely spell out.
+  if (!ResultReg && !SrcVT.isScalableVector() &&
+      SrcVT.getSizeInBits() == DstVT.getSizeInBits()) {
+    const TargetRegisterClass *DstRC = TLI.getRegClassFor(DstVT);
+    if (TLI.getRegClassFor(SrcVT) == DstRC) {
+      ResultReg = createResultReg(DstRC);
+      BuildMI(*FuncInfo.MBB, FuncInfo.InsertPt, MIMD,
+              TII.get(TargetOpcode::COPY), ResultReg)
+          .addReg(Op0);
+    }
+  }
+
   if (!ResultReg)
     return false;
 
@@ -20,6 +20,7 @@
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/Analysis/AssumptionCache.h"
@@ -138,6 +139,11 @@ static cl::opt<bool> EnableFastISelFallbackReport(
     cl::desc("Emit a diagnostic when \"fast\" instruction selection "
              "falls back to SelectionDAG."));
 
+static cl::opt<bool> FastISelReportMisses(
+    "fastisel-report-misses", cl::Hidden,
+    cl::desc("Print a per-function summary of the instructions \"fast\" "
+             "instruction selection failed on, grouped by opcode and type."));
+
 static cl::opt<bool>
 UseMBPI("use-mbpi",
         cl::desc("use Machine Branch Probability Info"),
@@ -1480,6 +1486,8 @@ static void processSingleLocVars(FunctionLoweringInfo &FuncInfo,
 
 void SelectionDAGISel::SelectAllBasicBlocks(const Function &Fn) {
   FastISelFailed = false;
+  // Counts of FastISel misses by opcode and type, for -fastisel-report-misses.
+  StringMap<unsigned> FastISelMissCounts;
   // Initialize the Fast-ISel state, if needed.
   FastISel *FastIS = nullptr;
   if (TM.Options.EnableFastISel) {
@@ -1641,6 +1649,19 @@ void SelectionDAGISel::SelectAllBasicBlocks(const Function &Fn) {
 
         FastISelFailed = true;
 
+        if (FastISelReportMisses) {
+          // Key the miss on the opcode and the interesting type: the result
+          // type, or the first operand's type for void instructions such as
+          // stores.
+          Type *Ty = Inst->getType();
+          if (Ty->isVoidTy() && Inst->getNumOperands() != 0)
+            Ty = Inst->getOperand(0)->getType();
+          std::string Key;
+          raw_string_ostream KeyOS(Key);
+          KeyOS << Inst->getOpcodeName() << " " << *Ty;
+          ++FastISelMissCounts[Key];
+        }
+
         // Then handle certain instructions as single-LLVM-Instruction blocks.
         // We cannot separate out GCrelocates to their own blocks since we need
         // to keep track of gc-relocates for a particular gc-statepoint. This is
@@ -1760,6 +1781,19 @@ void SelectionDAGISel::SelectAllBasicBlocks(const Function &Fn) {
 
   SwiftError->propagateVRegs();
 
+  if (FastISelReportMisses && !FastISelMissCounts.empty()) {
+    std::vector<std::pair<StringRef, unsigned>> Misses;
+    for (const auto &KV : FastISelMissCounts)
+      Misses.emplace_back(KV.getKey(), KV.getValue());
+    // Most frequent misses first; break ties alphabetically for stable output.
+    llvm::sort(Misses, [](const auto &LHS, const auto &RHS) {
+      return std::tie(RHS.second, LHS.first) < std::tie(LHS.second, RHS.first);
+    });
+    errs() << "FastISel misses in " << Fn.getName() << ":\n";
+    for (const auto &Miss : Misses)
+      errs() << "  " << Miss.second << "x " << Miss.first << "\n";
+  }
+
   delete FastIS;
   SDB->clearDanglingDebugInfo();
   SDB->SPDescriptor.resetPerFunctionState();
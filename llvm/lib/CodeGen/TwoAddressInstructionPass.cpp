@@ -329,6 +329,7 @@ bool TwoAddressInstructionPass::isPlainlyKilled(const MachineInstr *MI,
   // one of those. A kill flag is manually inserted on the operand so the
   // check below will handle it.
   if (LIS && !LIS->isNotInMIMap(*MI)) {
+    LIS->applyQueuedRepairs();
     if (Reg.isVirtual())
       return isPlainlyKilled(MI, LIS->getInterval(Reg));
     // Reserved registers are considered always live.
@@ -1245,6 +1246,9 @@ tryInstructionTransform(MachineBasicBlock::iterator &mi,
   if (OptLevel == CodeGenOptLevel::None)
     return false;
 
+  if (LIS)
+    LIS->applyQueuedRepairs();
+
   MachineInstr &MI = *mi;
   Register regA = MI.getOperand(DstIdx).getReg();
   Register regB = MI.getOperand(SrcIdx).getReg();
@@ -1479,6 +1483,9 @@ void
 TwoAddressInstructionPass::processTiedPairs(MachineInstr *MI,
                                             TiedPairList &TiedPairs,
                                             unsigned &Dist) {
+  if (LIS)
+    LIS->applyQueuedRepairs();
+
   bool IsEarlyClobber = llvm::any_of(TiedPairs, [MI](auto const &TP) {
     return MI->getOperand(TP.second).isEarlyClobber();
   });
@@ -1667,6 +1674,9 @@ TwoAddressInstructionPass::processTiedPairs(MachineInstr *MI,
 bool TwoAddressInstructionPass::processStatepoint(
     MachineInstr *MI, TiedOperandMap &TiedOperands) {
 
+  if (LIS)
+    LIS->applyQueuedRepairs();
+
   bool NeedCopy = false;
   for (auto &TO : TiedOperands) {
     Register RegB = TO.first;
@@ -1872,6 +1882,7 @@ bool TwoAddressInstructionPass::runOnMachineFunction(MachineFunction &Func) {
 
         // Update LiveIntervals.
         if (LIS) {
+          LIS->applyQueuedRepairs();
           Register Reg = mi->getOperand(0).getReg();
           LiveInterval &LI = LIS->getInterval(Reg);
           if (LI.hasSubRanges()) {
@@ -1909,6 +1920,10 @@ bool TwoAddressInstructionPass::runOnMachineFunction(MachineFunction &Func) {
       removeClobberedSrcRegMap(&*mi);
       mi = nmi;
     }
+
+    // Don't let queued interval repairs outlive the block they belong to.
+    if (LIS)
+      LIS->applyQueuedRepairs();
   }
 
   return MadeChange;
@@ -1995,7 +2010,10 @@ eliminateRegSequence(MachineBasicBlock::iterator &MBBI) {
     MI.eraseFromParent();
   }
 
-  // Udpate LiveIntervals.
+  // Udpate LiveIntervals. Queue the repair rather than applying it directly:
+  // REG_SEQUENCEs commonly come in runs (piecewise vector construction), and
+  // queued repairs for adjacent expansions coalesce into one range walk. The
+  // queue is flushed before any of this pass's LiveIntervals queries.
   if (LIS)
-    LIS->repairIntervalsInRange(MBB, MBBI, EndMBBI, OrigRegs);
+    LIS->queueRepairIntervalsInRange(MBB, MBBI, EndMBBI, OrigRegs);
 }
@@ -236,6 +236,7 @@ StringEntry *CompileUnit::getFileName(unsigned FileIdx,
 
 void CompileUnit::cleanupDataAfterClonning() {
   AbbreviationsSet.clear();
+  Abbreviations.clear();
   ResolvedFullPaths.shrink_and_clear();
   ResolvedParentPaths.clear();
   FileNames.shrink_and_clear();
@@ -243,6 +244,12 @@ void CompileUnit::cleanupDataAfterClonning() {
   OutDieOffsetArray = SmallVector<uint64_t>();
   TypeEntries = SmallVector<TypeEntry *>();
   Dependencies.reset(nullptr);
+  Labels.clear();
+  Ranges.clear();
+  DebugAddrIndexMap.clear();
+  // The cloned DIE tree was emitted from an allocator local to
+  // cloneAndEmit(); the root pointer must not outlive it.
+  OutUnitDIE = nullptr;
   getOrigUnit().clear();
 }
 
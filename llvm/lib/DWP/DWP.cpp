@@ -11,6 +11,7 @@
 //
 //===----------------------------------------------------------------------===//
 #include "llvm/DWP/DWP.h"
+#include "llvm/ADT/ScopeExit.h"
 #include "llvm/ADT/Twine.h"
 #include "llvm/DWP/DWPError.h"
 #include "llvm/MC/MCContext.h"
@@ -20,7 +21,9 @@
 #include "llvm/Object/ELFObjectFile.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/ThreadPool.h"
 #include <limits>
+#include <optional>
 
 using namespace llvm;
 using namespace llvm::object;
@@ -638,8 +641,35 @@ Error write(MCStreamer &Out, ArrayRef<std::string> Inputs,
 
   std::deque<SmallString<32>> UncompressedSections;
 
-  for (const auto &Input : Inputs) {
-    auto ErrOrObj = object::ObjectFile::createObjectFile(Input);
+  // Read and parse all inputs up front on a thread pool. The inputs stay
+  // alive for the whole merge anyway (the index entries reference strings
+  // inside them), so this does not change peak memory usage, and loading is
+  // independent per input and dominated by I/O. The merge loop below still
+  // consumes the inputs strictly in command-line order, so the output is
+  // bit-identical to a serial run.
+  std::vector<std::optional<Expected<OwningBinary<object::ObjectFile>>>>
+      LoadedObjects(Inputs.size());
+  {
+    ThreadPool Pool;
+    for (size_t I = 0; I != Inputs.size(); ++I)
+      Pool.async([&LoadedObjects, &Inputs, I]() {
+        LoadedObjects[I] = object::ObjectFile::createObjectFile(Inputs[I]);
+      });
+    Pool.wait();
+  }
+  // The merge loop has several early exits; make sure load errors for inputs
+  // it never reached are still consumed.
+  auto ConsumeUnreachedErrors = make_scope_exit([&] {
+    for (auto &MaybeObj : LoadedObjects)
+      if (MaybeObj && !*MaybeObj)
+        consumeError(MaybeObj->takeError());
+  });
+
+  for (size_t InputIdx = 0; InputIdx != Inputs.size(); ++InputIdx) {
+    const std::string &Input = Inputs[InputIdx];
+    Expected<OwningBinary<object::ObjectFile>> ErrOrObj =
+        std::move(*LoadedObjects[InputIdx]);
+    LoadedObjects[InputIdx].reset();
     if (!ErrOrObj) {
       return handleErrors(ErrOrObj.takeError(),
                           [&](std::unique_ptr<ECError> EC) -> Error {
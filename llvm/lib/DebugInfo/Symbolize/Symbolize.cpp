@@ -502,8 +502,12 @@ LLVMSymbolizer::getOrCreateObjectPair(const std::string &Path,
 
   auto ObjOrErr = getOrCreateObject(Path, ArchName);
   if (!ObjOrErr) {
-    ObjectPairForPathArch.emplace(std::make_pair(Path, ArchName),
-                                  ObjectPair(nullptr, nullptr));
+    // Tie the negative entry to the (possibly also negative) binary so that
+    // evicting the binary drops the entry instead of leaving it dangling.
+    auto Pair = ObjectPairForPathArch.emplace(std::make_pair(Path, ArchName),
+                                              ObjectPair(nullptr, nullptr));
+    BinaryForPath.find(Path)->second.pushEvictor(
+        [this, I = Pair.first]() { ObjectPairForPathArch.erase(I); });
     return ObjOrErr.takeError();
   }
 
@@ -539,10 +543,18 @@ LLVMSymbolizer::getOrCreateObject(const std::string &Path,
     recordAccess(Pair.first->second);
   } else {
     Expected<OwningBinary<Binary>> BinOrErr = createBinary(Path);
-    if (!BinOrErr)
+    CachedBinary &CachedBin = Pair.first->second;
+    if (!BinOrErr) {
+      // Keep the negative entry in the LRU list so that it is eventually
+      // evicted like any other binary; otherwise repeated requests for
+      // missing files grow BinaryForPath without bound in long-running
+      // sessions.
+      CachedBin.pushEvictor(
+          [this, I = Pair.first]() { BinaryForPath.erase(I); });
+      LRUBinaries.push_back(CachedBin);
       return BinOrErr.takeError();
+    }
 
-    CachedBinary &CachedBin = Pair.first->second;
     CachedBin = std::move(BinOrErr.get());
     CachedBin.pushEvictor([this, I = Pair.first]() { BinaryForPath.erase(I); });
     LRUBinaries.push_back(CachedBin);
@@ -561,8 +573,10 @@ LLVMSymbolizer::getOrCreateObject(const std::string &Path,
     Expected<std::unique_ptr<ObjectFile>> ObjOrErr =
         UB->getMachOObjectForArch(ArchName);
     if (!ObjOrErr) {
-      ObjectForUBPathAndArch.emplace(std::make_pair(Path, ArchName),
-                                     std::unique_ptr<ObjectFile>());
+      auto Pair = ObjectForUBPathAndArch.emplace(std::make_pair(Path, ArchName),
+                                                 std::unique_ptr<ObjectFile>());
+      BinaryForPath.find(Path)->second.pushEvictor(
+          [this, Iter = Pair.first]() { ObjectForUBPathAndArch.erase(Iter); });
       return ObjOrErr.takeError();
     }
     ObjectFile *Res = ObjOrErr->get();
@@ -618,7 +632,9 @@ LLVMSymbolizer::getOrCreateModuleInfo(const std::string &ModuleName) {
   auto ObjectsOrErr = getOrCreateObjectPair(BinaryName, ArchName);
   if (!ObjectsOrErr) {
     // Failed to find valid object file.
-    Modules.emplace(ModuleName, std::unique_ptr<SymbolizableModule>());
+    auto I = Modules.emplace(ModuleName, std::unique_ptr<SymbolizableModule>());
+    BinaryForPath.find(BinaryName)->second.pushEvictor(
+        [this, I = I.first]() { Modules.erase(I); });
     return ObjectsOrErr.takeError();
   }
   ObjectPair Objects = ObjectsOrErr.get();
@@ -638,7 +654,10 @@ LLVMSymbolizer::getOrCreateModuleInfo(const std::string &ModuleName) {
           Opts.UseDIA ? PDB_ReaderType::DIA : PDB_ReaderType::Native;
       if (auto Err = loadDataForEXE(ReaderType, Objects.first->getFileName(),
                                     Session)) {
-        Modules.emplace(ModuleName, std::unique_ptr<SymbolizableModule>());
+        auto I =
+            Modules.emplace(ModuleName, std::unique_ptr<SymbolizableModule>());
+        BinaryForPath.find(BinaryName)->second.pushEvictor(
+            [this, I = I.first]() { Modules.erase(I); });
         // Return along the PDB filename to provide more context
         return createFileError(PDBFileName, std::move(Err));
       }
@@ -651,12 +670,12 @@ LLVMSymbolizer::getOrCreateModuleInfo(const std::string &ModuleName) {
         nullptr, Opts.DWPName);
   auto ModuleOrErr =
       createModuleInfo(Objects.first, std::move(Context), ModuleName);
-  if (ModuleOrErr) {
-    auto I = Modules.find(ModuleName);
-    BinaryForPath.find(BinaryName)->second.pushEvictor([this, I]() {
-      Modules.erase(I);
-    });
-  }
+  // createModuleInfo inserts a Modules entry even on failure; register the
+  // evictor either way so the entry cannot outlive its binary.
+  auto ModIt = Modules.find(ModuleName);
+  BinaryForPath.find(BinaryName)->second.pushEvictor([this, ModIt]() {
+    Modules.erase(ModIt);
+  });
   return ModuleOrErr;
 }
 
@@ -34,6 +34,7 @@
 #include "llvm/Support/Caching.h"
 #include "llvm/Support/Errc.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/FileUtilities.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
@@ -41,6 +42,7 @@
 #include "llvm/Support/xxhash.h"
 
 #include <atomic>
+#include <mutex>
 #include <optional>
 #include <thread>
 
@@ -161,20 +163,31 @@ Expected<std::string> getCachedOrDownloadArtifact(StringRef UniqueKey,
 namespace {
 
 /// A simple handler which streams the returned data to a cache file. The cache
-/// file is only created if a 200 OK status is observed.
+/// file is only created if a 200 OK status is observed. When several servers
+/// are queried concurrently, the shared StreamClaimed flag ensures only the
+/// first responder writes to the (single) cache stream; the others abort their
+/// transfers.
 class StreamedHTTPResponseHandler : public HTTPResponseHandler {
   using CreateStreamFn =
       std::function<Expected<std::unique_ptr<CachedFileStream>>()>;
   CreateStreamFn CreateStream;
   HTTPClient &Client;
+  std::atomic<bool> &StreamClaimed;
   std::unique_ptr<CachedFileStream> FileStream;
+  bool LostRace = false;
 
 public:
-  StreamedHTTPResponseHandler(CreateStreamFn CreateStream, HTTPClient &Client)
-      : CreateStream(CreateStream), Client(Client) {}
+  StreamedHTTPResponseHandler(CreateStreamFn CreateStream, HTTPClient &Client,
+                              std::atomic<bool> &StreamClaimed)
+      : CreateStream(CreateStream), Client(Client),
+        StreamClaimed(StreamClaimed) {}
   virtual ~StreamedHTTPResponseHandler() = default;
 
   Error handleBodyChunk(StringRef BodyChunk) override;
+
+  // Returns true if this transfer was aborted because another server claimed
+  // the cache stream first.
+  bool lostRace() const { return LostRace; }
 };
 
 } // namespace
@@ -184,6 +197,12 @@ Error StreamedHTTPResponseHandler::handleBodyChunk(StringRef BodyChunk) {
     unsigned Code = Client.responseCode();
     if (Code && Code != 200)
       return Error::success();
+    bool WasClaimed = false;
+    if (!StreamClaimed.compare_exchange_strong(WasClaimed, true)) {
+      LostRace = true;
+      return createStringError(errc::interrupted,
+                               "another debuginfod server responded first");
+    }
     Expected<std::unique_ptr<CachedFileStream>> FileStreamOrError =
         CreateStream();
     if (!FileStreamOrError)
@@ -253,6 +272,20 @@ Expected<std::string> getCachedOrDownloadArtifact(
   AddStreamFn &CacheAddStream = *CacheAddStreamOrErr;
   if (!CacheAddStream)
     return std::string(AbsCachedArtifactPath);
+
+  // Respect a recent negative lookup so that repeated queries for unknown
+  // build IDs (common when symbolizing a core dump) do not go back to the
+  // network every time. 600 seconds matches the default cache_miss_s of the
+  // elfutils debuginfod client.
+  static constexpr std::chrono::seconds NegativeCacheTTL(600);
+  SmallString<64> NegativeCachePath(AbsCachedArtifactPath);
+  NegativeCachePath += ".miss";
+  sys::fs::file_status MissStatus;
+  if (!sys::fs::status(NegativeCachePath, MissStatus) &&
+      std::chrono::system_clock::now() - MissStatus.getLastModificationTime() <
+          NegativeCacheTTL)
+    return createStringError(errc::argument_out_of_domain, "build id not found");
+
   // The artifact was not found in the local cache, query the debuginfod
   // servers.
   if (!HTTPClient::isAvailable())
@@ -266,27 +299,52 @@ Expected<std::string> getCachedOrDownloadArtifact(
         "allow Debuginfod to make HTTP requests, call HTTPClient::initialize() "
         "at the beginning of main.");
 
-  HTTPClient Client;
-  Client.setTimeout(Timeout);
-  for (StringRef ServerUrl : DebuginfodUrls) {
-    SmallString<64> ArtifactUrl;
-    sys::path::append(ArtifactUrl, sys::path::Style::posix, ServerUrl, UrlPath);
-
-    // Perform the HTTP request and if successful, write the response body to
-    // the cache.
-    {
-      StreamedHTTPResponseHandler Handler(
-          [&]() { return CacheAddStream(Task, ""); }, Client);
-      HTTPRequest Request(ArtifactUrl);
-      Request.Headers = getHeaders();
-      Error Err = Client.perform(Request, Handler);
-      if (Err)
-        return std::move(Err);
-
-      unsigned Code = Client.responseCode();
-      if (Code && Code != 200)
-        continue;
+  // Query all the configured servers concurrently and take the first good
+  // response; the losing transfers are aborted by the response handler. This
+  // bounds the total wall time by the slowest single request instead of the
+  // sum of the timeouts over every unreachable server.
+  std::atomic<bool> StreamClaimed(false);
+  std::mutex ResultMutex;
+  Error FirstErr = Error::success();
+  bool Downloaded = false;
+  {
+    ThreadPool Pool(hardware_concurrency(DebuginfodUrls.size()));
+    for (StringRef ServerUrl : DebuginfodUrls) {
+      Pool.async([&, ServerUrl]() {
+        SmallString<64> ArtifactUrl;
+        sys::path::append(ArtifactUrl, sys::path::Style::posix, ServerUrl,
+                          UrlPath);
+
+        HTTPClient Client;
+        Client.setTimeout(Timeout);
+        StreamedHTTPResponseHandler Handler(
+            [&]() { return CacheAddStream(Task, ""); }, Client, StreamClaimed);
+        HTTPRequest Request(ArtifactUrl);
+        Request.Headers = getHeaders();
+        Error Err = Client.perform(Request, Handler);
+
+        std::lock_guard<std::mutex> Guard(ResultMutex);
+        if (Err) {
+          // Losing the race to a faster server is not an error.
+          if (Handler.lostRace() || FirstErr)
+            consumeError(std::move(Err));
+          else
+            FirstErr = std::move(Err);
+          return;
+        }
+        unsigned Code = Client.responseCode();
+        if (!Code || Code == 200)
+          Downloaded = true;
+      });
     }
+    Pool.wait();
+  }
+
+  if (Downloaded) {
+    // A server that errored out does not matter if another one delivered the
+    // artifact.
+    consumeError(std::move(FirstErr));
+    sys::fs::remove(NegativeCachePath);
 
     Expected<CachePruningPolicy> PruningPolicyOrErr =
         parseCachePruningPolicy(std::getenv("DEBUGINFOD_CACHE_POLICY"));
@@ -298,6 +356,16 @@ Expected<std::string> getCachedOrDownloadArtifact(
     return std::string(AbsCachedArtifactPath);
   }
 
+  if (FirstErr)
+    return std::move(FirstErr);
+
+  // Record the miss so that near-term retries can fail fast. Best effort;
+  // failure to create the marker is harmless.
+  if (!DebuginfodUrls.empty()) {
+    std::error_code MissEC;
+    raw_fd_ostream MissOS(NegativeCachePath, MissEC, sys::fs::OF_None);
+  }
+
   return createStringError(errc::argument_out_of_domain, "build id not found");
 }
 
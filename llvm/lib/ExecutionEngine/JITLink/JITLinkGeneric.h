@@ -14,6 +14,9 @@
 #define LIB_EXECUTIONENGINE_JITLINK_JITLINKGENERIC_H
 
 #include "llvm/ExecutionEngine/JITLink/JITLink.h"
+#include "llvm/Support/Parallel.h"
+
+#include <mutex>
 
 #define DEBUG_TYPE "jitlink"
 
@@ -132,49 +135,79 @@ private:
   Error fixUpBlocks(LinkGraph &G) const override {
     LLVM_DEBUG(dbgs() << "Fixing up blocks:\n");
 
+    // Collect the blocks to fix up. No-alloc section contents are copied into
+    // memory on the Graph's allocator here (if they haven't been already):
+    // the allocator is not thread-safe, so this must not run from the
+    // parallel loop below.
+    SmallVector<Block *, 128> Blocks;
     for (auto &Sec : G.sections()) {
       bool NoAllocSection = Sec.getMemLifetime() == orc::MemLifetime::NoAlloc;
 
       for (auto *B : Sec.blocks()) {
-        LLVM_DEBUG(dbgs() << "  " << *B << ":\n");
-
-        // Copy Block data and apply fixups.
-        LLVM_DEBUG(dbgs() << "    Applying fixups.\n");
-        assert((!B->isZeroFill() || all_of(B->edges(),
-                                           [](const Edge &E) {
-                                             return E.getKind() ==
-                                                    Edge::KeepAlive;
-                                           })) &&
-               "Non-KeepAlive edges in zero-fill block?");
-
-        // If this is a no-alloc section then copy the block content into
-        // memory allocated on the Graph's allocator (if it hasn't been
-        // already).
         if (NoAllocSection)
           (void)B->getMutableContent(G);
+        Blocks.push_back(B);
+      }
+    }
 
-        for (auto &E : B->edges()) {
-
-          // Skip non-relocation edges.
-          if (!E.isRelocation())
-            continue;
-
-          // If B is a block in a Standard or Finalize section then make sure
-          // that no edges point to symbols in NoAlloc sections.
-          assert((NoAllocSection || !E.getTarget().isDefined() ||
-                  E.getTarget().getBlock().getSection().getMemLifetime() !=
-                      orc::MemLifetime::NoAlloc) &&
-                 "Block in allocated section has edge pointing to no-alloc "
-                 "section");
-
-          // Dispatch to LinkerImpl for fixup.
-          if (auto Err = impl().applyFixup(G, *B, E))
-            return Err;
-        }
+    auto FixUpBlock = [&](Block *B) -> Error {
+      LLVM_DEBUG(dbgs() << "  " << *B << ":\n");
+
+      // Copy Block data and apply fixups.
+      LLVM_DEBUG(dbgs() << "    Applying fixups.\n");
+      assert((!B->isZeroFill() || all_of(B->edges(),
+                                         [](const Edge &E) {
+                                           return E.getKind() ==
+                                                  Edge::KeepAlive;
+                                         })) &&
+             "Non-KeepAlive edges in zero-fill block?");
+
+      for (auto &E : B->edges()) {
+
+        // Skip non-relocation edges.
+        if (!E.isRelocation())
+          continue;
+
+        // If B is a block in a Standard or Finalize section then make sure
+        // that no edges point to symbols in NoAlloc sections.
+        assert((B->getSection().getMemLifetime() ==
+                    orc::MemLifetime::NoAlloc ||
+                !E.getTarget().isDefined() ||
+                E.getTarget().getBlock().getSection().getMemLifetime() !=
+                    orc::MemLifetime::NoAlloc) &&
+               "Block in allocated section has edge pointing to no-alloc "
+               "section");
+
+        // Dispatch to LinkerImpl for fixup.
+        if (auto Err = impl().applyFixup(G, *B, E))
+          return Err;
       }
+      return Error::success();
+    };
+
+    // Each block's fixups write only to that block's working memory and read
+    // only assigned addresses, so blocks can be fixed up independently. Only
+    // bother fanning out for graphs with enough blocks to pay for it.
+    constexpr size_t ParallelFixupThreshold = 128;
+    if (Blocks.size() < ParallelFixupThreshold) {
+      for (auto *B : Blocks)
+        if (auto Err = FixUpBlock(B))
+          return Err;
+      return Error::success();
     }
 
-    return Error::success();
+    std::mutex ErrMutex;
+    Error FixupErr = Error::success();
+    parallelForEach(Blocks, [&](Block *B) {
+      if (auto Err = FixUpBlock(B)) {
+        std::lock_guard<std::mutex> Lock(ErrMutex);
+        if (FixupErr)
+          consumeError(std::move(Err));
+        else
+          FixupErr = std::move(Err);
+      }
+    });
+    return FixupErr;
   }
 };
 
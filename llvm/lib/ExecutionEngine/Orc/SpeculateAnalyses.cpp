@@ -11,6 +11,7 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Analysis/BlockFrequencyInfo.h"
 #include "llvm/Analysis/BranchProbabilityInfo.h"
 #include "llvm/Analysis/CFG.h"
@@ -301,5 +302,46 @@ SpeculateQuery::ResultTy SequenceBBQuery::operator()(Function &F) {
   return CallerAndCalles;
 }
 
+// CallOrderProfileQuery Implementation
+Expected<CallOrderProfileQuery>
+CallOrderProfileQuery::fromFile(StringRef ProfilePath,
+                                unsigned LookaheadWindow) {
+  auto BufOrErr = MemoryBuffer::getFile(ProfilePath, /*IsText=*/true);
+  if (!BufOrErr)
+    return createFileError(ProfilePath, errorCodeToError(BufOrErr.getError()));
+  return CallOrderProfileQuery(std::move(*BufOrErr), LookaheadWindow);
+}
+
+CallOrderProfileQuery::CallOrderProfileQuery(
+    std::unique_ptr<MemoryBuffer> Buffer, unsigned LookaheadWindow)
+    : ProfileBuffer(std::move(Buffer)) {
+  SmallVector<StringRef, 64> Order;
+  for (StringRef Line : split(ProfileBuffer->getBuffer(), '\n')) {
+    Line = Line.trim();
+    if (!Line.empty() && !Line.starts_with("#"))
+      Order.push_back(Line);
+  }
+
+  for (size_t I = 0, E = Order.size(); I != E; ++I) {
+    auto &Followers = FollowersMap[Order[I]];
+    for (size_t J = I + 1, JE = std::min(E, I + 1 + size_t(LookaheadWindow));
+         J != JE; ++J)
+      if (Order[J] != Order[I] && !is_contained(Followers, Order[J]))
+        Followers.push_back(Order[J]);
+  }
+}
+
+SpeculateQuery::ResultTy CallOrderProfileQuery::operator()(Function &F) {
+  auto It = FollowersMap.find(F.getName());
+  if (It == FollowersMap.end() || It->second.empty())
+    return std::nullopt;
+
+  DenseMap<StringRef, DenseSet<StringRef>> CallerAndCalles;
+  DenseSet<StringRef> &Calles = CallerAndCalles[F.getName()];
+  for (StringRef Name : It->second)
+    Calles.insert(Name);
+  return CallerAndCalles;
+}
+
 } // namespace orc
 } // namespace llvm
@@ -808,6 +808,13 @@ bool Pattern::parsePattern(StringRef PatternStr, StringRef Prefix,
     RegExStr += '^';
     if (!Req.NoCanonicalizeWhiteSpace)
       RegExStr += " *";
+  } else {
+    // Remember any fixed text at the start of the pattern so match() can
+    // prescreen the buffer with a substring search before running the regex.
+    // This may stop short of the full literal run (e.g. at a literal "[[["),
+    // which only makes the prescreen more conservative.
+    PrefixLiteral = PatternStr.take_front(
+        std::min(PatternStr.find("{{"), PatternStr.find("[[")));
   }
 
   // Paren value #0 is for the fully matched string.  Any new parenthesized
@@ -1089,6 +1096,21 @@ Pattern::MatchResult Pattern::match(StringRef Buffer,
 
   // Regex match.
 
+  // A match must begin with the pattern's literal prefix, if it has one, so
+  // everything before the prefix's first occurrence can be skipped and its
+  // absence means there is no match. This keeps the common failing probes of
+  // CHECK-NOT and CHECK-DAG scans out of the regex engine. The prefix is
+  // never recorded for line-anchored patterns, so narrowing the buffer here
+  // cannot create a spurious '^' match position.
+  StringRef MatchBuffer = Buffer;
+  if (!PrefixLiteral.empty()) {
+    size_t PrefixPos = IgnoreCase ? Buffer.find_insensitive(PrefixLiteral)
+                                  : Buffer.find(PrefixLiteral);
+    if (PrefixPos == StringRef::npos)
+      return make_error<NotFoundError>();
+    MatchBuffer = Buffer.substr(PrefixPos);
+  }
+
   // If there are substitutions, we need to create a temporary string with the
   // actual value.
   StringRef RegExToMatch = RegExStr;
@@ -1143,7 +1165,17 @@ Pattern::MatchResult Pattern::match(StringRef Buffer,
   unsigned int Flags = Regex::Newline;
   if (IgnoreCase)
     Flags |= Regex::IgnoreCase;
-  if (!Regex(RegExToMatch, Flags).match(Buffer, &MatchInfo))
+  bool Matched;
+  if (Substitutions.empty()) {
+    // Without substitutions the regex is the same for every match attempt;
+    // compile it once and reuse it across repeated probes.
+    if (!CompiledRegex)
+      CompiledRegex = std::make_shared<Regex>(RegExToMatch, Flags);
+    Matched = CompiledRegex->match(MatchBuffer, &MatchInfo);
+  } else {
+    Matched = Regex(RegExToMatch, Flags).match(MatchBuffer, &MatchInfo);
+  }
+  if (!Matched)
     return make_error<NotFoundError>();
 
   // Successful regex match.
@@ -20,6 +20,7 @@
 #include "llvm/ADT/StringRef.h"
 #include "llvm/FileCheck/FileCheck.h"
 #include "llvm/Support/Error.h"
+#include "llvm/Support/Regex.h"
 #include "llvm/Support/SourceMgr.h"
 #include <map>
 #include <optional>
@@ -573,6 +574,18 @@ class Pattern {
   /// a fixed string to match.
   std::string RegExStr;
 
+  /// The literal text at the start of a regex pattern, before the first regex
+  /// or substitution block, or empty if the pattern starts with one. Any
+  /// match must begin with this text, so a plain substring search for it can
+  /// reject or narrow the buffer before the regex engine runs.
+  StringRef PrefixLiteral;
+
+  /// Compiled form of RegExStr, created on first use. Only used when the
+  /// pattern has no substitutions, since substitutions yield a different
+  /// regex for every match attempt. Shared so that Pattern stays copyable;
+  /// copies match the same regex and may share the compiled form.
+  mutable std::shared_ptr<Regex> CompiledRegex;
+
   /// Entries in this vector represent a substitution of a string variable or
   /// an expression in the RegExStr regex at match time. For example, in the
   /// case of a CHECK directive with the pattern "foo[[bar]]baz[[#N+1]]",
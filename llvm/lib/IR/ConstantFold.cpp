@@ -17,6 +17,7 @@
 //===----------------------------------------------------------------------===//
 
 #include "llvm/IR/ConstantFold.h"
+#include "LLVMContextImpl.h"
 #include "llvm/ADT/APSInt.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/IR/Constants.h"
@@ -914,18 +915,41 @@ Constant *llvm::ConstantFoldBinaryInstruction(unsigned Opcode, Constant *C1,
     if (ConstantInt *CI2 = dyn_cast<ConstantInt>(C2)) {
       const APInt &C1V = CI1->getValue();
       const APInt &C2V = CI2->getValue();
+      // Wide-integer folds allocate an APInt temporary and hash it against
+      // the IntConstants table. Memoize the hot shapes in a small per-context
+      // cache keyed by the uniqued operand pointers.
+      LLVMContextImpl &Impl = *CI1->getContext().pImpl;
+      bool CacheableShape = C1V.getBitWidth() > APInt::APINT_BITS_PER_WORD &&
+                            (Opcode == Instruction::Add ||
+                             Opcode == Instruction::Mul ||
+                             Opcode == Instruction::UDiv);
+      if (CacheableShape)
+        if (ConstantInt *Cached = Impl.lookupWideIntFold(Opcode, CI1, CI2))
+          return Cached;
       switch (Opcode) {
       default:
         break;
-      case Instruction::Add:
-        return ConstantInt::get(CI1->getContext(), C1V + C2V);
+      case Instruction::Add: {
+        ConstantInt *Res = ConstantInt::get(CI1->getContext(), C1V + C2V);
+        if (CacheableShape)
+          Impl.rememberWideIntFold(Opcode, CI1, CI2, Res);
+        return Res;
+      }
       case Instruction::Sub:
         return ConstantInt::get(CI1->getContext(), C1V - C2V);
-      case Instruction::Mul:
-        return ConstantInt::get(CI1->getContext(), C1V * C2V);
-      case Instruction::UDiv:
+      case Instruction::Mul: {
+        ConstantInt *Res = ConstantInt::get(CI1->getContext(), C1V * C2V);
+        if (CacheableShape)
+          Impl.rememberWideIntFold(Opcode, CI1, CI2, Res);
+        return Res;
+      }
+      case Instruction::UDiv: {
         assert(!CI2->isZero() && "Div by zero handled above");
-        return ConstantInt::get(CI1->getContext(), C1V.udiv(C2V));
+        ConstantInt *Res = ConstantInt::get(CI1->getContext(), C1V.udiv(C2V));
+        if (CacheableShape)
+          Impl.rememberWideIntFold(Opcode, CI1, CI2, Res);
+        return Res;
+      }
       case Instruction::SDiv:
         assert(!CI2->isZero() && "Div by zero handled above");
         if (C2V.isAllOnes() && C1V.isMinSignedValue())
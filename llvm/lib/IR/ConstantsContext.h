@@ -576,6 +576,9 @@ public:
   typename MapTy::iterator begin() { return Map.begin(); }
   typename MapTy::iterator end() { return Map.end(); }
 
+  size_t size() const { return Map.size(); }
+  size_t getMemorySize() const { return Map.getMemorySize(); }
+
   void freeConstants() {
     for (auto &I : Map)
       deleteConstant(I);
@@ -357,6 +357,8 @@ void LLVMContext::setDiscardValueNames(bool Discard) {
   pImpl->DiscardValueNames = Discard;
 }
 
+void LLVMContext::printStats(raw_ostream &OS) const { pImpl->printStats(OS); }
+
 OptPassGate &LLVMContext::getOptPassGate() const {
   return pImpl->getOptPassGate();
 }
@@ -12,6 +12,7 @@
 
 #include "LLVMContextImpl.h"
 #include "AttributeImpl.h"
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/StringMapEntry.h"
 #include "llvm/ADT/iterator.h"
@@ -27,12 +28,19 @@
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Compiler.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/TypeSize.h"
+#include "llvm/Support/raw_ostream.h"
 #include <cassert>
 #include <utility>
 
 using namespace llvm;
 
+static cl::opt<bool> PrintContextStats(
+    "print-context-stats", cl::Hidden,
+    cl::desc("Print LLVMContext uniquing table statistics when the context is "
+             "destroyed"));
+
 LLVMContextImpl::LLVMContextImpl(LLVMContext &C)
     : DiagHandler(std::make_unique<DiagnosticHandler>()),
       VoidTy(C, Type::VoidTyID), LabelTy(C, Type::LabelTyID),
@@ -45,6 +53,10 @@ LLVMContextImpl::LLVMContextImpl(LLVMContext &C)
       Int16Ty(C, 16), Int32Ty(C, 32), Int64Ty(C, 64), Int128Ty(C, 128) {}
 
 LLVMContextImpl::~LLVMContextImpl() {
+  // Dump the table stats before teardown empties the tables.
+  if (PrintContextStats)
+    printStats(errs());
+
 #ifndef NDEBUG
   // Check that any variable location records that fell off the end of a block
   // when it's terminator was removed were eventually replaced. This assertion
@@ -172,6 +184,117 @@ void Module::dropTriviallyDeadConstantArrays() {
   Context.pImpl->dropTriviallyDeadConstantArrays();
 }
 
+ConstantInt *LLVMContextImpl::lookupWideIntFold(unsigned Opcode,
+                                                const ConstantInt *LHS,
+                                                const ConstantInt *RHS) {
+  const WideIntFoldCacheEntry &E =
+      WideIntFoldCache[hash_combine(Opcode, LHS, RHS) % WideIntFoldCacheSize];
+  if (E.Opcode == Opcode && E.LHS == LHS && E.RHS == RHS)
+    return E.Result;
+  return nullptr;
+}
+
+void LLVMContextImpl::rememberWideIntFold(unsigned Opcode,
+                                          const ConstantInt *LHS,
+                                          const ConstantInt *RHS,
+                                          ConstantInt *Result) {
+  WideIntFoldCache[hash_combine(Opcode, LHS, RHS) % WideIntFoldCacheSize] = {
+      LHS, RHS, Opcode, Result};
+}
+
+void LLVMContextImpl::printStats(raw_ostream &OS) {
+  size_t TotalEntries = 0;
+  size_t TotalBytes = 0;
+  // Bytes cover the table's own storage (buckets and inline entries), not the
+  // uniqued objects themselves; objects owned by an arena are attributed to
+  // the allocator rows at the bottom.
+  auto Row = [&](StringRef Name, size_t Entries, size_t Bytes) {
+    TotalEntries += Entries;
+    TotalBytes += Bytes;
+    OS << format("%12zu %14zu  ", Entries, Bytes) << Name << '\n';
+  };
+  auto FoldingSetRow = [&](StringRef Name, FoldingSetBase &Set) {
+    Row(Name, Set.size(), Set.capacity() * sizeof(void *));
+  };
+  // StringMap stores one pointer and one cached hash per bucket.
+  auto StringMapRow = [&](StringRef Name, StringMapImpl &Map) {
+    Row(Name, Map.size(),
+        Map.getNumBuckets() * (sizeof(void *) + sizeof(unsigned)));
+  };
+
+  OS << "===" << std::string(74, '-') << "===\n";
+  OS << "                        LLVMContext uniquing tables\n";
+  OS << "===" << std::string(74, '-') << "===\n";
+  OS << "     Entries    Table bytes  Table\n";
+
+  Row("IntZeroConstants", IntZeroConstants.size(),
+      IntZeroConstants.getMemorySize());
+  Row("IntOneConstants", IntOneConstants.size(),
+      IntOneConstants.getMemorySize());
+  Row("IntConstants", IntConstants.size(), IntConstants.getMemorySize());
+  Row("FPConstants", FPConstants.size(), FPConstants.getMemorySize());
+  FoldingSetRow("AttrsSet", AttrsSet);
+  FoldingSetRow("AttrsLists", AttrsLists);
+  FoldingSetRow("AttrsSetNodes", AttrsSetNodes);
+  StringMapRow("MDStringCache", MDStringCache);
+  Row("ValuesAsMetadata", ValuesAsMetadata.size(),
+      ValuesAsMetadata.getMemorySize());
+  Row("MetadataAsValues", MetadataAsValues.size(),
+      MetadataAsValues.getMemorySize());
+  Row("DIArgLists", DIArgLists.size(), DIArgLists.getMemorySize());
+#define HANDLE_MDNODE_LEAF_UNIQUABLE(CLASS)                                    \
+  Row(#CLASS "s", CLASS##s.size(), CLASS##s.getMemorySize());
+#include "llvm/IR/Metadata.def"
+  Row("DistinctMDNodes", DistinctMDNodes.size(),
+      DistinctMDNodes.capacity() * sizeof(MDNode *));
+  Row("CAZConstants", CAZConstants.size(), CAZConstants.getMemorySize());
+  Row("ArrayConstants", ArrayConstants.size(), ArrayConstants.getMemorySize());
+  Row("StructConstants", StructConstants.size(),
+      StructConstants.getMemorySize());
+  Row("VectorConstants", VectorConstants.size(),
+      VectorConstants.getMemorySize());
+  Row("CPNConstants", CPNConstants.size(), CPNConstants.getMemorySize());
+  Row("CTNConstants", CTNConstants.size(), CTNConstants.getMemorySize());
+  Row("UVConstants", UVConstants.size(), UVConstants.getMemorySize());
+  Row("PVConstants", PVConstants.size(), PVConstants.getMemorySize());
+  StringMapRow("CDSConstants", CDSConstants);
+  Row("BlockAddresses", BlockAddresses.size(), BlockAddresses.getMemorySize());
+  Row("DSOLocalEquivalents", DSOLocalEquivalents.size(),
+      DSOLocalEquivalents.getMemorySize());
+  Row("NoCFIValues", NoCFIValues.size(), NoCFIValues.getMemorySize());
+  Row("ExprConstants", ExprConstants.size(), ExprConstants.getMemorySize());
+  Row("InlineAsms", InlineAsms.size(), InlineAsms.getMemorySize());
+  Row("IntegerTypes", IntegerTypes.size(), IntegerTypes.getMemorySize());
+  Row("FunctionTypes", FunctionTypes.size(), FunctionTypes.getMemorySize());
+  Row("AnonStructTypes", AnonStructTypes.size(),
+      AnonStructTypes.getMemorySize());
+  StringMapRow("NamedStructTypes", NamedStructTypes);
+  Row("TargetExtTypes", TargetExtTypes.size(), TargetExtTypes.getMemorySize());
+  Row("ArrayTypes", ArrayTypes.size(), ArrayTypes.getMemorySize());
+  Row("VectorTypes", VectorTypes.size(), VectorTypes.getMemorySize());
+  Row("PointerTypes", PointerTypes.size(), PointerTypes.getMemorySize());
+  Row("LegacyPointerTypes", LegacyPointerTypes.size(),
+      LegacyPointerTypes.getMemorySize());
+  Row("ASTypedPointerTypes", ASTypedPointerTypes.size(),
+      ASTypedPointerTypes.getMemorySize());
+  Row("ValueNames", ValueNames.size(), ValueNames.getMemorySize());
+  Row("ValueMetadata", ValueMetadata.size(), ValueMetadata.getMemorySize());
+  StringMapRow("CustomMDKindNames", CustomMDKindNames);
+  Row("DiscriminatorTable", DiscriminatorTable.size(),
+      DiscriminatorTable.getMemorySize());
+  StringMapRow("BundleTagCache", BundleTagCache);
+  StringMapRow("SSC", SSC);
+  Row("GCNames", GCNames.size(), GCNames.getMemorySize());
+
+  OS << format("%12zu %14zu  ", TotalEntries, TotalBytes) << "(total)\n\n";
+  OS << "Arena allocators (hold the uniqued objects backing the tables "
+        "above):\n";
+  OS << format("%27zu  ", Alloc.getTotalMemory())
+     << "Alloc (types, attributes, saved strings)\n";
+  OS << format("%27zu  ", MDStringCache.getAllocator().getTotalMemory())
+     << "MDStringCache string data\n";
+}
+
 namespace llvm {
 
 /// Make MDOperand transparent for hashing.
@@ -41,6 +41,7 @@
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/StringSaver.h"
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -65,6 +66,7 @@ class GlobalValue;
 class InlineAsm;
 class LLVMRemarkStreamer;
 class OptPassGate;
+class raw_ostream;
 namespace remarks {
 class RemarkStreamer;
 }
@@ -1489,6 +1491,25 @@ public:
   DenseMap<unsigned, std::unique_ptr<ConstantInt>> IntOneConstants;
   DenseMap<APInt, std::unique_ptr<ConstantInt>> IntConstants;
 
+  /// Direct-mapped cache memoizing wide-integer binary constant folds, keyed
+  /// by the uniqued operand pointers. Wide folds both allocate an APInt
+  /// temporary and hash it against IntConstants; crypto-style code folding
+  /// the same i128/i256 add/mul/udiv shapes repeatedly hits here instead.
+  /// Safe because ConstantInts are never destroyed before context teardown.
+  struct WideIntFoldCacheEntry {
+    const ConstantInt *LHS = nullptr;
+    const ConstantInt *RHS = nullptr;
+    unsigned Opcode = 0;
+    ConstantInt *Result = nullptr;
+  };
+  static constexpr size_t WideIntFoldCacheSize = 64;
+  std::array<WideIntFoldCacheEntry, WideIntFoldCacheSize> WideIntFoldCache;
+
+  ConstantInt *lookupWideIntFold(unsigned Opcode, const ConstantInt *LHS,
+                                 const ConstantInt *RHS);
+  void rememberWideIntFold(unsigned Opcode, const ConstantInt *LHS,
+                           const ConstantInt *RHS, ConstantInt *Result);
+
   DenseMap<APFloat, std::unique_ptr<ConstantFP>> FPConstants;
 
   FoldingSet<AttributeImpl> AttrsSet;
@@ -1650,6 +1671,12 @@ public:
   /// Destroy the ConstantArrays if they are not used.
   void dropTriviallyDeadConstantArrays();
 
+  /// Print entry counts and approximate byte sizes of the uniquing tables and
+  /// allocators owned by this context. The uniquing tables only shrink in rare
+  /// circumstances, so a dump at context teardown is a good approximation of
+  /// the high-water mark. Also triggered by -print-context-stats.
+  void printStats(raw_ostream &OS);
+
   mutable OptPassGate *OPG = nullptr;
 
   /// Access the object which can disable optional passes and individual
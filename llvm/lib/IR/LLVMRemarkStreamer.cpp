@@ -82,6 +82,9 @@ void LLVMRemarkStreamer::emit(const DiagnosticInfoOptimizationBase &Diag) {
   if (!RS.matchesFilter(Diag.getPassName()))
       return;
 
+  if (!RS.shouldSampleRemark(Diag.getRemarkName()))
+    return;
+
   // First, convert the diagnostic to a remark.
   remarks::Remark R = toRemark(Diag);
   // Then, emit the remark through the serializer.
@@ -588,20 +588,133 @@ StringRef MDString::getString() const {
       "Alignment is insufficient after objects prepended to " #CLASS);
 #include "llvm/IR/Metadata.def"
 
+namespace {
+
+/// A per-thread size-class pool for MDNode allocations.
+///
+/// Metadata nodes are tiny (a DILocation or an MDTuple of a few operands is
+/// well under 256 bytes), are created in enormous numbers during LTO links,
+/// and churn through uniquing collisions and temporary-node replacement.
+/// Routing them through malloc fragments the heap badly over a long link.
+/// Instead, freed nodes are kept on per-size-class free lists (8-byte
+/// granularity) and handed back to the next allocation of the same class in
+/// O(1). The pool is thread-local, so no locking is needed; each class keeps
+/// at most MaxFreePerClass blocks and overflow goes back to the heap.
+class MDNodeAllocationPool {
+  static constexpr size_t Granularity = 8;
+  static constexpr size_t MaxPooledSize = 256;
+  static constexpr size_t NumClasses = MaxPooledSize / Granularity;
+  static constexpr size_t MaxFreePerClass = 1024;
+
+  struct FreeBlock {
+    FreeBlock *Next;
+  };
+
+  FreeBlock *FreeLists[NumClasses] = {};
+  size_t FreeCounts[NumClasses] = {};
+
+  static size_t sizeClass(size_t Size) {
+    assert(isPooledSize(Size));
+    return (Size - 1) / Granularity;
+  }
+
+public:
+  static bool isPooledSize(size_t Size) {
+    return Size > 0 && Size <= MaxPooledSize;
+  }
+
+  /// Round \p Size up so every allocation in a class has the same size.
+  static size_t roundUp(size_t Size) { return alignTo(Size, Granularity); }
+
+  /// Fetch a recycled block of the class for \p Size, or nullptr.
+  void *allocate(size_t Size) {
+    size_t Class = sizeClass(Size);
+    FreeBlock *Block = FreeLists[Class];
+    if (!Block)
+      return nullptr;
+    FreeLists[Class] = Block->Next;
+    --FreeCounts[Class];
+    return Block;
+  }
+
+  /// Park \p Mem for reuse. \returns false if the class is full and the
+  /// caller should free the block itself.
+  bool deallocate(void *Mem, size_t Size) {
+    size_t Class = sizeClass(Size);
+    if (FreeCounts[Class] >= MaxFreePerClass)
+      return false;
+    FreeBlock *Block = static_cast<FreeBlock *>(Mem);
+    Block->Next = FreeLists[Class];
+    FreeLists[Class] = Block;
+    ++FreeCounts[Class];
+    return true;
+  }
+
+  MDNodeAllocationPool();
+  ~MDNodeAllocationPool();
+};
+
+// Lives before the pool so it is still readable (and false) after the pool's
+// destructor has run; MDNodes owned by objects destroyed later at thread or
+// process exit then fall back to the heap.
+thread_local bool MDNodePoolLive = false;
+thread_local MDNodeAllocationPool MDNodePool;
+
+/// \returns the calling thread's pool, or nullptr once it has been destroyed.
+static MDNodeAllocationPool *getMDNodePool() {
+  // Taking the address odr-uses the pool and triggers its construction on
+  // first use, which sets MDNodePoolLive.
+  MDNodeAllocationPool *Pool = &MDNodePool;
+  return MDNodePoolLive ? Pool : nullptr;
+}
+
+MDNodeAllocationPool::MDNodeAllocationPool() { MDNodePoolLive = true; }
+
+MDNodeAllocationPool::~MDNodeAllocationPool() {
+  MDNodePoolLive = false;
+  for (FreeBlock *&List : FreeLists) {
+    while (FreeBlock *Block = List) {
+      List = Block->Next;
+      ::operator delete(Block);
+    }
+  }
+}
+
+} // end anonymous namespace
+
 void *MDNode::operator new(size_t Size, size_t NumOps, StorageType Storage) {
   // uint64_t is the most aligned type we need support (ensured by static_assert
   // above)
   size_t AllocSize =
       alignTo(Header::getAllocSize(Storage, NumOps), alignof(uint64_t));
-  char *Mem = reinterpret_cast<char *>(::operator new(AllocSize + Size));
+  size_t TotalSize = AllocSize + Size;
+  char *Mem;
+  if (MDNodeAllocationPool::isPooledSize(TotalSize)) {
+    TotalSize = MDNodeAllocationPool::roundUp(TotalSize);
+    MDNodeAllocationPool *Pool = getMDNodePool();
+    Mem = Pool ? reinterpret_cast<char *>(Pool->allocate(TotalSize)) : nullptr;
+    if (!Mem)
+      Mem = reinterpret_cast<char *>(::operator new(TotalSize));
+  } else {
+    Mem = reinterpret_cast<char *>(::operator new(TotalSize));
+  }
   Header *H = new (Mem + AllocSize - sizeof(Header)) Header(NumOps, Storage);
   return reinterpret_cast<void *>(H + 1);
 }
 
-void MDNode::operator delete(void *N) {
+void MDNode::operator delete(void *N, size_t Size) {
   Header *H = reinterpret_cast<Header *>(N) - 1;
+  // Recompute the total allocation size the same way operator new did; Size
+  // is exact because deletion goes through the concrete subclass.
+  size_t TotalSize = alignTo(H->getAllocSize(), alignof(uint64_t)) + Size;
   void *Mem = H->getAllocation();
   H->~Header();
+  if (MDNodeAllocationPool::isPooledSize(TotalSize)) {
+    TotalSize = MDNodeAllocationPool::roundUp(TotalSize);
+    MDNodeAllocationPool *Pool = getMDNodePool();
+    if (Pool && Pool->deallocate(Mem, TotalSize))
+      return;
+  }
   ::operator delete(Mem);
 }
 
@@ -1358,6 +1358,9 @@ protected:
   const DenseMap<StringRef, GVSummaryMapTy> &ModuleToDefinedGVSummaries;
   lto::IndexWriteCallback OnWrite;
   bool ShouldEmitImportsFiles;
+  // If non-null, supplies the output stream for each module's sharded index
+  // instead of NewModulePath + ".thinlto.bc".
+  lto::IndexWriteStreamCallback GetIndexStream;
 
 public:
   ThinBackendProc(
@@ -1387,11 +1390,19 @@ public:
     gatherImportedSummariesForModule(ModulePath, ModuleToDefinedGVSummaries,
                                      ImportList, ModuleToSummariesForIndex);
 
-    raw_fd_ostream OS(NewModulePath + ".thinlto.bc", EC,
-                      sys::fs::OpenFlags::OF_None);
-    if (EC)
-      return errorCodeToError(EC);
-    writeIndexToFile(CombinedIndex, OS, &ModuleToSummariesForIndex);
+    if (GetIndexStream) {
+      Expected<std::unique_ptr<raw_ostream>> OS =
+          GetIndexStream(std::string(ModulePath));
+      if (!OS)
+        return OS.takeError();
+      writeIndexToFile(CombinedIndex, **OS, &ModuleToSummariesForIndex);
+    } else {
+      raw_fd_ostream OS(NewModulePath + ".thinlto.bc", EC,
+                        sys::fs::OpenFlags::OF_None);
+      if (EC)
+        return errorCodeToError(EC);
+      writeIndexToFile(CombinedIndex, OS, &ModuleToSummariesForIndex);
+    }
 
     if (ShouldEmitImportsFiles) {
       EC = EmitImportsFiles(ModulePath, NewModulePath + ".imports",
@@ -1583,12 +1594,15 @@ public:
       const DenseMap<StringRef, GVSummaryMapTy> &ModuleToDefinedGVSummaries,
       std::string OldPrefix, std::string NewPrefix,
       std::string NativeObjectPrefix, bool ShouldEmitImportsFiles,
-      raw_fd_ostream *LinkedObjectsFile, lto::IndexWriteCallback OnWrite)
+      raw_fd_ostream *LinkedObjectsFile, lto::IndexWriteCallback OnWrite,
+      lto::IndexWriteStreamCallback GetIndexStream)
       : ThinBackendProc(Conf, CombinedIndex, ModuleToDefinedGVSummaries,
                         OnWrite, ShouldEmitImportsFiles),
         OldPrefix(OldPrefix), NewPrefix(NewPrefix),
         NativeObjectPrefix(NativeObjectPrefix),
-        LinkedObjectsFile(LinkedObjectsFile) {}
+        LinkedObjectsFile(LinkedObjectsFile) {
+    this->GetIndexStream = std::move(GetIndexStream);
+  }
 
   Error start(
       unsigned Task, BitcodeModule BM,
@@ -1627,7 +1641,8 @@ public:
 ThinBackend lto::createWriteIndexesThinBackend(
     std::string OldPrefix, std::string NewPrefix,
     std::string NativeObjectPrefix, bool ShouldEmitImportsFiles,
-    raw_fd_ostream *LinkedObjectsFile, IndexWriteCallback OnWrite) {
+    raw_fd_ostream *LinkedObjectsFile, IndexWriteCallback OnWrite,
+    IndexWriteStreamCallback GetIndexStream) {
   return
       [=](const Config &Conf, ModuleSummaryIndex &CombinedIndex,
           const DenseMap<StringRef, GVSummaryMapTy> &ModuleToDefinedGVSummaries,
@@ -1635,7 +1650,7 @@ ThinBackend lto::createWriteIndexesThinBackend(
         return std::make_unique<WriteIndexesThinBackend>(
             Conf, CombinedIndex, ModuleToDefinedGVSummaries, OldPrefix,
             NewPrefix, NativeObjectPrefix, ShouldEmitImportsFiles,
-            LinkedObjectsFile, OnWrite);
+            LinkedObjectsFile, OnWrite, GetIndexStream);
       };
 }
 
@@ -1664,8 +1679,11 @@ Error LTO::runThinLTO(AddStreamFn AddStream, FileCache Cache,
   // Summary).
   DenseMap<StringRef, GVSummaryMapTy> ModuleToDefinedGVSummaries(
       ThinLTO.ModuleMap.size());
-  ThinLTO.CombinedIndex.collectDefinedGVSummariesPerModule(
-      ModuleToDefinedGVSummaries);
+  {
+    TimeTraceScope TimeScope("CollectDefinedGVSummaries");
+    ThinLTO.CombinedIndex.collectDefinedGVSummariesPerModule(
+        ModuleToDefinedGVSummaries);
+  }
   // Create entries for any modules that didn't have any GV summaries
   // (either they didn't have any GVs to start with, or we suppressed
   // generation of the summaries because they e.g. had inline assembly
@@ -1678,7 +1696,10 @@ Error LTO::runThinLTO(AddStreamFn AddStream, FileCache Cache,
       ModuleToDefinedGVSummaries.try_emplace(Mod.first);
 
   // Synthesize entry counts for functions in the CombinedIndex.
-  computeSyntheticCounts(ThinLTO.CombinedIndex);
+  {
+    TimeTraceScope TimeScope("ComputeSyntheticCounts");
+    computeSyntheticCounts(ThinLTO.CombinedIndex);
+  }
 
   DenseMap<StringRef, FunctionImporter::ImportMapTy> ImportLists(
       ThinLTO.ModuleMap.size());
@@ -1728,8 +1749,11 @@ Error LTO::runThinLTO(AddStreamFn AddStream, FileCache Cache,
   // no index entries in the typeIdMetadata map (e.g. if we are instead
   // performing IR-based WPD in hybrid regular/thin LTO mode).
   std::map<ValueInfo, std::vector<VTableSlotSummary>> LocalWPDTargetsMap;
-  runWholeProgramDevirtOnIndex(ThinLTO.CombinedIndex, ExportedGUIDs,
-                               LocalWPDTargetsMap);
+  {
+    TimeTraceScope TimeScope("WholeProgramDevirt");
+    runWholeProgramDevirtOnIndex(ThinLTO.CombinedIndex, ExportedGUIDs,
+                                 LocalWPDTargetsMap);
+  }
 
   auto isPrevailing = [&](GlobalValue::GUID GUID, const GlobalValueSummary *S) {
     return ThinLTO.PrevailingModuleForGUID[GUID] == S->modulePath();
@@ -1739,9 +1763,11 @@ Error LTO::runThinLTO(AddStreamFn AddStream, FileCache Cache,
     ContextDisambiguation.run(ThinLTO.CombinedIndex, isPrevailing);
   }
 
-  if (Conf.OptLevel > 0)
+  if (Conf.OptLevel > 0) {
+    TimeTraceScope TimeScope("ComputeCrossModuleImport");
     ComputeCrossModuleImport(ThinLTO.CombinedIndex, ModuleToDefinedGVSummaries,
                              isPrevailing, ImportLists, ExportLists);
+  }
 
   // Figure out which symbols need to be internalized. This also needs to happen
   // at -O0 because summary-based DCE is implemented using internalization, and
@@ -1780,20 +1806,32 @@ Error LTO::runThinLTO(AddStreamFn AddStream, FileCache Cache,
   updateIndexWPDForExports(ThinLTO.CombinedIndex, isExported,
                            LocalWPDTargetsMap);
 
-  thinLTOInternalizeAndPromoteInIndex(ThinLTO.CombinedIndex, isExported,
-                                      isPrevailing);
+  {
+    TimeTraceScope TimeScope("InternalizeAndPromote");
+    thinLTOInternalizeAndPromoteInIndex(ThinLTO.CombinedIndex, isExported,
+                                        isPrevailing);
+  }
 
   auto recordNewLinkage = [&](StringRef ModuleIdentifier,
                               GlobalValue::GUID GUID,
                               GlobalValue::LinkageTypes NewLinkage) {
     ResolvedODR[ModuleIdentifier][GUID] = NewLinkage;
   };
-  thinLTOResolvePrevailingInIndex(Conf, ThinLTO.CombinedIndex, isPrevailing,
-                                  recordNewLinkage, GUIDPreservedSymbols);
+  {
+    TimeTraceScope TimeScope("ResolvePrevailing");
+    thinLTOResolvePrevailingInIndex(Conf, ThinLTO.CombinedIndex, isPrevailing,
+                                    recordNewLinkage, GUIDPreservedSymbols);
+  }
 
-  thinLTOPropagateFunctionAttrs(ThinLTO.CombinedIndex, isPrevailing);
+  {
+    TimeTraceScope TimeScope("PropagateFunctionAttrs");
+    thinLTOPropagateFunctionAttrs(ThinLTO.CombinedIndex, isPrevailing);
+  }
 
-  generateParamAccessSummary(ThinLTO.CombinedIndex);
+  {
+    TimeTraceScope TimeScope("ParamAccessSummary");
+    generateParamAccessSummary(ThinLTO.CombinedIndex);
+  }
 
   if (llvm::timeTraceProfilerEnabled())
     llvm::timeTraceProfilerEnd();
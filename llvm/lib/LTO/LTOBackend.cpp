@@ -36,6 +36,7 @@
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Program.h"
 #include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/TimeProfiler.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Support/VirtualFileSystem.h"
 #include "llvm/Support/raw_ostream.h"
@@ -344,6 +345,7 @@ bool lto::opt(const Config &Conf, TargetMachine *TM, unsigned Task, Module &Mod,
               bool IsThinLTO, ModuleSummaryIndex *ExportSummary,
               const ModuleSummaryIndex *ImportSummary,
               const std::vector<uint8_t> &CmdArgs) {
+  TimeTraceScope TimeScope("LTO backend optimize", Mod.getModuleIdentifier());
   if (EmbedBitcode == LTOBitcodeEmbedding::EmbedPostMergePreOptimized) {
     // FIXME: the motivation for capturing post-merge bitcode and command line
     // is replicating the compilation environment from bitcode, without needing
@@ -370,6 +372,7 @@ bool lto::opt(const Config &Conf, TargetMachine *TM, unsigned Task, Module &Mod,
 static void codegen(const Config &Conf, TargetMachine *TM,
                     AddStreamFn AddStream, unsigned Task, Module &Mod,
                     const ModuleSummaryIndex &CombinedIndex) {
+  TimeTraceScope TimeScope("LTO backend codegen", Mod.getModuleIdentifier());
   if (Conf.PreCodeGenModuleHook && !Conf.PreCodeGenModuleHook(Task, Mod))
     return;
 
@@ -554,6 +557,7 @@ Error lto::thinBackend(const Config &Conf, unsigned Task, AddStreamFn AddStream,
                        const GVSummaryMapTy &DefinedGlobals,
                        MapVector<StringRef, BitcodeModule> *ModuleMap,
                        const std::vector<uint8_t> &CmdArgs) {
+  TimeTraceScope TimeScope("Thin backend", Mod.getModuleIdentifier());
   Expected<const Target *> TOrErr = initAndLookupTarget(Conf, Mod);
   if (!TOrErr)
     return TOrErr.takeError();
@@ -619,6 +623,29 @@ Error lto::thinBackend(const Config &Conf, unsigned Task, AddStreamFn AddStream,
       !Conf.PostInternalizeModuleHook(Task, Mod))
     return finalizeOptimizationRemarks(std::move(DiagnosticOutputFile));
 
+  // Without a module map the imported modules are read from individual files
+  // (the distributed backend case), and a slow file read serializes the whole
+  // import. Issue all the reads up front on worker threads and let the loader
+  // below consume the buffers; parsing stays on this thread, as modules must
+  // be created in the destination context.
+  StringMap<std::unique_ptr<MemoryBuffer>> PrefetchedBuffers;
+  if (!ModuleMap && ImportList.size() > 1) {
+    ThreadPool Pool;
+    std::mutex Mu;
+    for (const auto &Entry : ImportList)
+      Pool.async([&, Identifier = Entry.first] {
+        ErrorOr<std::unique_ptr<MemoryBuffer>> MBOrErr =
+            MemoryBuffer::getFile(Identifier);
+        if (!MBOrErr)
+          // Fall back to the synchronous read in the loader, which will
+          // report the error.
+          return;
+        std::lock_guard<std::mutex> L(Mu);
+        PrefetchedBuffers[Identifier] = std::move(*MBOrErr);
+      });
+    Pool.wait();
+  }
+
   auto ModuleLoader = [&](StringRef Identifier) {
     assert(Mod.getContext().isODRUniquingDebugTypes() &&
            "ODR Type uniquing should be enabled on the context");
@@ -630,8 +657,12 @@ Error lto::thinBackend(const Config &Conf, unsigned Task, AddStreamFn AddStream,
                                      /*IsImporting*/ true);
     }
 
-    ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> MBOrErr =
-        llvm::MemoryBuffer::getFile(Identifier);
+    ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> MBOrErr = std::error_code();
+    auto Prefetched = PrefetchedBuffers.find(Identifier);
+    if (Prefetched != PrefetchedBuffers.end() && Prefetched->second)
+      MBOrErr = std::move(Prefetched->second);
+    else
+      MBOrErr = llvm::MemoryBuffer::getFile(Identifier);
     if (!MBOrErr)
       return Expected<std::unique_ptr<llvm::Module>>(make_error<StringError>(
           Twine("Error loading imported file ") + Identifier + " : ",
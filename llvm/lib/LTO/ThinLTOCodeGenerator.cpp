@@ -73,6 +73,9 @@ using namespace llvm;
 
 #define DEBUG_TYPE "thinlto"
 
+STATISTIC(NumCacheHits, "Number of ThinLTO backend cache hits");
+STATISTIC(NumCacheMisses, "Number of ThinLTO backend cache misses");
+
 namespace llvm {
 // Flags -discard-value-names, defined in LTOCodeGenerator.cpp
 extern cl::opt<bool> LTODiscardValueNames;
@@ -1157,6 +1160,12 @@ void ThinLTOCodeGenerator::run() {
           LLVM_DEBUG(dbgs() << "Cache " << (ErrOrBuffer ? "hit" : "miss")
                             << " '" << CacheEntryPath << "' for buffer "
                             << count << " " << ModuleIdentifier << "\n");
+          if (!CacheEntryPath.empty()) {
+            if (ErrOrBuffer)
+              ++NumCacheHits;
+            else
+              ++NumCacheMisses;
+          }
 
           if (ErrOrBuffer) {
             // Cache Hit!
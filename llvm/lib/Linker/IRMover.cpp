@@ -1238,6 +1238,23 @@ void IRLinker::linkNamedMDNodes() {
     if (IsPerformingImport && NMD.getName() == "llvm.stats")
       continue;
 
+    // When importing, only link compile units that were reached while mapping
+    // the imported function bodies; those are the only ones the destination's
+    // debug info can refer to. The rest stay behind in the source module,
+    // which will emit them itself. Eagerly mapping every source compile unit
+    // here would drag in its whole metadata graph.
+    if (IsPerformingImport && NMD.getName() == "llvm.dbg.cu") {
+      MDMapT &MDMap = *ValueMap.getMDMap();
+      for (const MDNode *Op : NMD.operands()) {
+        auto MappedOp = MDMap.find(Op);
+        if (MappedOp == MDMap.end() || !MappedOp->second)
+          continue;
+        NamedMDNode *DestNMD = DstM.getOrInsertNamedMetadata(NMD.getName());
+        DestNMD->addOperand(Mapper.mapMDNode(*Op));
+      }
+      continue;
+    }
+
     NamedMDNode *DestNMD = DstM.getOrInsertNamedMetadata(NMD.getName());
     // Add Src elements into Dest node.
     for (const MDNode *Op : NMD.operands())
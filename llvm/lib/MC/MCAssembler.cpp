@@ -69,6 +69,10 @@ STATISTIC(evaluateFixup, "Number of evaluated fixups");
 STATISTIC(FragmentLayouts, "Number of fragment layouts");
 STATISTIC(ObjectBytes, "Number of emitted object file bytes");
 STATISTIC(RelaxationSteps, "Number of assembler layout and relaxation steps");
+STATISTIC(RelaxationPasses, "Number of per-section relaxation passes");
+STATISTIC(RelaxationAttempts, "Number of fragment relaxation attempts");
+STATISTIC(RelaxedFragments,
+          "Number of fragments that changed size during relaxation");
 STATISTIC(RelaxedInstructions, "Number of relaxed instructions");
 
 } // end namespace stats
@@ -1215,19 +1219,25 @@ bool MCAssembler::relaxFragment(MCAsmLayout &Layout, MCFragment &F) {
   }
 }
 
-bool MCAssembler::layoutSectionOnce(MCAsmLayout &Layout, MCSection &Sec) {
+bool MCAssembler::layoutSectionOnce(MCAsmLayout &Layout,
+                                    ArrayRef<MCFragment *> Relaxable) {
   // Holds the first fragment which needed relaxing during this layout. It will
   // remain NULL if none were relaxed.
   // When a fragment is relaxed, all the fragments following it should get
   // invalidated because their offset is going to change.
   MCFragment *FirstRelaxedFragment = nullptr;
+  ++stats::RelaxationPasses;
 
-  // Attempt to relax all the fragments in the section.
-  for (MCFragment &Frag : Sec) {
+  // Attempt to relax all the candidate fragments of the section.
+  for (MCFragment *Frag : Relaxable) {
     // Check if this is a fragment that needs relaxation.
-    bool RelaxedFrag = relaxFragment(Layout, Frag);
-    if (RelaxedFrag && !FirstRelaxedFragment)
-      FirstRelaxedFragment = &Frag;
+    ++stats::RelaxationAttempts;
+    bool RelaxedFrag = relaxFragment(Layout, *Frag);
+    if (RelaxedFrag) {
+      ++stats::RelaxedFragments;
+      if (!FirstRelaxedFragment)
+        FirstRelaxedFragment = Frag;
+    }
   }
   if (FirstRelaxedFragment) {
     Layout.invalidateFragmentsFrom(FirstRelaxedFragment);
@@ -1236,12 +1246,41 @@ bool MCAssembler::layoutSectionOnce(MCAsmLayout &Layout, MCSection &Sec) {
   return false;
 }
 
+/// Whether relaxFragment() can change the size of the given fragment. Must
+/// cover every kind relaxFragment() handles.
+static bool isRelaxableFragment(const MCFragment &F) {
+  switch (F.getKind()) {
+  default:
+    return false;
+  case MCFragment::FT_Relaxable:
+  case MCFragment::FT_Dwarf:
+  case MCFragment::FT_DwarfFrame:
+  case MCFragment::FT_LEB:
+  case MCFragment::FT_BoundaryAlign:
+  case MCFragment::FT_CVInlineLines:
+  case MCFragment::FT_CVDefRange:
+  case MCFragment::FT_PseudoProbe:
+    return true;
+  }
+}
+
 bool MCAssembler::layoutOnce(MCAsmLayout &Layout) {
   ++stats::RelaxationSteps;
 
   bool WasRelaxed = false;
   for (MCSection &Sec : *this) {
-    while (layoutSectionOnce(Layout, Sec))
+    // The bulk of the fragments are data fragments that can never relax.
+    // Collect the candidates once so the iterations to a fixed point below
+    // only visit those instead of rescanning the whole section. Relaxation
+    // changes fragment sizes but never fragment kinds, so the set is stable.
+    SmallVector<MCFragment *, 16> Relaxable;
+    for (MCFragment &Frag : Sec)
+      if (isRelaxableFragment(Frag))
+        Relaxable.push_back(&Frag);
+    if (Relaxable.empty())
+      continue;
+
+    while (layoutSectionOnce(Layout, Relaxable))
       WasRelaxed = true;
   }
 
@@ -12,8 +12,10 @@
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/BinaryFormat/COFF.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Endian.h"
 #include "llvm/Support/MathExtras.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Support/raw_ostream.h"
 #include <cassert>
 #include <cstddef>
@@ -24,6 +26,16 @@
 
 using namespace llvm;
 
+static cl::opt<unsigned> ParallelTailMergeMinStrings(
+    "string-table-parallel-merge-min-strings", cl::Hidden, cl::init(1 << 16),
+    cl::desc("Shard string table tail merging across threads when the table "
+             "holds at least this many strings (1-byte alignment only)"));
+
+static cl::opt<uint64_t> TailMergeMaxBytes(
+    "string-table-tail-merge-max-bytes", cl::Hidden, cl::init(0),
+    cl::desc("Keep the in-order layout instead of tail merging for string "
+             "tables larger than this many bytes (0 = always merge)"));
+
 StringTableBuilder::~StringTableBuilder() = default;
 
 void StringTableBuilder::initSize() {
@@ -135,36 +147,89 @@ void StringTableBuilder::finalizeInOrder() {
   finalizeStringTable(/*Optimize=*/false);
 }
 
+// Lay out tail-sorted strings starting at Size, merging each string that is
+// a suffix of its predecessor, and return the resulting size.
+static size_t assignOffsets(ArrayRef<StringPair *> Strings, bool AppendNul,
+                            Align Alignment, size_t Size) {
+  StringRef Previous;
+  for (StringPair *P : Strings) {
+    StringRef S = P->first.val();
+    if (Previous.endswith(S)) {
+      size_t Pos = Size - S.size() - AppendNul;
+      if (isAligned(Alignment, Pos)) {
+        P->second = Pos;
+        continue;
+      }
+    }
+
+    Size = alignTo(Size, Alignment);
+    P->second = Size;
+
+    Size += S.size();
+    if (AppendNul)
+      ++Size;
+    Previous = S;
+  }
+  return Size;
+}
+
 void StringTableBuilder::finalizeStringTable(bool Optimize) {
   Finalized = true;
 
+  // Above the configured size the sort dominates finalize time while the
+  // relative tail-merge savings shrink; keep the offsets assigned by add().
+  if (Optimize && TailMergeMaxBytes && Size > TailMergeMaxBytes)
+    Optimize = false;
+
   if (Optimize) {
     std::vector<StringPair *> Strings;
     Strings.reserve(StringIndexMap.size());
     for (StringPair &P : StringIndexMap)
       Strings.push_back(&P);
 
-    multikeySort(Strings, 0);
     initSize();
+    const bool AppendNul = K != RAW;
 
-    StringRef Previous;
-    for (StringPair *P : Strings) {
-      StringRef S = P->first.val();
-      if (Previous.endswith(S)) {
-        size_t Pos = Size - S.size() - (K != RAW);
-        if (isAligned(Alignment, Pos)) {
-          P->second = Pos;
-          continue;
-        }
+    if (Alignment == Align(1) && Strings.size() >= ParallelTailMergeMinStrings) {
+      // Shard by final byte: strings whose last characters differ can never
+      // tail-merge, and the multikey sort's first pass is exactly a partition
+      // on that byte, so sorting and laying out the shards independently and
+      // concatenating them in descending byte order (the sort's order)
+      // reproduces the serial layout byte for byte. Requires 1-byte alignment
+      // because per-shard offsets are relative to an unknown base.
+      std::vector<StringPair *> Shards[256];
+      StringPair *EmptyString = nullptr;
+      for (StringPair *P : Strings) {
+        StringRef S = P->first.val();
+        if (S.empty())
+          EmptyString = P;
+        else
+          Shards[(unsigned char)S.back()].push_back(P);
       }
 
-      Size = alignTo(Size, Alignment);
-      P->second = Size;
+      size_t ShardSizes[256];
+      parallelFor(0, 256, [&](size_t I) {
+        multikeySort(Shards[I], 0);
+        ShardSizes[I] = assignOffsets(Shards[I], AppendNul, Alignment, 0);
+      });
+
+      size_t Bases[256];
+      for (int I = 255; I >= 0; --I) {
+        Bases[I] = Size;
+        Size += ShardSizes[I];
+      }
+      parallelFor(0, 256, [&](size_t I) {
+        for (StringPair *P : Shards[I])
+          P->second += Bases[I];
+      });
 
-      Size += S.size();
-      if (K != RAW)
-        ++Size;
-      Previous = S;
+      // The empty string sorts last and tail-merges with whatever was laid
+      // out before it, exactly as in the serial layout.
+      if (EmptyString)
+        EmptyString->second = Size - AppendNul;
+    } else {
+      multikeySort(Strings, 0);
+      Size = assignOffsets(Strings, AppendNul, Alignment, Size);
     }
   }
 
@@ -14,12 +14,15 @@
 
 #include "llvm/Passes/StandardInstrumentations.h"
 #include "llvm/ADT/Any.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/StableHashing.h"
+#include "llvm/ADT/Statistic.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Analysis/CallGraphSCCPass.h"
 #include "llvm/Analysis/LazyCallGraph.h"
 #include "llvm/Analysis/LoopInfo.h"
 #include "llvm/CodeGen/MachineFunction.h"
+#include "llvm/IR/CFG.h"
 #include "llvm/IR/Constants.h"
 #include "llvm/IR/Function.h"
 #include "llvm/IR/Module.h"
@@ -47,6 +50,13 @@
 
 using namespace llvm;
 
+#define DEBUG_TYPE "pipeline-gating"
+
+STATISTIC(NumGatedPassRuns,
+          "Number of optional pass runs skipped by pipeline gating");
+STATISTIC(NumGateQueries,
+          "Number of pipeline gating feature scans performed");
+
 static cl::opt<bool> VerifyAnalysisInvalidation("verify-analysis-invalidation",
                                                 cl::Hidden,
 #ifdef EXPENSIVE_CHECKS
@@ -1021,6 +1031,119 @@ void OptPassGateInstrumentation::registerCallbacks(
   });
 }
 
+static cl::opt<bool> EnablePipelineGating(
+    "enable-pipeline-gating",
+    cl::desc("Skip optional function passes that cannot fire on a function, "
+             "based on cheap syntactic features"),
+    cl::init(false), cl::Hidden);
+
+static cl::opt<unsigned> PipelineGatingMaxInstrs(
+    "pipeline-gating-max-instrs",
+    cl::desc("Only gate passes on functions with at most this many "
+             "instructions, so the feature scan stays cheap"),
+    cl::init(64), cl::Hidden);
+
+static cl::list<std::string> PipelineGatingLoopPasses(
+    "pipeline-gating-loop-passes", cl::CommaSeparated, cl::Hidden,
+    cl::desc("Passes skipped on functions whose CFG has no cycle"),
+    cl::list_init<std::string>({"LoopVectorizePass", "LoopUnrollPass",
+                                "LoopLoadEliminationPass"}));
+
+static cl::list<std::string> PipelineGatingFPPasses(
+    "pipeline-gating-fp-passes", cl::CommaSeparated, cl::Hidden,
+    cl::desc("Passes skipped on functions without floating-point operations"),
+    cl::list_init<std::string>({"Float2IntPass"}));
+
+namespace {
+/// Cheap syntactic function features consulted by pipeline gating.
+struct FunctionGatingFeatures {
+  bool Scanned = false; ///< False if the function exceeded the size cap.
+  bool HasLoop = false;
+  bool HasFPOps = false;
+};
+} // namespace
+
+static FunctionGatingFeatures scanFunctionForGating(const Function &F) {
+  FunctionGatingFeatures Features;
+  unsigned NumInstrs = 0;
+  for (const BasicBlock &BB : F) {
+    NumInstrs += BB.size();
+    if (NumInstrs > PipelineGatingMaxInstrs)
+      return Features;
+    for (const Instruction &I : BB)
+      if (I.getType()->isFPOrFPVectorTy() ||
+          any_of(I.operands(), [](const Use &U) {
+            return U->getType()->isFPOrFPVectorTy();
+          }))
+        Features.HasFPOps = true;
+  }
+
+  // Any cycle in the CFG counts as a loop; irreducible control flow is fine
+  // to treat as one. The function is small, so a plain DFS is cheap.
+  SmallVector<std::pair<const BasicBlock *, const_succ_iterator>, 16> Stack;
+  SmallPtrSet<const BasicBlock *, 16> Visited, OnStack;
+  const BasicBlock *Entry = &F.getEntryBlock();
+  Stack.push_back({Entry, succ_begin(Entry)});
+  Visited.insert(Entry);
+  OnStack.insert(Entry);
+  while (!Stack.empty() && !Features.HasLoop) {
+    auto &[BB, SuccIt] = Stack.back();
+    if (SuccIt == succ_end(BB)) {
+      OnStack.erase(BB);
+      Stack.pop_back();
+      continue;
+    }
+    const BasicBlock *Succ = *SuccIt++;
+    if (OnStack.count(Succ)) {
+      Features.HasLoop = true;
+      break;
+    }
+    if (Visited.insert(Succ).second) {
+      Stack.push_back({Succ, succ_begin(Succ)});
+      OnStack.insert(Succ);
+    }
+  }
+
+  Features.Scanned = true;
+  return Features;
+}
+
+bool PipelineGatingInstrumentation::shouldRun(StringRef PassID, Any IR) {
+  enum class GateKind { NeedsLoop, NeedsFP };
+  GateKind Kind;
+  if (is_contained(PipelineGatingLoopPasses, PassID))
+    Kind = GateKind::NeedsLoop;
+  else if (is_contained(PipelineGatingFPPasses, PassID))
+    Kind = GateKind::NeedsFP;
+  else
+    return true;
+
+  const Function **FPtr = llvm::any_cast<const Function *>(&IR);
+  if (!FPtr || (*FPtr)->isDeclaration())
+    return true;
+  const Function &F = **FPtr;
+
+  ++NumGateQueries;
+  FunctionGatingFeatures Features = scanFunctionForGating(F);
+  if (!Features.Scanned)
+    return true;
+
+  bool ShouldRun =
+      Kind == GateKind::NeedsLoop ? Features.HasLoop : Features.HasFPOps;
+  if (!ShouldRun)
+    ++NumGatedPassRuns;
+  return ShouldRun;
+}
+
+void PipelineGatingInstrumentation::registerCallbacks(
+    PassInstrumentationCallbacks &PIC) {
+  if (!EnablePipelineGating)
+    return;
+
+  PIC.registerShouldRunOptionalPassCallback(
+      [this](StringRef P, Any IR) { return this->shouldRun(P, IR); });
+}
+
 raw_ostream &PrintPassInstrumentation::print() {
   if (Opts.Indent) {
     assert(Indent >= 0);
@@ -1387,12 +1510,52 @@ void PreservedCFGCheckerInstrumentation::registerCallbacks(
   });
 }
 
+// Restricts -verify-each to the IR a pass could have changed: passes that
+// preserve all analyses are skipped entirely, CGSCC passes re-verify only the
+// functions of their SCC, and module passes re-verify only functions whose
+// structural hash changed. Module-level checks (globals, module metadata) are
+// not re-run after module passes in this mode; run a full verifier pass at the
+// end of the pipeline to keep that coverage.
+static cl::opt<bool> VerifyEachIncremental(
+    "verify-each-incremental", cl::Hidden, cl::init(false),
+    cl::desc("With -verify-each, only re-verify functions the pass changed"));
+
+static void verifyFunctionAfterPass(const Function &F, StringRef P,
+                                    bool DebugLogging) {
+  if (DebugLogging)
+    dbgs() << "Verifying function " << F.getName() << "\n";
+
+  if (verifyFunction(F, &errs()))
+    report_fatal_error(formatv("Broken function found after pass "
+                               "\"{0}\", compilation aborted!",
+                               P));
+}
+
 void VerifyInstrumentation::registerCallbacks(
     PassInstrumentationCallbacks &PIC) {
+  if (VerifyEachIncremental) {
+    // Snapshot per-function hashes before each module pass so the after-pass
+    // callback can re-verify only what changed.
+    PIC.registerBeforeNonSkippedPassCallback([this](StringRef P, Any IR) {
+      if (isIgnored(P) || P == "VerifierPass")
+        return;
+      const Module **MPtr = llvm::any_cast<const Module *>(&IR);
+      if (!MPtr)
+        return;
+      FunctionHashes.clear();
+      for (const Function &F : **MPtr)
+        if (!F.isDeclaration())
+          FunctionHashes[&F] = StructuralHash(F, /*DetailedHash=*/true);
+    });
+  }
+
   PIC.registerAfterPassCallback(
       [this](StringRef P, Any IR, const PreservedAnalyses &PassPA) {
         if (isIgnored(P) || P == "VerifierPass")
           return;
+        // A pass that preserves all analyses cannot have changed the IR.
+        if (VerifyEachIncremental && PassPA.areAllPreserved())
+          return;
         const Function **FPtr = llvm::any_cast<const Function *>(&IR);
         const Function *F = FPtr ? *FPtr : nullptr;
         if (!F) {
@@ -1401,14 +1564,32 @@ void VerifyInstrumentation::registerCallbacks(
         }
 
         if (F) {
-          if (DebugLogging)
-            dbgs() << "Verifying function " << F->getName() << "\n";
-
-          if (verifyFunction(*F, &errs()))
-            report_fatal_error(formatv("Broken function found after pass "
-                                       "\"{0}\", compilation aborted!",
-                                       P));
+          verifyFunctionAfterPass(*F, P, DebugLogging);
         } else {
+          if (VerifyEachIncremental) {
+            // A CGSCC pass only mutates the functions of its SCC.
+            if (const auto **C =
+                    llvm::any_cast<const LazyCallGraph::SCC *>(&IR)) {
+              for (const LazyCallGraph::Node &N : **C)
+                verifyFunctionAfterPass(N.getFunction(), P, DebugLogging);
+              return;
+            }
+            // After a module pass, re-verify only functions whose structural
+            // hash differs from the before-pass snapshot.
+            if (const Module **MPtr = llvm::any_cast<const Module *>(&IR)) {
+              for (const Function &F : **MPtr) {
+                if (F.isDeclaration())
+                  continue;
+                auto It = FunctionHashes.find(&F);
+                if (It != FunctionHashes.end() &&
+                    It->second == StructuralHash(F, /*DetailedHash=*/true))
+                  continue;
+                verifyFunctionAfterPass(F, P, DebugLogging);
+              }
+              return;
+            }
+          }
+
           const Module **MPtr = llvm::any_cast<const Module *>(&IR);
           const Module *M = MPtr ? *MPtr : nullptr;
           if (!M) {
@@ -1499,7 +1680,9 @@ void TimeProfilingPassesHandler::registerCallbacks(
       },
       true);
   PIC.registerAfterPassInvalidatedCallback(
-      [this](StringRef P, const PreservedAnalyses &) { this->runAfterPass(); },
+      [this](StringRef P, const PreservedAnalyses &) {
+        this->runAfterPassInvalidated();
+      },
       true);
   PIC.registerBeforeAnalysisCallback(
       [this](StringRef P, Any IR) { this->runBeforePass(P, IR); });
@@ -1508,10 +1691,25 @@ void TimeProfilingPassesHandler::registerCallbacks(
 }
 
 void TimeProfilingPassesHandler::runBeforePass(StringRef PassID, Any IR) {
-  timeTraceProfilerBegin(PassID, getIRName(IR));
+  timeTraceProfilerBegin(PassID, StringRef(""));
+  TimedIR.push_back(std::move(IR));
 }
 
-void TimeProfilingPassesHandler::runAfterPass() { timeTraceProfilerEnd(); }
+void TimeProfilingPassesHandler::runAfterPass() {
+  // Defer computing the IR name to the profiler: the detail callback only
+  // runs for sections that survive the granularity filter, which keeps the
+  // string formatting off the vast majority of pass and analysis runs.
+  Any IR = TimedIR.pop_back_val();
+  timeTraceProfilerEnd([&] { return getIRName(IR); });
+}
+
+void TimeProfilingPassesHandler::runAfterPassInvalidated() {
+  // The pass destroyed its IR unit (e.g. a loop pass deleting its loop), so
+  // the stored handle must not be dereferenced; end the section with no
+  // detail.
+  TimedIR.pop_back();
+  timeTraceProfilerEnd();
+}
 
 namespace {
 
@@ -2436,6 +2634,7 @@ void StandardInstrumentations::registerCallbacks(
   TimePasses.registerCallbacks(PIC);
   OptNone.registerCallbacks(PIC);
   OptPassGate.registerCallbacks(PIC);
+  PipelineGating.registerCallbacks(PIC);
   PrintChangedIR.registerCallbacks(PIC);
   PseudoProbeVerification.registerCallbacks(PIC);
   if (VerifyEach)
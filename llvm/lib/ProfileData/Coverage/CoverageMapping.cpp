@@ -26,6 +26,8 @@
 #include "llvm/Support/Error.h"
 #include "llvm/Support/ErrorHandling.h"
 #include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
 #include "llvm/Support/VirtualFileSystem.h"
 #include "llvm/Support/raw_ostream.h"
 #include <algorithm>
@@ -444,6 +446,11 @@ Error CoverageMapping::loadFromFile(
   SmallVector<std::unique_ptr<CoverageMappingReader>, 4> Readers;
   for (auto &Reader : CoverageReadersOrErr.get())
     Readers.push_back(std::move(Reader));
+  // Everything up to this point only touched per-file state and may run
+  // concurrently with the loads of other object files; merging the decoded
+  // records into the shared CoverageMapping (and the profile lookups that
+  // entails) must be serialized.
+  std::lock_guard<std::mutex> Lock(Coverage.LoadLock);
   if (FoundBinaryIDs && !Readers.empty()) {
     llvm::append_range(*FoundBinaryIDs,
                        llvm::map_range(BinaryIDs, [](object::BuildIDRef BID) {
@@ -476,11 +483,34 @@ Expected<std::unique_ptr<CoverageMapping>> CoverageMapping::load(
   };
 
   SmallVector<object::BuildID> FoundBinaryIDs;
-  for (const auto &File : llvm::enumerate(ObjectFilenames)) {
-    if (Error E =
-            loadFromFile(File.value(), GetArch(File.index()), CompilationDir,
-                         *ProfileReader, *Coverage, DataFound, &FoundBinaryIDs))
-      return std::move(E);
+  if (ObjectFilenames.size() < 2) {
+    for (const auto &File : llvm::enumerate(ObjectFilenames)) {
+      if (Error E = loadFromFile(File.value(), GetArch(File.index()),
+                                 CompilationDir, *ProfileReader, *Coverage,
+                                 DataFound, &FoundBinaryIDs))
+        return std::move(E);
+    }
+  } else {
+    // With many binaries, most of the load time is spent parsing objects and
+    // decoding their coverage sections, which is independent per file. Run
+    // the loads on a thread pool; loadFromFile serializes the final merge
+    // into the shared CoverageMapping internally.
+    ThreadPool Pool(heavyweight_hardware_concurrency());
+    std::mutex ErrorLock;
+    Error MergedErr = Error::success();
+    for (const auto &File : llvm::enumerate(ObjectFilenames)) {
+      Pool.async([&, Filename = File.value(), Arch = GetArch(File.index())] {
+        if (Error E = loadFromFile(Filename, Arch, CompilationDir,
+                                   *ProfileReader, *Coverage, DataFound,
+                                   &FoundBinaryIDs)) {
+          std::lock_guard<std::mutex> Lock(ErrorLock);
+          MergedErr = joinErrors(std::move(MergedErr), std::move(E));
+        }
+      });
+    }
+    Pool.wait();
+    if (MergedErr)
+      return std::move(MergedErr);
   }
 
   if (BIDFetcher) {
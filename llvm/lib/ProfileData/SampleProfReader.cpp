@@ -863,6 +863,11 @@ std::error_code SampleProfileReaderExtBinaryBase::readFuncProfiles() {
       }
     }
 
+    // Collect the profile slices to load before parsing any of them, so that
+    // the kernel can page the slices in (willNeedIfMmap below) while we
+    // parse, instead of faulting them in one at a time.
+    SmallVector<const uint8_t *, 0> FuncProfileAddrs;
+
     if (ProfileIsCS) {
       assert(useFuncOffsetList());
       DenseSet<uint64_t> FuncGuidsToUse;
@@ -900,9 +905,7 @@ std::error_code SampleProfileReaderExtBinaryBase::readFuncProfiles() {
             (CommonContext && CommonContext->IsPrefixOf(FContext))) {
           // Load profile for the current context which originated from
           // the common ancestor.
-          const uint8_t *FuncProfileAddr = Start + NameOffset.second;
-          if (std::error_code EC = readFuncProfile(FuncProfileAddr))
-            return EC;
+          FuncProfileAddrs.push_back(Start + NameOffset.second);
         }
       }
     } else if (useMD5()) {
@@ -912,9 +915,7 @@ std::error_code SampleProfileReaderExtBinaryBase::readFuncProfiles() {
         auto iter = FuncOffsetTable.find(GUID);
         if (iter == FuncOffsetTable.end())
           continue;
-        const uint8_t *FuncProfileAddr = Start + iter->second;
-        if (std::error_code EC = readFuncProfile(FuncProfileAddr))
-          return EC;
+        FuncProfileAddrs.push_back(Start + iter->second);
       }
     } else if (Remapper) {
       assert(useFuncOffsetList());
@@ -924,9 +925,7 @@ std::error_code SampleProfileReaderExtBinaryBase::readFuncProfiles() {
         StringRef FuncNameStr = FuncName.stringRef();
         if (!FuncsToUse.count(FuncNameStr) && !Remapper->exist(FuncNameStr))
           continue;
-        const uint8_t *FuncProfileAddr = Start + NameOffset.second;
-        if (std::error_code EC = readFuncProfile(FuncProfileAddr))
-          return EC;
+        FuncProfileAddrs.push_back(Start + NameOffset.second);
       }
     } else {
       assert(!useFuncOffsetList());
@@ -934,11 +933,37 @@ std::error_code SampleProfileReaderExtBinaryBase::readFuncProfiles() {
         auto iter = FuncOffsetTable.find(MD5Hash(Name));
         if (iter == FuncOffsetTable.end())
           continue;
-        const uint8_t *FuncProfileAddr = Start + iter->second;
-        if (std::error_code EC = readFuncProfile(FuncProfileAddr))
-          return EC;
+        FuncProfileAddrs.push_back(Start + iter->second);
+      }
+    }
+
+    // Ask the kernel to read ahead exactly the slices we are about to parse.
+    // The length of each slice is the distance to the next function profile
+    // in the section, computed from the sorted set of all offsets.
+    if (!FuncProfileAddrs.empty()) {
+      SmallVector<uint64_t, 0> AllOffsets;
+      if (useFuncOffsetList())
+        for (const auto &NameOffset : FuncOffsetList)
+          AllOffsets.push_back(NameOffset.second);
+      else
+        for (const auto &NameOffset : FuncOffsetTable)
+          AllOffsets.push_back(NameOffset.second);
+      llvm::sort(AllOffsets);
+      const uint8_t *BufStart =
+          reinterpret_cast<const uint8_t *>(Buffer->getBufferStart());
+      for (const uint8_t *FuncProfileAddr : FuncProfileAddrs) {
+        uint64_t Offset = FuncProfileAddr - Start;
+        auto NextIt = llvm::upper_bound(AllOffsets, Offset);
+        uint64_t EndOffset =
+            NextIt != AllOffsets.end() ? *NextIt : (uint64_t)(End - Start);
+        Buffer->willNeedIfMmap(FuncProfileAddr - BufStart, EndOffset - Offset);
       }
     }
+
+    for (const uint8_t *FuncProfileAddr : FuncProfileAddrs)
+      if (std::error_code EC = readFuncProfile(FuncProfileAddr))
+        return EC;
+
     Data = End;
   }
   assert((CSProfileCount == 0 || CSProfileCount == Profiles.size()) &&
@@ -24,6 +24,17 @@ static cl::opt<cl::boolOrDefault> EnableRemarksSection(
         "this is enabled for the following formats: yaml-strtab, bitstream."),
     cl::init(cl::BOU_UNSET), cl::Hidden);
 
+static cl::opt<unsigned> RemarkSampleRate(
+    "remarks-sample-rate", cl::init(1), cl::Hidden,
+    cl::desc("Once more than remarks-sample-threshold remarks with the same "
+             "name have been seen, keep only one out of every N further "
+             "occurrences. 1 keeps all remarks."));
+
+static cl::opt<unsigned> RemarkSampleThreshold(
+    "remarks-sample-threshold", cl::init(1024), cl::Hidden,
+    cl::desc("Number of remarks with the same name to emit before sampling "
+             "via remarks-sample-rate kicks in."));
+
 RemarkStreamer::RemarkStreamer(
     std::unique_ptr<remarks::RemarkSerializer> RemarkSerializer,
     std::optional<StringRef> FilenameIn)
@@ -48,6 +59,17 @@ bool RemarkStreamer::matchesFilter(StringRef Str) {
   return true;
 }
 
+bool RemarkStreamer::shouldSampleRemark(StringRef RemarkName) {
+  if (RemarkSampleRate <= 1)
+    return true;
+  uint64_t Count = RemarkCounts[RemarkName]++;
+  if (Count < RemarkSampleThreshold)
+    return true;
+  // Decimate deterministically rather than with a random draw so that
+  // identical builds produce identical remark files.
+  return (Count - RemarkSampleThreshold) % RemarkSampleRate == 0;
+}
+
 bool RemarkStreamer::needsSection() const {
   if (EnableRemarksSection == cl::BOU_TRUE)
     return true;
@@ -265,6 +265,20 @@ APInt &APInt::operator*=(const APInt &RHS) {
   return *this;
 }
 
+void APInt::mul(const APInt &LHS, const APInt &RHS, APInt &Result) {
+  assert(LHS.BitWidth == RHS.BitWidth && LHS.BitWidth == Result.BitWidth &&
+         "Bit widths must be the same");
+  if (LHS.isSingleWord()) {
+    Result.U.VAL = LHS.U.VAL * RHS.U.VAL;
+    Result.clearUnusedBits();
+    return;
+  }
+  assert(Result.U.pVal != LHS.U.pVal && Result.U.pVal != RHS.U.pVal &&
+         "Result must not alias an operand");
+  tcMultiply(Result.U.pVal, LHS.U.pVal, RHS.U.pVal, LHS.getNumWords());
+  Result.clearUnusedBits();
+}
+
 APInt& APInt::operator*=(uint64_t RHS) {
   if (isSingleWord()) {
     U.VAL *= RHS;
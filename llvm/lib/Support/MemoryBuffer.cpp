@@ -238,6 +238,12 @@ public:
   }
 
   void dontNeedIfMmap() override { MFR.dontNeed(); }
+
+  void adviseSequentialIfMmap() override { MFR.adviseSequential(); }
+
+  void willNeedIfMmap(size_t Offset, size_t Length) override {
+    MFR.willNeed(Offset, Length);
+  }
 };
 } // namespace
 
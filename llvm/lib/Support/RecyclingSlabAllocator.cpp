@@ -0,0 +1,157 @@
+//===- RecyclingSlabAllocator.cpp - Slab-recycling allocator --------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/RecyclingSlabAllocator.h"
+#include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/MathExtras.h"
+#include "llvm/Support/MemAlloc.h"
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <mutex>
+
+using namespace llvm;
+
+namespace {
+
+// Size classes are the powers of two in [MinSlabSize, MaxSlabSize].
+constexpr unsigned MinSizeLog2 = 12; // 4096
+constexpr unsigned MaxSizeLog2 = 24; // 16M
+constexpr unsigned NumSizeClasses = MaxSizeLog2 - MinSizeLog2 + 1;
+
+unsigned sizeClassFor(size_t Size) {
+  assert(SlabCache::isCacheableSize(Size) && "not a size-class size");
+  return Log2_64(Size) - MinSizeLog2;
+}
+
+// Cached slabs are chained through their first word.
+struct FreeSlab {
+  FreeSlab *Next;
+};
+
+// Per-thread front cache: one slab per size class. Most clients destroy a
+// bump allocator and immediately build a new one on the same thread, so a
+// single slot already captures the hot reuse pattern without any locking.
+thread_local FreeSlab *ThreadFrontCache[NumSizeClasses] = {};
+
+struct SlabCacheImpl {
+  std::mutex Mutex;
+  FreeSlab *FreeLists[NumSizeClasses] = {};
+  size_t CachedBytes = 0;
+  std::atomic<size_t> MaxCachedBytes{SlabCache::DefaultMaxCachedBytes};
+
+  ~SlabCacheImpl() { clear(); }
+
+  void *pop(size_t Size) {
+    unsigned Class = sizeClassFor(Size);
+    if (FreeSlab *Slab = ThreadFrontCache[Class]) {
+      ThreadFrontCache[Class] = nullptr;
+      return Slab;
+    }
+    std::lock_guard<std::mutex> Guard(Mutex);
+    FreeSlab *Slab = FreeLists[Class];
+    if (!Slab)
+      return nullptr;
+    FreeLists[Class] = Slab->Next;
+    CachedBytes -= Size;
+    return Slab;
+  }
+
+  bool push(void *Ptr, size_t Size) {
+    unsigned Class = sizeClassFor(Size);
+    FreeSlab *Slab = static_cast<FreeSlab *>(Ptr);
+    if (!ThreadFrontCache[Class]) {
+      ThreadFrontCache[Class] = Slab;
+      return true;
+    }
+    std::lock_guard<std::mutex> Guard(Mutex);
+    if (CachedBytes + Size > MaxCachedBytes.load(std::memory_order_relaxed))
+      return false;
+    Slab->Next = FreeLists[Class];
+    FreeLists[Class] = Slab;
+    CachedBytes += Size;
+    return true;
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> Guard(Mutex);
+    for (FreeSlab *&List : FreeLists) {
+      while (FreeSlab *Slab = List) {
+        List = Slab->Next;
+        std::free(Slab);
+      }
+    }
+    CachedBytes = 0;
+  }
+};
+
+ManagedStatic<SlabCacheImpl> ProcessSlabCache;
+
+} // end anonymous namespace
+
+SlabCache &SlabCache::getProcessCache() {
+  // SlabCache is a stateless facade over the managed-static implementation;
+  // hand out a singleton so callers have an object to configure.
+  static SlabCache Cache;
+  return Cache;
+}
+
+bool SlabCache::isCacheableSize(size_t Size) {
+  return Size >= MinSlabSize && Size <= MaxSlabSize && isPowerOf2_64(Size);
+}
+
+void *SlabCache::pop(size_t Size) { return ProcessSlabCache->pop(Size); }
+
+bool SlabCache::push(void *Ptr, size_t Size) {
+  return ProcessSlabCache->push(Ptr, Size);
+}
+
+void SlabCache::setMaxCachedBytes(size_t Bytes) {
+  ProcessSlabCache->MaxCachedBytes.store(Bytes, std::memory_order_relaxed);
+  std::lock_guard<std::mutex> Guard(ProcessSlabCache->Mutex);
+  for (FreeSlab *&List : ProcessSlabCache->FreeLists) {
+    size_t Size = SlabCache::MinSlabSize
+                  << (&List - ProcessSlabCache->FreeLists);
+    while (ProcessSlabCache->CachedBytes > Bytes && List) {
+      FreeSlab *Slab = List;
+      List = Slab->Next;
+      std::free(Slab);
+      ProcessSlabCache->CachedBytes -= Size;
+    }
+  }
+}
+
+size_t SlabCache::getCachedBytes() const {
+  std::lock_guard<std::mutex> Guard(ProcessSlabCache->Mutex);
+  return ProcessSlabCache->CachedBytes;
+}
+
+void SlabCache::clear() { ProcessSlabCache->clear(); }
+
+void *RecyclingSlabAllocator::Allocate(size_t Size, size_t Alignment) {
+  // Recycled slabs are malloc-aligned; larger alignment requests bypass the
+  // cache. BumpPtrAllocator aligns within the slab itself.
+  if (Alignment <= alignof(std::max_align_t) &&
+      SlabCache::isCacheableSize(Size)) {
+    if (void *Slab = SlabCache::getProcessCache().pop(Size))
+      return Slab;
+    return safe_malloc(Size);
+  }
+  return allocate_buffer(Size, Alignment);
+}
+
+void RecyclingSlabAllocator::Deallocate(const void *Ptr, size_t Size,
+                                        size_t Alignment) {
+  if (Alignment <= alignof(std::max_align_t) &&
+      SlabCache::isCacheableSize(Size)) {
+    if (!SlabCache::getProcessCache().push(const_cast<void *>(Ptr), Size))
+      std::free(const_cast<void *>(Ptr));
+    return;
+  }
+  deallocate_buffer(const_cast<void *>(Ptr), Size, Alignment);
+}
@@ -36,6 +36,25 @@ void SmallPtrSetImplBase::shrink_and_clear() {
   memset(CurArray, -1, CurArraySize*sizeof(void*));
 }
 
+void SmallPtrSetImplBase::reserve(size_type NumEntries) {
+  // In small mode the inline array is used as a simple vector, so it can hold
+  // CurArraySize elements regardless of load factor.
+  if (isSmall() && NumEntries <= CurArraySize)
+    return;
+
+  // In big mode we are done once NumEntries stays below the 3/4 load factor
+  // that insert_imp_big grows at.
+  if (!isSmall() && NumEntries * 4 < CurArraySize * 3)
+    return;
+
+  // Size the table the same way shrink_and_clear does: the next power of two
+  // at least twice NumEntries, with 32 buckets minimum.
+  unsigned NewSize = NumEntries > 16 ? 1 << (Log2_32_Ceil(NumEntries) + 1) : 32;
+  if (!isSmall() && NewSize <= CurArraySize)
+    return;
+  Grow(NewSize);
+}
+
 std::pair<const void *const *, bool>
 SmallPtrSetImplBase::insert_imp_big(const void *Ptr) {
   if (LLVM_UNLIKELY(size() * 4 >= CurArraySize * 3)) {
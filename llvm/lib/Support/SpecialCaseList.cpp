@@ -31,6 +31,14 @@ Error SpecialCaseList::Matcher::insert(StringRef Pattern, unsigned LineNumber,
                              Twine("Supplied ") +
                                  (UseGlobs ? "glob" : "regex") + " was blank");
 
+  // Patterns without metacharacters match exactly one string; store them for
+  // hash lookup instead of compiling and scanning a pattern per line.
+  if (Pattern.find_first_of(UseGlobs ? "*?[]{}\\" : "^$.|*+?()[]{}\\") ==
+      StringRef::npos) {
+    Strings.try_emplace(Pattern, LineNumber);
+    return Error::success();
+  }
+
   if (!UseGlobs) {
     // Replace * with .*
     auto Regexp = Pattern.str();
@@ -68,6 +76,8 @@ Error SpecialCaseList::Matcher::insert(StringRef Pattern, unsigned LineNumber,
 }
 
 unsigned SpecialCaseList::Matcher::match(StringRef Query) const {
+  if (auto It = Strings.find(Query); It != Strings.end())
+    return It->second;
   for (const auto &[Pattern, Pair] : Globs)
     if (Pair.first.match(Query))
       return Pair.second;
@@ -17,6 +17,8 @@
 #if LLVM_ENABLE_THREADS
 #include "llvm/Support/FormatVariadic.h"
 #include "llvm/Support/Threading.h"
+#include "llvm/Support/WorkStealingQueue.h"
+#include <random>
 #else
 #include "llvm/Support/raw_ostream.h"
 #endif
@@ -188,6 +190,159 @@ ThreadPool::~ThreadPool() {
     Worker.join();
 }
 
+//===----------------------------------------------------------------------===//
+// WorkStealingThreadPool
+//===----------------------------------------------------------------------===//
+
+// A queued task. Deques hold plain pointers because WorkStealingQueue
+// requires trivially copyable items.
+struct TaskNode {
+  std::function<void()> Fn;
+};
+
+struct WorkStealingThreadPool::WorkerState {
+  /// Owner-only LIFO deque; other workers steal FIFO from the top.
+  WorkStealingQueue<TaskNode *> Deque;
+
+  /// Inbox for submissions from threads that do not own the deque
+  /// (non-worker threads and affinity-routed tasks). Drained by the owner;
+  /// stolen from as a last resort.
+  std::mutex InboxLock;
+  std::deque<TaskNode *> Inbox;
+
+  TaskNode *takeFromInbox() {
+    std::lock_guard<std::mutex> Guard(InboxLock);
+    if (Inbox.empty())
+      return nullptr;
+    TaskNode *Node = Inbox.front();
+    Inbox.pop_front();
+    return Node;
+  }
+};
+
+WorkStealingThreadPool::WorkStealingThreadPool(ThreadPoolStrategy S)
+    : Strategy(S), ThreadCount(S.compute_thread_count()) {
+  Workers.reserve(ThreadCount);
+  for (unsigned I = 0; I < ThreadCount; ++I)
+    Workers.push_back(std::make_unique<WorkerState>());
+  Threads.reserve(ThreadCount);
+  for (unsigned I = 0; I < ThreadCount; ++I)
+    Threads.emplace_back([this, I] {
+      set_thread_name(formatv("llvm-ws-worker-{0}", I));
+      Strategy.apply_thread_strategy(I);
+      processTasksUntilShutdown(I);
+    });
+}
+
+// The ID of the worker owned by the current thread within its pool, if any.
+static LLVM_THREAD_LOCAL const WorkStealingThreadPool *CurrentPool = nullptr;
+static LLVM_THREAD_LOCAL unsigned CurrentWorkerID = 0;
+
+void WorkStealingThreadPool::enqueue(std::function<void()> Task,
+                                     unsigned AffinityHint) {
+  TaskNode *Node = new TaskNode{std::move(Task)};
+  OutstandingTasks.fetch_add(1, std::memory_order_relaxed);
+
+  if (AffinityHint == NoAffinity && CurrentPool == this) {
+    // Task spawned by a worker of this pool: keep it local, LIFO.
+    AvailableTasks.fetch_add(1, std::memory_order_relaxed);
+    Workers[CurrentWorkerID]->Deque.push(Node);
+  } else {
+    unsigned WorkerID =
+        AffinityHint != NoAffinity
+            ? AffinityHint % ThreadCount
+            : NextVictim.fetch_add(1, std::memory_order_relaxed) % ThreadCount;
+    WorkerState &W = *Workers[WorkerID];
+    {
+      std::lock_guard<std::mutex> Guard(W.InboxLock);
+      W.Inbox.push_back(Node);
+    }
+    AvailableTasks.fetch_add(1, std::memory_order_relaxed);
+  }
+  // Taking the lock orders the increment before any worker's sleep check.
+  {
+    std::lock_guard<std::mutex> Guard(SleepLock);
+  }
+  WakeCondition.notify_one();
+}
+
+void WorkStealingThreadPool::processTasksUntilShutdown(unsigned WorkerID) {
+  CurrentPool = this;
+  CurrentWorkerID = WorkerID;
+  WorkerState &Self = *Workers[WorkerID];
+  std::mt19937 Rng(WorkerID);
+
+  auto FindTask = [&]() -> TaskNode * {
+    // Local work first: own deque (LIFO), then own inbox.
+    if (std::optional<TaskNode *> Node = Self.Deque.pop())
+      return *Node;
+    if (TaskNode *Node = Self.takeFromInbox())
+      return Node;
+    // Steal from victims in random order: deques first, inboxes last.
+    unsigned Start = Rng();
+    for (unsigned I = 0; I < ThreadCount; ++I) {
+      WorkerState &Victim = *Workers[(Start + I) % ThreadCount];
+      if (&Victim == &Self)
+        continue;
+      if (std::optional<TaskNode *> Node = Victim.Deque.steal())
+        return *Node;
+    }
+    for (unsigned I = 0; I < ThreadCount; ++I) {
+      WorkerState &Victim = *Workers[(Start + I) % ThreadCount];
+      if (&Victim == &Self)
+        continue;
+      if (TaskNode *Node = Victim.takeFromInbox())
+        return Node;
+    }
+    return nullptr;
+  };
+
+  while (true) {
+    TaskNode *Node = FindTask();
+    if (!Node) {
+      std::unique_lock<std::mutex> LockGuard(SleepLock);
+      WakeCondition.wait(LockGuard, [&] {
+        return !EnableFlag ||
+               AvailableTasks.load(std::memory_order_relaxed) > 0;
+      });
+      if (!EnableFlag && AvailableTasks.load(std::memory_order_relaxed) == 0)
+        return;
+      continue;
+    }
+
+    AvailableTasks.fetch_sub(1, std::memory_order_relaxed);
+    Node->Fn();
+    delete Node;
+
+    if (OutstandingTasks.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      std::lock_guard<std::mutex> Guard(SleepLock);
+      CompletionCondition.notify_all();
+    }
+  }
+}
+
+void WorkStealingThreadPool::wait() {
+  assert(!isWorkerThread()); // Would deadlock waiting for itself.
+  std::unique_lock<std::mutex> LockGuard(SleepLock);
+  CompletionCondition.wait(LockGuard, [&] {
+    return OutstandingTasks.load(std::memory_order_acquire) == 0;
+  });
+}
+
+bool WorkStealingThreadPool::isWorkerThread() const {
+  return CurrentPool == this;
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+  {
+    std::lock_guard<std::mutex> Guard(SleepLock);
+    EnableFlag = false;
+  }
+  WakeCondition.notify_all();
+  for (auto &Worker : Threads)
+    Worker.join();
+}
+
 #else // LLVM_ENABLE_THREADS Disabled
 
 // No threads are launched, issue a warning if ThreadCount is not 0
@@ -220,4 +375,30 @@ bool ThreadPool::isWorkerThread() const {
 
 ThreadPool::~ThreadPool() { wait(); }
 
+// No threads are launched, issue a warning if ThreadCount is not 0
+WorkStealingThreadPool::WorkStealingThreadPool(ThreadPoolStrategy S)
+    : ThreadCount(1) {
+  int RequestedCount = S.compute_thread_count();
+  if (RequestedCount != 1) {
+    errs() << "Warning: request a WorkStealingThreadPool with "
+           << RequestedCount
+           << " threads, but LLVM_ENABLE_THREADS has been turned off\n";
+  }
+}
+
+void WorkStealingThreadPool::wait() {
+  // Sequential implementation running the tasks
+  while (!DeferredTasks.empty()) {
+    auto Task = std::move(DeferredTasks.front());
+    DeferredTasks.pop_front();
+    Task();
+  }
+}
+
+bool WorkStealingThreadPool::isWorkerThread() const {
+  report_fatal_error("LLVM compiled without multithreading");
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() { wait(); }
+
 #endif
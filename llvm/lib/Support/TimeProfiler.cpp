@@ -69,7 +69,7 @@ struct TimeTraceProfilerEntry {
   const TimePointType Start;
   TimePointType End;
   const std::string Name;
-  const std::string Detail;
+  std::string Detail;
 
   TimeTraceProfilerEntry(TimePointType &&S, TimePointType &&E, std::string &&N,
                          std::string &&Dt)
@@ -107,7 +107,13 @@ struct llvm::TimeTraceProfiler {
                        Detail());
   }
 
-  void end() {
+  void end() { end(nullptr); }
+
+  /// Closes the last open section, attaching a detail computed by \p Detail
+  /// if the section is long enough to be kept. Deferring the detail
+  /// computation to this point keeps its cost off sections that the
+  /// granularity filter discards anyway.
+  void end(llvm::function_ref<std::string()> Detail) {
     assert(!Stack.empty() && "Must call begin() first");
     TimeTraceProfilerEntry &E = Stack.back();
     E.End = ClockType::now();
@@ -123,8 +129,11 @@ struct llvm::TimeTraceProfiler {
     DurationType Duration = E.End - E.Start;
 
     // Only include sections longer or equal to TimeTraceGranularity msec.
-    if (duration_cast<microseconds>(Duration).count() >= TimeTraceGranularity)
+    if (duration_cast<microseconds>(Duration).count() >= TimeTraceGranularity) {
+      if (Detail)
+        E.Detail = Detail();
       Entries.emplace_back(E);
+    }
 
     // Track total time taken by each "name", but only the topmost levels of
     // them; e.g. if there's a template instantiation that instantiates other
@@ -357,3 +366,8 @@ void llvm::timeTraceProfilerEnd() {
   if (TimeTraceProfilerInstance != nullptr)
     TimeTraceProfilerInstance->end();
 }
+
+void llvm::timeTraceProfilerEnd(llvm::function_ref<std::string()> Detail) {
+  if (TimeTraceProfilerInstance != nullptr)
+    TimeTraceProfilerInstance->end(Detail);
+}
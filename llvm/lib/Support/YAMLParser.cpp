@@ -396,6 +396,10 @@ private:
   ///        Pos is considered a "safe" character for plain scalars.
   bool isPlainSafeNonBlank(StringRef::iterator Position);
 
+  /// Skip a maximal run of printable ASCII bytes that the byte-at-a-time
+  /// plain scalar loop would consume unconditionally, a block at a time.
+  StringRef::iterator skipPlainSafeAscii(StringRef::iterator Position);
+
   /// Return true if the line is a line break, false otherwise.
   bool isLineEmpty(StringRef Line);
 
@@ -1067,6 +1071,37 @@ bool Scanner::isPlainSafeNonBlank(StringRef::iterator Position) {
   return true;
 }
 
+StringRef::iterator Scanner::skipPlainSafeAscii(StringRef::iterator Position) {
+  // A byte is skippable here exactly when the byte-at-a-time loop in
+  // scanPlainScalar consumes it without lookahead: printable ASCII that is
+  // not a blank or break, not ':' (which needs one byte of lookahead), and
+  // not a flow indicator inside a flow collection. Everything else (multi-
+  // byte UTF-8 in particular) is left to the slow path.
+  const bool InFlow = FlowLevel != 0;
+  auto IsSafe = [InFlow](uint8_t C) {
+    if (C < 0x21 || C > 0x7E || C == ':')
+      return false;
+    if (InFlow &&
+        (C == ',' || C == '[' || C == ']' || C == '{' || C == '}'))
+      return false;
+    return true;
+  };
+
+  // Classify fixed-size blocks without early exits so the compiler can turn
+  // the byte checks into vector compares, then finish byte-wise.
+  while (End - Position >= 8) {
+    bool AllSafe = true;
+    for (unsigned I = 0; I != 8; ++I)
+      AllSafe &= IsSafe(Position[I]);
+    if (!AllSafe)
+      break;
+    Position += 8;
+  }
+  while (Position != End && IsSafe(*Position))
+    ++Position;
+  return Position;
+}
+
 bool Scanner::isLineEmpty(StringRef Line) {
   for (const auto *Position = Line.begin(); Position != Line.end(); ++Position)
     if (!isBlankOrBreak(Position))
@@ -1466,6 +1501,14 @@ bool Scanner::scanPlainScalar() {
     while (Current != End &&
            ((*Current != ':' && isPlainSafeNonBlank(Current)) ||
             (*Current == ':' && isPlainSafeNonBlank(Current + 1)))) {
+      // Bulk-skip runs of plain-safe printable ASCII, the common case by
+      // far. Each such byte is exactly one code point and one column wide.
+      StringRef::iterator Fast = skipPlainSafeAscii(Current);
+      if (Fast != Current) {
+        Column += Fast - Current;
+        Current = Fast;
+        continue;
+      }
       StringRef::iterator i = skip_nb_char(Current);
       if (i == Current)
         break;
@@ -37,6 +37,10 @@
 # include <unistd.h>
 #endif
 
+#if !defined(_WIN32)
+#include <sys/uio.h>
+#endif
+
 #if defined(__CYGWIN__)
 #include <io.h>
 #endif
@@ -216,6 +220,12 @@ raw_ostream &raw_ostream::operator<<(double N) {
   return *this;
 }
 
+void raw_ostream::write_vectored_impl(ArrayRef<StringRef> Buffers) {
+  for (StringRef B : Buffers)
+    if (!B.empty())
+      write_impl(B.data(), B.size());
+}
+
 void raw_ostream::flush_nonempty() {
   assert(OutBufCur > OutBufStart && "Invalid call to flush_nonempty.");
   size_t Length = OutBufCur - OutBufStart;
@@ -274,6 +284,20 @@ raw_ostream &raw_ostream::write(const char *Ptr, size_t Size) {
       return *this;
     }
 
+    // A payload at least as large as the buffer is going to be written out
+    // directly regardless; emit the buffered bytes and the payload as one
+    // vectored operation instead of staging part of it in the buffer first.
+    if (Size >= size_t(OutBufEnd - OutBufStart)) {
+      if (TiedStream)
+        TiedStream->flush();
+      size_t Length = OutBufCur - OutBufStart;
+      OutBufCur = OutBufStart;
+      StringRef Regions[2] = {StringRef(OutBufStart, Length),
+                              StringRef(Ptr, Size)};
+      write_vectored_impl(Regions);
+      return *this;
+    }
+
     // We don't have enough space in the buffer to fit the string in. Insert as
     // much as possible, flush and start over with the remainder.
     copy_to_buffer(Ptr, NumBytes);
@@ -805,6 +829,72 @@ void raw_fd_ostream::write_impl(const char *Ptr, size_t Size) {
   } while (Size > 0);
 }
 
+void raw_fd_ostream::write_vectored_impl(ArrayRef<StringRef> Buffers) {
+#if defined(_WIN32)
+  // Console re-encoding via WriteConsoleW does not compose with vectored
+  // emission; keep the sequential path.
+  raw_ostream::write_vectored_impl(Buffers);
+#else
+  assert(FD >= 0 && "File already closed.");
+
+  // See the comments in write_impl for the write size cap.
+  size_t MaxWriteSize = INT32_MAX;
+#if defined(__linux__)
+  MaxWriteSize = 1024 * 1024 * 1024;
+#endif
+
+  // Oversized regions need write_impl's chunking, and POSIX only guarantees
+  // 16 iovec entries per call; both are rare enough to take sequentially.
+  if (Buffers.size() > 16 || llvm::any_of(Buffers, [&](StringRef B) {
+        return B.size() > MaxWriteSize;
+      })) {
+    raw_ostream::write_vectored_impl(Buffers);
+    return;
+  }
+
+  SmallVector<struct iovec, 8> Iovs;
+  size_t Total = 0;
+  for (StringRef B : Buffers) {
+    if (B.empty())
+      continue;
+    Iovs.push_back({const_cast<char *>(B.data()), B.size()});
+    Total += B.size();
+  }
+  if (Iovs.empty())
+    return;
+  pos += Total;
+
+  size_t Idx = 0;
+  while (Idx != Iovs.size()) {
+    ssize_t ret = ::writev(FD, &Iovs[Idx], Iovs.size() - Idx);
+
+    if (ret < 0) {
+      // Match the recoverable-error handling in write_impl.
+      if (errno == EINTR || errno == EAGAIN
+#ifdef EWOULDBLOCK
+          || errno == EWOULDBLOCK
+#endif
+          )
+        continue;
+
+      error_detected(std::error_code(errno, std::generic_category()));
+      break;
+    }
+
+    // Consume fully written regions and trim a partially written one.
+    size_t Written = ret;
+    while (Idx != Iovs.size() && Written >= Iovs[Idx].iov_len) {
+      Written -= Iovs[Idx].iov_len;
+      ++Idx;
+    }
+    if (Written != 0) {
+      Iovs[Idx].iov_base = static_cast<char *>(Iovs[Idx].iov_base) + Written;
+      Iovs[Idx].iov_len -= Written;
+    }
+  }
+#endif
+}
+
 void raw_fd_ostream::close() {
   assert(ShouldClose);
   ShouldClose = false;
@@ -44,6 +44,20 @@
 
 #include <stdlib.h>
 
+// Pick a vectorized implementation of the long-input accumulate loop when the
+// target unconditionally provides the ISA. Runtime dispatch is intentionally
+// avoided; like the rest of Support, we only use what the build enables.
+#if !defined(XXH_FORCE_SCALAR)
+#if defined(__AVX2__)
+#define XXH_VECTOR_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) ||                                  \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define XXH_VECTOR_SSE2 1
+#include <emmintrin.h>
+#endif
+#endif
+
 using namespace llvm;
 using namespace support;
 
@@ -320,7 +334,7 @@ static uint64_t XXH3_len_129to240_64b(const uint8_t *input, size_t len,
   return XXH3_avalanche(acc);
 }
 
-LLVM_ATTRIBUTE_ALWAYS_INLINE
+LLVM_ATTRIBUTE_ALWAYS_INLINE LLVM_ATTRIBUTE_UNUSED
 static void XXH3_accumulate_512_scalar(uint64_t *acc, const uint8_t *input,
                                        const uint8_t *secret) {
   for (size_t i = 0; i < XXH_ACC_NB; ++i) {
@@ -331,15 +345,8 @@ static void XXH3_accumulate_512_scalar(uint64_t *acc, const uint8_t *input,
   }
 }
 
-LLVM_ATTRIBUTE_ALWAYS_INLINE
-static void XXH3_accumulate_scalar(uint64_t *acc, const uint8_t *input,
-                                   const uint8_t *secret, size_t nbStripes) {
-  for (size_t n = 0; n < nbStripes; ++n)
-    XXH3_accumulate_512_scalar(acc, input + n * XXH_STRIPE_LEN,
-                               secret + n * XXH_SECRET_CONSUME_RATE);
-}
-
-static void XXH3_scrambleAcc(uint64_t *acc, const uint8_t *secret) {
+LLVM_ATTRIBUTE_UNUSED
+static void XXH3_scrambleAcc_scalar(uint64_t *acc, const uint8_t *secret) {
   for (size_t i = 0; i < XXH_ACC_NB; ++i) {
     acc[i] ^= acc[i] >> 47;
     acc[i] ^= endian::read64le(secret + 8 * i);
@@ -347,6 +354,114 @@ static void XXH3_scrambleAcc(uint64_t *acc, const uint8_t *secret) {
   }
 }
 
+#if XXH_VECTOR_AVX2
+
+LLVM_ATTRIBUTE_ALWAYS_INLINE
+static void XXH3_accumulate_512_avx2(uint64_t *acc, const uint8_t *input,
+                                     const uint8_t *secret) {
+  for (size_t i = 0; i < XXH_STRIPE_LEN / sizeof(__m256i); ++i) {
+    __m256i data_vec =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(input) + i);
+    __m256i key_vec =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(secret) + i);
+    __m256i data_key = _mm256_xor_si256(data_vec, key_vec);
+    // (data_key & 0xffffffff) * (data_key >> 32) per 64-bit lane.
+    __m256i data_key_lo = _mm256_srli_epi64(data_key, 32);
+    __m256i product = _mm256_mul_epu32(data_key, data_key_lo);
+    // acc[i ^ 1] += data_val, expressed as a 32-bit lane swap.
+    __m256i data_swap =
+        _mm256_shuffle_epi32(data_vec, _MM_SHUFFLE(1, 0, 3, 2));
+    __m256i acc_vec =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc) + i);
+    acc_vec = _mm256_add_epi64(acc_vec, data_swap);
+    acc_vec = _mm256_add_epi64(acc_vec, product);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc) + i, acc_vec);
+  }
+}
+
+static void XXH3_scrambleAcc_avx2(uint64_t *acc, const uint8_t *secret) {
+  const __m256i prime32 = _mm256_set1_epi32(int(PRIME32_1));
+  for (size_t i = 0; i < XXH_STRIPE_LEN / sizeof(__m256i); ++i) {
+    __m256i acc_vec =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(acc) + i);
+    __m256i shifted = _mm256_srli_epi64(acc_vec, 47);
+    __m256i data_vec = _mm256_xor_si256(acc_vec, shifted);
+    __m256i key_vec =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(secret) + i);
+    __m256i data_key = _mm256_xor_si256(data_vec, key_vec);
+    // 64-bit multiply by the 32-bit PRIME32_1 via two 32x32 products.
+    __m256i data_key_hi = _mm256_srli_epi64(data_key, 32);
+    __m256i prod_lo = _mm256_mul_epu32(data_key, prime32);
+    __m256i prod_hi = _mm256_mul_epu32(data_key_hi, prime32);
+    acc_vec = _mm256_add_epi64(prod_lo, _mm256_slli_epi64(prod_hi, 32));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(acc) + i, acc_vec);
+  }
+}
+
+#define XXH3_accumulate_512 XXH3_accumulate_512_avx2
+#define XXH3_scrambleAcc XXH3_scrambleAcc_avx2
+
+#elif XXH_VECTOR_SSE2
+
+LLVM_ATTRIBUTE_ALWAYS_INLINE
+static void XXH3_accumulate_512_sse2(uint64_t *acc, const uint8_t *input,
+                                     const uint8_t *secret) {
+  for (size_t i = 0; i < XXH_STRIPE_LEN / sizeof(__m128i); ++i) {
+    __m128i data_vec =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(input) + i);
+    __m128i key_vec =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(secret) + i);
+    __m128i data_key = _mm_xor_si128(data_vec, key_vec);
+    // (data_key & 0xffffffff) * (data_key >> 32) per 64-bit lane.
+    __m128i data_key_lo = _mm_srli_epi64(data_key, 32);
+    __m128i product = _mm_mul_epu32(data_key, data_key_lo);
+    // acc[i ^ 1] += data_val, expressed as a 32-bit lane swap.
+    __m128i data_swap = _mm_shuffle_epi32(data_vec, _MM_SHUFFLE(1, 0, 3, 2));
+    __m128i acc_vec =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(acc) + i);
+    acc_vec = _mm_add_epi64(acc_vec, data_swap);
+    acc_vec = _mm_add_epi64(acc_vec, product);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(acc) + i, acc_vec);
+  }
+}
+
+static void XXH3_scrambleAcc_sse2(uint64_t *acc, const uint8_t *secret) {
+  const __m128i prime32 = _mm_set1_epi32(int(PRIME32_1));
+  for (size_t i = 0; i < XXH_STRIPE_LEN / sizeof(__m128i); ++i) {
+    __m128i acc_vec =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(acc) + i);
+    __m128i shifted = _mm_srli_epi64(acc_vec, 47);
+    __m128i data_vec = _mm_xor_si128(acc_vec, shifted);
+    __m128i key_vec =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(secret) + i);
+    __m128i data_key = _mm_xor_si128(data_vec, key_vec);
+    // 64-bit multiply by the 32-bit PRIME32_1 via two 32x32 products.
+    __m128i data_key_hi = _mm_srli_epi64(data_key, 32);
+    __m128i prod_lo = _mm_mul_epu32(data_key, prime32);
+    __m128i prod_hi = _mm_mul_epu32(data_key_hi, prime32);
+    acc_vec = _mm_add_epi64(prod_lo, _mm_slli_epi64(prod_hi, 32));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(acc) + i, acc_vec);
+  }
+}
+
+#define XXH3_accumulate_512 XXH3_accumulate_512_sse2
+#define XXH3_scrambleAcc XXH3_scrambleAcc_sse2
+
+#else
+
+#define XXH3_accumulate_512 XXH3_accumulate_512_scalar
+#define XXH3_scrambleAcc XXH3_scrambleAcc_scalar
+
+#endif
+
+LLVM_ATTRIBUTE_ALWAYS_INLINE
+static void XXH3_accumulate(uint64_t *acc, const uint8_t *input,
+                            const uint8_t *secret, size_t nbStripes) {
+  for (size_t n = 0; n < nbStripes; ++n)
+    XXH3_accumulate_512(acc, input + n * XXH_STRIPE_LEN,
+                        secret + n * XXH_SECRET_CONSUME_RATE);
+}
+
 static uint64_t XXH3_mix2Accs(const uint64_t *acc, const uint8_t *secret) {
   return XXH3_mul128_fold64(acc[0] ^ endian::read64le(secret),
                             acc[1] ^ endian::read64le(secret + 8));
@@ -372,21 +487,20 @@ static uint64_t XXH3_hashLong_64b(const uint8_t *input, size_t len,
       PRIME64_4, PRIME32_2, PRIME64_5, PRIME32_1,
   };
   for (size_t n = 0; n < nb_blocks; ++n) {
-    XXH3_accumulate_scalar(acc, input + n * block_len, secret,
-                           nbStripesPerBlock);
+    XXH3_accumulate(acc, input + n * block_len, secret, nbStripesPerBlock);
     XXH3_scrambleAcc(acc, secret + secretSize - XXH_STRIPE_LEN);
   }
 
   /* last partial block */
   const size_t nbStripes = (len - 1 - (block_len * nb_blocks)) / XXH_STRIPE_LEN;
   assert(nbStripes <= secretSize / XXH_SECRET_CONSUME_RATE);
-  XXH3_accumulate_scalar(acc, input + nb_blocks * block_len, secret, nbStripes);
+  XXH3_accumulate(acc, input + nb_blocks * block_len, secret, nbStripes);
 
   /* last stripe */
   constexpr size_t XXH_SECRET_LASTACC_START = 7;
-  XXH3_accumulate_512_scalar(acc, input + len - XXH_STRIPE_LEN,
-                             secret + secretSize - XXH_STRIPE_LEN -
-                                 XXH_SECRET_LASTACC_START);
+  XXH3_accumulate_512(acc, input + len - XXH_STRIPE_LEN,
+                      secret + secretSize - XXH_STRIPE_LEN -
+                          XXH_SECRET_LASTACC_START);
 
   /* converge into final hash */
   constexpr size_t XXH_SECRET_MERGEACCS_START = 11;
@@ -405,3 +519,34 @@ uint64_t llvm::xxh3_64bits(ArrayRef<uint8_t> data) {
     return XXH3_len_129to240_64b(in, len, kSecret, 0);
   return XXH3_hashLong_64b(in, len, kSecret, sizeof(kSecret));
 }
+
+void llvm::xxh3_64bits_batch(ArrayRef<ArrayRef<uint8_t>> data,
+                             MutableArrayRef<uint64_t> results) {
+  assert(data.size() == results.size() && "one result slot per input");
+  for (size_t i = 0, e = data.size(); i != e; ++i) {
+    // Overlap the page-in/cache-miss latency of the next key with hashing
+    // the current one; batch callers typically stream over cold data.
+    if (LLVM_LIKELY(i + 1 != e))
+      LLVM_PREFETCH(data[i + 1].data(), 0, 3);
+    results[i] = xxh3_64bits(data[i]);
+  }
+}
+
+void llvm::xxh3_64bits_batch(ArrayRef<StringRef> data,
+                             MutableArrayRef<uint64_t> results) {
+  assert(data.size() == results.size() && "one result slot per input");
+  for (size_t i = 0, e = data.size(); i != e; ++i) {
+    if (LLVM_LIKELY(i + 1 != e))
+      LLVM_PREFETCH(data[i + 1].data(), 0, 3);
+    results[i] = xxh3_64bits(data[i]);
+  }
+}
+
+void llvm::xxh3_64bits_batch(ArrayRef<uint8_t> data, size_t stride,
+                             MutableArrayRef<uint64_t> results) {
+  assert(stride != 0 && data.size() % stride == 0 &&
+         data.size() / stride == results.size() &&
+         "data must be a whole number of stride-sized records");
+  for (size_t i = 0, e = results.size(); i != e; ++i)
+    results[i] = xxh3_64bits(data.slice(i * stride, stride));
+}
@@ -29,6 +29,7 @@
 #include "llvm/IR/IRBuilder.h"
 #include "llvm/IR/InstIterator.h"
 #include "llvm/IR/IntrinsicInst.h"
+#include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/OptimizedStructLayout.h"
@@ -47,6 +48,17 @@ using namespace llvm;
 // "coro-frame", which results in leaner debug spew.
 #define DEBUG_TYPE "coro-suspend-crossing"
 
+static cl::opt<bool> CoroAlignPacking(
+    "coro-frame-align-packing", cl::Hidden, cl::init(true),
+    cl::desc("Allow allocas with disjoint live ranges to share a frame slot "
+             "even when the more aligned one is smaller, raising the slot "
+             "alignment as needed."));
+
+static cl::opt<bool> CoroFrameReport(
+    "coro-frame-report", cl::Hidden, cl::init(false),
+    cl::desc("Report per-coroutine frame sizes and the bytes saved by "
+             "overlapping frame slots."));
+
 enum { SmallVectorThreshold = 32 };
 
 // Provides two way mapping between the blocks and numbers.
@@ -603,15 +615,23 @@ private:
   SmallVector<Field, 8> Fields;
   DenseMap<Value*, unsigned> FieldIndexByKey;
 
+  // Bookkeeping for -coro-frame-report: how many allocas were packed into
+  // shared slots, and how many bytes the sharing saved.
+  unsigned PackedAllocas = 0;
+  unsigned PackedSlots = 0;
+  uint64_t PackedSavedBytes = 0;
+
 public:
   FrameTypeBuilder(LLVMContext &Context, const DataLayout &DL,
                    std::optional<Align> MaxFrameAlignment)
       : DL(DL), Context(Context), MaxFrameAlignment(MaxFrameAlignment) {}
 
   /// Add a field to this structure for the storage of an `alloca`
-  /// instruction.
+  /// instruction. When several allocas share the slot, \p OverrideAlign
+  /// carries the maximum alignment over all of them.
   [[nodiscard]] FieldIDType addFieldForAlloca(AllocaInst *AI,
-                                              bool IsHeader = false) {
+                                              bool IsHeader = false,
+                                              MaybeAlign OverrideAlign = {}) {
     Type *Ty = AI->getAllocatedType();
 
     // Make an array type if this is a static array allocation.
@@ -622,7 +642,8 @@ public:
         report_fatal_error("Coroutines cannot handle non static allocas yet");
     }
 
-    return addField(Ty, AI->getAlign(), IsHeader);
+    return addField(Ty, OverrideAlign ? *OverrideAlign : AI->getAlign(),
+                    IsHeader);
   }
 
   /// We want to put the allocas whose lifetime-ranges are not overlapped
@@ -730,6 +751,10 @@ public:
     assert(IsFinished && "not yet finished!");
     return Fields[Id];
   }
+
+  unsigned getPackedAllocas() const { return PackedAllocas; }
+  unsigned getPackedSlots() const { return PackedSlots; }
+  uint64_t getPackedSavedBytes() const { return PackedSavedBytes; }
 };
 } // namespace
 
@@ -763,9 +788,22 @@ void FrameTypeBuilder::addFieldForAllocas(const Function &F,
   auto AddFieldForAllocasAtExit = make_scope_exit([&]() {
     for (auto AllocaList : NonOverlapedAllocas) {
       auto *LargestAI = *AllocaList.begin();
-      FieldIDType Id = addFieldForAlloca(LargestAI);
+      // The slot has to satisfy every member, so align it to the most
+      // aligned one.
+      Align SlotAlign = LargestAI->getAlign();
+      for (auto *Alloca : AllocaList)
+        SlotAlign = std::max(SlotAlign, Alloca->getAlign());
+      FieldIDType Id =
+          addFieldForAlloca(LargestAI, /*IsHeader=*/false, SlotAlign);
       for (auto *Alloca : AllocaList)
         FrameData.setFieldIndex(Alloca, Id);
+      if (AllocaList.size() > 1) {
+        ++PackedSlots;
+        PackedAllocas += AllocaList.size();
+        for (auto *Alloca : drop_begin(AllocaList))
+          PackedSavedBytes +=
+              Alloca->getAllocationSize(DL)->getFixedValue();
+      }
     }
   });
 
@@ -823,9 +861,14 @@ void FrameTypeBuilder::addFieldForAllocas(const Function &F,
   // Put larger allocas in the front. So the larger allocas have higher
   // priority to merge, which can save more space potentially. Also each
   // AllocaSet would be ordered. So we can get the largest Alloca in one
-  // AllocaSet easily.
+  // AllocaSet easily. Among allocas of one size, prefer the more aligned
+  // ones as slot representatives so later members rarely raise the slot
+  // alignment.
   sort(FrameData.Allocas, [&](const auto &Iter1, const auto &Iter2) {
-    return GetAllocaSize(Iter1) > GetAllocaSize(Iter2);
+    uint64_t Size1 = GetAllocaSize(Iter1), Size2 = GetAllocaSize(Iter2);
+    if (Size1 != Size2)
+      return Size1 > Size2;
+    return Iter1.Alloca->getAlign() > Iter2.Alloca->getAlign();
   });
   for (const auto &A : FrameData.Allocas) {
     AllocaInst *Alloca = A.Alloca;
@@ -839,12 +882,11 @@ void FrameTypeBuilder::addFieldForAllocas(const Function &F,
         return IsAllocaInferenre(Alloca, Iter);
       });
       // If the alignment of A is multiple of the alignment of B, the address
-      // of A should satisfy the requirement for aligning for B.
-      //
-      // There may be other more fine-grained strategies to handle the alignment
-      // infomation during the merging process. But it seems hard to handle
-      // these strategies and benefit little.
-      bool Alignable = [&]() -> bool {
+      // of A should satisfy the requirement for aligning for B. With
+      // -coro-frame-align-packing (the default) this is not a constraint at
+      // all: every member lives at the start of the slot, so a more aligned
+      // member just raises the slot alignment when the field is added.
+      bool Alignable = CoroAlignPacking || [&]() -> bool {
         auto *LargestAlloca = *AllocaSet.begin();
         return LargestAlloca->getAlign().value() % Alloca->getAlign().value() ==
                0;
@@ -1386,6 +1428,13 @@ static StructType *buildFrameType(Function &F, coro::Shape &Shape,
   }
   }
 
+  if (CoroFrameReport)
+    errs() << "coro-frame: " << F.getName() << ": frame size "
+           << Shape.FrameSize << ", align " << Shape.FrameAlign.value()
+           << ", packed " << B.getPackedAllocas() << " allocas into "
+           << B.getPackedSlots() << " shared slots, saving "
+           << B.getPackedSavedBytes() << " bytes\n";
+
   return FrameTy;
 }
 
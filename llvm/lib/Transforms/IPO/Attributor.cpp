@@ -45,6 +45,7 @@
 #include "llvm/Support/DebugCounter.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/GraphWriter.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/ModRef.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/Utils/BasicBlockUtils.h"
@@ -95,6 +96,12 @@ static cl::opt<unsigned>
                           cl::desc("Maximal number of fixpoint iterations."),
                           cl::init(32));
 
+static cl::opt<bool> AutoTuneFixpointIterations(
+    "attributor-auto-tune-max-iterations", cl::Hidden, cl::init(false),
+    cl::desc("Derive the maximal number of fixpoint iterations from the "
+             "number of seeded abstract attributes instead of using the "
+             "fixed -attributor-max-iterations budget."));
+
 static cl::opt<unsigned>
     MaxSpecializationPerCB("attributor-max-specializations-per-call-base",
                            cl::Hidden,
@@ -2125,10 +2132,26 @@ void Attributor::runTillFixpoint() {
   // Now that all abstract attributes are collected and initialized we start
   // the abstract analysis.
 
+  // A note on parallelizing this loop: updateAA is not a pure evaluation over
+  // the dependence graph. Updates create new abstract attributes on demand
+  // (getOrCreateAAFor), register dependences as they are discovered, and read
+  // shared Attributor state, so even weakly-connected components of AADepGraph
+  // do not stay disjoint across an iteration. Shard-parallel updates would
+  // race on the AA map and the dependence lists.
+
   unsigned IterationCounter = 1;
   unsigned MaxIterations =
       Configuration.MaxFixpointIterations.value_or(SetFixpointIterations);
 
+  // With auto-tuning, scale the iteration budget with the size of the seeded
+  // dependence graph: information travels one dependence edge per iteration,
+  // and the longest chains grow with the module rather than with a constant.
+  // An explicit budget, from the configuration or the command line, wins.
+  if (AutoTuneFixpointIterations && !Configuration.MaxFixpointIterations &&
+      !SetFixpointIterations.getNumOccurrences())
+    MaxIterations = std::max<unsigned>(
+        16, 4 * Log2_64_Ceil(DG.SyntheticRoot.Deps.size() + 1));
+
   SmallVector<AbstractAttribute *, 32> ChangedAAs;
   SetVector<AbstractAttribute *> Worklist, InvalidAAs;
   Worklist.insert(DG.SyntheticRoot.begin(), DG.SyntheticRoot.end());
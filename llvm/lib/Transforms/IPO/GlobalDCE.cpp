@@ -22,6 +22,7 @@
 #include "llvm/IR/IntrinsicInst.h"
 #include "llvm/IR/Module.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Parallel.h"
 #include "llvm/Transforms/IPO.h"
 #include "llvm/Transforms/Utils/CtorUtils.h"
 #include "llvm/Transforms/Utils/GlobalStatus.h"
@@ -34,6 +35,14 @@ static cl::opt<bool>
     ClEnableVFE("enable-vfe", cl::Hidden, cl::init(true),
                 cl::desc("Enable virtual function elimination"));
 
+// Building the dependency graph only reads use-lists and constants, so
+// independent globals can be scanned on the thread pool; the results are
+// committed serially. Off by default: GlobalDCE commonly runs inside ThinLTO
+// backends that are already parallel at module granularity.
+static cl::opt<bool> ClParallelDeps(
+    "globaldce-parallel-deps", cl::Hidden, cl::init(false),
+    cl::desc("Build the global dependency graph in parallel"));
+
 STATISTIC(NumAliases  , "Number of global aliases removed");
 STATISTIC(NumFunctions, "Number of functions removed");
 STATISTIC(NumIFuncs,    "Number of indirect functions removed");
@@ -59,6 +68,7 @@ static bool isEmptyFunction(Function *F) {
 /// Compute the set of GlobalValue that depends from V.
 /// The recursion stops as soon as a GlobalValue is met.
 void GlobalDCEPass::ComputeDependencies(Value *V,
+                                        ConstantDependenciesCacheTy &Cache,
                                         SmallPtrSetImpl<GlobalValue *> &Deps) {
   if (auto *I = dyn_cast<Instruction>(V)) {
     Function *Parent = I->getParent()->getParent();
@@ -67,24 +77,34 @@ void GlobalDCEPass::ComputeDependencies(Value *V,
     Deps.insert(GV);
   } else if (auto *CE = dyn_cast<Constant>(V)) {
     // Avoid walking the whole tree of a big ConstantExprs multiple times.
-    auto Where = ConstantDependenciesCache.find(CE);
-    if (Where != ConstantDependenciesCache.end()) {
+    auto Where = Cache.find(CE);
+    if (Where != Cache.end()) {
       auto const &K = Where->second;
       Deps.insert(K.begin(), K.end());
     } else {
-      SmallPtrSetImpl<GlobalValue *> &LocalDeps = ConstantDependenciesCache[CE];
+      SmallPtrSetImpl<GlobalValue *> &LocalDeps = Cache[CE];
       for (User *CEUser : CE->users())
-        ComputeDependencies(CEUser, LocalDeps);
+        ComputeDependencies(CEUser, Cache, LocalDeps);
       Deps.insert(LocalDeps.begin(), LocalDeps.end());
     }
   }
 }
 
-void GlobalDCEPass::UpdateGVDependencies(GlobalValue &GV) {
-  SmallPtrSet<GlobalValue *, 8> Deps;
+/// Collect the set of globals directly depending on GV. Only reads use-lists
+/// and constants, so it is safe to run for distinct globals concurrently as
+/// long as each caller owns its \p Cache.
+void GlobalDCEPass::ComputeGVDependencies(GlobalValue &GV,
+                                          ConstantDependenciesCacheTy &Cache,
+                                          SmallPtrSetImpl<GlobalValue *> &Deps) {
   for (User *User : GV.users())
-    ComputeDependencies(User, Deps);
+    ComputeDependencies(User, Cache, Deps);
   Deps.erase(&GV); // Remove self-reference.
+}
+
+/// Record the reverse edges for GV's dependencies. Mutates GVDependencies,
+/// so this part stays single-threaded.
+void GlobalDCEPass::CommitGVDependencies(
+    GlobalValue &GV, const SmallPtrSetImpl<GlobalValue *> &Deps) {
   for (GlobalValue *GVU : Deps) {
     // If this is a dep from a vtable to a virtual function, and we have
     // complete information about all virtual call sites which could call
@@ -99,6 +119,12 @@ void GlobalDCEPass::UpdateGVDependencies(GlobalValue &GV) {
   }
 }
 
+void GlobalDCEPass::UpdateGVDependencies(GlobalValue &GV) {
+  SmallPtrSet<GlobalValue *, 8> Deps;
+  ComputeGVDependencies(GV, ConstantDependenciesCache, Deps);
+  CommitGVDependencies(GV, Deps);
+}
+
 /// Mark Global value as Live
 void GlobalDCEPass::MarkLive(GlobalValue &GV,
                              SmallVectorImpl<GlobalValue *> *Updates) {
@@ -277,6 +303,9 @@ PreservedAnalyses GlobalDCEPass::run(Module &M, ModuleAnalysisManager &MAM) {
   AddVirtualFunctionDependencies(M);
 
   // Loop over the module, adding globals which are obviously necessary.
+  // Dropping dead constant users mutates use-lists, so it has to happen
+  // before the (possibly parallel) dependency scan below.
+  SmallVector<GlobalValue *, 0> AllGlobals;
   for (GlobalObject &GO : M.global_objects()) {
     GO.removeDeadConstantUsers();
     // Functions with external linkage are needed if they have a body.
@@ -286,27 +315,53 @@ PreservedAnalyses GlobalDCEPass::run(Module &M, ModuleAnalysisManager &MAM) {
       if (!GO.isDiscardableIfUnused())
         MarkLive(GO);
 
-    UpdateGVDependencies(GO);
+    AllGlobals.push_back(&GO);
   }
 
-  // Compute direct dependencies of aliases.
+  // Collect aliases.
   for (GlobalAlias &GA : M.aliases()) {
     GA.removeDeadConstantUsers();
     // Externally visible aliases are needed.
     if (!GA.isDiscardableIfUnused())
       MarkLive(GA);
 
-    UpdateGVDependencies(GA);
+    AllGlobals.push_back(&GA);
   }
 
-  // Compute direct dependencies of ifuncs.
+  // Collect ifuncs.
   for (GlobalIFunc &GIF : M.ifuncs()) {
     GIF.removeDeadConstantUsers();
     // Externally visible ifuncs are needed.
     if (!GIF.isDiscardableIfUnused())
       MarkLive(GIF);
 
-    UpdateGVDependencies(GIF);
+    AllGlobals.push_back(&GIF);
+  }
+
+  // Compute the direct dependencies of every global.
+  if (!ClParallelDeps) {
+    for (GlobalValue *GV : AllGlobals)
+      UpdateGVDependencies(*GV);
+  } else {
+    // Scan contiguous chunks of globals on the thread pool, each chunk with
+    // its own constant-dependency cache, then commit the per-global results
+    // in module order on this thread.
+    constexpr size_t ChunkSize = 1024;
+    const size_t NumChunks = (AllGlobals.size() + ChunkSize - 1) / ChunkSize;
+    std::vector<std::vector<SmallPtrSet<GlobalValue *, 8>>> ChunkDeps(
+        NumChunks);
+    parallelFor(0, NumChunks, [&](size_t Chunk) {
+      ConstantDependenciesCacheTy Cache;
+      const size_t Begin = Chunk * ChunkSize;
+      const size_t End = std::min(AllGlobals.size(), Begin + ChunkSize);
+      auto &Deps = ChunkDeps[Chunk];
+      Deps.resize(End - Begin);
+      for (size_t I = Begin; I != End; ++I)
+        ComputeGVDependencies(*AllGlobals[I], Cache, Deps[I - Begin]);
+    });
+    for (size_t I = 0, E = AllGlobals.size(); I != E; ++I)
+      CommitGVDependencies(*AllGlobals[I],
+                           ChunkDeps[I / ChunkSize][I % ChunkSize]);
   }
 
   // Propagate liveness from collected Global Values through the computed
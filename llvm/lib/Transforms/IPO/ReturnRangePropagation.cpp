@@ -0,0 +1,158 @@
+//===- ReturnRangePropagation.cpp - Propagate return ranges ---------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// This pass computes a compact side table of per-function return-value ranges
+// and materializes it as !range metadata on direct call sites. Summaries are
+// computed bottom-up over the lazy call graph so a callee's summary can
+// sharpen its callers'; functions in multi-node SCCs are still summarized,
+// just without the benefit of their mutually recursive callees' results.
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Transforms/IPO/ReturnRangePropagation.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/Statistic.h"
+#include "llvm/Analysis/LazyCallGraph.h"
+#include "llvm/Analysis/ValueTracking.h"
+#include "llvm/IR/ConstantRange.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/MDBuilder.h"
+#include "llvm/IR/Module.h"
+
+using namespace llvm;
+
+#define DEBUG_TYPE "return-range-propagation"
+
+STATISTIC(NumSummarized,
+          "Number of functions with a non-trivial return range summary");
+STATISTIC(NumRangesAttached,
+          "Number of call sites annotated with a return range");
+
+namespace {
+
+class ReturnRangePropagator {
+public:
+  bool run(Module &M, LazyCallGraph &CG);
+
+private:
+  /// Return range summaries; only functions with a range strictly smaller
+  /// than the full set of their return type are present.
+  DenseMap<const Function *, ConstantRange> Summaries;
+
+  void summarize(Function &F);
+  bool annotateCallSites(Function &F);
+};
+
+} // end anonymous namespace
+
+/// Compute the union of the ranges of all returned values of \p F, refined by
+/// the summaries of already-visited callees, and record it if non-trivial.
+void ReturnRangePropagator::summarize(Function &F) {
+  // Only exact definitions can be summarized: an interposed definition may
+  // return anything.
+  if (!F.hasExactDefinition())
+    return;
+  auto *RetTy = dyn_cast<IntegerType>(F.getReturnType());
+  if (!RetTy)
+    return;
+
+  ConstantRange Range = ConstantRange::getEmpty(RetTy->getBitWidth());
+  for (BasicBlock &BB : F) {
+    auto *RI = dyn_cast<ReturnInst>(BB.getTerminator());
+    if (!RI)
+      continue;
+    Value *RV = RI->getReturnValue();
+    ConstantRange RetRange =
+        computeConstantRange(RV, /*ForSigned=*/false, /*UseInstrInfo=*/true);
+    // A value returned straight through from a summarized callee inherits the
+    // callee's summary.
+    if (auto *CB = dyn_cast<CallBase>(RV))
+      if (const Function *Callee = CB->getCalledFunction()) {
+        auto It = Summaries.find(Callee);
+        if (It != Summaries.end())
+          RetRange = RetRange.intersectWith(It->second);
+      }
+    Range = Range.unionWith(RetRange);
+    if (Range.isFullSet())
+      return;
+  }
+
+  // A function with no reachable return has nothing useful to say about its
+  // (never produced) return value.
+  if (Range.isEmptySet())
+    return;
+
+  Summaries.try_emplace(&F, Range);
+  ++NumSummarized;
+}
+
+/// Attach !range metadata to direct calls of summarized functions in \p F.
+bool ReturnRangePropagator::annotateCallSites(Function &F) {
+  bool Changed = false;
+  MDBuilder MDB(F.getContext());
+  for (BasicBlock &BB : F)
+    for (Instruction &I : BB) {
+      auto *CB = dyn_cast<CallBase>(&I);
+      if (!CB)
+        continue;
+      const Function *Callee = CB->getCalledFunction();
+      if (!Callee || CB->getType() != Callee->getReturnType())
+        continue;
+      auto It = Summaries.find(Callee);
+      if (It == Summaries.end())
+        continue;
+
+      ConstantRange Range = It->second;
+      if (MDNode *Existing = CB->getMetadata(LLVMContext::MD_range)) {
+        Range = Range.intersectWith(getConstantRangeFromMetadata(*Existing));
+        // Don't manufacture a contradiction or rewrite equivalent metadata;
+        // an empty intersection means the call is dead anyway.
+        if (Range.isEmptySet() ||
+            Range == getConstantRangeFromMetadata(*Existing))
+          continue;
+      }
+
+      CB->setMetadata(LLVMContext::MD_range,
+                      MDB.createRange(Range.getLower(), Range.getUpper()));
+      ++NumRangesAttached;
+      Changed = true;
+    }
+  return Changed;
+}
+
+bool ReturnRangePropagator::run(Module &M, LazyCallGraph &CG) {
+  // Summarize bottom-up so callee summaries are available to callers. SCCs
+  // with several functions are visited in some order within their RefSCC;
+  // missing summaries only cost precision, never soundness.
+  CG.buildRefSCCs();
+  for (LazyCallGraph::RefSCC &RC : CG.postorder_ref_sccs())
+    for (LazyCallGraph::SCC &C : RC)
+      for (LazyCallGraph::Node &N : C)
+        summarize(N.getFunction());
+
+  if (Summaries.empty())
+    return false;
+
+  bool Changed = false;
+  for (Function &F : M)
+    if (!F.isDeclaration())
+      Changed |= annotateCallSites(F);
+  return Changed;
+}
+
+PreservedAnalyses ReturnRangePropagationPass::run(Module &M,
+                                                  ModuleAnalysisManager &AM) {
+  LazyCallGraph &CG = AM.getResult<LazyCallGraphAnalysis>(M);
+  if (!ReturnRangePropagator().run(M, CG))
+    return PreservedAnalyses::all();
+
+  PreservedAnalyses PA;
+  PA.preserveSet<CFGAnalyses>();
+  return PA;
+}
@@ -39,6 +39,7 @@
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/Statistic.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/Analysis/AliasAnalysis.h"
 #include "llvm/Analysis/AssumptionCache.h"
 #include "llvm/Analysis/BasicAliasAnalysis.h"
@@ -92,13 +93,17 @@
 #include "llvm/Support/Debug.h"
 #include "llvm/Support/DebugCounter.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/KnownBits.h"
+#include "llvm/Support/ManagedStatic.h"
+#include "llvm/Support/Mutex.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/InstCombine/InstCombine.h"
 #include "llvm/Transforms/Utils/BasicBlockUtils.h"
 #include "llvm/Transforms/Utils/Local.h"
 #include <algorithm>
 #include <cassert>
+#include <cinttypes>
 #include <cstdint>
 #include <memory>
 #include <optional>
@@ -152,6 +157,47 @@ MaxArraySize("instcombine-maxarray-size", cl::init(1024),
 static cl::opt<unsigned> ShouldLowerDbgDeclare("instcombine-lower-dbg-declare",
                                                cl::Hidden, cl::init(true));
 
+static cl::opt<bool> InstCombineOpcodeStats(
+    "instcombine-opcode-stats", cl::Hidden,
+    cl::desc("Collect per-opcode visit and fold counts across the whole "
+             "process and print them on shutdown"));
+
+namespace {
+/// Process-wide visit/fold counts per instruction opcode, collected under
+/// -instcombine-opcode-stats. Printed when llvm_shutdown() destroys the
+/// collector. The visit counts show where pattern matching time goes; the
+/// fold counts show which of it pays off.
+struct OpcodeStatsCollector {
+  sys::SmartMutex<true> Lock;
+  StringMap<std::pair<uint64_t, uint64_t>> Counts;
+
+  void record(StringRef Opcode, bool Folded) {
+    sys::SmartScopedLock<true> Guard(Lock);
+    auto &VisitsFolds = Counts[Opcode];
+    ++VisitsFolds.first;
+    VisitsFolds.second += Folded;
+  }
+
+  ~OpcodeStatsCollector() {
+    if (Counts.empty())
+      return;
+    std::vector<StringMapConstIterator<std::pair<uint64_t, uint64_t>>> Rows;
+    for (auto It = Counts.begin(), E = Counts.end(); It != E; ++It)
+      Rows.push_back(It);
+    llvm::sort(Rows, [](const auto &LHS, const auto &RHS) {
+      return LHS->second.first > RHS->second.first;
+    });
+    errs() << "InstCombine visits and folds per opcode:\n";
+    for (const auto &Row : Rows)
+      errs() << format("  %-16s %12" PRIu64 " visits %12" PRIu64 " folds\n",
+                       Row->getKey().str().c_str(), Row->second.first,
+                       Row->second.second);
+  }
+};
+} // namespace
+
+static ManagedStatic<OpcodeStatsCollector> OpcodeStats;
+
 std::optional<Instruction *>
 InstCombiner::targetInstCombineIntrinsic(IntrinsicInst &II) {
   // Handle target specific intrinsics
@@ -4270,7 +4316,15 @@ bool InstCombinerImpl::run() {
     LLVM_DEBUG(raw_string_ostream SS(OrigI); I->print(SS); OrigI = SS.str(););
     LLVM_DEBUG(dbgs() << "IC: Visiting: " << OrigI << '\n');
 
-    if (Instruction *Result = visit(*I)) {
+    // The opcode name outlives I; grab it before visit() can erase I.
+    const char *OpcodeName =
+        LLVM_UNLIKELY(InstCombineOpcodeStats) ? I->getOpcodeName() : nullptr;
+
+    Instruction *Result = visit(*I);
+    if (LLVM_UNLIKELY(OpcodeName))
+      OpcodeStats->record(OpcodeName, Result != nullptr);
+
+    if (Result) {
       ++NumCombined;
       // Should we replace the old instruction with a new one?
       if (Result != I) {
@@ -382,6 +382,11 @@ static cl::opt<bool> ClOptSameTemp(
     "asan-opt-same-temp", cl::desc("Instrument the same temp just once"),
     cl::Hidden, cl::init(true));
 
+static cl::opt<bool> ClOptCoalesceChecks(
+    "asan-opt-coalesce-checks",
+    cl::desc("Cover adjacent accesses with one wide shadow check"), cl::Hidden,
+    cl::init(true));
+
 static cl::opt<bool> ClOptGlobals("asan-opt-globals",
                                   cl::desc("Don't instrument scalar globals"),
                                   cl::Hidden, cl::init(true));
@@ -455,6 +460,8 @@ STATISTIC(NumOptimizedAccessesToGlobalVar,
           "Number of optimized accesses to global vars");
 STATISTIC(NumOptimizedAccessesToStackVar,
           "Number of optimized accesses to stack vars");
+STATISTIC(NumCoalescedShadowChecks,
+          "Number of shadow checks merged into an adjacent access's check");
 
 namespace {
 
@@ -1504,6 +1511,59 @@ void AddressSanitizer::instrumentPointerComparisonOrSubtraction(
   IRB.CreateCall(F, Param);
 }
 
+// Try to fold the check for access \p B into the check for the earlier
+// access \p A: when two scalar accesses in the same basic block touch
+// adjacent memory (e.g. consecutive struct fields), one shadow check
+// covering the union of the two ranges subsumes both. Merging is refused
+// when a call separates the accesses, since a call may poison or unpoison
+// memory, and when the union would not qualify for the single-compare fast
+// path in doInstrumentAddress, so the merged check is never less precise
+// than the two it replaces. On success \p A is widened to cover \p B.
+static bool tryCoalesceWithPreviousCheck(InterestingMemoryOperand &A,
+                                         InterestingMemoryOperand &B,
+                                         unsigned Granularity,
+                                         const DataLayout &DL) {
+  if (A.MaybeMask || B.MaybeMask || A.MaybeEVL || B.MaybeEVL ||
+      A.MaybeStride || B.MaybeStride)
+    return false;
+  if (A.IsWrite != B.IsWrite)
+    return false;
+  if (A.TypeStoreSize.isScalable() || B.TypeStoreSize.isScalable())
+    return false;
+  uint64_t ABits = A.TypeStoreSize.getFixedValue();
+  uint64_t BBits = B.TypeStoreSize.getFixedValue();
+  if (ABits % 8 || BBits % 8)
+    return false;
+  uint64_t CombinedBits = ABits + BBits;
+  if (CombinedBits != 16 && CombinedBits != 32 && CombinedBits != 64 &&
+      CombinedBits != 128)
+    return false;
+  if (A.Alignment && *A.Alignment < Granularity &&
+      A.Alignment->value() < CombinedBits / 8)
+    return false;
+  Instruction *AI = A.getInsn(), *BI = B.getInsn();
+  if (AI->getParent() != BI->getParent())
+    return false;
+  unsigned Dist = 0;
+  for (const Instruction *I = AI->getNextNode();; I = I->getNextNode()) {
+    if (!I || ++Dist > 16)
+      return false;
+    if (I == BI)
+      break;
+    if (isa<CallBase>(I))
+      return false;
+  }
+  int64_t AOff = 0, BOff = 0;
+  Value *ABase = GetPointerBaseWithConstantOffset(A.getPtr(), AOff, DL);
+  Value *BBase = GetPointerBaseWithConstantOffset(B.getPtr(), BOff, DL);
+  if (!ABase || ABase != BBase)
+    return false;
+  if (BOff != AOff + static_cast<int64_t>(ABits / 8))
+    return false;
+  A.TypeStoreSize = TypeSize::getFixed(CombinedBits);
+  return true;
+}
+
 static void doInstrumentAddress(AddressSanitizer *Pass, Instruction *I,
                                 Instruction *InsertBefore, Value *Addr,
                                 MaybeAlign Alignment, unsigned Granularity,
@@ -2908,6 +2968,23 @@ bool AddressSanitizer::instrumentFunction(Function &F,
     }
   }
 
+  // Merge checks of provably adjacent accesses before instrumenting, so one
+  // wide shadow check covers a run of consecutive scalar accesses.
+  if (ClOpt && ClOptCoalesceChecks && OperandsToInstrument.size() > 1) {
+    const unsigned Granularity = 1 << Mapping.Scale;
+    SmallVector<InterestingMemoryOperand, 16> Coalesced;
+    for (auto &Operand : OperandsToInstrument) {
+      if (!Coalesced.empty() &&
+          tryCoalesceWithPreviousCheck(Coalesced.back(), Operand, Granularity,
+                                       F.getParent()->getDataLayout())) {
+        NumCoalescedShadowChecks++;
+        continue;
+      }
+      Coalesced.push_back(Operand);
+    }
+    OperandsToInstrument = std::move(Coalesced);
+  }
+
   bool UseCalls = (InstrumentationWithCallsThreshold >= 0 &&
                    OperandsToInstrument.size() + IntrinToInstrument.size() >
                        (unsigned)InstrumentationWithCallsThreshold);
@@ -103,6 +103,9 @@ STATISTIC(IsValueFullyAvailableInBlockNumSpeculationsMax,
 STATISTIC(MaxBBSpeculationCutoffReachedTimes,
           "Number of times we we reached gvn-max-block-speculations cut-off "
           "preventing further exploration");
+STATISTIC(NumGVNOpaqueNumbers,
+          "Number of instructions numbered opaquely after reaching the "
+          "gvn-max-num-exprs cut-off");
 
 static cl::opt<bool> GVNEnablePRE("enable-pre", cl::init(true), cl::Hidden);
 static cl::opt<bool> GVNEnableLoadPRE("enable-load-pre", cl::init(true));
@@ -134,6 +137,13 @@ static cl::opt<uint32_t> MaxNumInsnsPerBlock(
     cl::desc("Max number of instructions to scan in each basic block in GVN "
              "(default = 100)"));
 
+static cl::opt<uint32_t> MaxNumExprs(
+    "gvn-max-num-exprs", cl::Hidden, cl::init(0),
+    cl::desc("Max number of value numbers handed out per function before "
+             "instructions are numbered opaquely. Opaque numbers give up new "
+             "equivalences but keep the expression tables bounded on "
+             "pathological functions (default = 0, no limit)"));
+
 struct llvm::GVNPass::Expression {
   uint32_t opcode;
   bool commutative = false;
@@ -608,6 +618,18 @@ uint32_t GVNPass::ValueTable::lookupOrAdd(Value *V) {
     return nextValueNumber++;
   }
 
+  // Once the per-function expression budget is exhausted, number every
+  // further instruction opaquely. A unique number is always sound -- it just
+  // means no new equivalence is discovered -- and it keeps the expression
+  // tables bounded. PHIs are exempt: their numbering is cheap and
+  // phi-translation needs it.
+  if (MaxNumExprs && nextValueNumber > MaxNumExprs &&
+      I->getOpcode() != Instruction::PHI) {
+    ++NumGVNOpaqueNumbers;
+    valueNumbering[V] = nextValueNumber;
+    return nextValueNumber++;
+  }
+
   Expression exp;
   switch (I->getOpcode()) {
     case Instruction::Call:
@@ -692,6 +714,12 @@ uint32_t GVNPass::ValueTable::lookup(Value *V, bool Verify) const {
 uint32_t GVNPass::ValueTable::lookupOrAddCmp(unsigned Opcode,
                                              CmpInst::Predicate Predicate,
                                              Value *LHS, Value *RHS) {
+  // Respect the expression budget; a fresh number simply means the deduced
+  // comparison has no leader to propagate from.
+  if (MaxNumExprs && nextValueNumber > MaxNumExprs) {
+    ++NumGVNOpaqueNumbers;
+    return nextValueNumber++;
+  }
   Expression exp = createCmpExpr(Opcode, Predicate, LHS, RHS);
   return assignExpNewValueNum(exp).first;
 }
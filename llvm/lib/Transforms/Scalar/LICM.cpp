@@ -148,6 +148,12 @@ cl::opt<unsigned> llvm::SetLicmMssaOptCap(
     cl::desc("Enable imprecision in LICM in pathological cases, in exchange "
              "for faster compile. Caps the MemorySSA clobbering calls."));
 
+static cl::opt<bool> LicmMssaMayWriteSummary(
+    "licm-mssa-may-write-summary", cl::init(true), cl::Hidden,
+    cl::desc("After the clobbering-call cap is exhausted, answer invariance "
+             "queries from a per-loop may-write summary instead of "
+             "conservatively giving up."));
+
 // Experimentally, memory promotion carries less importance than sinking and
 // hoisting. Limit when we do promotion when using MemorySSA, in order to save
 // compile time.
@@ -393,6 +399,49 @@ llvm::SinkAndHoistLICMFlags::SinkAndHoistLICMFlags(
       }
 }
 
+bool llvm::SinkAndHoistLICMFlags::mayWriteSetInvariant(
+    const MemoryLocation &Loc, BatchAAResults &BAA, MemorySSA &MSSA,
+    const Loop &L) {
+  if (!MayWriteSummaryBuilt) {
+    MayWriteSummaryBuilt = true;
+    MayWriteSummaryValid = true;
+    for (const BasicBlock *BB : L.blocks()) {
+      const auto *Defs = MSSA.getBlockDefs(BB);
+      if (!Defs)
+        continue;
+      for (const MemoryAccess &MA : *Defs) {
+        const auto *MD = dyn_cast<MemoryDef>(&MA);
+        if (!MD)
+          continue; // MemoryPhis do not write.
+        Instruction *DefInst = MD->getMemoryInst();
+        if (auto *SI = dyn_cast<StoreInst>(DefInst)) {
+          if (!SI->isUnordered()) {
+            MayWriteSummaryValid = false;
+            break;
+          }
+          LoopMayWriteLocs.push_back(MemoryLocation::get(SI));
+        } else if (auto *MI = dyn_cast<AnyMemIntrinsic>(DefInst)) {
+          LoopMayWriteLocs.push_back(MemoryLocation::getForDest(MI));
+        } else {
+          // Calls, fences and ordered accesses cannot be summarized as a
+          // written location.
+          MayWriteSummaryValid = false;
+          break;
+        }
+      }
+      if (!MayWriteSummaryValid)
+        break;
+    }
+    if (!MayWriteSummaryValid)
+      LoopMayWriteLocs.clear();
+  }
+  if (!MayWriteSummaryValid)
+    return false;
+  return llvm::none_of(LoopMayWriteLocs, [&](const MemoryLocation &WriteLoc) {
+    return BAA.alias(Loc, WriteLoc) != AliasResult::NoAlias;
+  });
+}
+
 /// Hoist expressions out of the specified loop. Note, alias info for inner
 /// loop is not preserved so it is not a good idea to run LICM multiple
 /// times on one loop.
@@ -1134,10 +1183,19 @@ bool isOnlyMemoryAccess(const Instruction *I, const Loop *L,
 static MemoryAccess *getClobberingMemoryAccess(MemorySSA &MSSA,
                                                BatchAAResults &BAA,
                                                SinkAndHoistLICMFlags &Flags,
-                                               MemoryUseOrDef *MA) {
+                                               MemoryUseOrDef *MA,
+                                               Loop *CurLoop) {
   // See declaration of SetLicmMssaOptCap for usage details.
-  if (Flags.tooManyClobberingCalls())
+  if (Flags.tooManyClobberingCalls()) {
+    // The walker budget is exhausted. Before settling for the conservative
+    // defining access, consult the per-loop may-write summary: membership
+    // tests against it are enough to prove there is no clobber in the loop.
+    if (LicmMssaMayWriteSummary && CurLoop)
+      if (auto Loc = MemoryLocation::getOrNone(MA->getMemoryInst()))
+        if (Flags.mayWriteSetInvariant(*Loc, BAA, MSSA, *CurLoop))
+          return MSSA.getLiveOnEntryDef();
     return MA->getDefiningAccess();
+  }
 
   MemoryAccess *Source =
       MSSA.getSkipSelfWalker()->getClobberingMemoryAccess(MA, BAA);
@@ -1272,7 +1330,7 @@ bool llvm::canSinkOrHoistInst(Instruction &I, AAResults *AA, DominatorTree *DT,
 
     auto *SIMD = MSSA->getMemoryAccess(SI);
     BatchAAResults BAA(*AA);
-    auto *Source = getClobberingMemoryAccess(*MSSA, BAA, Flags, SIMD);
+    auto *Source = getClobberingMemoryAccess(*MSSA, BAA, Flags, SIMD, CurLoop);
     // Make sure there are no clobbers inside the loop.
     if (!MSSA->isLiveOnEntryDef(Source) &&
            CurLoop->contains(Source->getBlock()))
@@ -1288,7 +1346,7 @@ bool llvm::canSinkOrHoistInst(Instruction &I, AAResults *AA, DominatorTree *DT,
         for (const auto &MA : *Accesses)
           if (const auto *MU = dyn_cast<MemoryUse>(&MA)) {
             auto *MD = getClobberingMemoryAccess(*MSSA, BAA, Flags,
-                const_cast<MemoryUse *>(MU));
+                const_cast<MemoryUse *>(MU), CurLoop);
             if (!MSSA->isLiveOnEntryDef(MD) &&
                 CurLoop->contains(MD->getBlock()))
               return false;
@@ -2344,7 +2402,8 @@ static bool pointerInvalidatedByLoop(MemorySSA *MSSA, MemoryUse *MU,
     // if the memory loaded is the phi node
 
     BatchAAResults BAA(MSSA->getAA());
-    MemoryAccess *Source = getClobberingMemoryAccess(*MSSA, BAA, Flags, MU);
+    MemoryAccess *Source =
+        getClobberingMemoryAccess(*MSSA, BAA, Flags, MU, CurLoop);
     return !MSSA->isLiveOnEntryDef(Source) &&
            CurLoop->contains(Source->getBlock()) &&
            !(InvariantGroup && Source->getBlock() == CurLoop->getHeader() && isa<MemoryPhi>(Source));
@@ -77,6 +77,11 @@ static cl::opt<bool> UserSinkCommonInsts(
     "sink-common-insts", cl::Hidden, cl::init(false),
     cl::desc("Sink common instructions (default = false)"));
 
+static cl::opt<bool> LazyDomTreeUpdates(
+    "simplifycfg-lazy-dtu", cl::Hidden, cl::init(true),
+    cl::desc("Batch CFG edge updates and repair the dominator tree once per "
+             "flush instead of once per edge (default = true)"));
+
 
 STATISTIC(NumSimpl, "Number of blocks simplified");
 
@@ -265,7 +270,14 @@ static bool iterativelySimplifyCFG(Function &F, const TargetTransformInfo &TTI,
 static bool simplifyFunctionCFGImpl(Function &F, const TargetTransformInfo &TTI,
                                     DominatorTree *DT,
                                     const SimplifyCFGOptions &Options) {
-  DomTreeUpdater DTU(DT, DomTreeUpdater::UpdateStrategy::Eager);
+  // With the lazy strategy each applyUpdates call below only records the edge
+  // changes; the dominator tree is repaired with one incremental batch per
+  // flush (deduplicating no-op insert/delete pairs along the way) rather than
+  // once per edge. The iteration in iterativelySimplifyCFG already skips
+  // blocks whose deletion is pending on such a flush.
+  DomTreeUpdater DTU(DT, LazyDomTreeUpdates
+                             ? DomTreeUpdater::UpdateStrategy::Lazy
+                             : DomTreeUpdater::UpdateStrategy::Eager);
 
   bool EverChanged = removeUnreachableBlocks(F, DT ? &DTU : nullptr);
   EverChanged |=
@@ -1676,6 +1676,7 @@ public:
     CallWideningDecisions.clear();
     Uniforms.clear();
     Scalars.clear();
+    InstructionCostCache.clear();
   }
 
   /// The vectorization cost is a combination of the cost itself and a boolean
@@ -1728,9 +1729,14 @@ private:
   ElementCount getMaxLegalScalableVF(unsigned MaxSafeElements);
 
   /// Returns the execution time cost of an instruction for a given vector
-  /// width. Vector width of one means scalar.
+  /// width. Vector width of one means scalar. Results are cached in
+  /// InstructionCostCache so every instruction/VF pair is costed at most once
+  /// per set of cost-modeling decisions.
   VectorizationCostTy getInstructionCost(Instruction *I, ElementCount VF);
 
+  /// The uncached cost-computation logic behind getInstructionCost.
+  VectorizationCostTy computeInstructionCost(Instruction *I, ElementCount VF);
+
   /// The cost-computation logic from getInstructionCost which provides
   /// the vector type as an output parameter.
   InstructionCost getInstructionCost(Instruction *I, ElementCount VF,
@@ -1867,6 +1873,17 @@ private:
 
   CallDecisionList CallWideningDecisions;
 
+  /// Caches the results of getInstructionCost, keyed on instruction and VF.
+  /// The per-VF analysis state the cost computation reads (widening decisions,
+  /// uniform and scalar sets, instructions to scalarize) is collected before
+  /// that VF is costed and is not changed afterwards, so entries stay valid
+  /// until the decisions are invalidated. The table lets repeated costing of
+  /// the same VF (e.g. re-costing a user-selected VF for the interleave-count
+  /// decision) and the per-candidate re-query of scalar costs for forced
+  /// scalars hit the cache instead of the target hooks.
+  DenseMap<std::pair<Instruction *, ElementCount>, VectorizationCostTy>
+      InstructionCostCache;
+
   /// Returns true if \p V is expected to be vectorized and it needs to be
   /// extracted.
   bool needsExtract(Value *V, ElementCount VF) const {
@@ -5185,6 +5202,11 @@ VectorizationFactor LoopVectorizationPlanner::selectVectorizationFactor(
     ChosenFactor.Cost = InstructionCost::getMax();
   }
 
+  // When extra analysis remarks are enabled, collect the estimated cost of
+  // every candidate so the whole cost table can be reported for the loop.
+  const bool EmitCostTable = ORE->allowExtraAnalysis(LV_NAME);
+  SmallVector<VectorizationFactor> CostTable;
+
   SmallVector<InstructionVFPair> InvalidCosts;
   for (const auto &i : VFCandidates) {
     // The cost for scalar VF=1 is already calculated, so ignore it.
@@ -5194,6 +5216,8 @@ VectorizationFactor LoopVectorizationPlanner::selectVectorizationFactor(
     LoopVectorizationCostModel::VectorizationCostTy C =
         CM.expectedCost(i, &InvalidCosts);
     VectorizationFactor Candidate(i, C.first, ScalarCost.ScalarCost);
+    if (EmitCostTable)
+      CostTable.push_back(Candidate);
 
 #ifndef NDEBUG
     unsigned AssumedMinimumVscale = 1;
@@ -5226,6 +5250,16 @@ VectorizationFactor LoopVectorizationPlanner::selectVectorizationFactor(
       ChosenFactor = Candidate;
   }
 
+  if (EmitCostTable && !CostTable.empty()) {
+    std::string OutString;
+    raw_string_ostream OS(OutString);
+    OS << "Cost table: scalar cost " << ScalarCost.Cost;
+    for (const VectorizationFactor &Candidate : CostTable)
+      OS << ", VF=" << Candidate.Width << " cost " << Candidate.Cost;
+    OS.flush();
+    reportVectorizationInfo(OutString, "CostTable", ORE, OrigLoop);
+  }
+
   emitInvalidCostRemarks(InvalidCosts, ORE, OrigLoop);
 
   if (!EnableCondStoresVectorization && CM.hasPredStores()) {
@@ -6539,6 +6573,18 @@ LoopVectorizationCostModel::getMemoryInstructionCost(Instruction *I,
 LoopVectorizationCostModel::VectorizationCostTy
 LoopVectorizationCostModel::getInstructionCost(Instruction *I,
                                                ElementCount VF) {
+  auto CacheIt = InstructionCostCache.find(std::make_pair(I, VF));
+  if (CacheIt != InstructionCostCache.end())
+    return CacheIt->second;
+
+  VectorizationCostTy Cost = computeInstructionCost(I, VF);
+  InstructionCostCache[std::make_pair(I, VF)] = Cost;
+  return Cost;
+}
+
+LoopVectorizationCostModel::VectorizationCostTy
+LoopVectorizationCostModel::computeInstructionCost(Instruction *I,
+                                                   ElementCount VF) {
   // If we know that this instruction will remain uniform, check the cost of
   // the scalar version.
   if (isUniformAfterVectorization(I, VF))
@@ -73,6 +73,7 @@
 #include "llvm/IR/Verifier.h"
 #endif
 #include "llvm/Pass.h"
+#include "llvm/Support/Allocator.h"
 #include "llvm/Support/Casting.h"
 #include "llvm/Support/CommandLine.h"
 #include "llvm/Support/Compiler.h"
@@ -89,6 +90,7 @@
 #include "llvm/Transforms/Utils/LoopUtils.h"
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstdint>
 #include <iterator>
 #include <memory>
@@ -116,6 +118,11 @@ static cl::opt<int>
                      cl::desc("Only vectorize if you gain more than this "
                               "number "));
 
+static cl::opt<bool>
+    SLPReport("slp-report", cl::init(false), cl::Hidden,
+              cl::desc("Report per-tree build/cost-estimation timing and "
+                       "gather-cost cache statistics"));
+
 static cl::opt<bool>
 ShouldVectorizeHor("slp-vectorize-hor", cl::init(true), cl::Hidden,
                    cl::desc("Attempt to vectorize horizontal reductions"));
@@ -1069,6 +1076,12 @@ public:
 
   unsigned getTreeSize() const { return VectorizableTree.size(); }
 
+  /// \returns the number of hits and lookups seen by the gather-cost cache,
+  /// for -slp-report.
+  std::pair<unsigned, unsigned> getGatherCostCacheStats() const {
+    return std::make_pair(NumGatherCostHits, NumGatherCostLookups);
+  }
+
   /// Perform LICM and CSE on the newly generated gather sequences.
   void optimizeGatherSequence();
 
@@ -2931,6 +2944,22 @@ private:
   /// Maps a value to the proposed vectorizable size.
   SmallDenseMap<Value *, unsigned> InstrElementSize;
 
+  /// Cached scalarization/gather costs for value bundles. Overlapping trees
+  /// built from different seeds commonly re-analyze the very same bundles,
+  /// and the cost depends only on the bundle contents and the target, so the
+  /// cache deliberately survives deleteTree() and lives as long as this pass
+  /// object, i.e. one function. The keys point into GatherCostArena.
+  mutable DenseMap<std::pair<ArrayRef<Value *>, unsigned>, InstructionCost>
+      GatherCostCache;
+
+  /// Arena owning the bundle copies used as keys in GatherCostCache. Like the
+  /// cache it is recycled per function, not per tree.
+  mutable BumpPtrAllocator GatherCostArena;
+
+  /// Number of GatherCostCache lookups and hits, reported via -slp-report.
+  mutable unsigned NumGatherCostLookups = 0;
+  mutable unsigned NumGatherCostHits = 0;
+
   /// A list of scalars that we found that we need to keep as scalars.
   ValueSet MustGather;
 
@@ -5129,20 +5158,40 @@ BoUpSLP::findExternalStoreUsersReorderIndices(TreeEntry *TE) const {
   return ExternalReorderIndices;
 }
 
+/// Prints a -slp-report line for a tree of \p TreeSize entries on which the
+/// action \p What took the time elapsed since \p Start.
+static void reportTreeTiming(StringRef What, unsigned TreeSize,
+                             std::chrono::steady_clock::time_point Start) {
+  auto Micros = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - Start);
+  errs() << "SLP: report: " << What << " for tree of " << TreeSize
+         << " entries took " << Micros.count() << "us\n";
+}
+
 void BoUpSLP::buildTree(ArrayRef<Value *> Roots,
                         const SmallDenseSet<Value *> &UserIgnoreLst) {
   deleteTree();
   UserIgnoreList = &UserIgnoreLst;
   if (!allSameType(Roots))
     return;
+  std::chrono::steady_clock::time_point Start;
+  if (SLPReport)
+    Start = std::chrono::steady_clock::now();
   buildTree_rec(Roots, 0, EdgeInfo());
+  if (SLPReport)
+    reportTreeTiming("build", VectorizableTree.size(), Start);
 }
 
 void BoUpSLP::buildTree(ArrayRef<Value *> Roots) {
   deleteTree();
   if (!allSameType(Roots))
     return;
+  std::chrono::steady_clock::time_point Start;
+  if (SLPReport)
+    Start = std::chrono::steady_clock::now();
   buildTree_rec(Roots, 0, EdgeInfo());
+  if (SLPReport)
+    reportTreeTiming("build", VectorizableTree.size(), Start);
 }
 
 /// \return true if the specified list of values has only one instruction that
@@ -8895,6 +8944,9 @@ static T *performExtractsShuffleAction(
 }
 
 InstructionCost BoUpSLP::getTreeCost(ArrayRef<Value *> VectorizedVals) {
+  std::chrono::steady_clock::time_point Start;
+  if (SLPReport)
+    Start = std::chrono::steady_clock::now();
   InstructionCost Cost = 0;
   LLVM_DEBUG(dbgs() << "SLP: Calculating cost for tree of size "
                     << VectorizableTree.size() << ".\n");
@@ -9170,6 +9222,8 @@ InstructionCost BoUpSLP::getTreeCost(ArrayRef<Value *> VectorizedVals) {
     ViewGraph(this, "SLP" + F->getName(), false, Str);
 #endif
 
+  if (SLPReport)
+    reportTreeTiming("cost estimation", VectorizableTree.size(), Start);
   return Cost;
 }
 
@@ -9728,6 +9782,16 @@ BoUpSLP::isGatherShuffledEntry(
 
 InstructionCost BoUpSLP::getGatherCost(ArrayRef<Value *> VL,
                                        bool ForPoisonSrc) const {
+  // The cost depends only on the bundle contents and the target, so bundles
+  // already analyzed for an earlier (possibly deleted) tree can be served from
+  // the per-function cache.
+  ++NumGatherCostLookups;
+  auto CacheIt =
+      GatherCostCache.find(std::make_pair(VL, unsigned(ForPoisonSrc)));
+  if (CacheIt != GatherCostCache.end()) {
+    ++NumGatherCostHits;
+    return CacheIt->second;
+  }
   // Find the type of the operands in VL.
   Type *ScalarTy = VL[0]->getType();
   if (StoreInst *SI = dyn_cast<StoreInst>(VL[0]))
@@ -9768,6 +9832,14 @@ InstructionCost BoUpSLP::getGatherCost(ArrayRef<Value *> VL,
   if (DuplicateNonConst)
     Cost +=
         TTI->getShuffleCost(TargetTransformInfo::SK_PermuteSingleSrc, VecTy);
+  // Copy the bundle into the arena so the cache key outlives the caller's
+  // storage.
+  MutableArrayRef<Value *> CachedVL(GatherCostArena.Allocate<Value *>(VL.size()),
+                                    VL.size());
+  copy(VL, CachedVL.begin());
+  GatherCostCache.try_emplace(
+      std::make_pair(ArrayRef<Value *>(CachedVL), unsigned(ForPoisonSrc)),
+      Cost);
   return Cost;
 }
 
@@ -13399,6 +13471,12 @@ bool SLPVectorizerPass::runImpl(Function &F, ScalarEvolution *SE_,
     R.optimizeGatherSequence();
     LLVM_DEBUG(dbgs() << "SLP: vectorized \"" << F.getName() << "\"\n");
   }
+
+  if (SLPReport) {
+    std::pair<unsigned, unsigned> Stats = R.getGatherCostCacheStats();
+    errs() << "SLP: report: " << F.getName() << ": gather-cost cache hit "
+           << Stats.first << " of " << Stats.second << " lookups\n";
+  }
   return Changed;
 }
 
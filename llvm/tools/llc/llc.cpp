@@ -14,6 +14,7 @@
 
 #include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/ScopeExit.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Analysis/TargetLibraryInfo.h"
 #include "llvm/CodeGen/CommandFlags.h"
 #include "llvm/CodeGen/LinkAllAsmWriterComponents.h"
@@ -21,6 +22,7 @@
 #include "llvm/CodeGen/MIRParser/MIRParser.h"
 #include "llvm/CodeGen/MachineFunctionPass.h"
 #include "llvm/CodeGen/MachineModuleInfo.h"
+#include "llvm/CodeGen/ParallelCG.h"
 #include "llvm/CodeGen/TargetPassConfig.h"
 #include "llvm/CodeGen/TargetSubtargetInfo.h"
 #include "llvm/IR/AutoUpgrade.h"
@@ -126,6 +128,13 @@ static cl::opt<std::string> SplitDwarfFile(
     cl::desc(
         "Specify the name of the .dwo file to encode in the DWARF output"));
 
+static cl::opt<unsigned> SplitCodegen(
+    "split-codegen", cl::init(0), cl::value_desc("N"),
+    cl::desc("Split the module into N partitions and run codegen on them in "
+             "parallel, writing partition i to <output file>.<i>. The "
+             "partition outputs, linked together, are equivalent to a "
+             "single-output compile (default = 0, disabled)"));
+
 static cl::opt<bool> NoVerify("disable-verify", cl::Hidden,
                               cl::desc("Do not verify input module"));
 
@@ -634,6 +643,70 @@ static int compileModule(char **argv, LLVMContext &Context) {
   if (codegen::getFloatABIForCalls() != FloatABI::Default)
     Target->Options.FloatABIType = codegen::getFloatABIForCalls();
 
+  // Parallel codegen splits the module into partitions and runs a complete
+  // backend per partition, so it bypasses the single-output pipeline below.
+  if (SplitCodegen > 1) {
+    if (MIR)
+      reportError("-split-codegen is not supported for MIR input",
+                  InputFilename);
+    if (!getRunPassNames().empty() || CompileTwice ||
+        !SplitDwarfOutputFile.empty())
+      reportError("-split-codegen cannot be combined with -run-pass, "
+                  "-compile-twice or -split-dwarf-output");
+    if (OutputFilename.empty() || OutputFilename == "-")
+      reportError("-split-codegen requires -o <file>");
+
+    // Verify module immediately to catch problems before doInitialization()
+    // is called on any passes.
+    if (!NoVerify && verifyModule(*M, &errs()))
+      reportError("input module cannot be verified", InputFilename);
+
+    // Override function attributes based on CPUStr, FeaturesStr, and command
+    // line flags.
+    codegen::setFunctionAttributes(CPUStr, FeaturesStr, *M);
+
+    SmallVector<std::unique_ptr<ToolOutputFile>, 4> Outs;
+    SmallVector<raw_pwrite_stream *, 4> OSs;
+    for (unsigned I = 0; I != SplitCodegen; ++I) {
+      std::string Filename = OutputFilename + "." + utostr(I);
+      std::error_code EC;
+      Outs.push_back(std::make_unique<ToolOutputFile>(Filename, EC,
+                                                      sys::fs::OF_None));
+      if (EC)
+        reportError(EC.message(), Filename);
+      OSs.push_back(&Outs.back()->os());
+    }
+
+    // Each worker thread builds its own TargetMachine: a TargetMachine may
+    // not be shared across concurrent codegen pipelines.
+    std::optional<CodeModel::Model> CM_IR = M->getCodeModel();
+    auto TMFactory = [&]() -> std::unique_ptr<TargetMachine> {
+      std::unique_ptr<TargetMachine> TM(TheTarget->createTargetMachine(
+          TheTriple.getTriple(), CPUStr, FeaturesStr, Options, RM, CM, OLvl));
+      if (codegen::getFloatABIForCalls() != FloatABI::Default)
+        TM->Options.FloatABIType = codegen::getFloatABIForCalls();
+      if (!CM && CM_IR)
+        TM->setCodeModel(*CM_IR);
+      if (std::optional<uint64_t> LDT =
+              codegen::getExplicitLargeDataThreshold())
+        TM->setLargeDataThreshold(*LDT);
+      return TM;
+    };
+
+    cl::PrintOptionValues();
+
+    splitCodeGen(*M, OSs, {}, TMFactory, codegen::getFileType());
+
+    auto HasError =
+        ((const LLCDiagnosticHandler *)(Context.getDiagHandlerPtr()))->HasError;
+    if (*HasError)
+      return 1;
+
+    for (std::unique_ptr<ToolOutputFile> &Out : Outs)
+      Out->keep();
+    return 0;
+  }
+
   // Figure out where we are going to send the output.
   std::unique_ptr<ToolOutputFile> Out =
       GetOutputStream(TheTarget->getName(), TheTriple.getOS(), argv[0]);
@@ -78,11 +78,26 @@ Expected<llvm::SmallVector<int64_t, 4>>
 BenchmarkRunner::FunctionExecutor::runAndSample(const char *Counters) const {
   // We sum counts when there are several counters for a single ProcRes
   // (e.g. P23 on SandyBridge).
-  llvm::SmallVector<int64_t, 4> CounterValues;
   SmallVector<StringRef, 2> CounterNames;
   StringRef(Counters).split(CounterNames, '+');
-  for (auto &CounterName : CounterNames) {
+  for (auto &CounterName : CounterNames)
     CounterName = CounterName.trim();
+
+  // Try to program all the counters as one group first so that they are
+  // measured over a single execution of the snippet.
+  if (CounterNames.size() > 1) {
+    Expected<std::optional<SmallVector<int64_t, 4>>> GroupValuesOrError =
+        tryRunWithCounterGroup(CounterNames);
+    if (!GroupValuesOrError)
+      return GroupValuesOrError.takeError();
+    if (*GroupValuesOrError)
+      return std::move(**GroupValuesOrError);
+    // The counters cannot be grouped on this host/executor; fall back to
+    // measuring them over one execution each.
+  }
+
+  llvm::SmallVector<int64_t, 4> CounterValues;
+  for (auto &CounterName : CounterNames) {
     Expected<SmallVector<int64_t, 4>> ValueOrError =
         runWithCounter(CounterName);
     if (!ValueOrError)
@@ -126,14 +141,37 @@ private:
 
   Expected<llvm::SmallVector<int64_t, 4>>
   runWithCounter(StringRef CounterName) const override {
-    const ExegesisTarget &ET = State.getExegesisTarget();
-    char *const ScratchPtr = Scratch->ptr();
-    auto CounterOrError = ET.createCounter(CounterName, State);
+    auto CounterOrError =
+        State.getExegesisTarget().createCounter(CounterName, State);
+    if (!CounterOrError)
+      return CounterOrError.takeError();
+    return runMeasuringCounter(*CounterOrError.get());
+  }
 
+  Expected<std::optional<llvm::SmallVector<int64_t, 4>>>
+  tryRunWithCounterGroup(ArrayRef<StringRef> CounterNames) const override {
+    auto CounterOrError =
+        State.getExegesisTarget().createCounter(CounterNames.front(), State);
     if (!CounterOrError)
       return CounterOrError.takeError();
+    pfm::Counter &Counter = *CounterOrError.get();
+    for (StringRef CounterName : CounterNames.drop_front()) {
+      pfm::PerfEvent Event(CounterName);
+      if (!Event.valid() || !Counter.addSiblingEvent(std::move(Event)))
+        return std::nullopt;
+    }
+    auto ValuesOrError = runMeasuringCounter(Counter);
+    if (!ValuesOrError)
+      return ValuesOrError.takeError();
+    return std::optional<llvm::SmallVector<int64_t, 4>>(
+        std::move(*ValuesOrError));
+  }
 
-    pfm::Counter *Counter = CounterOrError.get().get();
+  Expected<llvm::SmallVector<int64_t, 4>>
+  runMeasuringCounter(pfm::Counter &CounterRef) const {
+    const ExegesisTarget &ET = State.getExegesisTarget();
+    char *const ScratchPtr = Scratch->ptr();
+    pfm::Counter *Counter = &CounterRef;
     Scratch->clear();
     {
       auto PS = ET.withSavedState();
@@ -21,11 +21,13 @@
 #include "LlvmState.h"
 #include "MCInstrDescView.h"
 #include "SnippetRepetitor.h"
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/MC/MCInst.h"
 #include "llvm/Support/Error.h"
 #include <cstdlib>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace llvm {
@@ -101,6 +103,14 @@ public:
                             llvm::SmallVectorImpl<int64_t> *Result);
     virtual Expected<llvm::SmallVector<int64_t, 4>>
     runWithCounter(StringRef CounterName) const = 0;
+    /// Tries to measure all of \p CounterNames as one counter group over a
+    /// single execution. Returns std::nullopt if the executor or the host
+    /// cannot group the counters, in which case the caller measures them over
+    /// one execution each.
+    virtual Expected<std::optional<llvm::SmallVector<int64_t, 4>>>
+    tryRunWithCounterGroup(ArrayRef<StringRef> CounterNames) const {
+      return std::nullopt;
+    }
   };
 
 protected:
@@ -133,19 +133,48 @@ void Counter::initRealEvent(const PerfEvent &E, pid_t ProcessID) {
   assert(FileDescriptor != -1 && "Unable to open event");
 }
 
+bool Counter::addSiblingEvent(PerfEvent &&E, pid_t ProcessID) {
+  assert(E.valid());
+  if (IsDummyEvent) {
+    SiblingEvents.push_back(std::move(E));
+    return true;
+  }
+  if (FileDescriptor == -1)
+    return false;
+  const int Cpu = -1; // measure any processor.
+  const uint32_t Flags = 0;
+  perf_event_attr AttrCopy = *E.attribute();
+  const int Fd =
+      perf_event_open(&AttrCopy, ProcessID, Cpu, FileDescriptor, Flags);
+  if (Fd == -1)
+    return false;
+  SiblingEvents.push_back(std::move(E));
+  SiblingFileDescriptors.push_back(Fd);
+  return true;
+}
+
 Counter::~Counter() {
-  if (!IsDummyEvent)
+  if (!IsDummyEvent) {
+    for (int Fd : SiblingFileDescriptors)
+      close(Fd);
     close(FileDescriptor);
+  }
 }
 
 void Counter::start() {
-  if (!IsDummyEvent)
+  if (!IsDummyEvent) {
     ioctl(FileDescriptor, PERF_EVENT_IOC_RESET, 0);
+    for (int Fd : SiblingFileDescriptors)
+      ioctl(Fd, PERF_EVENT_IOC_RESET, 0);
+  }
 }
 
 void Counter::stop() {
-  if (!IsDummyEvent)
+  if (!IsDummyEvent) {
     ioctl(FileDescriptor, PERF_EVENT_IOC_DISABLE, 0);
+    for (int Fd : SiblingFileDescriptors)
+      ioctl(Fd, PERF_EVENT_IOC_DISABLE, 0);
+  }
 }
 
 int64_t Counter::read() const {
@@ -161,14 +190,24 @@ int64_t Counter::read() const {
 
 llvm::Expected<llvm::SmallVector<int64_t, 4>>
 Counter::readOrError(StringRef /*unused*/) const {
+  // Sibling counts are summed into the leader's, matching what callers get
+  // when they measure '+'-joined counters over separate runs.
   int64_t Count = 0;
   if (!IsDummyEvent) {
     ssize_t ReadSize = ::read(FileDescriptor, &Count, sizeof(Count));
     if (ReadSize != sizeof(Count))
       return llvm::make_error<llvm::StringError>("Failed to read event counter",
                                                  llvm::errc::io_error);
+    for (int Fd : SiblingFileDescriptors) {
+      int64_t SiblingCount = 0;
+      ReadSize = ::read(Fd, &SiblingCount, sizeof(SiblingCount));
+      if (ReadSize != sizeof(SiblingCount))
+        return llvm::make_error<llvm::StringError>(
+            "Failed to read sibling event counter", llvm::errc::io_error);
+      Count += SiblingCount;
+    }
   } else {
-    Count = 42;
+    Count = 42 * (1 + static_cast<int64_t>(SiblingEvents.size()));
   }
 
   llvm::SmallVector<int64_t, 4> Result;
@@ -181,6 +220,14 @@ int Counter::numValues() const { return 1; }
 
 void Counter::initRealEvent(const PerfEvent &, pid_t ProcessID) {}
 
+bool Counter::addSiblingEvent(PerfEvent &&E, pid_t /*ProcessID*/) {
+  if (IsDummyEvent) {
+    SiblingEvents.push_back(std::move(E));
+    return true;
+  }
+  return false;
+}
+
 Counter::~Counter() = default;
 
 void Counter::start() {}
@@ -193,7 +240,7 @@ llvm::Expected<llvm::SmallVector<int64_t, 4>>
 Counter::readOrError(StringRef /*unused*/) const {
   if (IsDummyEvent) {
     llvm::SmallVector<int64_t, 4> Result;
-    Result.push_back(42);
+    Result.push_back(42 * (1 + static_cast<int64_t>(SiblingEvents.size())));
     return Result;
   }
   return llvm::make_error<llvm::StringError>("Not implemented",
@@ -89,6 +89,13 @@ public:
 
   virtual ~Counter();
 
+  /// Adds an event to be measured in the same counter group as this
+  /// counter's event, so that all of them are programmed, started and read
+  /// together over a single execution. Returns false if the kernel cannot
+  /// schedule the event into the group (e.g. not enough hardware counters),
+  /// in which case the caller should measure the events over separate runs.
+  bool addSiblingEvent(PerfEvent &&E, pid_t ProcessID = 0);
+
   /// Starts the measurement of the event.
   virtual void start();
 
@@ -115,6 +122,8 @@ protected:
   PerfEvent Event;
   int FileDescriptor = -1;
   bool IsDummyEvent;
+  llvm::SmallVector<PerfEvent, 2> SiblingEvents;
+  llvm::SmallVector<int, 2> SiblingFileDescriptors;
 
 private:
   void initRealEvent(const PerfEvent &E, pid_t ProcessID);
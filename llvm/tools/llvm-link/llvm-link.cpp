@@ -29,14 +29,17 @@
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/InitLLVM.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/SmallVectorMemoryBuffer.h"
 #include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/SystemUtils.h"
+#include "llvm/Support/ThreadPool.h"
 #include "llvm/Support/ToolOutputFile.h"
 #include "llvm/Support/WithColor.h"
 #include "llvm/Transforms/IPO/FunctionImport.h"
 #include "llvm/Transforms/IPO/Internalize.h"
 #include "llvm/Transforms/Utils/FunctionImportUtils.h"
 
+#include <atomic>
 #include <memory>
 #include <utility>
 using namespace llvm;
@@ -124,6 +127,11 @@ static cl::opt<bool> NoVerify("disable-verify",
                               cl::desc("Do not run the verifier"), cl::Hidden,
                               cl::cat(LinkCategory));
 
+static cl::opt<unsigned> ParallelLinkJobs(
+    "j", cl::desc("Link input files pairwise in up to N worker threads, then "
+                  "merge the partial results (tree reduction)"),
+    cl::init(1), cl::value_desc("N"), cl::cat(LinkCategory));
+
 static cl::opt<bool> IgnoreNonBitcode(
     "ignore-non-bitcode",
     cl::desc("Do not report an error for non-bitcode files in archives"),
@@ -458,6 +466,87 @@ static bool linkFiles(const char *argv0, LLVMContext &Context, Linker &L,
   return true;
 }
 
+// Link two in-memory modules on a worker thread and serialize the result.
+// Each pair is linked in its own LLVMContext; the only way to move the result
+// across contexts is through bitcode, which also keeps the worker's memory
+// bounded to the pair being linked.
+static std::unique_ptr<MemoryBuffer> linkPair(const char *argv0,
+                                              std::unique_ptr<MemoryBuffer> A,
+                                              std::unique_ptr<MemoryBuffer> B,
+                                              std::atomic<bool> &Failed) {
+  LLVMContext Ctx;
+  Ctx.setDiagnosticHandler(std::make_unique<LLVMLinkDiagnosticHandler>(),
+                           true);
+  if (!DisableDITypeMap)
+    Ctx.enableDebugTypeODRUniquing();
+
+  if (Verbose)
+    errs() << "Linking '" << A->getBufferIdentifier() << "' and '"
+           << B->getBufferIdentifier() << "'\n";
+
+  std::unique_ptr<Module> MA = loadFile(argv0, std::move(A), Ctx);
+  std::unique_ptr<Module> MB = loadFile(argv0, std::move(B), Ctx);
+  if (!MA || !MB || Linker::linkModules(*MA, std::move(MB))) {
+    Failed = true;
+    return nullptr;
+  }
+
+  SmallVector<char, 0> Buf;
+  raw_svector_ostream OS(Buf);
+  WriteBitcodeToFile(*MA, OS, PreserveBitcodeUseListOrder);
+  return std::make_unique<SmallVectorMemoryBuffer>(
+      std::move(Buf), MA->getModuleIdentifier(),
+      /*RequiresNullTerminator=*/false);
+}
+
+// Reduce the input files to a single module by linking adjacent pairs in
+// parallel, then link that module into the composite. Left-to-right order is
+// preserved within every partial link, so symbol and comdat resolution sees
+// the inputs in the same relative order as a serial link.
+static bool linkFilesParallel(const char *argv0, LLVMContext &Context,
+                              Linker &L, const cl::list<std::string> &Files,
+                              unsigned Flags) {
+  std::vector<std::unique_ptr<MemoryBuffer>> Level;
+  Level.reserve(Files.size());
+  for (const auto &File : Files) {
+    std::unique_ptr<MemoryBuffer> Buffer =
+        ExitOnErr(errorOrToExpected(MemoryBuffer::getFileOrSTDIN(File)));
+    if (identify_magic(Buffer->getBuffer()) == file_magic::archive) {
+      errs() << argv0 << ": ";
+      WithColor::error() << "archive input '" << File
+                         << "' is not supported with -j\n";
+      return false;
+    }
+    Level.push_back(std::move(Buffer));
+  }
+
+  ThreadPool Pool(hardware_concurrency(ParallelLinkJobs));
+  std::atomic<bool> Failed(false);
+  while (Level.size() > 1 && !Failed) {
+    std::vector<std::unique_ptr<MemoryBuffer>> Next((Level.size() + 1) / 2);
+    for (size_t I = 0, E = Level.size() - 1; I < E; I += 2)
+      Pool.async([&, I] {
+        Next[I / 2] =
+            linkPair(argv0, std::move(Level[I]), std::move(Level[I + 1]),
+                     Failed);
+      });
+    if (Level.size() & 1)
+      Next.back() = std::move(Level.back());
+    Pool.wait();
+    Level = std::move(Next);
+  }
+  if (Failed)
+    return false;
+
+  std::unique_ptr<Module> M = loadFile(argv0, std::move(Level.front()), Context);
+  if (!M) {
+    errs() << argv0 << ": ";
+    WithColor::error() << "loading reduced module\n";
+    return false;
+  }
+  return !L.linkInModule(std::move(M), Flags);
+}
+
 int main(int argc, char **argv) {
   InitLLVM X(argc, argv);
   ExitOnErr.setBanner(std::string(argv[0]) + ": ");
@@ -480,7 +569,17 @@ int main(int argc, char **argv) {
     Flags |= Linker::Flags::LinkOnlyNeeded;
 
   // First add all the regular input files
-  if (!linkFiles(argv[0], Context, L, InputFilenames, Flags))
+  if (ParallelLinkJobs > 1) {
+    // Tree reduction is incompatible with the per-file processing the serial
+    // loop does for these options.
+    if (Internalize || OnlyNeeded || !SummaryIndex.empty()) {
+      WithColor::error() << "-j cannot be combined with -internalize, "
+                            "-only-needed or -summary-index\n";
+      return 1;
+    }
+    if (!linkFilesParallel(argv[0], Context, L, InputFilenames, Flags))
+      return 1;
+  } else if (!linkFiles(argv[0], Context, L, InputFilenames, Flags))
     return 1;
 
   // Next the -override ones.
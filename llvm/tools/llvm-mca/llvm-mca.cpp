@@ -658,6 +658,10 @@ int main(int argc, char **argv) {
       CB = std::make_unique<mca::CustomBehaviour>(*STI, S, *MCII);
 
     // Create a basic pipeline simulating an out-of-order backend.
+    // The previous region's pipeline is gone by now, so drop the hardware
+    // units built for it before creating new ones; they would otherwise
+    // accumulate in the context for the lifetime of the process.
+    MCA.clearHardwareUnits();
     auto P = MCA.createDefaultPipeline(PO, S, *CB);
 
     mca::PipelinePrinter Printer(*P, *Region, RegionIdx, *STI, PO);
@@ -2352,6 +2352,30 @@ static void dumpSymbolicFile(SymbolicFile *O, std::vector<NMSymbol> &SymbolList,
                             /*PrintObjectLabel=*/false);
 }
 
+// Ask the OS to page in the symbol and string tables ahead of the symbol
+// walk. Name lookups touch strtab pages in st_name order, which is
+// effectively random, so on a cold cache every page costs a synchronous
+// fault; advising the ranges up front overlaps the page-in with parsing.
+static void adviseSymbolTableRanges(MemoryBuffer &Buffer, Binary &Bin) {
+  auto *Obj = dyn_cast<ELFObjectFileBase>(&Bin);
+  if (!Obj)
+    return;
+  const char *BufStart = Buffer.getBufferStart();
+  for (const SectionRef &Sec : Obj->sections()) {
+    uint32_t Type = ELFSectionRef(Sec).getType();
+    if (Type != ELF::SHT_SYMTAB && Type != ELF::SHT_DYNSYM &&
+        Type != ELF::SHT_STRTAB)
+      continue;
+    Expected<StringRef> ContentsOrErr = Sec.getContents();
+    if (!ContentsOrErr) {
+      consumeError(ContentsOrErr.takeError());
+      continue;
+    }
+    Buffer.willNeedIfMmap(ContentsOrErr->data() - BufStart,
+                          ContentsOrErr->size());
+  }
+}
+
 static std::vector<NMSymbol> dumpSymbolNamesFromFile(StringRef Filename) {
   std::vector<NMSymbol> SymbolList;
   ErrorOr<std::unique_ptr<MemoryBuffer>> BufferOrErr =
@@ -2376,6 +2400,7 @@ static std::vector<NMSymbol> dumpSymbolNamesFromFile(StringRef Filename) {
     return SymbolList;
   }
   Binary &Bin = *BinaryOrErr.get();
+  adviseSymbolTableRanges(**BufferOrErr, Bin);
   if (Archive *A = dyn_cast<Archive>(&Bin))
     dumpArchive(A, SymbolList, Filename, ContextPtr);
   else if (MachOUniversalBinary *UB = dyn_cast<MachOUniversalBinary>(&Bin))
@@ -60,15 +60,19 @@ int TestRunner::run(StringRef Filename) const {
 }
 
 void TestRunner::writeOutput(StringRef Message) {
+  writeOutput(Message, *Program);
+}
+
+void TestRunner::writeOutput(StringRef Message, const ReducerWorkItem &Item) {
   std::error_code EC;
   raw_fd_ostream Out(OutputFilename, EC,
-                     EmitBitcode && !Program->isMIR() ? sys::fs::OF_None
-                                                      : sys::fs::OF_Text);
+                     EmitBitcode && !Item.isMIR() ? sys::fs::OF_None
+                                                  : sys::fs::OF_Text);
   if (EC) {
     errs() << "Error opening output file: " << EC.message() << "!\n";
     exit(1);
   }
 
-  Program->writeOutput(Out, EmitBitcode);
+  Item.writeOutput(Out, EmitBitcode);
   errs() << Message << OutputFilename << '\n';
 }
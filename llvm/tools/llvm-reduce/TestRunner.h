@@ -48,6 +48,12 @@ public:
 
   void writeOutput(StringRef Message);
 
+  /// Write \p Item to the output file. Used to persist a candidate reduction
+  /// that has not (yet) been installed as the current program.
+  void writeOutput(StringRef Message, const ReducerWorkItem &Item);
+
+  StringRef getOutputFilename() const { return OutputFilename; }
+
   bool inputIsBitcode() const {
     return InputIsBitcode;
   }
@@ -44,6 +44,13 @@ static cl::opt<unsigned int> StartingGranularityLevel(
     cl::desc("Number of times to divide chunks prior to first test"),
     cl::cat(LLVMReduceOptions));
 
+static cl::opt<bool> WriteCheckpoints(
+    "checkpoint",
+    cl::desc("Update the output file with the best reduction found so far "
+             "after every round of chunk testing, not only after each pass, "
+             "so that a killed run can be resumed from the output file"),
+    cl::cat(LLVMReduceOptions));
+
 #ifdef LLVM_ENABLE_THREADS
 static cl::opt<unsigned> NumJobs(
     "j",
@@ -333,6 +340,16 @@ void llvm::runDeltaPass(TestRunner &Test, ReductionFunc ExtractChunksFromModule,
              [&UninterestingChunks](const Chunk &C) {
                return UninterestingChunks.count(C);
              });
+
+    // A pass over a large module can run for a long time before the best
+    // reduction is normally written out below. Optionally persist it after
+    // every round instead. ReducedProgram cannot be installed as the current
+    // program yet since the remaining chunk indices refer to the original.
+    if (WriteCheckpoints && ReducedProgram &&
+        Test.getOutputFilename() != "-" &&
+        FoundAtLeastOneNewUninterestingChunkWithCurrentGranularity)
+      Test.writeOutput(" **** CHECKPOINT | Saved best reduction so far to ",
+                       *ReducedProgram);
   } while (!ChunksStillConsideredInteresting.empty() &&
            (FoundAtLeastOneNewUninterestingChunkWithCurrentGranularity ||
             increaseGranularity(ChunksStillConsideredInteresting)));
@@ -2736,6 +2736,28 @@ TEST(APIntTest, multiply) {
   EXPECT_EQ(64U, i96.countr_zero());
 }
 
+TEST(APIntTest, mulScratch) {
+  // Single word.
+  APInt Result(64, 0);
+  APInt::mul(APInt(64, 1234), APInt(64, 5678), Result);
+  EXPECT_EQ(7006652, Result);
+
+  // Multi-word, reusing the same scratch result across calls.
+  APInt WideResult(256, 0);
+  APInt A = APInt::getOneBitSet(256, 128);
+  APInt B(256, 1234);
+  APInt::mul(A, B, WideResult);
+  EXPECT_EQ(A * B, WideResult);
+  APInt::mul(B, B, WideResult);
+  EXPECT_EQ(B * B, WideResult);
+
+  // Truncation of the high half matches operator*.
+  APInt C = APInt::getAllOnes(128);
+  APInt Narrow(128, 0);
+  APInt::mul(C, C, Narrow);
+  EXPECT_EQ(C * C, Narrow);
+}
+
 TEST(APIntTest, RoundingUDiv) {
   for (uint64_t Ai = 1; Ai <= 255; Ai++) {
     APInt A(8, Ai);
@@ -0,0 +1,81 @@
+//===- ConcurrentStringMapTest.cpp ----------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/ConcurrentStringMap.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/Parallel.h"
+#include "gtest/gtest.h"
+#include <vector>
+using namespace llvm;
+
+namespace {
+
+TEST(ConcurrentStringMapTest, SerialInsertLookup) {
+  ConcurrentStringMap<int> Map(1);
+  EXPECT_TRUE(Map.empty());
+
+  auto Res1 = Map.try_emplace("one", 1);
+  EXPECT_TRUE(Res1.second);
+  EXPECT_EQ(Res1.first->getValue(), 1);
+
+  // Reinsertion keeps the original value.
+  auto Res2 = Map.try_emplace("one", 100);
+  EXPECT_FALSE(Res2.second);
+  EXPECT_EQ(Res2.first, Res1.first);
+  EXPECT_EQ(Res2.first->getValue(), 1);
+
+  EXPECT_TRUE(Map.contains("one"));
+  EXPECT_FALSE(Map.contains("two"));
+  EXPECT_EQ(Map.lookup("one"), 1);
+  EXPECT_EQ(Map.lookup("two"), 0);
+  EXPECT_EQ(Map.find("two"), nullptr);
+  EXPECT_EQ(Map.size(), 1U);
+}
+
+TEST(ConcurrentStringMapTest, ParallelInsert) {
+  const size_t NumEntries = 10000;
+  ConcurrentStringMap<size_t> Map;
+
+  std::vector<size_t> Indexes(NumEntries);
+  for (size_t I = 0; I < NumEntries; ++I)
+    Indexes[I] = I;
+
+  parallelForEach(Indexes, [&](size_t I) {
+    std::string Key = formatv("key{0}", I);
+    auto Res = Map.try_emplace(Key, I);
+    EXPECT_TRUE(Res.second);
+    EXPECT_EQ(Res.first->getValue(), I);
+  });
+
+  EXPECT_EQ(Map.size(), NumEntries);
+  for (size_t I = 0; I < NumEntries; ++I)
+    EXPECT_EQ(Map.lookup(formatv("key{0}", I).str()), I);
+
+  size_t Visited = 0;
+  Map.forEach([&](StringMapEntry<size_t> &Entry) { ++Visited; });
+  EXPECT_EQ(Visited, NumEntries);
+}
+
+TEST(ConcurrentStringMapTest, ParallelDuplicateInsert) {
+  const size_t NumEntries = 1000;
+  ConcurrentStringMap<size_t> Map;
+
+  std::vector<size_t> Indexes(4 * NumEntries);
+  for (size_t I = 0; I < Indexes.size(); ++I)
+    Indexes[I] = I % NumEntries;
+
+  parallelForEach(Indexes, [&](size_t I) {
+    auto Res = Map.try_emplace(formatv("key{0}", I).str(), I);
+    // Whichever thread won, the stored value matches the key.
+    EXPECT_EQ(Res.first->getValue(), I);
+  });
+
+  EXPECT_EQ(Map.size(), NumEntries);
+}
+
+} // namespace
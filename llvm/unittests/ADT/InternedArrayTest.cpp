@@ -0,0 +1,74 @@
+//===- llvm/unittest/ADT/InternedArrayTest.cpp ----------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/ADT/InternedArray.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+TEST(InternedArrayTest, DeduplicatesEqualContents) {
+  BumpPtrAllocator Alloc;
+  ArrayInterner<int> Interner(Alloc);
+
+  int A[] = {1, 2, 3};
+  int B[] = {1, 2, 3};
+  ArrayRef<int> RA = Interner.intern(A);
+  ArrayRef<int> RB = Interner.intern(B);
+
+  // Same contents yield the same canonical storage.
+  EXPECT_EQ(RA.data(), RB.data());
+  EXPECT_EQ(RA.size(), 3u);
+  EXPECT_EQ(Interner.size(), 1u);
+
+  // The canonical copy is stable storage, not the caller's buffer.
+  EXPECT_NE(RA.data(), &A[0]);
+  EXPECT_NE(RA.data(), &B[0]);
+  EXPECT_TRUE(RA.equals(ArrayRef(A)));
+}
+
+TEST(InternedArrayTest, DistinctContents) {
+  BumpPtrAllocator Alloc;
+  ArrayInterner<int> Interner(Alloc);
+
+  int A[] = {1, 2, 3};
+  int B[] = {1, 2, 4};
+  int C[] = {1, 2};
+  ArrayRef<int> RA = Interner.intern(A);
+  ArrayRef<int> RB = Interner.intern(B);
+  ArrayRef<int> RC = Interner.intern(C);
+
+  EXPECT_NE(RA.data(), RB.data());
+  EXPECT_NE(RA.data(), RC.data());
+  EXPECT_EQ(Interner.size(), 3u);
+}
+
+TEST(InternedArrayTest, EmptyArray) {
+  BumpPtrAllocator Alloc;
+  ArrayInterner<int> Interner(Alloc);
+
+  ArrayRef<int> R = Interner.intern(ArrayRef<int>());
+  EXPECT_TRUE(R.empty());
+  EXPECT_EQ(Interner.size(), 0u);
+}
+
+TEST(InternedArrayTest, PointerElements) {
+  BumpPtrAllocator Alloc;
+  ArrayInterner<const int *> Interner(Alloc);
+
+  int X, Y;
+  const int *A[] = {&X, &Y};
+  const int *B[] = {&X, &Y};
+  EXPECT_EQ(Interner.intern(A).data(), Interner.intern(B).data());
+
+  const int *Rev[] = {&Y, &X};
+  EXPECT_NE(Interner.intern(A).data(), Interner.intern(Rev).data());
+}
+
+} // end anonymous namespace
@@ -338,6 +338,38 @@ TEST_F(MemoryBufferTest, slice) {
   EXPECT_TRUE(BufData2.substr(0x2FF8,8).equals("abcdefgh"));
 }
 
+TEST_F(MemoryBufferTest, mmapReadAdvice) {
+  // Create a file large enough that getFile() maps it.
+  int FD;
+  SmallString<64> TestPath;
+  sys::fs::createTemporaryFile("MemoryBufferTest_Advice", "temp", FD, TestPath);
+  FileRemover Cleanup(TestPath);
+  raw_fd_ostream OF(FD, true, /*unbuffered=*/true);
+  for (unsigned i = 0; i < 0x8000 / 8; ++i)
+    OF << "12345678";
+  OF << "x"; // Avoid an exact multiple of the page size.
+  OF.close();
+
+  ErrorOr<OwningBuffer> MB = MemoryBuffer::getFile(TestPath.str());
+  std::error_code EC = MB.getError();
+  ASSERT_FALSE(EC);
+
+  // Advice calls are hints; they must be safe on any buffer kind and must
+  // leave the contents readable.
+  MB.get()->adviseSequentialIfMmap();
+  MB.get()->willNeedIfMmap();
+  MB.get()->willNeedIfMmap(/*Offset=*/0x1234, /*Length=*/0x100);
+  MB.get()->willNeedIfMmap(/*Offset=*/0x10000000); // Past the end: no-op.
+  StringRef BufData = MB.get()->getBuffer();
+  EXPECT_EQ(0x8001UL, BufData.size());
+  EXPECT_TRUE(BufData.substr(0, 8).equals("12345678"));
+
+  // Also a no-op on non-mmap buffers.
+  OwningBuffer Copy(MemoryBuffer::getMemBufferCopy(BufData));
+  Copy->adviseSequentialIfMmap();
+  Copy->willNeedIfMmap();
+}
+
 TEST_F(MemoryBufferTest, writableSlice) {
   // Create a file initialized with some data
   int FD;
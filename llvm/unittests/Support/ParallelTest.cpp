@@ -35,6 +35,20 @@ TEST(Parallel, sort) {
   ASSERT_TRUE(llvm::is_sorted(array));
 }
 
+TEST(Parallel, sortNonTrivial) {
+  // Non-trivially-copyable elements take a different code path than the
+  // merge sort used for the test above.
+  std::mt19937 randEngine;
+  std::uniform_int_distribution<uint32_t> dist;
+
+  std::vector<std::string> strings(10000);
+  for (auto &s : strings)
+    s = std::to_string(dist(randEngine));
+
+  parallelSort(strings.begin(), strings.end());
+  ASSERT_TRUE(llvm::is_sorted(strings));
+}
+
 TEST(Parallel, parallel_for) {
   // We need to test the case with a TaskSize > 1. We are white-box testing
   // here. The TaskSize is calculated as (End - Begin) / 1024 at the time of
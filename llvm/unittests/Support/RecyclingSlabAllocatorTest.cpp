@@ -0,0 +1,76 @@
+//===- RecyclingSlabAllocatorTest.cpp -------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/RecyclingSlabAllocator.h"
+#include "gtest/gtest.h"
+
+using namespace llvm;
+
+namespace {
+
+TEST(RecyclingSlabAllocatorTest, CacheableSizes) {
+  EXPECT_FALSE(SlabCache::isCacheableSize(0));
+  EXPECT_FALSE(SlabCache::isCacheableSize(64));
+  EXPECT_TRUE(SlabCache::isCacheableSize(4096));
+  EXPECT_TRUE(SlabCache::isCacheableSize(8192));
+  EXPECT_FALSE(SlabCache::isCacheableSize(4096 + 1));
+  EXPECT_TRUE(SlabCache::isCacheableSize(SlabCache::MaxSlabSize));
+  EXPECT_FALSE(SlabCache::isCacheableSize(SlabCache::MaxSlabSize * 2));
+}
+
+TEST(RecyclingSlabAllocatorTest, SlabIsRecycled) {
+  SlabCache &Cache = SlabCache::getProcessCache();
+  Cache.clear();
+
+  void *FirstSlab = nullptr;
+  {
+    RecyclingBumpPtrAllocator Alloc;
+    FirstSlab = Alloc.Allocate(1, 1);
+  }
+  // The freed slab should be handed back to the next allocator.
+  {
+    RecyclingBumpPtrAllocator Alloc;
+    void *SecondSlab = Alloc.Allocate(1, 1);
+    EXPECT_EQ(FirstSlab, SecondSlab);
+  }
+  Cache.clear();
+}
+
+TEST(RecyclingSlabAllocatorTest, ByteLimitRespected) {
+  SlabCache &Cache = SlabCache::getProcessCache();
+  Cache.clear();
+  Cache.setMaxCachedBytes(2 * 4096);
+
+  {
+    RecyclingBumpPtrAllocator Alloc;
+    // Force several standard-sized slabs.
+    for (int I = 0; I < 8; ++I)
+      Alloc.Allocate(3000, 8);
+  }
+  EXPECT_LE(Cache.getCachedBytes(), 2 * 4096u);
+
+  Cache.setMaxCachedBytes(0);
+  EXPECT_EQ(Cache.getCachedBytes(), 0u);
+
+  Cache.setMaxCachedBytes(SlabCache::DefaultMaxCachedBytes);
+  Cache.clear();
+}
+
+TEST(RecyclingSlabAllocatorTest, CustomSizedSlabsFallThrough) {
+  SlabCache &Cache = SlabCache::getProcessCache();
+  Cache.clear();
+  {
+    RecyclingBumpPtrAllocator Alloc;
+    // Larger than any slab size class; allocated and freed via malloc.
+    void *P = Alloc.Allocate(SlabCache::MaxSlabSize + 4096, 8);
+    EXPECT_NE(P, nullptr);
+  }
+  Cache.clear();
+}
+
+} // namespace
@@ -451,3 +451,60 @@ TEST_F(ThreadPoolTest, AffinityMask) {
 
 #endif // #ifdef _WIN32
 #endif // #if LLVM_ENABLE_THREADS == 1
+
+#if LLVM_ENABLE_THREADS == 1
+
+TEST(WorkStealingThreadPoolTest, Async) {
+  WorkStealingThreadPool Pool;
+  std::atomic_int Count{0};
+  for (size_t I = 0; I < 1000; ++I)
+    Pool.async([&Count] { ++Count; });
+  Pool.wait();
+  ASSERT_EQ(1000, Count.load());
+}
+
+TEST(WorkStealingThreadPoolTest, NestedSpawn) {
+  WorkStealingThreadPool Pool;
+  std::atomic_int Count{0};
+  // Tasks spawned from worker threads go on the local deque and must still
+  // be accounted for by wait().
+  for (size_t I = 0; I < 32; ++I)
+    Pool.async([&] {
+      for (size_t J = 0; J < 32; ++J)
+        Pool.async([&Count] { ++Count; });
+    });
+  Pool.wait();
+  ASSERT_EQ(32 * 32, Count.load());
+}
+
+TEST(WorkStealingThreadPoolTest, GetFutureWithResult) {
+  WorkStealingThreadPool Pool;
+  auto F1 = Pool.async([] { return 1; });
+  auto F2 = Pool.asyncWithAffinity(7, [] { return 2; });
+  Pool.wait();
+  ASSERT_EQ(1, F1.get());
+  ASSERT_EQ(2, F2.get());
+}
+
+TEST(WorkStealingThreadPoolTest, AffinityHintIsAdvisory) {
+  WorkStealingThreadPool Pool;
+  std::atomic_int Count{0};
+  // All tasks share one hint; stealing must still drain them all.
+  for (size_t I = 0; I < 100; ++I)
+    Pool.asyncWithAffinity(3, [&Count] { ++Count; });
+  Pool.wait();
+  ASSERT_EQ(100, Count.load());
+}
+
+TEST(WorkStealingThreadPoolTest, PoolDestruction) {
+  std::atomic_int Count{0};
+  {
+    WorkStealingThreadPool Pool;
+    for (size_t I = 0; I < 100; ++I)
+      Pool.async([&Count] { ++Count; });
+    // Destructor must wait for all tasks.
+  }
+  ASSERT_EQ(100, Count.load());
+}
+
+#endif // #if LLVM_ENABLE_THREADS == 1
@@ -0,0 +1,98 @@
+//===- WorkStealingQueueTest.cpp ------------------------------------------===//
+//
+// Part of the LLVM Project, under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+
+#include "llvm/Support/WorkStealingQueue.h"
+#include "llvm/Support/thread.h"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <vector>
+
+using namespace llvm;
+
+namespace {
+
+TEST(WorkStealingQueueTest, OwnerLIFO) {
+  WorkStealingQueue<int *> Queue;
+  int Items[3] = {0, 1, 2};
+  EXPECT_TRUE(Queue.empty());
+  EXPECT_FALSE(Queue.pop().has_value());
+
+  for (int &I : Items)
+    Queue.push(&I);
+  EXPECT_FALSE(Queue.empty());
+
+  // Owner pops in LIFO order.
+  EXPECT_EQ(*Queue.pop(), &Items[2]);
+  EXPECT_EQ(*Queue.pop(), &Items[1]);
+  EXPECT_EQ(*Queue.pop(), &Items[0]);
+  EXPECT_FALSE(Queue.pop().has_value());
+  EXPECT_TRUE(Queue.empty());
+}
+
+TEST(WorkStealingQueueTest, ThiefFIFO) {
+  WorkStealingQueue<int *> Queue;
+  int Items[3] = {0, 1, 2};
+  for (int &I : Items)
+    Queue.push(&I);
+
+  // Thieves take the oldest item first.
+  EXPECT_EQ(*Queue.steal(), &Items[0]);
+  EXPECT_EQ(*Queue.steal(), &Items[1]);
+  EXPECT_EQ(*Queue.steal(), &Items[2]);
+  EXPECT_FALSE(Queue.steal().has_value());
+}
+
+TEST(WorkStealingQueueTest, GrowsPastInitialCapacity) {
+  WorkStealingQueue<size_t> Queue(4);
+  for (size_t I = 0; I < 1000; ++I)
+    Queue.push(I);
+  for (size_t I = 1000; I-- > 0;)
+    EXPECT_EQ(*Queue.pop(), I);
+}
+
+#if LLVM_ENABLE_THREADS
+
+TEST(WorkStealingQueueTest, ConcurrentSteal) {
+  const size_t NumItems = 100000;
+  const unsigned NumThieves = 4;
+  WorkStealingQueue<size_t> Queue;
+  std::atomic<size_t> Taken{0};
+  std::atomic<bool> Done{false};
+
+  std::vector<llvm::thread> Thieves;
+  for (unsigned I = 0; I < NumThieves; ++I)
+    Thieves.emplace_back([&] {
+      while (!Done.load(std::memory_order_acquire)) {
+        if (Queue.steal())
+          Taken.fetch_add(1, std::memory_order_relaxed);
+      }
+      // Drain whatever is left.
+      while (Queue.steal())
+        Taken.fetch_add(1, std::memory_order_relaxed);
+    });
+
+  // Owner interleaves pushes and pops while thieves are active.
+  for (size_t I = 0; I < NumItems; ++I) {
+    Queue.push(I);
+    if ((I & 7) == 0 && Queue.pop())
+      Taken.fetch_add(1, std::memory_order_relaxed);
+  }
+  while (Queue.pop())
+    Taken.fetch_add(1, std::memory_order_relaxed);
+
+  Done.store(true, std::memory_order_release);
+  for (auto &Thief : Thieves)
+    Thief.join();
+
+  // Every pushed item is taken exactly once.
+  EXPECT_EQ(Taken.load(), NumItems);
+}
+
+#endif // LLVM_ENABLE_THREADS
+
+} // namespace
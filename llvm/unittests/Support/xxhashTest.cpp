@@ -61,3 +61,30 @@ TEST(xxhashTest, xxh3) {
   F(2243, 0x0979f786a24edde7);
 #undef F
 }
+
+TEST(xxhashTest, xxh3Batch) {
+  constexpr size_t size = 2048;
+  uint8_t a[size];
+  uint64_t x = 1;
+  for (size_t i = 0; i < size; ++i) {
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    a[i] = uint8_t(x);
+  }
+
+  // Batch results match element-wise hashing for mixed-length keys.
+  ArrayRef<uint8_t> inputs[] = {ArrayRef(a, size_t(0)), ArrayRef(a, size_t(5)),
+                                ArrayRef(a, size_t(100)),
+                                ArrayRef(a, size_t(2048))};
+  uint64_t results[std::size(inputs)];
+  xxh3_64bits_batch(inputs, results);
+  for (size_t i = 0; i < std::size(inputs); ++i)
+    EXPECT_EQ(xxh3_64bits(inputs[i]), results[i]);
+
+  // Strided form: fixed-size records.
+  uint64_t strided[16];
+  xxh3_64bits_batch(ArrayRef(a, size_t(2048)), 128, strided);
+  for (size_t i = 0; i < 16; ++i)
+    EXPECT_EQ(xxh3_64bits(ArrayRef(a + i * 128, size_t(128))), strided[i]);
+}
@@ -224,8 +224,13 @@ public:
   /// Each item is processed by invoking the child analysis at the program
   /// point.
   using WorkItem = std::pair<ProgramPoint, DataFlowAnalysis *>;
-  /// Push a work item onto the worklist.
-  void enqueue(WorkItem item) { worklist.push(std::move(item)); }
+  /// Push a work item onto the worklist, unless it is already pending. A
+  /// pending visit reads the latest analysis state when it runs, so queueing
+  /// the same item again would only repeat that visit.
+  void enqueue(WorkItem item) {
+    if (pendingWorkItems.insert(item).second)
+      worklist.push(std::move(item));
+  }
 
   /// Get the state associated with the given program point. If it does not
   /// exist, create an uninitialized state.
@@ -242,6 +247,10 @@ private:
   /// quickly degenerate to quadratic due to propagation of state updates.
   std::queue<WorkItem> worklist;
 
+  /// The set of work items currently on the queue, used to avoid enqueueing
+  /// an item more than once while it is pending.
+  DenseSet<WorkItem> pendingWorkItems;
+
   /// Type-erased instances of the children analyses.
   SmallVector<std::unique_ptr<DataFlowAnalysis>> childAnalyses;
 
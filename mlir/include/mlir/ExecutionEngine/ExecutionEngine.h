@@ -92,6 +92,15 @@ struct ExecutionEngineOptions {
   /// be dumped to a file via the `dumpToObjectFile` method.
   bool enableObjectDump = false;
 
+  /// If `objectCache` is provided, the JIT compiler will consult it before
+  /// compiling the module and will notify it of every object it does compile.
+  /// A disk-backed cache keyed on the module identifier lets compiled kernels
+  /// be reused across engines and across processes. The cache is not owned
+  /// and must outlive the engine. When set, it replaces the internal cache
+  /// implied by `enableObjectDump` for compilation; `dumpToObjectFile` still
+  /// only covers the internal cache.
+  llvm::ObjectCache *objectCache = nullptr;
+
   /// If enable `enableGDBNotificationListener` is set, the JIT compiler will
   /// notify the llvm's global GDB notification listener.
   bool enableGDBNotificationListener = true;
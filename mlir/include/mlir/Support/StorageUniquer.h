@@ -146,20 +146,24 @@ public:
   /// Register a new parametric storage class, this is necessary to create
   /// instances of this class type. `id` is the type identifier that will be
   /// used to identify this type when creating instances of it via 'get'.
+  /// `numShards` is the number of lock shards to use for uniquing instances of
+  /// this storage class, and must be zero or a power of 2. Zero selects a
+  /// default scaled to the host's level of hardware concurrency; storage
+  /// classes known to be heavily contended may pass a larger count.
   template <typename Storage>
-  void registerParametricStorageType(TypeID id) {
+  void registerParametricStorageType(TypeID id, size_t numShards = 0) {
     // If the storage is trivially destructible, we don't need a destructor
     // function.
     if constexpr (std::is_trivially_destructible_v<Storage>)
-      return registerParametricStorageTypeImpl(id, nullptr);
-    registerParametricStorageTypeImpl(id, [](BaseStorage *storage) {
+      return registerParametricStorageTypeImpl(id, numShards, nullptr);
+    registerParametricStorageTypeImpl(id, numShards, [](BaseStorage *storage) {
       static_cast<Storage *>(storage)->~Storage();
     });
   }
   /// Utility override when the storage type represents the type id.
   template <typename Storage>
-  void registerParametricStorageType() {
-    registerParametricStorageType<Storage>(TypeID::get<Storage>());
+  void registerParametricStorageType(size_t numShards = 0) {
+    registerParametricStorageType<Storage>(TypeID::get<Storage>(), numShards);
   }
   /// Register a new singleton storage class, this is necessary to get the
   /// singletone instance. `id` is the type identifier that will be used to
@@ -268,9 +272,11 @@ private:
 
   /// Implementation for registering an instance of a derived type with
   /// parametric storage. This method takes an optional destructor function that
-  /// destructs storage instances when necessary.
+  /// destructs storage instances when necessary. `numShards` is the number of
+  /// uniquing shards to use, with zero selecting the default.
   void registerParametricStorageTypeImpl(
-      TypeID id, function_ref<void(BaseStorage *)> destructorFn);
+      TypeID id, size_t numShards,
+      function_ref<void(BaseStorage *)> destructorFn);
 
   /// Implementation for getting an instance of a derived type with default
   /// storage.
@@ -99,6 +99,7 @@ LogicalResult DataFlowSolver::initializeAndRun(Operation *top) {
     // Exhaust the worklist.
     while (!worklist.empty()) {
       auto [point, analysis] = worklist.front();
+      pendingWorkItems.erase(worklist.front());
       worklist.pop();
 
       DATAFLOW_DEBUG(llvm::dbgs() << "Invoking '" << analysis->debugName
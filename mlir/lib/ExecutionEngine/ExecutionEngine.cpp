@@ -359,8 +359,9 @@ ExecutionEngine::create(Operation *m, const ExecutionEngineOptions &options,
       -> Expected<std::unique_ptr<IRCompileLayer::IRCompiler>> {
     if (options.jitCodeGenOptLevel)
       jtmb.setCodeGenOptLevel(*options.jitCodeGenOptLevel);
-    return std::make_unique<TMOwningSimpleCompiler>(std::move(tm),
-                                                    engine->cache.get());
+    return std::make_unique<TMOwningSimpleCompiler>(
+        std::move(tm),
+        options.objectCache ? options.objectCache : engine->cache.get());
   };
 
   // Create the LLJIT by calling the LLJITBuilder with 2 callbacks.
@@ -11,11 +11,25 @@
 #include "mlir/Support/LLVM.h"
 #include "mlir/Support/ThreadLocalCache.h"
 #include "mlir/Support/TypeID.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/RWMutex.h"
+#include "llvm/Support/Threading.h"
 
 using namespace mlir;
 using namespace mlir::detail;
 
+/// Return the default number of uniquing shards for a parametric storage
+/// class. Shards are allocated lazily, so the only fixed cost of a larger
+/// count is one atomic pointer per shard; size it to the host so that uniquer
+/// locks don't become the scaling limit on many-core machines.
+static size_t getDefaultNumShards() {
+  static size_t numShards = llvm::PowerOf2Ceil(std::min<unsigned>(
+      std::max<unsigned>(
+          llvm::hardware_concurrency().compute_thread_count(), 8u),
+      256u));
+  return numShards;
+}
+
 namespace {
 /// This class represents a uniquer for storage instances of a specific type
 /// that has parametric storage. It contains all of the necessary data to unique
@@ -113,7 +127,7 @@ public:
   /// use. The provided shard number is required to be a valid power of 2. The
   /// destructor function is used to destroy any allocated storage instances.
   ParametricStorageUniquer(function_ref<void(BaseStorage *)> destructorFn,
-                           size_t numShards = 8)
+                           size_t numShards)
       : shards(new std::atomic<Shard *>[numShards]), numShards(numShards),
         destructorFn(destructorFn) {
     assert(llvm::isPowerOf2_64(numShards) &&
@@ -215,7 +229,7 @@ private:
   /// always use one shard. The destructor function is used to destroy any
   /// allocated storage instances.
   ParametricStorageUniquer(function_ref<void(BaseStorage *)> destructorFn,
-                           size_t numShards = 0)
+                           size_t numShards)
       : destructorFn(destructorFn) {}
   ~ParametricStorageUniquer() { destroyShardInstances(shard); }
 
@@ -378,9 +392,14 @@ auto StorageUniquer::getParametricStorageTypeImpl(
 /// Implementation for registering an instance of a derived type with
 /// parametric storage.
 void StorageUniquer::registerParametricStorageTypeImpl(
-    TypeID id, function_ref<void(BaseStorage *)> destructorFn) {
+    TypeID id, size_t numShards,
+    function_ref<void(BaseStorage *)> destructorFn) {
+  if (numShards == 0)
+    numShards = getDefaultNumShards();
+  assert(llvm::isPowerOf2_64(numShards) &&
+         "the number of shards is required to be a power of 2");
   impl->parametricUniquers.try_emplace(
-      id, std::make_unique<ParametricStorageUniquer>(destructorFn));
+      id, std::make_unique<ParametricStorageUniquer>(destructorFn, numShards));
 }
 
 /// Implementation for getting an instance of a derived type with default
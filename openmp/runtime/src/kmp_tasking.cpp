@@ -3415,13 +3415,32 @@ static inline int __kmp_execute_tasks_template(
           asleep = 0;
         } else if (!new_victim) { // no recent steals and we haven't already
           // used a new victim; select a random thread
+          int steal_nearby = 1;
           do { // Find a different thread to steal work from.
             // Pick a random thread. Initial plan was to cycle through all the
             // threads, and only return if we tried to steal from every thread,
             // and failed.  Arch says that's not such a great idea.
-            victim_tid = __kmp_get_random(thread) % (nthreads - 1);
-            if (victim_tid >= tid) {
-              ++victim_tid; // Adjusts random distribution to exclude self
+            // The first probe prefers a victim nearby in the team: with
+            // compact place bindings neighboring tids share a core complex /
+            // last-level cache, so a successful nearby steal keeps the stolen
+            // task's data in the local cache domain and avoids all threads
+            // hammering the same remote deques on large machines. Subsequent
+            // probes draw uniformly from the whole team so sparse bindings
+            // and empty neighborhoods still make progress.
+            const kmp_int32 span = 8; // ~ one core complex
+            if (steal_nearby && nthreads > span) {
+              victim_tid = tid - span / 2 +
+                           (kmp_int32)(__kmp_get_random(thread) % span);
+              if (victim_tid >= tid) {
+                ++victim_tid; // Adjusts distribution to exclude self
+              }
+              victim_tid = (victim_tid + nthreads) % nthreads;
+              steal_nearby = 0;
+            } else {
+              victim_tid = __kmp_get_random(thread) % (nthreads - 1);
+              if (victim_tid >= tid) {
+                ++victim_tid; // Adjusts random distribution to exclude self
+              }
             }
             // Found a potential victim
             other_thread = threads_data[victim_tid].td.td_thr;